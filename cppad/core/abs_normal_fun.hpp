@@ -876,6 +876,8 @@ void ADFun<Base>::abs_normal_fun(ADFun<Base>& g, ADFun<Base>& a) const
 	// (the resutls are no longer valid)
 	g.for_jac_sparse_pack_.resize(0, 0);
 	g.for_jac_sparse_set_.resize(0, 0);
+	g.for_jac_sparse_roaring_.resize(0, 0);
+	g.sparse_cache_info_.clear();
 
 	// free taylor coefficient memory
 	g.taylor_.clear();
@@ -913,6 +915,8 @@ void ADFun<Base>::abs_normal_fun(ADFun<Base>& g, ADFun<Base>& a) const
 	// (the resutls are no longer valid)
 	a.for_jac_sparse_pack_.resize(0, 0);
 	a.for_jac_sparse_set_.resize(0, 0);
+	a.for_jac_sparse_roaring_.resize(0, 0);
+	a.sparse_cache_info_.clear();
 
 	// free taylor coefficient memory
 	a.taylor_.clear();
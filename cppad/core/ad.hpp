@@ -300,6 +300,7 @@ private:
 	inline static tape_id_t*            tape_id_ptr(size_t thread);
 	inline static local::ADTape<Base>** tape_handle(size_t thread);
 	static local::ADTape<Base>*         tape_manage(tape_manage_job job);
+	static void                         tape_reset(size_t thread);
 	inline static local::ADTape<Base>*  tape_ptr(void);
 	inline static local::ADTape<Base>*  tape_ptr(tape_id_t tape_id);
 };
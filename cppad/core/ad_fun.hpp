@@ -41,6 +41,8 @@ derivative values, and other values related to the corresponding function.
 $childtable%
 	omh/adfun.omh%
 	cppad/core/optimize.hpp%
+	cppad/core/reroll.hpp%
+	cppad/core/memory_checkpoint.hpp%
 	example/abs_normal/abs_normal.omh%
 	cppad/core/fun_check.hpp%
 	cppad/core/check_for_nan.hpp
@@ -48,7 +50,9 @@ $childtable%
 
 $end
 */
+# include <vector>
 # include <cppad/local/subgraph/info.hpp>
+# include <cppad/local/sparse_cache.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -67,6 +71,11 @@ It does it calculations using \c Base operations.
 
 template <class Base>
 class ADFun {
+	// reroll and memory_checkpoint set the operation sequence directly
+	friend class reroll<Base>;
+	friend class memory_checkpoint<Base>;
+	// checkpoint uses share_recording for its per-thread functions
+	friend class checkpoint<Base>;
 // ------------------------------------------------------------
 // Private member variables
 private:
@@ -76,6 +85,14 @@ private:
 	/// Check for nan's and report message to user (default value is true).
 	bool check_for_nan_;
 
+	/// Use compressed bitmaps for internal sparsity patterns
+	/// (default value is false).
+	bool internal_roaring_;
+
+	/// Keep the sparsity patterns and colorings computed by sparse_jac_full
+	/// and sparse_hes_full (default value is false).
+	bool sparse_cache_;
+
 	/// If zero, ignoring comparison operators. Otherwise is the
 	/// compare change count at which to store the operator index.
 	size_t compare_change_count_;
@@ -125,6 +142,11 @@ private:
 	/// the operation sequence corresponding to this object
 	local::player<Base> play_;
 
+	/// If not null, Forward and Reverse use this operation sequence
+	/// (owned by another ADFun object) instead of play_
+	/// (see share_recording).
+	const local::player<Base>* shared_play_;
+
 	/// Packed results of the forward mode Jacobian sparsity calculations.
 	/// for_jac_sparse_pack_.n_set() != 0  implies other sparsity results
 	/// are empty
@@ -134,9 +156,17 @@ private:
 	/// for_jac_sparse_set_.n_set() != 0  implies for_sparse_pack_ is empty.
 	local::sparse_list for_jac_sparse_set_;
 
+	/// Compressed bitmap results of the forward mode Jacobian sparsity
+	/// calculations. for_jac_sparse_roaring_.n_set() != 0  implies
+	/// other sparsity results are empty.
+	local::sparse_roaring for_jac_sparse_roaring_;
+
 	/// subgraph information for this object
 	local::subgraph::subgraph_info subgraph_info_;
 
+	/// sparsity patterns and colorings cached for this object
+	local::sparse_cache_info sparse_cache_info_;
+
 	/// used for subgraph reverse mode calculations.
 	/// Declared here to avoid reallocation for each call to subgraph_reverse.
 	/// Not in subgraph_info_ because it depends on Base.
@@ -145,6 +175,19 @@ private:
 // ------------------------------------------------------------
 // Private member functions
 
+	/// operation sequence used by Forward and Reverse
+	const local::player<Base>* play_ptr(void) const
+	{	if( shared_play_ != CPPAD_NULL )
+			return shared_play_;
+		return &play_;
+	}
+
+	/// share the operation sequence in f for use by Forward and Reverse
+	void share_recording(const ADFun& f);
+
+	/// values that identify the operation sequence for sparse_cache_write
+	void sparse_cache_key(CppAD::vector<size_t>& key) const;
+
 	/// change the operation sequence corresponding to this object
 	template <typename ADvector>
 	void Dependent(local::ADTape<Base> *tape, const ADvector &y);
@@ -271,11 +314,17 @@ private:
 		      VectorBase&              hes         ,
 		      sparse_hessian_work&     work
 	);
+	// ------------------------------------------------------------
+	// optimize with or without a report (see doxygen in optimize.hpp)
+	void optimize_compute(
+		const std::string&             options     ,
+		optimize_report*               report
+	);
 // ------------------------------------------------------------
 public:
 	/// copy constructor
 	ADFun(const ADFun& g)
-	: num_var_tape_(0)
+	: num_var_tape_(0), shared_play_(CPPAD_NULL)
 	{	CppAD::ErrorHandler::Call(
 		true,
 		__LINE__,
@@ -308,6 +357,24 @@ public:
 	/// get check_for_nan
 	bool check_for_nan(void) const;
 
+	/// set internal_roaring
+	void internal_roaring(bool value);
+
+	/// get internal_roaring
+	bool internal_roaring(void) const;
+
+	/// set sparse_cache
+	void sparse_cache(bool value);
+
+	/// get sparse_cache
+	bool sparse_cache(void) const;
+
+	/// write the sparse_cache information
+	void sparse_cache_write(std::ostream& os) const;
+
+	/// read the sparse_cache information
+	bool sparse_cache_read(std::istream& is);
+
 	/// assign a new operation sequence
 	template <typename ADvector>
 	void Dependent(const ADvector &x, const ADvector &y);
@@ -361,17 +428,37 @@ public:
 		SizeVector&                          col       ,
 		VectorBase&                          dw
 	);
+	void subgraph_jac_rev_thread(
+		const local::pod_vector<size_t>&     dep_index ,
+		size_t                               n_thread  ,
+		std::vector< std::vector<size_t> >&  col_out   ,
+		std::vector< std::vector<Base> >&    val_out
+	);
 	template <typename SizeVector, typename BaseVector>
 	void subgraph_jac_rev(
 		const BaseVector&                    x         ,
-		sparse_rcv<SizeVector, BaseVector>&  subset
+		sparse_rcv<SizeVector, BaseVector>&  subset    ,
+		size_t                               n_thread = 1
 	);
 	template <typename BoolVector, typename SizeVector, typename BaseVector>
 	void subgraph_jac_rev(
 		const BoolVector&                    select_domain ,
 		const BoolVector&                    select_range  ,
 		const BaseVector&                    x             ,
-		sparse_rcv<SizeVector, BaseVector>&  matrix_out
+		sparse_rcv<SizeVector, BaseVector>&  matrix_out    ,
+		size_t                               n_thread = 1
+	);
+	template <typename Addr, typename SizeVector, typename BaseVector>
+	void subgraph_hes_helper(
+		const BaseVector&                    w             ,
+		const local::pod_vector<bool>&       select_domain ,
+		sparse_rcv<SizeVector, BaseVector>&  subset
+	);
+	template <typename SizeVector, typename BaseVector>
+	void subgraph_hes(
+		const BaseVector&                    x             ,
+		const BaseVector&                    w             ,
+		sparse_rcv<SizeVector, BaseVector>&  subset
 	);
 	template <typename SizeVector, typename BaseVector>
 	size_t sparse_jac_for(
@@ -380,7 +467,8 @@ public:
 		sparse_rcv<SizeVector, BaseVector>&  subset    ,
 		const sparse_rc<SizeVector>&         pattern   ,
 		const std::string&                   coloring  ,
-		sparse_jac_work&                     work
+		sparse_jac_work&                     work      ,
+		size_t                               n_thread = 1
 	);
 	template <typename SizeVector, typename BaseVector>
 	size_t sparse_jac_rev(
@@ -388,7 +476,8 @@ public:
 		sparse_rcv<SizeVector, BaseVector>&  subset   ,
 		const sparse_rc<SizeVector>&         pattern  ,
 		const std::string&                   coloring ,
-		sparse_jac_work&                     work
+		sparse_jac_work&                     work     ,
+		size_t                               n_thread = 1
 	);
 	template <typename SizeVector, typename BaseVector>
 	size_t sparse_hes(
@@ -397,7 +486,21 @@ public:
 		sparse_rcv<SizeVector, BaseVector>&  subset   ,
 		const sparse_rc<SizeVector>&         pattern  ,
 		const std::string&                   coloring ,
-		sparse_hes_work&                     work
+		sparse_hes_work&                     work     ,
+		size_t                               n_thread = 1
+	);
+	template <typename SizeVector, typename BaseVector>
+	size_t sparse_jac_full(
+		const BaseVector&                    x        ,
+		sparse_rcv<SizeVector, BaseVector>&  jac      ,
+		size_t                               n_thread = 1
+	);
+	template <typename SizeVector, typename BaseVector>
+	size_t sparse_hes_full(
+		const BaseVector&                    x        ,
+		const BaseVector&                    w        ,
+		sparse_rcv<SizeVector, BaseVector>&  hes      ,
+		size_t                               n_thread = 1
 	);
 	// ---------------------------------------------------------------------
 	template <typename BoolVector, typename SizeVector>
@@ -405,7 +508,8 @@ public:
 		const BoolVector&            select_domain    ,
 		const BoolVector&            select_range     ,
 		bool                         transpose        ,
-		sparse_rc<SizeVector>&       pattern_out
+		sparse_rc<SizeVector>&       pattern_out      ,
+		size_t                       n_thread = 1
 	);
 	template <typename SizeVector>
 	void for_jac_sparsity(
@@ -483,7 +587,6 @@ public:
 	bool                          dependency ,
 	local::sparse_list&                  s
 	);
-
 	/// amount of memory used for boolean Jacobain sparsity pattern
 	size_t size_forward_bool(void) const
 	{	return for_jac_sparse_pack_.memory(); }
@@ -499,7 +602,7 @@ public:
 
 	/// amount of memory used for vector of set Jacobain sparsity pattern
 	size_t size_forward_set(void) const
-	{	return for_jac_sparse_set_.memory(); }
+	{	return for_jac_sparse_set_.memory() + for_jac_sparse_roaring_.memory(); }
 
 	/// free memory used for Jacobain sparsity pattern
 	void size_forward_set(size_t zero)
@@ -508,6 +611,7 @@ public:
 			"size_forward_bool: argument not equal to zero"
 		);
 		for_jac_sparse_set_.resize(0, 0);
+		for_jac_sparse_roaring_.resize(0, 0);
 	}
 
 	/// number of operators in the operation sequence
@@ -569,6 +673,9 @@ public:
 	/// set number of orders and directions currently allocated
 	void capacity_order(size_t c, size_t r);
 
+	/// arena used for the Taylor coefficients and other work memory
+	void set_arena(thread_alloc_arena* arena);
+
 	/// number of variables in conditional expressions that can be skipped
 	size_t number_skip(void);
 
@@ -703,6 +810,7 @@ public:
 	// Optimize the tape
 	// (see doxygen documentation in optimize.hpp)
 	void optimize( const std::string& options = "" );
+	void optimize( const std::string& options, optimize_report& report );
 
 	// create abs-normal representation of the function f(x)
 	void abs_normal_fun( ADFun& g, ADFun& a ) const;
@@ -729,11 +837,13 @@ public:
 	size_t Memory(void) const
 	{	size_t pervar  = cap_order_taylor_ * sizeof(Base)
 		+ for_jac_sparse_pack_.memory()
-		+ for_jac_sparse_set_.memory();
+		+ for_jac_sparse_set_.memory()
+		+ for_jac_sparse_roaring_.memory();
 		size_t total   = num_var_tape_  * pervar;
 		total         += play_.size_op_seq();
 		total         += play_.size_random();
 		total         += subgraph_info_.memory();
+		total         += sparse_cache_info_.memory();
 		return total;
 	}
 
@@ -781,6 +891,8 @@ public:
 # include <cppad/core/fun_check.hpp>
 # include <cppad/core/omp_max_thread.hpp>
 # include <cppad/core/optimize.hpp>
+# include <cppad/core/reroll.hpp>
+# include <cppad/core/memory_checkpoint.hpp>
 # include <cppad/core/abs_normal_fun.hpp>
 
 # endif
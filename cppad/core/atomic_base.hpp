@@ -103,6 +103,10 @@ public:
 	/// Name corresponding to a base_atomic object
 	const std::string& afun_name(void) const
 	{	return class_name()[index_]; }
+
+	/// Index of this object in the list of atomic functions
+	size_t atomic_index(void) const
+	{	return index_; }
 /*
 $begin atomic_ctor$$
 $spell
@@ -277,7 +281,8 @@ void allocate_work(size_t thread)
 	return;
 }
 /// frees work_ for a specified thread
-void free_work(size_t thread)
+/// (derived classes can also free their own memory for this thread)
+virtual void free_work(size_t thread)
 {	if( work_[thread] != CPPAD_NULL )
 	{	// call destructor
 		work_[thread]->~work_struct();
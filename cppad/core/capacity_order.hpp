@@ -154,7 +154,8 @@ The output value of num_direction_taylor_ is equal to \c r.
 
 template <typename Base>
 void ADFun<Base>::capacity_order(size_t c, size_t r)
-{	// temporary indices
+{	thread_alloc::tag_scope scope(thread_alloc::taylor_tag);
+	// temporary indices
 	size_t i, k, ell;
 
 	if( (c == cap_order_taylor_) & (r == num_direction_taylor_) )
@@ -172,7 +173,9 @@ void ADFun<Base>::capacity_order(size_t c, size_t r)
 
 	// Allocate new taylor with requested number of orders and directions
 	size_t new_len   = ( (c-1)*r + 1 ) * num_var_tape_;
-	local::pod_vector_maybe<Base> new_taylor(new_len);
+	local::pod_vector_maybe<Base> new_taylor;
+	new_taylor.set_arena( taylor_.arena() );
+	new_taylor.extend(new_len);
 
 	// number of orders to copy
 	size_t p = std::min(num_order_taylor_, c);
@@ -13,6 +13,9 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 # include <cppad/local/sparse_list.hpp>
 # include <cppad/local/sparse_pack.hpp>
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <mutex>
+# endif
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -35,6 +38,7 @@ $spell
 	enum
 	bool
 	recomputed
+	mutex
 $$
 
 $section Checkpointing Functions$$
@@ -43,6 +47,7 @@ $head Syntax$$
 $codei%checkpoint<%Base%> %atom_fun%(
 	%name%, %algo%, %ax%, %ay%, %sparsity%, %optimize%
 )
+checkpoint<%Base%> %atom_fun%(%name%, %fun%, %sparsity%, %optimize%)
 %sv% = %atom_fun%.size_var()
 %atom_fun%.option(%option_value%)
 %algo%(%ax%, %ay%)
@@ -112,6 +117,10 @@ $lnext
 This object $icode atom_fun$$ must not be destructed for as long
 as any $codei%ADFun<%Base%>%$$ object uses its atomic operation.
 $lnext
+The $icode fun$$ syntax for the constructor can be used when
+the operation sequence for $latex f(x)$$ is already stored in an
+$codei%ADFun<%Base%>%$$ object.
+$lnext
 This class is implemented as a derived class of
 $cref/atomic_base/atomic_ctor/atomic_base/$$ and hence
 some of its error message will refer to $code atomic_base$$.
@@ -154,6 +163,19 @@ The input values of its elements do not matter.
 Upon return, it is an $codei%AD<%Base%>%$$ version of
 $latex y = f(x)$$.
 
+$head fun$$
+This argument has prototype
+$codei%
+	const ADFun<%Base%>& %fun%
+%$$
+Its operation sequence corresponds to $latex y = f(x)$$
+and it cannot use any $cref/dynamic/Independent/dynamic/$$ parameters.
+A copy of this operation sequence is stored in $icode atom_fun$$.
+It is used in place of $icode algo$$, $icode ax$$, and $icode ay$$
+and $latex n$$ ($latex m$$) is the
+$cref/domain/seq_property/Domain/$$ ($cref/range/seq_property/Range/$$)
+size for $icode fun$$.
+
 $head sparsity$$
 This argument has prototype
 $codei%
@@ -218,9 +240,28 @@ see $cref/start recording/Independent/Start Recording/$$.
 $icode%m%+%n%+2%$$ operations and creates $icode m$$ new variables,
 but this is not part of the CppAD specifications and my change.)
 
+$head Parallel Mode$$
+The operation sequence corresponding to $icode algo$$ is stored once
+in $icode atom_fun$$ and is not changed after the constructor.
+Each thread that uses $icode atom_fun$$ stores its own Taylor coefficients
+(for the duration of a forward or reverse mode calculation).
+Hence, the same $icode atom_fun$$ object can be used by multiple threads
+at the same time in $cref/parallel/ta_in_parallel/$$ execution mode;
+i.e., there is no need to create a separate checkpoint object,
+and copy of the operation sequence, for each thread.
+The sparsity patterns for $icode atom_fun$$ are computed once and cached.
+If $code CPPAD_USE_CPLUSPLUS_2011$$ is true,
+sparsity calculations that use $icode atom_fun$$ can also be done
+by multiple threads at the same time
+(they are serialized using a mutex).
+Otherwise, only one thread at a time can do such sparsity calculations.
+See $cref checkpoint_thread.cpp$$ for an example and test.
+
 $head clear$$
 The $code atomic_base$$ class holds onto static work space in order to
 increase speed by avoiding system memory allocation calls.
+In addition, each thread that has used a checkpoint function holds onto
+the memory used to evaluate its operation sequence.
 This call makes to work space $cref/available/ta_available/$$ to
 for other uses by the same thread.
 This should be called when you are done using the
@@ -231,6 +272,7 @@ The $code clear$$ routine cannot be called
 while in $cref/parallel/ta_in_parallel/$$ execution mode.
 
 $children%example/atomic/checkpoint.cpp
+	%example/atomic/checkpoint_thread.cpp
 	%example/atomic/mul_level.cpp
 	%example/atomic/ode.cpp
 	%example/atomic/extended_ode.cpp
@@ -263,8 +305,14 @@ private:
 	typedef typename atomic_base<Base>::option_enum option_enum;
 	//
 	/// AD function corresponding to this checkpoint object
+	/// (its operation sequence is shared by all the threads)
 	ADFun<Base> f_;
 	//
+	/// Taylor coefficients for each thread; i.e., functions that share the
+	/// operation sequence in f_ (null if not yet used by a thread).
+	/// Use pointers, to avoid false sharing between threads.
+	ADFun<Base>* eval_[CPPAD_MAX_NUM_THREADS];
+	//
 	/// sparsity for entire Jacobian f(x)^{(1)} does not change so can cache it
 	local::sparse_list         jac_sparse_set_;
 	vectorBool                 jac_sparse_bool_;
@@ -272,10 +320,40 @@ private:
 	/// sparsity for sum_i f_i(x)^{(2)} does not change so can cache it
 	local::sparse_list         hes_sparse_set_;
 	vectorBool                 hes_sparse_bool_;
+	//
+# if CPPAD_USE_CPLUSPLUS_2011
+	/// serializes the sparsity calculations (which use f_ and the cached
+	/// sparsity patterns above) between threads
+	std::mutex sparse_mutex_;
+	typedef std::lock_guard<std::mutex> sparse_lock;
+# else
+	/// sparsity calculations cannot be done by more than one thread at once
+	struct sparse_mutex_struct { };
+	sparse_mutex_struct sparse_mutex_;
+	struct sparse_lock {
+		sparse_lock(sparse_mutex_struct&) { }
+	};
+# endif
 	// ------------------------------------------------------------------------
 	option_enum sparsity(void)
 	{	return static_cast< atomic_base<Base>* >(this)->sparsity(); }
 	// ------------------------------------------------------------------------
+	/// function used by the current thread for Forward and Reverse mode
+	ADFun<Base>& eval(void)
+	{	size_t thread = thread_alloc::thread_num();
+		if( eval_[thread] == CPPAD_NULL )
+		{	// allocate the raw memory
+			size_t min_bytes = sizeof( ADFun<Base> );
+			size_t num_bytes;
+			void*  v_ptr     = thread_alloc::get_memory(min_bytes, num_bytes);
+			// call constructor
+			eval_[thread] = new( v_ptr ) ADFun<Base>;
+			// share the operation sequence in f_
+			eval_[thread]->share_recording(f_);
+		}
+		return *eval_[thread];
+	}
+	// ------------------------------------------------------------------------
 	/// set jac_sparse_set_
 	void set_jac_sparse_set(void)
 	{	CPPAD_ASSERT_UNKNOWN( jac_sparse_set_.n_set() == 0 );
@@ -422,6 +500,7 @@ private:
 		      sparsity_type&                    s  ,
 		const vector<Base>&                     x  )
 	{	// during user sparsity calculations
+		sparse_lock lock(sparse_mutex_);
 		size_t m = f_.Range();
 		size_t n = f_.Domain();
 		if( jac_sparse_bool_.size() == 0 )
@@ -467,6 +546,7 @@ private:
 		      sparsity_type&                    st ,
 		const vector<Base>&                     x  )
 	{	// during user sparsity calculations
+		sparse_lock lock(sparse_mutex_);
 		size_t m = f_.Range();
 		size_t n = f_.Domain();
 		if( jac_sparse_bool_.size() == 0 )
@@ -512,7 +592,8 @@ private:
 		const sparsity_type&                    u  ,
 		      sparsity_type&                    v  ,
 		const vector<Base>&                     x  )
-	{	size_t n = f_.Domain();
+	{	sparse_lock lock(sparse_mutex_);
+		size_t n = f_.Domain();
 # ifndef NDEBUG
 		size_t m = f_.Range();
 # endif
@@ -615,6 +696,8 @@ public:
 		bool                           optimize = true
 	) : atomic_base<Base>(name, sparsity)
 	{	CheckSimpleVector< CppAD::AD<Base> , ADVector>();
+		for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+			eval_[thread] = CPPAD_NULL;
 
 		// make a copy of ax because Independent modifies AD information
 		ADVector x_tmp(ax);
@@ -638,6 +721,65 @@ public:
 	}
 	// ------------------------------------------------------------------------
 	/*!
+	Constructor of a checkpoint object using an existing function
+
+	\param name [in]
+	is the user's name for the AD version of this atomic operation.
+
+	\param fun [in]
+	is the function that this checkpoint object computes.
+
+	\param sparsity [in]
+	what type of sparsity patterns are computed by this function,
+	pack_sparsity_enum bool_sparsity_enum, or set_sparsity_enum.
+	The default value is unspecified.
+
+	\param optimize [in]
+	should the operation sequence corresponding to fun be optimized.
+	The default value is true.
+	*/
+	checkpoint(
+		const char*                    name            ,
+		const ADFun<Base>&             fun             ,
+		option_enum                    sparsity =
+				atomic_base<Base>::pack_sparsity_enum  ,
+		bool                           optimize = true
+	) : atomic_base<Base>(name, sparsity)
+	{	for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+			eval_[thread] = CPPAD_NULL;
+		f_ = fun;
+		if( optimize )
+		{	f_.check_for_nan(false);
+			f_.optimize();
+		}
+		f_.compare_change_count(0);
+	}
+	/// destructor frees the Taylor coefficients for all the threads
+	virtual ~checkpoint(void)
+	{	for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+			free_work(thread);
+	}
+	// ------------------------------------------------------------------------
+	/*!
+	Free the work space, and the function used for Forward and Reverse mode,
+	for a specified thread.
+
+	\param thread
+	is the thread.
+	*/
+	virtual void free_work(size_t thread)
+	{	this->atomic_base<Base>::free_work(thread);
+		if( eval_[thread] != CPPAD_NULL )
+		{	// call destructor
+			eval_[thread]->~ADFun<Base>();
+			// return memory to avialable pool for this thread
+			void* v_ptr = reinterpret_cast<void*>( eval_[thread] );
+			thread_alloc::return_memory(v_ptr);
+			eval_[thread] = CPPAD_NULL;
+		}
+	}
+	// ------------------------------------------------------------------------
+	/*!
 	Implement the user call to <tt>atom_fun.size_var()</tt>.
 	*/
 	size_t size_var(void)
@@ -691,8 +833,9 @@ public:
 		CPPAD_ASSERT_UNKNOWN( m == ty.size() / (q+1) );
 		bool ok  = true;
 		//
-		if( vx.size() == 0 )
+		if( vx.size() == 0 && ! thread_alloc::in_parallel() )
 		{	// during user forward mode
+			// (other threads may be using the cached patterns in parallel)
 			if( jac_sparse_set_.n_set() != 0 )
 				jac_sparse_set_.resize(0,0);
 			if( jac_sparse_bool_.size() != 0 )
@@ -706,6 +849,7 @@ public:
 		if( vx.size() > 0 )
 		{	// need Jacobian sparsity pattern to determine variable relation
 			// during user recording using checkpoint functions
+			sparse_lock lock(sparse_mutex_);
 			if( sparsity() == atomic_base<Base>::set_sparsity_enum )
 			{	if( jac_sparse_set_.n_set() == 0 )
 					set_jac_sparse_set();
@@ -747,14 +891,15 @@ public:
 			}
 		}
 		// compute forward results for orders zero through q
-		ty = f_.Forward(q, tx);
+		ADFun<Base>& g( eval() );
+		ty = g.Forward(q, tx);
 
-		// no longer need the Taylor coefficients in f_
+		// no longer need the Taylor coefficients in g
 		// (have to reconstruct them every time)
 		// Hold onto sparsity pattern because it is always good.
 		size_t c = 0;
 		size_t r = 0;
-		f_.capacity_order(c, r);
+		g.capacity_order(c, r);
 		return ok;
 	}
 	// ------------------------------------------------------------------------
@@ -781,17 +926,18 @@ public:
 		CPPAD_ASSERT_UNKNOWN( ty.size() % (q+1) == 0 );
 		bool ok  = true;
 
-		// put proper forward mode coefficients in f_
+		// put proper forward mode coefficients in g
+		ADFun<Base>& g( eval() );
 # ifdef NDEBUG
 		// compute forward results for orders zero through q
-		f_.Forward(q, tx);
+		g.Forward(q, tx);
 # else
 		CPPAD_ASSERT_UNKNOWN( px.size() == n * (q+1) );
 		CPPAD_ASSERT_UNKNOWN( py.size() == m * (q+1) );
 		size_t i, j, k;
 		//
 		// compute forward results for orders zero through q
-		vector<Base> check_ty = f_.Forward(q, tx);
+		vector<Base> check_ty = g.Forward(q, tx);
 		for(i = 0; i < m; i++)
 		{	for(k = 0; k <= q; k++)
 			{	j = i * (q+1) + k;
@@ -800,13 +946,13 @@ public:
 		}
 # endif
 		// now can run reverse mode
-		px = f_.Reverse(q+1, py);
+		px = g.Reverse(q+1, py);
 
-		// no longer need the Taylor coefficients in f_
+		// no longer need the Taylor coefficients in g
 		// (have to reconstruct them every time)
 		size_t c = 0;
 		size_t r = 0;
-		f_.capacity_order(c, r);
+		g.capacity_order(c, r);
 		return ok;
 	}
 	// ------------------------------------------------------------------------
@@ -845,6 +991,7 @@ public:
 		      vector< std::set<size_t> >&       s  ,
 		const vector<Base>&                     x  )
 	{	// during user sparsity calculations
+		sparse_lock lock(sparse_mutex_);
 		size_t m = f_.Range();
 		size_t n = f_.Domain();
 		if( jac_sparse_bool_.size() != 0 )
@@ -918,6 +1065,7 @@ public:
 		      vector< std::set<size_t> >&       st ,
 		const vector<Base>&                     x  )
 	{	// during user sparsity calculations
+		sparse_lock lock(sparse_mutex_);
 		size_t m = f_.Range();
 		size_t n = f_.Domain();
 		if( jac_sparse_bool_.size() != 0 )
@@ -1008,7 +1156,8 @@ public:
 		const vector< std::set<size_t> >&       u  ,
 		      vector< std::set<size_t> >&       v  ,
 		const vector<Base>&                     x  )
-	{	size_t n = f_.Domain();
+	{	sparse_lock lock(sparse_mutex_);
+		size_t n = f_.Domain();
 # ifndef NDEBUG
 		size_t m = f_.Range();
 # endif
@@ -1477,6 +1626,49 @@ l	should the operation sequence corresponding to the algo be optimized.
 	}
 	// ------------------------------------------------------------------------
 	/*!
+	Constructor of a checkpoint object using an existing function
+
+	\param name [in]
+	is the user's name for the AD version of this atomic operation.
+
+	\param fun [in]
+	is the function that this checkpoint object computes.
+
+	\param sparsity [in]
+	what type of sparsity patterns are computed by this function,
+	pack_sparsity_enum bool_sparsity_enum, or set_sparsity_enum.
+	The default value is unspecified.
+
+	\param optimize [in]
+	should the operation sequence corresponding to fun be optimized.
+	The default value is true.
+	*/
+	checkpoint(
+		const char*                    name            ,
+		const ADFun<Base>&             fun             ,
+		option_enum                    sparsity =
+				atomic_base<Base>::pack_sparsity_enum  ,
+		bool                           optimize = true
+	) :
+	atomic_base<Base>(name  , sparsity)        ,
+	f_( omp_get_max_threads() )                ,
+	jac_sparse_set_( omp_get_max_threads() )   ,
+	jac_sparse_bool_( omp_get_max_threads() )  ,
+	hes_sparse_set_( omp_get_max_threads() )   ,
+	hes_sparse_bool_( omp_get_max_threads() )
+	{	f_[0] = fun;
+		if( optimize )
+		{	f_[0].check_for_nan(false);
+			f_[0].optimize();
+		}
+		f_[0].compare_change_count(0);
+		//
+		// copy for use during multi-threading
+		for(int i = 1; i < omp_get_max_threads(); ++i)
+			f_[i] = f_[0];
+	}
+	// ------------------------------------------------------------------------
+	/*!
 	Implement the user call to <tt>atom_fun.size_var()</tt>.
 	*/
 	size_t size_var(void)
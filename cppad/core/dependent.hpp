@@ -228,7 +228,7 @@ The dependent variable vector for the function being stored in this object.
 
 \par
 All of the private member data in ad_fun.hpp is set to correspond to the
-new tape except for check_for_nan_.
+new tape except for check_for_nan_, internal_roaring_, and sparse_cache_.
 */
 
 template <typename Base>
@@ -296,6 +296,7 @@ void ADFun<Base>::Dependent(local::ADTape<Base> *tape, const ADvector &y)
 	// and there is a EndOp at the end of the tape, we can transfer the
 	// recording to the player and and erase the recording; i.e. ERASE Rec_.
 	play_.get_recording(tape->Rec_, n);
+	shared_play_ = CPPAD_NULL;
 
 	// ind_taddr_
 	// Note that play_ has been set, we can use it to check operators
@@ -306,9 +307,10 @@ void ADFun<Base>::Dependent(local::ADTape<Base> *tape, const ADvector &y)
 		ind_taddr_[j] = j+1;
 	}
 
-	// for_jac_sparse_pack_, for_jac_sparse_set_
+	// for_jac_sparse_pack_, for_jac_sparse_set_, for_jac_sparse_roaring_
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0,0);
+	for_jac_sparse_roaring_.resize(0,0);
 
 	// resize subgraph_info_
 	subgraph_info_.resize(
@@ -317,6 +319,9 @@ void ADFun<Base>::Dependent(local::ADTape<Base> *tape, const ADvector &y)
 		play_.num_op_rec(),  // n_op
 		play_.num_var_rec()  // n_var
 	);
+
+	// sparse_cache_info_
+	sparse_cache_info_.clear();
 	// ---------------------------------------------------------------------
 	// End set ad_fun.hpp private member data
 	// ---------------------------------------------------------------------
@@ -87,6 +87,9 @@ if and only if $latex s_i$$ is possibly non-zero.
 $head internal_bool$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+In the case where it is false and
+$cref/internal_roaring/internal_roaring/$$ is true for $icode f$$,
+the sets are stored using compressed bitmaps.
 
 $head pattern_out$$
 This argument has prototype
@@ -147,6 +150,8 @@ is a sparsity pattern for for s.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of standard sets is used.
+If it is false and internal_roaring_ is true,
+the sets are stored using compressed bitmaps.
 
 \param pattern_out
 The return value is a sparsity pattern for H(x) where
@@ -163,7 +168,8 @@ void ADFun<Base>::for_hes_sparsity(
 	const BoolVector&            select_range     ,
 	bool                         internal_bool    ,
 	sparse_rc<SizeVector>&       pattern_out      )
-{	size_t n  = Domain();
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t n  = Domain();
 	size_t m  = Range();
 	//
 	CPPAD_ASSERT_KNOWN(
@@ -181,7 +187,61 @@ void ADFun<Base>::for_hes_sparsity(
 	bool dependency = false;
 	//
 	sparse_rc<SizeVector> pattern_tmp;
-	if( internal_bool )
+	if( internal_roaring_ && ! internal_bool )
+	{	// forward Jacobian sparsity pattern for independent variables
+		// (corresponds to D)
+		local::sparse_roaring internal_for_jac;
+		internal_for_jac.resize(num_var_tape_, n + 1 );
+		for(size_t j = 0; j < n; j++) if( select_domain[j] )
+		{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < n + 1 );
+			// use add_element when only adding one element per set
+			internal_for_jac.add_element( ind_taddr_[j] , ind_taddr_[j] );
+		}
+		// forward Jacobian sparsity for all variables on tape
+		local::sweep::for_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			internal_for_jac
+		);
+		// reverse Jacobian sparsity pattern for select_range
+		// (corresponds to s)
+		local::sparse_roaring internal_rev_jac;
+		internal_rev_jac.resize(num_var_tape_, 1);
+		for(size_t i = 0; i < m; i++) if( select_range[i] )
+		{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_ );
+			// use add_element when only adding one element per set
+			internal_rev_jac.add_element( dep_taddr_[i] , 0 );
+		}
+		// reverse Jacobian sparsity for all variables on tape
+		local::sweep::rev_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			internal_rev_jac
+		);
+		// internal vector of sets that will hold Hessian
+		local::sparse_roaring internal_for_hes;
+		internal_for_hes.resize(n + 1, n + 1);
+		//
+		// compute forward Hessian sparsity pattern
+		local::sweep::for_hes<addr_t>(
+			&play_,
+			n,
+			num_var_tape_,
+			internal_for_jac,
+			internal_rev_jac,
+			internal_for_hes
+		);
+		//
+		// put the result in pattern_tmp
+		get_internal_sparsity(
+			transpose, ind_taddr_, internal_for_hes, pattern_tmp
+		);
+	}
+	else if( internal_bool )
 	{	// forward Jacobian sparsity pattern for independent variables
 		local::sparse_pack internal_for_jac;
 		internal_for_jac.resize(num_var_tape_, n + 1 );
@@ -271,6 +331,7 @@ void ADFun<Base>::for_hes_sparsity(
 		// internal vector of sets that will hold Hessian
 		local::sparse_list internal_for_hes;
 		internal_for_hes.resize(n + 1, n + 1);
+		internal_for_hes.auto_compact(true);
 		//
 		// compute forward Hessian sparsity pattern
 		local::sweep::for_hes<addr_t>(
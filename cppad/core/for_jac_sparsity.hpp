@@ -72,7 +72,8 @@ sets $icode k$$ to the amount of memory (in unsigned character units)
 used to store the
 $cref/boolean vector/glossary/Sparsity Pattern/Boolean Vector/$$
 sparsity patterns.
-If $icode internal_bool$$ if false, $icode k$$ will be zero.
+If $icode internal_bool$$ if false,
+$icode k$$ will be zero.
 Otherwise it will be non-zero.
 If you do not need this information for $cref RevSparseHes$$
 calculations, it can be deleted
@@ -91,7 +92,8 @@ sets $icode k$$ to the amount of memory (in unsigned character units)
 used to store the
 $cref/vector of sets/glossary/Sparsity Pattern/Vector of Sets/$$
 sparsity patterns.
-If $icode internal_bool$$ if true, $icode k$$ will be zero.
+If $icode internal_bool$$ if true,
+$icode k$$ will be zero.
 Otherwise it will be non-zero.
 If you do not need this information for future $cref rev_hes_sparsity$$
 calculations, it can be deleted
@@ -132,6 +134,9 @@ $codei%
 %$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+In the case where it is false and
+$cref/internal_roaring/internal_roaring/$$ is true for $icode f$$,
+the sets are stored using compressed bitmaps.
 
 $head pattern_out$$
 This argument has prototype
@@ -197,6 +202,8 @@ This is used by the optimizer to obtain the correct dependency relations.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Othewise, a vector of standard sets is used.
+If it is false and internal_roaring_ is true,
+the sets are stored using compressed bitmaps.
 
 \param pattern_out
 The value of transpose is false (true),
@@ -215,7 +222,8 @@ void ADFun<Base>::for_jac_sparsity(
 	bool                         dependency       ,
 	bool                         internal_bool    ,
 	sparse_rc<SizeVector>&       pattern_out      )
-{	// number or rows, columns, and non-zeros in pattern_in
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	// number or rows, columns, and non-zeros in pattern_in
 	size_t nr_in  = pattern_in.nr();
 	size_t nc_in  = pattern_in.nc();
 	//
@@ -231,11 +239,42 @@ void ADFun<Base>::for_jac_sparsity(
 	);
 	bool zero_empty  = true;
 	bool input_empty = true;
-	if( internal_bool )
+	if( internal_roaring_ && ! internal_bool )
+	{	// allocate memory for compressed bitmap sparsity calculation
+		// (sparsity pattern is emtpy after a resize)
+		for_jac_sparse_roaring_.resize(num_var_tape_, ell);
+		for_jac_sparse_pack_.resize(0, 0);
+		for_jac_sparse_set_.resize(0, 0);
+		//
+		// set sparsity patttern for independent variables
+		local::set_internal_sparsity(
+			zero_empty              ,
+			input_empty             ,
+			transpose               ,
+			ind_taddr_              ,
+			for_jac_sparse_roaring_ ,
+			pattern_in
+		);
+
+		// compute sparsity for other variables
+		local::sweep::for_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			for_jac_sparse_roaring_
+		);
+		// get the ouput pattern
+		local::get_internal_sparsity(
+			transpose, dep_taddr_, for_jac_sparse_roaring_, pattern_out
+		);
+	}
+	else if( internal_bool )
 	{	// allocate memory for bool sparsity calculation
 		// (sparsity pattern is emtpy after a resize)
 		for_jac_sparse_pack_.resize(num_var_tape_, ell);
 		for_jac_sparse_set_.resize(0, 0);
+		for_jac_sparse_roaring_.resize(0, 0);
 		//
 		// set sparsity patttern for independent variables
 		local::set_internal_sparsity(
@@ -266,6 +305,7 @@ void ADFun<Base>::for_jac_sparsity(
 		// (sparsity pattern is emtpy after a resize)
 		for_jac_sparse_set_.resize(num_var_tape_, ell);
 		for_jac_sparse_pack_.resize(0, 0);
+		for_jac_sparse_roaring_.resize(0, 0);
 		//
 		// set sparsity patttern for independent variables
 		local::set_internal_sparsity(
@@ -285,6 +325,8 @@ void ADFun<Base>::for_jac_sparsity(
 			num_var_tape_,
 			for_jac_sparse_set_
 		);
+		// this pattern is stored in f, so free its unused memory
+		for_jac_sparse_set_.compact();
 		// get the ouput pattern
 		local::get_internal_sparsity(
 			transpose, dep_taddr_, for_jac_sparse_set_, pattern_out
@@ -376,6 +376,7 @@ void ADFun<Base>::ForSparseHesCase(
 	// vector of sets that will hold reverse Hessain values
 	local::sparse_list for_hes_pattern;
 	for_hes_pattern.resize(n+1, n+1);
+	for_hes_pattern.auto_compact(true);
 	//
 	// compute the Hessian sparsity patterns
 	local::sweep::for_hes<addr_t>(
@@ -449,7 +450,8 @@ template <class VectorSet>
 VectorSet ADFun<Base>::ForSparseHes(
 	const VectorSet& r, const VectorSet& s
 )
-{	VectorSet h;
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	VectorSet h;
 	typedef typename VectorSet::value_type Set_type;
 
 	// Should check to make sure q is same as in previous call to
@@ -521,6 +523,7 @@ void ADFun<Base>::ForSparseHesCheckpoint(
 	// holds forward Hessian sparsity pattern for all variables
 	local::sparse_list for_hes_pattern;
 	for_hes_pattern.resize(n+1, n+1);
+	for_hes_pattern.auto_compact(true);
 
 	// compute Hessian sparsity pattern for all variables
 	local::sweep::for_hes<addr_t>(
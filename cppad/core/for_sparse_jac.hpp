@@ -459,6 +459,8 @@ void ADFun<Base>::ForSparseJacCase(
 		num_var_tape_,
 		for_jac_sparse_set_
 	);
+	// this pattern is stored in f, so free its unused memory
+	for_jac_sparse_set_.compact();
 
 	// return values corresponding to dependent variables
 	CPPAD_ASSERT_UNKNOWN( size_t(s.size()) == m || transpose );
@@ -562,12 +564,14 @@ VectorSet ADFun<Base>::ForSparseJac(
 	const VectorSet&   r             ,
 	bool               transpose     ,
 	bool               dependency    )
-{	VectorSet s;
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	VectorSet s;
 	typedef typename VectorSet::value_type Set_type;
 
 	// free all memory currently in sparsity patterns
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0, 0);
+	for_jac_sparse_roaring_.resize(0, 0);
 
 	ForSparseJacCase(
 		Set_type()  ,
@@ -671,6 +675,7 @@ void ADFun<Base>::ForSparseJacCheckpoint(
 	// free all memory currently in sparsity patterns
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0, 0);
+	for_jac_sparse_roaring_.resize(0, 0);
 
 	// allocate new sparsity pattern
 	for_jac_sparse_set_.resize(num_var_tape_, q);
@@ -708,6 +713,8 @@ void ADFun<Base>::ForSparseJacCheckpoint(
 		num_var_tape_,
 		for_jac_sparse_set_
 	);
+	// this pattern is stored in f, so free its unused memory
+	for_jac_sparse_set_.compact();
 
 	// dimension the return value
 	if( transpose )
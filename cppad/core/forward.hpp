@@ -14,6 +14,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 
 // documened after Forward but included here so easy to see
 # include <cppad/core/capacity_order.hpp>
+# include <cppad/core/fun_arena.hpp>
 # include <cppad/core/num_skip.hpp>
 # include <cppad/core/check_for_nan.hpp>
 
@@ -79,7 +80,8 @@ VectorBase ADFun<Base>::Forward(
 	size_t              q         ,
 	const VectorBase&   xq        ,
 	      std::ostream& s         )
-{	// temporary indices
+{	thread_alloc::tag_scope scope(thread_alloc::taylor_tag);
+	// temporary indices
 	size_t i, j, k;
 
 	// number of independent variables
@@ -141,7 +143,9 @@ VectorBase ADFun<Base>::Forward(
 	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
 
 		// ind_taddr_[j] is operator taddr for j-th independent variable
-		CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+		CPPAD_ASSERT_UNKNOWN(
+			play_ptr()->GetOp( ind_taddr_[j] ) == local::InvOp
+		);
 
 		if( p == q )
 			taylor_[ C * ind_taddr_[j] + q] = xq[j];
@@ -152,10 +156,10 @@ VectorBase ADFun<Base>::Forward(
 	}
 
 	// evaluate the derivatives
-	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
-	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_ptr()->num_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_ptr()->num_load_op_rec() );
 	if( q == 0 )
-	{	local::sweep::forward0(&play_, s, true,
+	{	local::sweep::forward0(play_ptr(), s, true,
 			n, num_var_tape_, C,
 			taylor_.data(), cskip_op_.data(), load_op_,
 			compare_change_count_,
@@ -164,12 +168,14 @@ VectorBase ADFun<Base>::Forward(
 		);
 	}
 	else
-	{	local::sweep::forward1(&play_, s, true, p, q,
+	{	local::play::const_sequential_iterator play_itr = play_ptr()->begin();
+		local::sweep::forward1(play_ptr(), s, true, p, q,
 			n, num_var_tape_, C,
 			taylor_.data(), cskip_op_.data(), load_op_,
 			compare_change_count_,
 			compare_change_number_,
-			compare_change_op_index_
+			compare_change_op_index_,
+			play_itr
 		);
 	}
 
@@ -325,7 +331,8 @@ VectorBase ADFun<Base>::Forward(
 	size_t              q         ,
 	size_t              r         ,
 	const VectorBase&   xq        )
-{	// temporary indices
+{	thread_alloc::tag_scope scope(thread_alloc::taylor_tag);
+	// temporary indices
 	size_t i, j, ell;
 
 	// number of independent variables
@@ -372,7 +379,9 @@ VectorBase ADFun<Base>::Forward(
 	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
 
 		// ind_taddr_[j] is operator taddr for j-th independent variable
-		CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+		CPPAD_ASSERT_UNKNOWN(
+			play_ptr()->GetOp( ind_taddr_[j] ) == local::InvOp
+		);
 
 		for(ell = 0; ell < r; ell++)
 		{	size_t index = ((c-1)*r + 1)*ind_taddr_[j] + (q-1)*r + ell + 1;
@@ -381,10 +390,10 @@ VectorBase ADFun<Base>::Forward(
 	}
 
 	// evaluate the derivatives
-	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
-	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_ptr()->num_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_ptr()->num_load_op_rec() );
 	local::sweep::forward2(
-		&play_,
+		play_ptr(),
 		q,
 		r,
 		n,
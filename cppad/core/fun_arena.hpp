@@ -0,0 +1,125 @@
+# ifndef CPPAD_CORE_FUN_ARENA_HPP
+# define CPPAD_CORE_FUN_ARENA_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin fun_arena$$
+$spell
+	const
+	Jacobian
+	Taylor
+	alloc
+$$
+
+$section Use a Memory Arena for the Work Memory of an ADFun Object$$
+
+$head Syntax$$
+$icode%f%.set_arena(%arena%)%$$
+
+$head Purpose$$
+Use a $cref/memory arena/ta_arena/$$ for the memory that $icode f$$
+uses during evaluation requests; i.e.,
+its Taylor coefficients (see $cref Forward$$),
+the partial derivatives used by $cref Reverse$$ mode,
+and its forward Jacobian sparsity patterns
+(see $cref/size_forward_bool/ForSparseJac/f/size_forward_bool/$$ and
+$cref/size_forward_set/ForSparseJac/f/size_forward_set/$$).
+The other memory used by CppAD, including the memory for the
+operation sequence in $icode f$$, is not affected.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+
+$head arena$$
+This argument has prototype
+$codei%
+	CppAD::thread_alloc_arena* %arena%
+%$$
+If it is null, the $cref thread_alloc$$ pools are used
+(this is the initial setting).
+The arena is not copied when $icode f$$ is
+$cref/assigned/FunConstruct/Assignment Operator/$$.
+
+$head Freeing Memory$$
+If $icode arena$$ is different from the previous setting,
+the Taylor coefficients and forward Jacobian sparsity patterns
+stored in $icode f$$ are freed; i.e.,
+$codei%
+	%f%.capacity_order(0)
+%$$
+is called.
+Hence, after
+$codei%
+	%f%.set_arena(CPPAD_NULL)
+%$$
+$icode f$$ does not contain any memory from the previous arena,
+and it can be reset.
+
+$head Vectors$$
+The arena is only used for memory that is stored in $icode f$$.
+The vectors that are returned by evaluation requests
+(for example $icode y$$ in $icode%y% = %f%.Forward(%q%, %x%)%$$)
+are not in the arena, even if they are $cref CppAD_vector$$ objects;
+i.e., $code CppAD::vector$$ always uses the $cref thread_alloc$$ pools.
+
+$head Example$$
+The file $cref thread_alloc_arena.cpp$$ is an example and test
+that uses a bump allocator for an $code ADFun$$ object.
+
+$end
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file fun_arena.hpp
+Use a memory arena for the work memory of an ADFun object.
+*/
+
+/*!
+Use a memory arena for the Taylor coefficients, partial derivatives,
+and forward Jacobian sparsity patterns of this function.
+
+\tparam Base
+is the base type for this function.
+
+\param arena
+is the arena (null for the thread_alloc pools).
+If it is not the same as the previous setting, the memory for the
+Taylor coefficients and forward Jacobian sparsity patterns is freed.
+*/
+template <typename Base>
+void ADFun<Base>::set_arena(thread_alloc_arena* arena)
+{	if( arena == taylor_.arena() )
+		return;
+	//
+	// free memory that may be in the previous arena
+	capacity_order(0);
+	for_jac_sparse_pack_.resize(0, 0);
+	for_jac_sparse_set_.resize(0, 0);
+	for_jac_sparse_roaring_.resize(0, 0);
+	subgraph_partial_.clear();
+	//
+	// future allocations
+	taylor_.set_arena(arena);
+	for_jac_sparse_pack_.set_arena(arena);
+	for_jac_sparse_set_.set_arena(arena);
+	for_jac_sparse_roaring_.set_arena(arena);
+	subgraph_partial_.set_arena(arena);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
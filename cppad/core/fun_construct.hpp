@@ -245,10 +245,13 @@ template <typename Base>
 ADFun<Base>::ADFun(void) :
 has_been_optimized_(false),
 check_for_nan_(true) ,
+internal_roaring_(false) ,
+sparse_cache_(false) ,
 compare_change_count_(1),
 compare_change_number_(0),
 compare_change_op_index_(0),
-num_var_tape_(0)
+num_var_tape_(0),
+shared_play_(CPPAD_NULL)
 { }
 
 /*!
@@ -281,6 +284,8 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 	// size_t objects
 	has_been_optimized_        = f.has_been_optimized_;
 	check_for_nan_             = f.check_for_nan_;
+	internal_roaring_          = f.internal_roaring_;
+	sparse_cache_              = f.sparse_cache_;
 	compare_change_count_      = f.compare_change_count_;
 	compare_change_number_     = f.compare_change_number_;
 	compare_change_op_index_   = f.compare_change_op_index_;
@@ -303,11 +308,16 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 	load_op_                   = f.load_op_;
 	//
 	// player
-	play_                      = f.play_;
+	// (a copy of a shared operation sequence does not share it)
+	play_                      = *f.play_ptr();
+	shared_play_               = CPPAD_NULL;
 	//
 	// subgraph
 	subgraph_info_             = f.subgraph_info_;
 	//
+	// sparsity patterns and colorings (same operation sequence)
+	sparse_cache_info_         = f.sparse_cache_info_;
+	//
 	// sparse_pack
 	for_jac_sparse_pack_.resize(0, 0);
 	size_t n_set = f.for_jac_sparse_pack_.n_set();
@@ -341,6 +351,84 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 			);
 		}
 	}
+	//
+	// sparse_roaring
+	for_jac_sparse_roaring_.resize(0, 0);
+	n_set = f.for_jac_sparse_roaring_.n_set();
+	end   = f.for_jac_sparse_roaring_.end();
+	if( n_set > 0 )
+	{	CPPAD_ASSERT_UNKNOWN( n_set == num_var_tape_  );
+		CPPAD_ASSERT_UNKNOWN( f.for_jac_sparse_pack_.n_set() == 0 );
+		CPPAD_ASSERT_UNKNOWN( f.for_jac_sparse_set_.n_set() == 0 );
+		for_jac_sparse_roaring_.resize(n_set, end);
+		for(i = 0; i < num_var_tape_; i++)
+		{	for_jac_sparse_roaring_.assignment(
+				i                       ,
+				i                       ,
+				f.for_jac_sparse_roaring_
+			);
+		}
+	}
+}
+
+/*!
+Share the operation sequence in another ADFun object
+
+After this call, Forward, Reverse, and capacity_order for this object
+use the operation sequence stored in \c f (which is not copied).
+Only the Taylor coefficients, and other information that changes during
+these calculations, are stored in this object.
+This enables multiple threads to evaluate the same operation sequence
+at the same time (each using a different ADFun object).
+This object must not contain an operation sequence; i.e.,
+it was created using the default constructor.
+
+\tparam Base
+is the base for the recording that can be stored in this ADFun object.
+
+\param f
+ADFun object containing the operation sequence to be shared.
+It must not be changed (e.g. optimized) or deleted for as long as
+this object is used.
+*/
+template <typename Base>
+void ADFun<Base>::share_recording(const ADFun<Base>& f)
+{	CPPAD_ASSERT_UNKNOWN( f.shared_play_ == CPPAD_NULL );
+	CPPAD_ASSERT_UNKNOWN( play_.num_op_rec() == 0 );
+	//
+	// size_t objects
+	has_been_optimized_        = f.has_been_optimized_;
+	check_for_nan_             = f.check_for_nan_;
+	internal_roaring_          = f.internal_roaring_;
+	sparse_cache_              = false;
+	compare_change_count_      = f.compare_change_count_;
+	compare_change_number_     = 0;
+	compare_change_op_index_   = 0;
+	num_order_taylor_          = 0;
+	cap_order_taylor_          = 0;
+	num_direction_taylor_      = 0;
+	num_var_tape_              = f.num_var_tape_;
+	//
+	// CppAD::vector objects
+	ind_taddr_.resize( f.ind_taddr_.size() );
+	ind_taddr_                 = f.ind_taddr_;
+	dep_taddr_.resize( f.dep_taddr_.size() );
+	dep_taddr_                 = f.dep_taddr_;
+	dep_parameter_.resize( f.dep_parameter_.size() );
+	dep_parameter_             = f.dep_parameter_;
+	//
+	// pod_vector objects
+	taylor_.clear();
+	cskip_op_                  = f.cskip_op_;
+	load_op_                   = f.load_op_;
+	//
+	// player
+	shared_play_               = &f.play_;
+	//
+	// sparsity patterns
+	for_jac_sparse_pack_.resize(0, 0);
+	for_jac_sparse_set_.resize(0, 0);
+	for_jac_sparse_roaring_.resize(0, 0);
 }
 
 /*!
@@ -422,6 +510,8 @@ ADFun<Base>::ADFun(const VectorAD &x, const VectorAD &y)
 
 	// ad_fun.hpp member values not set by dependent
 	check_for_nan_       = true;
+	internal_roaring_    = false;
+	sparse_cache_        = false;
 
 	// allocate memory for one zero order taylor_ coefficient
 	CPPAD_ASSERT_UNKNOWN( num_order_taylor_ == 0 );
@@ -0,0 +1,131 @@
+# ifndef CPPAD_CORE_INTERNAL_ROARING_HPP
+# define CPPAD_CORE_INTERNAL_ROARING_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin internal_roaring$$
+$spell
+	const
+	bool
+	Jacobian
+	jac
+	hes
+$$
+$section Use Compressed Bitmaps for Internal Sparsity Patterns$$
+
+$head Syntax$$
+$icode%f%.internal_roaring(%b%)
+%$$
+$icode%b% = %f%.internal_roaring()
+%$$
+
+$head Purpose$$
+The $cref/preferred/sparsity_pattern/Preferred Sparsity Patterns/$$
+sparsity routines have an $icode internal_bool$$ argument that chooses
+between a vector of boolean values and a vector of sets of integers
+for the sparsity patterns of the variables in the operation sequence.
+A vector of boolean values is fast when the patterns are dense
+and a vector of sets is small when they are sparse.
+Neither is a good choice when the patterns are dense for some variables,
+or for some ranges of the elements, and sparse for others.
+This option selects a different representation for the vector of sets
+(the case where $icode internal_bool$$ is false).
+Each set is split into
+chunks of $latex 2^{16}$$ possible elements and the elements in each chunk
+are stored as the smallest of a sorted array, a bitmap, or a sorted list
+of runs of consecutive elements.
+The representation is chosen chunk by chunk
+as the sparsity calculation proceeds.
+
+$head f$$
+For the syntax where $icode b$$ is an argument,
+$icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+(see $codei%ADFun<%Base%>%$$ $cref/constructor/FunConstruct/$$).
+For the syntax where $icode b$$ is the result,
+$icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+
+$head b$$
+This argument or result has prototype
+$codei%
+	bool %b%
+%$$
+If it is true (false),
+future calls to
+$cref for_jac_sparsity$$,
+$cref rev_jac_sparsity$$,
+$cref for_hes_sparsity$$, and
+$cref rev_hes_sparsity$$
+will (will not) use compressed bitmaps for the internal sparsity patterns
+when $icode internal_bool$$ is false in these calls.
+If $icode internal_bool$$ is true, a vector of boolean values is used
+for the internal sparsity patterns no matter what the value of $icode b$$.
+
+$head Default$$
+The value for this setting after construction of $icode f$$ is false.
+The value of this setting is not affected by calling
+$cref Dependent$$ for this function object.
+
+$head size_forward_set$$
+If $icode b$$ is true and $icode internal_bool$$ is false
+when $cref for_jac_sparsity$$ is called,
+the memory used to store the sparsity patterns for
+the variables in the operation sequence is included in
+$cref/size_forward_set/for_jac_sparsity/f/size_forward_set/$$.
+
+$head rev_hes_sparsity$$
+If $icode internal_bool$$ is false when $cref rev_hes_sparsity$$ is called,
+the value of $icode b$$ must be the same as its value during the previous call
+to $cref for_jac_sparsity$$.
+
+$head Example$$
+$children%
+	example/sparse/internal_roaring.cpp
+%$$
+The file
+$cref internal_roaring.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+/*!
+Set internal_roaring
+
+\param value
+new value for this flag.
+*/
+template <class Base>
+void ADFun<Base>::internal_roaring(bool value)
+{	internal_roaring_ = value; }
+
+/*!
+Get internal_roaring
+
+\return
+current value of internal_roaring_.
+*/
+template <class Base>
+bool ADFun<Base>::internal_roaring(void) const
+{	return internal_roaring_; }
+
+} // END_CPPAD_NAMESPACE
+
+# endif
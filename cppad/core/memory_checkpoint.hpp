@@ -0,0 +1,262 @@
+# ifndef CPPAD_CORE_MEMORY_CHECKPOINT_HPP
+# define CPPAD_CORE_MEMORY_CHECKPOINT_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin memory_checkpoint$$
+$spell
+	const
+	op
+	VecAD
+	Taylor
+$$
+
+$section Split an Operation Sequence into Checkpoint Functions$$
+
+$head Syntax$$
+$codei%memory_checkpoint<%Base%> %body%(%f%, %max_var%)
+%$$
+$icode%n_body% = %body%.size()
+%$$
+$icode%peak_var% = %body%.peak_var()
+%$$
+$icode%ok% = %body%.ok()%$$
+
+$head Purpose$$
+During reverse mode, the Taylor coefficients for all the variables
+in the operation sequence for $icode f$$ are stored at the same time.
+This routine splits the operation sequence into consecutive segments
+and replaces each segment by a call to a $cref checkpoint$$ function.
+The Taylor coefficients for a checkpoint function are recomputed,
+and only stored, while reverse mode is computing its derivative.
+This reduces the maximum number of variables that have
+Taylor coefficients stored at the same time.
+On the other hand, forward mode values are computed twice for the
+variables in a checkpoint function.
+
+$head Segments$$
+The segments only contain operations that use
+the arithmetic operators and standard math functions,
+with variables or constants for arguments (see
+$cref/segments/reroll/Segments/$$ for $code reroll$$),
+and the cumulative summations created by $cref optimize$$.
+The segments are chosen as large as possible
+(to reduce the number of checkpoint function calls)
+subject to $icode peak_var$$ being less than or equal $icode max_var$$.
+The operations between two operations that cannot be in a segment
+are split into segments of about the same size.
+A segment is not replaced unless the checkpoint function call
+has fewer operations than the segment; i.e.,
+two plus the number of arguments plus the number of results
+for the checkpoint function is less than the number of operations
+in the segment.
+If this does not satisfy the bound $icode max_var$$,
+segments with at least four variables are used
+when they satisfy the bound.
+
+$head f$$
+This argument has prototype
+$codei%
+	ADFun<%Base%>& %f%
+%$$
+Upon return, its segments have been replaced and it computes
+the same function, and derivatives, as on input.
+The Taylor coefficients, and sparsity patterns,
+stored in $icode f$$ are lost.
+The conditional skip operations (see
+$cref/conditional_skip/optimize/options/no_conditional_skip/$$)
+are removed.
+If the number of variables in $icode f$$ is less than or equal
+$icode max_var$$, $icode f$$ is not changed.
+
+$head max_var$$
+This argument has prototype
+$codei%
+	size_t %max_var%
+%$$
+It is the maximum number of variables that should have
+Taylor coefficients stored at the same time during reverse mode.
+For example, the memory used by the Taylor coefficients for
+$codei%
+	%f%.Reverse(%q%, %w%)
+%$$
+is about $icode%max_var% * %q% * sizeof(%Base%)%$$.
+
+$head body$$
+This object holds the checkpoint functions used by $icode f$$.
+It must not be destructed for as long as $icode f$$, or any copy of
+$icode f$$, is used.
+The checkpoint functions are derived from $cref atomic_base$$ and hence
+$icode body$$ cannot be constructed in
+$cref/parallel/ta_in_parallel/$$ mode.
+
+$head size$$
+The return value $icode n_body$$ has prototype
+$codei%
+	size_t %n_body%
+%$$
+It is the number of checkpoint functions; i.e., the number of segments.
+Each segment is a separate checkpoint function and is called once by
+$icode f$$.
+
+$head peak_var$$
+The return value $icode peak_var$$ has prototype
+$codei%
+	size_t %peak_var%
+%$$
+It is the number of variables in $icode f$$ plus the maximum,
+with respect to the checkpoint functions,
+of the number of variables in the checkpoint function.
+This is the maximum number of variables that have
+Taylor coefficients stored at the same time during reverse mode.
+If it is not possible for this to be less than or equal $icode max_var$$,
+the segments (that have more operations than the checkpoint function
+calls) are chosen to make it as small as possible
+(see $cref/ok/memory_checkpoint/ok/$$ below).
+
+$head ok$$
+The return value $icode ok$$ has prototype
+$codei%
+	bool %ok%
+%$$
+It is true if $icode peak_var$$ is less than or equal $icode max_var$$
+and false otherwise.
+The bound may not be possible because
+operations that cannot be in a segment are not replaced,
+and results of a segment that are used after the segment
+are variables in $icode f$$.
+
+$children%
+	example/general/memory_checkpoint.cpp
+%$$
+$head Example$$
+The file $cref memory_checkpoint.cpp$$ contains an example and test of
+this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cppad/local/optimize/split_find.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file memory_checkpoint.hpp
+Split an operation sequence into checkpoint functions to reduce the memory
+used during reverse mode.
+*/
+
+/*!
+Checkpoint functions that replace segments of an operation sequence.
+
+\tparam Base
+base type for the operation sequence.
+*/
+template <class Base>
+class memory_checkpoint {
+private:
+	/// checkpoint functions for each segment
+	reroll<Base> body_;
+	//
+	/// number of variables in the function plus maximum number of
+	/// variables in the checkpoint functions
+	size_t peak_var_;
+	//
+	/// maximum number of variables that should have Taylor coefficients
+	/// stored at the same time during reverse mode
+	size_t max_var_;
+	//
+	// copying is not allowed
+	memory_checkpoint(const memory_checkpoint& other);
+	memory_checkpoint& operator=(const memory_checkpoint& other);
+	// ------------------------------------------------------------------------
+	/*!
+	Replace segments in a function object by checkpoint functions.
+
+	\tparam Addr
+	type used for random iterators for the operation sequence in f.
+
+	\param f
+	is the function object.
+
+	\param max_var
+	is the maximum number of variables that should have
+	Taylor coefficients stored at the same time during reverse mode.
+	*/
+	template <class Addr>
+	void compute(ADFun<Base>& f, size_t max_var)
+	{	local::player<Base>* play = &f.play_;
+		play->template setup_random<Addr>();
+		local::play::const_random_iterator<Addr> random_itr =
+			play->template get_random<Addr>();
+		//
+		// segments
+		vector<local::optimize::reroll_group> group;
+		local::pod_vector<bool>               is_output;
+		local::optimize::split_find(
+			max_var, f.dep_taddr_, play, random_itr, group, is_output
+		);
+		if( group.size() > 0 ) body_.replace(
+			"memory_checkpoint", f, random_itr, group, is_output
+		);
+		//
+		peak_var_ = f.size_var();
+		size_t max_inner = 0;
+		for(size_t i = 0; i < body_.body_.size(); ++i)
+			max_inner = std::max(max_inner, body_.body_[i]->size_var() );
+		peak_var_ += max_inner;
+	}
+public:
+	/*!
+	Split an operation sequence into checkpoint functions.
+
+	\param f
+	is the function object. Upon return, its segments have
+	been replaced by calls to checkpoint functions owned by this object.
+
+	\param max_var
+	is the maximum number of variables that should have
+	Taylor coefficients stored at the same time during reverse mode.
+	*/
+	memory_checkpoint(ADFun<Base>& f, size_t max_var)
+	: peak_var_(0), max_var_(max_var)
+	{	switch( f.play_.address_type() )
+		{
+			case local::play::unsigned_short_enum:
+			compute<unsigned short>(f, max_var);
+			break;
+
+			case local::play::unsigned_int_enum:
+			compute<unsigned int>(f, max_var);
+			break;
+
+			case local::play::size_t_enum:
+			compute<size_t>(f, max_var);
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+	}
+	/// number of checkpoint functions
+	size_t size(void) const
+	{	return body_.size(); }
+	/// number of variables in the function plus maximum number of
+	/// variables in the checkpoint functions
+	size_t peak_var(void) const
+	{	return peak_var_; }
+	/// is peak_var less than or equal the bound max_var
+	bool ok(void) const
+	{	return peak_var_ <= max_var_; }
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,382 @@
+# ifndef CPPAD_CORE_MULTI_START_NEWTON_HPP
+# define CPPAD_CORE_MULTI_START_NEWTON_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin multi_start_newton$$
+$spell
+	const
+	xlow
+	xup
+	xout
+	itr
+	num
+	CppAD
+	Jacobian
+$$
+
+$section Multi-Start Newton's Method Using a Team of Threads$$
+
+$head Syntax$$
+$codei%# include <cppad/cppad.hpp>
+%$$
+$icode%num_root% = multi_start_newton(
+	%xout%, %f%, %num_sub%, %xlow%, %xup%, %epsilon%, %max_itr%, %num_threads%
+)%$$
+
+$head Purpose$$
+Finds the zeros of a function
+$latex f : \B{R}^n \rightarrow \B{R}^n$$ in a box
+$latex [ xlow , xup ] \subset \B{R}^n$$.
+The box is split into a grid of sub-boxes
+and Newton's method is started at the center of each sub-box.
+The iterates for a start are kept in its sub-box,
+so at most one zero is found for each sub-box.
+This is a library version of the $cref multi_newton.cpp$$ example.
+
+$head Load Balancing$$
+Each thread uses its own copy of $icode f$$.
+The starting points are distributed between the threads using
+the $cref/work stealing/thread_team/parallel_for/Work Stealing/$$
+of a $cref thread_team$$,
+so threads do not stay idle when Newton's method converges faster
+in some sub-boxes than others.
+
+$head C++11$$
+This routine is only defined when
+$code CPPAD_USE_CPLUSPLUS_2011$$ is true.
+It creates a $cref thread_team$$ and hence can only be called
+in sequential execution mode when there is no other $code thread_team$$.
+
+$head f$$
+This argument has prototype
+$codei%
+	const ADFun<%Base%>& %f%
+%$$
+Its domain and range dimensions must be equal; i.e.,
+$icode%n% = %f%.Domain() == %f%.Range()%$$.
+
+$head num_sub$$
+This argument has prototype
+$codei%
+	const %VectorSize%& %num_sub%
+%$$
+and size $icode n$$
+(where $icode VectorSize$$ is a $cref SimpleVector$$ with
+elements of type $code size_t$$).
+For $icode%j% = 0 , %...% , %n%-1%$$,
+the interval $codei%[ %xlow%[%j%] , %xup%[%j%] ]%$$
+is split into $icode%num_sub%[%j%] > 0%$$ sub-intervals of equal length.
+The number of starting points is the product of the elements of
+$icode num_sub$$.
+
+$head xlow$$
+This argument has prototype
+$codei%
+	const %VectorBase%& %xlow%
+%$$
+and size $icode n$$
+(where $icode VectorBase$$ is a $cref SimpleVector$$ with
+elements of type $icode Base$$).
+It is the lower limit for the box.
+
+$head xup$$
+This argument has prototype
+$codei%
+	const %VectorBase%& %xup%
+%$$
+and size $icode n$$.
+It is the upper limit for the box and
+$icode%xlow%[%j%] < %xup%[%j%]%$$ for all $icode j$$.
+
+$head epsilon$$
+This argument has prototype
+$codei%
+	const %Base%& %epsilon%
+%$$
+A point $icode x$$ is a zero if the absolute value of
+every component of $latex f(x)$$ is less than or equal $icode epsilon$$.
+
+$head max_itr$$
+This argument has prototype
+$codei%
+	size_t %max_itr%
+%$$
+and is the maximum number of Newton iterations for each starting point.
+
+$head num_threads$$
+This argument has prototype
+$codei%
+	size_t %num_threads%
+%$$
+and is the number of threads (including the current thread)
+used for the calculation.
+
+$head xout$$
+This argument has prototype
+$codei%
+	%VectorBase%& %xout%
+%$$
+Its input value does not matter.
+Upon return it has size $icode%num_root% * %n%$$ and for
+$icode%k% = 0 , %...% , %num_root%-1%$$,
+$codei%
+	%xout%[ %k% * %n% + %j% ] , %j% = 0 , %...% , %n%-1
+%$$
+is a zero of $icode f$$.
+Zeros that are found in neighboring sub-boxes, and are closer than
+the size of a sub-box in every component, are considered to be the same
+(the one with the smaller value of $latex | f(x) |$$ is returned).
+
+$head num_root$$
+The return value has prototype
+$codei%
+	size_t %num_root%
+%$$
+and is the number of zeros in $icode xout$$.
+
+$head Method$$
+Newton's method uses the Jacobian computed by
+$icode n$$ first order $cref/forward/forward_one/$$ sweeps and
+$cref LuSolve$$ to solve for the step.
+The iterations for a starting point stop if the Jacobian is singular,
+if the maximum number of iterations is reached,
+or if the iterate is on the boundary of the sub-box and the
+Newton step does not change it.
+
+$children%
+	example/general/multi_start_newton.cpp
+%$$
+$head Example$$
+The file $cref multi_start_newton.cpp$$ contains an example and test
+of this routine.
+
+$end
+*/
+# include <cppad/utility/thread_team.hpp>
+# include <cppad/utility/lu_solve.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <vector>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file multi_start_newton.hpp
+Multi-start Newton's method using a team of threads.
+*/
+
+/*!
+Find the zeros of a function in a box starting Newton's method at the
+center of each sub-box.
+
+\tparam Base
+is the base type for the recording in f.
+
+\tparam VectorBase
+is a simple vector class with elements of type Base.
+
+\tparam VectorSize
+is a simple vector class with elements of type size_t.
+
+\param xout [out]
+is the vector of zeros (size num_root * n).
+
+\param f [in]
+is the function we are finding the zeros of (n = f.Domain() = f.Range()).
+
+\param num_sub [in]
+is the number of sub-intervals for each component of x.
+
+\param xlow [in]
+is the lower limit for the box.
+
+\param xup [in]
+is the upper limit for the box.
+
+\param epsilon [in]
+is the convergence criteria for the absolute value of f(x).
+
+\param max_itr [in]
+is the maximum number of Newton iterations for each starting point.
+
+\param num_threads [in]
+is the number of threads used for the calculation.
+
+\return
+is the number of zeros num_root.
+*/
+template <class Base, class VectorBase, class VectorSize>
+size_t multi_start_newton(
+	VectorBase&         xout        ,
+	const ADFun<Base>&  f           ,
+	const VectorSize&   num_sub     ,
+	const VectorBase&   xlow        ,
+	const VectorBase&   xup         ,
+	const Base&         epsilon     ,
+	size_t              max_itr     ,
+	size_t              num_threads )
+{	size_t n = f.Domain();
+	CPPAD_ASSERT_KNOWN(
+		n > 0 && f.Range() == n,
+		"multi_start_newton: f.Domain() is zero or not equal f.Range()"
+	);
+	CPPAD_ASSERT_KNOWN(
+		num_sub.size() == n && xlow.size() == n && xup.size() == n,
+		"multi_start_newton: size of num_sub, xlow, or xup is not f.Domain()"
+	);
+	// length of the sub-intervals and total number of starting points
+	VectorBase sub_length(n);
+	size_t num_start = 1;
+	for(size_t j = 0; j < n; ++j)
+	{	CPPAD_ASSERT_KNOWN(
+			num_sub[j] > 0 && xlow[j] < xup[j],
+			"multi_start_newton: num_sub[j] is zero or xlow[j] >= xup[j]"
+		);
+		sub_length[j] = (xup[j] - xlow[j]) / Base( double(num_sub[j]) );
+		num_start    *= num_sub[j];
+	}
+	//
+	// result for each starting point (written by the thread that did it)
+	VectorBase        x_all(num_start * n), f_all(num_start);
+	std::vector<char> found(num_start, 0);
+	//
+	// pointers used by the threads
+	char*              found_ptr      = found.data();
+	const ADFun<Base>* f_ptr          = &f;
+	const VectorSize*  num_sub_ptr    = &num_sub;
+	const VectorBase*  xlow_ptr       = &xlow;
+	const VectorBase*  sub_length_ptr = &sub_length;
+	VectorBase*        x_all_ptr      = &x_all;
+	VectorBase*        f_all_ptr      = &f_all;
+	//
+	{	thread_team team(num_threads);
+		parallel_ad<Base>();
+		//
+		// initialize static variables used by LuSolve (and Forward)
+		{	VectorBase a(1), b(1), c(1);
+			a[0] = Base(1.0);
+			b[0] = Base(1.0);
+			Base logdet;
+			LuSolve(1, 1, a, b, c, logdet);
+		}
+		//
+		// copy of f for each thread (made by the thread that uses it and
+		// deleted before the team so its memory is freed by the team)
+		std::vector< ADFun<Base> > g(num_threads);
+		std::vector<char>          copied(num_threads, 0);
+		ADFun<Base>*               g_ptr      = g.data();
+		char*                      copied_ptr = copied.data();
+		//
+		team.parallel_for(num_start, [=](size_t k)
+		{	size_t thread = thread_alloc::thread_num();
+			if( ! copied_ptr[thread] )
+			{	g_ptr[thread]      = *f_ptr;
+				copied_ptr[thread] = 1;
+			}
+			ADFun<Base>& fun = g_ptr[thread];
+			//
+			// limits for this sub-box and the starting point
+			VectorBase low(n), up(n), x(n), dx(n), y(n), dy(n), jac(n * n);
+			size_t index = k;
+			for(size_t j = 0; j < n; ++j)
+			{	size_t i = index % (*num_sub_ptr)[j];
+				index    = index / (*num_sub_ptr)[j];
+				Base len = (*sub_length_ptr)[j];
+				low[j]   = (*xlow_ptr)[j] + Base( double(i) ) * len;
+				up[j]    = low[j] + len;
+				x[j]     = low[j] + len / Base(2.0);
+			}
+			//
+			// Newton iterations
+			Base fmax = Base(0.0);
+			for(size_t itr = 0; itr <= max_itr; ++itr)
+			{	y    = fun.Forward(0, x);
+				fmax = Base(0.0);
+				for(size_t i = 0; i < n; ++i)
+				{	if( fmax < abs( y[i] ) )
+						fmax = abs( y[i] );
+				}
+				if( fmax <= epsilon || itr == max_itr )
+					break;
+				//
+				// Jacobian using n first order forward sweeps
+				for(size_t j = 0; j < n; ++j)
+					dx[j] = Base(0.0);
+				for(size_t j = 0; j < n; ++j)
+				{	dx[j] = Base(1.0);
+					dy    = fun.Forward(1, dx);
+					dx[j] = Base(0.0);
+					for(size_t i = 0; i < n; ++i)
+						jac[i * n + j] = dy[i];
+				}
+				//
+				// Newton step
+				for(size_t i = 0; i < n; ++i)
+					y[i] = - y[i];
+				Base logdet;
+				int signdet = LuSolve(n, 1, jac, y, dx, logdet);
+				if( signdet == 0 )
+					break;
+				//
+				// next iterate (kept in this sub-box)
+				bool change = false;
+				for(size_t j = 0; j < n; ++j)
+				{	Base xj = x[j] + dx[j];
+					if( xj < low[j] )
+						xj = low[j];
+					if( up[j] < xj )
+						xj = up[j];
+					change |= xj != x[j];
+					x[j]    = xj;
+				}
+				if( ! change )
+					break;
+			}
+			if( fmax <= epsilon )
+			{	found_ptr[k] = 1;
+				(*f_all_ptr)[k] = fmax;
+				for(size_t j = 0; j < n; ++j)
+					(*x_all_ptr)[k * n + j] = x[j];
+			}
+		});
+	}
+	//
+	// remove zeros that are the same
+	std::vector<size_t> root;
+	for(size_t k = 0; k < num_start; ++k) if( found[k] )
+	{	bool same = false;
+		for(size_t ell = 0; ell < root.size() && ! same; ++ell)
+		{	size_t r = root[ell];
+			same     = true;
+			for(size_t j = 0; j < n; ++j)
+			{	Base diff = abs( x_all[k * n + j] - x_all[r * n + j] );
+				same &= diff < sub_length[j];
+			}
+			if( same && f_all[k] < f_all[r] )
+				root[ell] = k;
+		}
+		if( ! same )
+			root.push_back(k);
+	}
+	size_t num_root = root.size();
+	xout.resize(num_root * n);
+	for(size_t ell = 0; ell < num_root; ++ell)
+	{	for(size_t j = 0; j < n; ++j)
+			xout[ell * n + j] = x_all[ root[ell] * n + j ];
+	}
+	return num_root;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif // CPPAD_USE_CPLUSPLUS_2011
+# endif
@@ -27,6 +27,14 @@ $spell
 	const
 	onetape
 	op
+	num
+	pthread
+	dyn
+	cexp
+	csum
+	cskip
+	var
+	VecAD
 $$
 
 $section Optimize an ADFun Object Tape$$
@@ -38,6 +46,8 @@ $icode%f%.optimize()
 %$$
 $icode%f%.optimize(%options%)
 %$$
+$icode%f%.optimize(%options%, %report%)
+%$$
 
 $head Purpose$$
 The operation sequence corresponding to an $cref ADFun$$ object can
@@ -89,6 +99,135 @@ $cref PrintFor$$ operations will be removed form the optimized function.
 These operators are useful for reporting problems evaluating derivatives
 at independent variable values different from those used to record a function.
 
+$subhead simplify$$
+If the sub-string $code simplify$$ appears in $icode options$$,
+algebraic simplification and constant folding is done
+before the other optimizations.
+For example,
+$icode%x% * 1%$$, $icode%x% + 0%$$, and $codei%-(-%x%)%$$ are replaced by
+$icode x$$,
+$codei%pow(%x%, 2)%$$ is replaced by $icode%x% * %x%$$,
+$icode%x% - %x%$$ and $codei%0 * %x%$$ are replaced by zero,
+$icode%x% / %x%$$ is replaced by one,
+and operations that only depend on constants are evaluated.
+Conditional expressions, and comparisons, that do not depend on the
+independent variables are also resolved.
+These replacements assume that the values of the variables are finite;
+e.g., if $icode x$$ is infinity or nan,
+$icode%x% - %x%$$ is nan but it is replaced by zero.
+For this reason, simplification is not done by default.
+
+$subhead renumber$$
+If the sub-string $code renumber$$ appears in $icode options$$,
+the operations are renumbered before the other optimizations.
+The arguments for each operation are computed, in depth first order,
+just before the operation that uses them.
+This places the values for the arguments of an operation
+close to its result in the Taylor coefficient and partial derivative
+arrays, which can improve cache behavior when computing with $icode f$$.
+On the other hand, it may separate operations of the same type
+that were next to each other, so its effect on speed depends on the
+operation sequence (see the $cref/renumber/speed_main/Global Options/renumber/$$
+option for the speed tests).
+When the Taylor coefficients for $icode f$$ fit in the cache,
+it usually makes little difference.
+It is more likely to help when $icode f$$ has millions of variables.
+The renumbering does not change the values computed by $icode f$$.
+It does drop the operations whose results are not used;
+i.e., the operations that are not needed to compute the dependent variables,
+or the arguments of operations that keep their relative order
+(for example store and print operations).
+Thus the number of variables in $icode f$$ can decrease.
+
+$subhead num_threads$$
+If the sub-string $codei%num_threads=%value%$$ appears in $icode options$$,
+where $icode value$$ is a positive integer,
+$icode value$$ threads are used to find operations that
+are equivalent to previous operations.
+Equivalent operations are always searched for by the same thread,
+so the optimized operation sequence does not depend on $icode value$$.
+This is only done when
+$code CPPAD_USE_CPLUSPLUS_2011$$ is true
+(otherwise $icode value$$ is ignored)
+and one may need to link with a threading library; e.g., using the
+$code -pthread$$ compiler flag.
+It should not be greater than the number of processors because
+the threads wait for each other when
+an operation uses the result of an operation that another thread is
+responsible for.
+The other parts of the optimization are done by the current thread.
+
+$head report$$
+This optional argument has prototype
+$codei%
+	optimize_report& %report%
+%$$
+Its input value does not matter.
+Upon return, its fields contain the following information about
+the optimization:
+$table
+$icode Field$$ $cnext $icode Type$$ $cnext $icode Meaning$$ $rnext
+$code n_op_before$$ $cnext $code size_t$$ $cnext
+	$cref/f.size_op()/seq_property/size_op/$$ before the optimization
+$rnext
+$code n_op_after$$ $cnext $code size_t$$ $cnext
+	$icode%f%.size_op()%$$ after the optimization
+$rnext
+$code n_var_before$$ $cnext $code size_t$$ $cnext
+	$cref/f.size_var()/seq_property/size_var/$$ before the optimization
+$rnext
+$code n_var_after$$ $cnext $code size_t$$ $cnext
+	$icode%f%.size_var()%$$ after the optimization
+$rnext
+$code n_dyn_before$$ $cnext $code size_t$$ $cnext
+	$cref/f.size_dyn_par()/seq_property/size_dyn_par/$$
+	before the optimization
+$rnext
+$code n_dyn_after$$ $cnext $code size_t$$ $cnext
+	$icode%f%.size_dyn_par()%$$ after the optimization
+$rnext
+$code n_match$$ $cnext $code size_t$$ $cnext
+	number of operations that were replaced by an equivalent
+	previous operation
+$rnext
+$code n_csum$$ $cnext $code size_t$$ $cnext
+	number of cumulative summation operations that were formed
+$rnext
+$code n_cskip$$ $cnext $code size_t$$ $cnext
+	number of conditional skip operations that were inserted
+$rnext
+$code time_simplify$$ $cnext $code double$$ $cnext
+	seconds used by the $cref/simplify/optimize/options/simplify/$$ option
+$rnext
+$code time_renumber$$ $cnext $code double$$ $cnext
+	seconds used by the $cref/renumber/optimize/options/renumber/$$ option
+$rnext
+$code time_usage$$ $cnext $code double$$ $cnext
+	seconds used to determine which operations and parameters are used
+$rnext
+$code time_match$$ $cnext $code double$$ $cnext
+	seconds used to find equivalent previous operations
+$rnext
+$code time_cexp$$ $cnext $code double$$ $cnext
+	seconds used to find operations that can be conditionally skipped
+$rnext
+$code time_record$$ $cnext $code double$$ $cnext
+	seconds used to record the optimized operation sequence
+$rnext
+$code time_total$$ $cnext $code double$$ $cnext
+	seconds used by $icode%f%.optimize%$$
+$tend
+The number of variables, and dynamic parameters, that were removed are
+$codei%
+	%report%.n_var_before - %report%.n_var_after
+	%report%.n_dyn_before - %report%.n_dyn_after
+%$$
+The times are computed using $cref elapsed_seconds$$.
+If $icode%f%.optimize%$$ is called in
+$cref/parallel/ta_in_parallel/$$ execution mode,
+$code elapsed_seconds$$ must have been called before in sequential
+execution mode.
+
 $head Examples$$
 $children%
 	example/optimize/forward_active.cpp
@@ -98,6 +237,10 @@ $children%
 	%example/optimize/conditional_skip.cpp
 	%example/optimize/nest_conditional.cpp
 	%example/optimize/cumulative_sum.cpp
+	%example/optimize/simplify.cpp
+	%example/optimize/renumber.cpp
+	%example/optimize/report.cpp
+	%example/optimize/vecad.cpp
 %$$
 $table
 $cref/forward_active.cpp/optimize_forward_active.cpp/$$ $cnext
@@ -120,6 +263,18 @@ $cref/nest_conditional.cpp/optimize_nest_conditional.cpp/$$ $cnext
 $rnext
 $cref/cumulative_sum.cpp/optimize_cumulative_sum.cpp/$$ $cnext
 	$title optimize_cumulative_sum.cpp$$
+$rnext
+$cref/simplify.cpp/optimize_simplify.cpp/$$ $cnext
+	$title optimize_simplify.cpp$$
+$rnext
+$cref/renumber.cpp/optimize_renumber.cpp/$$ $cnext
+	$title optimize_renumber.cpp$$
+$rnext
+$cref/report.cpp/optimize_report.cpp/$$ $cnext
+	$title optimize_report.cpp$$
+$rnext
+$cref/vecad.cpp/optimize_vecad.cpp/$$ $cnext
+	$title optimize_vecad.cpp$$
 $tend
 
 $head Efficiency$$
@@ -170,6 +325,16 @@ If $icode%u%[%i%]%$$ does not affect the value of
 the dependent variables for $icode f$$,
 the value of $icode%u%[%i%]%$$ is set to $cref nan$$.
 
+$head VecAD$$
+If a $cref VecAD$$ element is loaded using a parameter index,
+and its value is known from the initial value for the vector,
+or a previous store to the element using a parameter index,
+the load is replaced by that value.
+(A store to the same vector using a variable index,
+between the store and the load, prevents this replacement.)
+A store using a parameter index is removed
+if the element is not loaded before it is stored again.
+
 $head Checking Optimization$$
 If $cref/NDEBUG/Faq/Speed/NDEBUG/$$ is not defined,
 and $cref/f.size_order()/size_order/$$ is greater than zero,
@@ -183,11 +348,61 @@ related to $icode%f%.optimize()%$$.
 $end
 -----------------------------------------------------------------------------
 */
-# include <cppad/local/optimize/optimize_run.hpp>
 /*!
 \file optimize.hpp
 Optimize a player object operation sequence
 */
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+Information about an optimization of an operation sequence.
+*/
+struct optimize_report {
+	/// number of operators before the optimization
+	size_t n_op_before;
+	/// number of operators after the optimization
+	size_t n_op_after;
+	/// number of variables before the optimization
+	size_t n_var_before;
+	/// number of variables after the optimization
+	size_t n_var_after;
+	/// number of dynamic parameters before the optimization
+	size_t n_dyn_before;
+	/// number of dynamic parameters after the optimization
+	size_t n_dyn_after;
+	/// number of operators replaced by an equivalent previous operator
+	size_t n_match;
+	/// number of cumulative summation operators formed
+	size_t n_csum;
+	/// number of conditional skip operators inserted
+	size_t n_cskip;
+	/// seconds used by the simplify option
+	double time_simplify;
+	/// seconds used by the renumber option
+	double time_renumber;
+	/// seconds used to compute operator and parameter usage
+	double time_usage;
+	/// seconds used to find equivalent previous operators
+	double time_match;
+	/// seconds used to compute conditional skip information
+	double time_cexp;
+	/// seconds used to record the optimized operation sequence
+	double time_record;
+	/// total seconds used by the optimization
+	double time_total;
+	/// constructor sets all the values to zero
+	optimize_report(void)
+	: n_op_before(0), n_op_after(0)
+	, n_var_before(0), n_var_after(0)
+	, n_dyn_before(0), n_dyn_after(0)
+	, n_match(0), n_csum(0), n_cskip(0)
+	, time_simplify(0.0), time_renumber(0.0), time_usage(0.0)
+	, time_match(0.0), time_cexp(0.0), time_record(0.0), time_total(0.0)
+	{ }
+};
+} // END_CPPAD_NAMESPACE
+
+# include <cppad/local/optimize/optimize_run.hpp>
+
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
 Optimize a player object operation sequence
@@ -213,10 +428,71 @@ These operators are necessary for the compare_change function to be
 be meaningful in the resulting recording.
 On the other hand, they are not necessary and take extra time
 when compare_change is not used.
+\li
+If the sub-string "simplify" appears,
+algebraic simplification and constant folding is done
+before the other optimizations.
+\li
+If the sub-string "renumber" appears,
+the operators are renumbered to improve memory locality
+before the other optimizations.
+\li
+If the sub-string "num_threads=value" appears,
+value threads are used to find operators that match previous operators.
 */
 template <class Base>
 void ADFun<Base>::optimize(const std::string& options)
-{
+{	optimize_compute(options, CPPAD_NULL);
+}
+/*!
+Optimize a player object operation sequence and report what was done.
+
+\tparam Base
+base type for the operator.
+
+\param options
+see the version of optimize without the report argument.
+
+\param report
+Upon return, contains information about the optimization;
+see optimize_report.
+*/
+template <class Base>
+void ADFun<Base>::optimize(
+	const std::string& options ,
+	optimize_report&   report  )
+{	optimize_compute(options, &report);
+}
+/*!
+Optimize a player object operation sequence with an optional report.
+
+\tparam Base
+base type for the operator.
+
+\param options
+see the version of optimize without the report argument.
+
+\param report
+If this is null, no report is computed
+(and elapsed_seconds is not used).
+Otherwise, upon return, *report contains information about the
+optimization.
+*/
+template <class Base>
+void ADFun<Base>::optimize_compute(
+	const std::string& options ,
+	optimize_report*   report  )
+{	thread_alloc::tag_scope scope(thread_alloc::optimize_tag);
+	//
+	// start time and sizes before the optimization
+	double time_start = 0.0;
+	if( report != CPPAD_NULL )
+	{	*report              = optimize_report();
+		time_start           = elapsed_seconds();
+		report->n_op_before  = size_op();
+		report->n_var_before = size_var();
+		report->n_dyn_before = size_dyn_par();
+	}
 # if CPPAD_CORE_OPTIMIZE_PRINT_RESULT
 	// size of operation sequence before optimizatiton
 	size_t size_op_before = size_op();
@@ -259,19 +535,19 @@ void ADFun<Base>::optimize(const std::string& options)
 	{
 		case local::play::unsigned_short_enum:
 		local::optimize::optimize_run<unsigned short>(
-			options, n, dep_taddr_, &play_, &rec
+			options, n, dep_taddr_, &play_, &rec, report
 		);
 		break;
 
 		case local::play::unsigned_int_enum:
 		local::optimize::optimize_run<unsigned int>(
-			options, n, dep_taddr_, &play_, &rec
+			options, n, dep_taddr_, &play_, &rec, report
 		);
 		break;
 
 		case local::play::size_t_enum:
 		local::optimize::optimize_run<size_t>(
-			options, n, dep_taddr_, &play_, &rec
+			options, n, dep_taddr_, &play_, &rec, report
 		);
 		break;
 
@@ -292,6 +568,7 @@ void ADFun<Base>::optimize(const std::string& options)
 	// (the results are no longer valid)
 	for_jac_sparse_pack_.resize(0, 0);
 	for_jac_sparse_set_.resize(0,0);
+	for_jac_sparse_roaring_.resize(0,0);
 
 	// free old Taylor coefficient memory
 	taylor_.clear();
@@ -302,6 +579,10 @@ void ADFun<Base>::optimize(const std::string& options)
 	// (must use player size because it now has the recoreder information)
 	cskip_op_.resize( play_.num_op_rec() );
 
+	// resize the vector of load operator indices
+	// (loads may have been removed or replaced)
+	load_op_.resize( play_.num_load_op_rec() );
+
 	// resize subgraph_info_
 	subgraph_info_.resize(
 		ind_taddr_.size(),    // n_ind
@@ -310,6 +591,17 @@ void ADFun<Base>::optimize(const std::string& options)
 		play_.num_var_rec()   // n_var
 	);
 
+	// cached sparsity patterns and colorings are no longer valid
+	sparse_cache_info_.clear();
+
+	// sizes after the optimization and total time
+	if( report != CPPAD_NULL )
+	{	report->n_op_after  = size_op();
+		report->n_var_after = size_var();
+		report->n_dyn_after = size_dyn_par();
+		report->time_total  = elapsed_seconds() - time_start;
+	}
+
 # ifndef NDEBUG
 	if( check_zero_order )
 	{	std::stringstream s;
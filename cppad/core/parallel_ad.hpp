@@ -109,6 +109,9 @@ void parallel_ad(void)
 	CheckSimpleVector< Base, CppAD::vector<Base> >();
 	CheckSimpleVector< AD<Base>, CppAD::vector< AD<Base> > >();
 
+	// delete a tape left by a registered thread that exited
+	thread_alloc::thread_reset_add( AD<Base>::tape_reset );
+
 }
 
 } // END CppAD namespace
@@ -0,0 +1,333 @@
+# ifndef CPPAD_CORE_REROLL_HPP
+# define CPPAD_CORE_REROLL_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin reroll$$
+$spell
+	const
+	enum
+	op
+	VecAD
+$$
+
+$section Replace Repeated Operations by Checkpoint Functions$$
+
+$head Syntax$$
+$codei%reroll<%Base%> %body%(%f%)
+%$$
+$codei%reroll<%Base%> %body%(%f%, %max_op%)
+%$$
+$icode%n_body% = %body%.size()
+%$$
+$icode%n_call% = %body%.n_call()%$$
+
+$head Purpose$$
+Recordings of loops, e.g., over time steps or mesh elements,
+repeat the same pattern of operations many times with different
+argument variables.
+This routine detects consecutive segments of the operation sequence
+for $icode f$$ that are isomorphic; i.e., that compute the same function
+of their arguments.
+Each group of such segments is replaced by calls to one
+$cref checkpoint$$ function that computes the function for a segment.
+This reduces the memory used to store the operation sequence.
+On the other hand, using a checkpoint function has some overhead
+(for example, its forward mode values are recomputed during reverse mode),
+so the forward and reverse mode sweeps for $icode f$$ may take more time.
+
+$head Segments$$
+A segment is a consecutive sequence of operations that only use
+the arithmetic operators and standard math functions,
+with variables or constants for arguments.
+Operations that use dynamic parameters, $cref VecAD$$ vectors,
+conditional expressions, comparisons, discrete functions,
+atomic functions, or $cref PrintFor$$ are not part of any segment.
+A group has at least two segments.
+It is only replaced when this reduces the total number of operations
+(including the operations in the corresponding checkpoint function).
+
+$head f$$
+This argument has prototype
+$codei%
+	ADFun<%Base%>& %f%
+%$$
+Upon return, its repeated segments have been replaced and it computes
+the same function, and derivatives, as on input.
+The Taylor coefficients, and sparsity patterns,
+stored in $icode f$$ are lost.
+The conditional skip operations (see
+$cref/conditional_skip/optimize/options/no_conditional_skip/$$)
+are removed; i.e., one can call $icode%f%.optimize()%$$ after this
+operation to put them back.
+
+$head max_op$$
+This optional argument has prototype
+$codei%
+	size_t %max_op%
+%$$
+It is the maximum number of operations in a segment.
+Larger values may find more segments but take more time.
+The default value for $icode max_op$$ is 1000.
+
+$head body$$
+This object holds the checkpoint functions used by $icode f$$.
+It must not be destructed for as long as $icode f$$, or any copy of
+$icode f$$, is used.
+The checkpoint functions are derived from $cref atomic_base$$ and hence
+$icode body$$ cannot be constructed in
+$cref/parallel/ta_in_parallel/$$ mode.
+
+$head size$$
+The return value $icode n_body$$ has prototype
+$codei%
+	size_t %n_body%
+%$$
+It is the number of checkpoint functions; i.e., the number of groups
+of repeated segments.
+
+$head n_call$$
+The return value $icode n_call$$ has prototype
+$codei%
+	size_t %n_call%
+%$$
+It is the number of checkpoint function calls in $icode f$$;
+i.e., the number of segments that were replaced.
+
+$children%
+	example/general/reroll.cpp
+%$$
+$head Example$$
+The file $cref reroll.cpp$$ contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cppad/local/optimize/reroll_run.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file reroll.hpp
+Replace repeated segments of an operation sequence by checkpoint functions.
+*/
+
+/*!
+Checkpoint functions that replace repeated segments of an operation sequence.
+
+\tparam Base
+base type for the operation sequence.
+*/
+template <class Base>
+class reroll {
+	// memory_checkpoint uses replace to create its checkpoint functions
+	friend class memory_checkpoint<Base>;
+private:
+	/// checkpoint functions for each group of repeated segments
+	vector< checkpoint<Base>* > body_;
+	//
+	/// number of segments replaced by checkpoint function calls
+	size_t n_call_;
+	//
+	// copying is not allowed
+	reroll(const reroll& other);
+	reroll& operator=(const reroll& other);
+	//
+	/// constructor with no checkpoint functions (used by memory_checkpoint)
+	reroll(void)
+	: n_call_(0)
+	{ }
+	// ------------------------------------------------------------------------
+	/*!
+	Set the operation sequence for a function object.
+
+	\param fun
+	is the function object. Upon return, its operation sequence corresponds
+	to rec, and it has no Taylor coefficients or sparsity patterns.
+	The dependent variable information for fun is not changed.
+
+	\param rec
+	is the recording for the operation sequence. Upon return it is empty.
+
+	\param n
+	is the number of independent variables for the operation sequence.
+	*/
+	static void set_recording(
+		ADFun<Base>&            fun ,
+		local::recorder<Base>&  rec ,
+		size_t                  n   )
+	{	fun.num_order_taylor_     = 0;
+		fun.num_direction_taylor_ = 0;
+		fun.cap_order_taylor_     = 0;
+		fun.num_var_tape_         = rec.num_var_rec();
+		fun.taylor_.clear();
+		fun.cskip_op_.resize( rec.num_op_rec() );
+		fun.load_op_.resize( rec.num_load_op_rec() );
+		//
+		// now replace the recording
+		fun.play_.get_recording(rec, n);
+		fun.shared_play_ = CPPAD_NULL;
+		//
+		fun.ind_taddr_.resize(n);
+		for(size_t j = 0; j < n; j++)
+		{	CPPAD_ASSERT_UNKNOWN( fun.play_.GetOp(j+1) == local::InvOp );
+			fun.ind_taddr_[j] = j+1;
+		}
+		fun.for_jac_sparse_pack_.resize(0, 0);
+		fun.for_jac_sparse_set_.resize(0, 0);
+		fun.for_jac_sparse_roaring_.resize(0, 0);
+		fun.subgraph_info_.resize(
+			fun.ind_taddr_.size(),    // n_ind
+			fun.dep_taddr_.size(),    // n_dep
+			fun.play_.num_op_rec(),   // n_op
+			fun.play_.num_var_rec()   // n_var
+		);
+		fun.sparse_cache_info_.clear();
+	}
+	// ------------------------------------------------------------------------
+	/*!
+	Replace groups of segments in a function object by checkpoint functions.
+
+	\tparam Addr
+	type used for random iterators for the operation sequence in f.
+
+	\param name
+	is the name used for the checkpoint functions.
+
+	\param f
+	is the function object.
+
+	\param random_itr
+	is a random iterator for the operation sequence in f.
+
+	\param group
+	is the groups of segments that are replaced
+	(see reroll_find for the specifications).
+
+	\param is_output
+	is the results of the function for each group
+	(see reroll_find for the specifications).
+	*/
+	template <class Addr>
+	void replace(
+		const char*                                      name       ,
+		ADFun<Base>&                                     f          ,
+		const local::play::const_random_iterator<Addr>&  random_itr ,
+		const vector<local::optimize::reroll_group>&     group      ,
+		const local::pod_vector<bool>&                   is_output  )
+	{	const local::player<Base>* play = &f.play_;
+		//
+		// checkpoint function for each group
+		vector<size_t> atom_index( group.size() );
+		for(size_t i = 0; i < group.size(); ++i)
+		{	local::recorder<Base> rec;
+			vector<size_t>        dep_taddr;
+			local::optimize::reroll_record_body(
+				play, random_itr, group[i], is_output, &rec, dep_taddr
+			);
+			ADFun<Base> fun;
+			size_t n_out = dep_taddr.size();
+			fun.dep_taddr_.resize(n_out);
+			fun.dep_parameter_.resize(n_out);
+			for(size_t k = 0; k < n_out; ++k)
+			{	fun.dep_taddr_[k]     = dep_taddr[k];
+				fun.dep_parameter_[k] = false;
+			}
+			set_recording(fun, rec, group[i].n_in);
+			//
+			checkpoint<Base>* ptr = new checkpoint<Base>(name, fun);
+			body_.push_back(ptr);
+			atom_index[i] = ptr->atomic_index();
+			n_call_      += group[i].n_repeat;
+		}
+		//
+		// replace the recording for f
+		local::recorder<Base> rec;
+		local::optimize::reroll_run(
+			f.dep_taddr_, play, random_itr, group, is_output, atom_index, &rec
+		);
+		set_recording(f, rec, f.ind_taddr_.size());
+	}
+	// ------------------------------------------------------------------------
+	/*!
+	Replace the repeated segments in a function object.
+
+	\tparam Addr
+	type used for random iterators for the operation sequence in f.
+
+	\param f
+	is the function object.
+
+	\param max_op
+	is the maximum number of operators in a segment.
+	*/
+	template <class Addr>
+	void compute(ADFun<Base>& f, size_t max_op)
+	{	local::player<Base>* play = &f.play_;
+		play->template setup_random<Addr>();
+		local::play::const_random_iterator<Addr> random_itr =
+			play->template get_random<Addr>();
+		//
+		// groups of repeated segments
+		vector<local::optimize::reroll_group> group;
+		local::pod_vector<bool>               is_output;
+		local::optimize::reroll_find(
+			max_op, f.dep_taddr_, play, random_itr, group, is_output
+		);
+		if( group.size() > 0 )
+			replace("reroll", f, random_itr, group, is_output);
+	}
+public:
+	/*!
+	Replace repeated segments by checkpoint functions.
+
+	\param f
+	is the function object. Upon return, its repeated segments have
+	been replaced by calls to checkpoint functions owned by this object.
+
+	\param max_op
+	is the maximum number of operators in a segment.
+	*/
+	reroll(ADFun<Base>& f, size_t max_op = 1000)
+	: n_call_(0)
+	{	switch( f.play_.address_type() )
+		{
+			case local::play::unsigned_short_enum:
+			compute<unsigned short>(f, max_op);
+			break;
+
+			case local::play::unsigned_int_enum:
+			compute<unsigned int>(f, max_op);
+			break;
+
+			case local::play::size_t_enum:
+			compute<size_t>(f, max_op);
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+	}
+	/// destructor deletes the checkpoint functions
+	~reroll(void)
+	{	for(size_t i = 0; i < body_.size(); ++i)
+			delete body_[i];
+	}
+	/// number of checkpoint functions
+	size_t size(void) const
+	{	return body_.size(); }
+	/// number of checkpoint function calls
+	size_t n_call(void) const
+	{	return n_call_; }
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -92,6 +92,9 @@ See $cref/pattern_out/rev_hes_sparsity/pattern_out/$$ below.
 $head internal_bool$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+In the case where it is false and
+$cref/internal_roaring/internal_roaring/$$ is true for $icode f$$,
+the sets are stored using compressed bitmaps.
 This must be the same as in the previous call to
 $icode%f%.for_jac_sparsity%$$.
 
@@ -150,6 +153,8 @@ Is the returned sparsity pattern transposed.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of standard sets is used.
+If it is false and internal_roaring_ is true,
+the sets are stored using compressed bitmaps.
 
 \param pattern_out
 The value of transpose is false (true),
@@ -167,7 +172,8 @@ void ADFun<Base>::rev_hes_sparsity(
 	bool                         transpose        ,
 	bool                         internal_bool    ,
 	sparse_rc<SizeVector>&       pattern_out      )
-{	size_t n  = Domain();
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t n  = Domain();
 	size_t m  = Range();
 	//
 	CPPAD_ASSERT_KNOWN(
@@ -186,7 +192,36 @@ void ADFun<Base>::rev_hes_sparsity(
 		rev_jac_pattern[ dep_taddr_[i] ] = select_range[i];
 	//
 	//
-	if( internal_bool )
+	if( internal_roaring_ && ! internal_bool )
+	{	CPPAD_ASSERT_KNOWN(
+			for_jac_sparse_roaring_.n_set() > 0,
+			"rev_hes_sparsity: previous call to for_jac_sparsity did not "
+			"use compressed bitmaps for internal sparsity patterns."
+		);
+		// column dimension of internal sparstiy pattern
+		size_t ell = for_jac_sparse_roaring_.end();
+		//
+		// allocate memory for compressed bitmap sparsity calculation
+		// (sparsity pattern is emtpy after a resize)
+		local::sparse_roaring internal_hes;
+		internal_hes.resize(num_var_tape_, ell);
+		//
+		// compute the Hessian sparsity pattern
+		local::sweep::rev_hes<addr_t>(
+			&play_,
+			n,
+			num_var_tape_,
+			for_jac_sparse_roaring_,
+			rev_jac_pattern.data(),
+			internal_hes
+
+		);
+		// get sparstiy pattern for independent variables
+		local::get_internal_sparsity(
+			transpose, ind_taddr_, internal_hes, pattern_out
+		);
+	}
+	else if( internal_bool )
 	{	CPPAD_ASSERT_KNOWN(
 			for_jac_sparse_pack_.n_set() > 0,
 			"rev_hes_sparsity: previous call to for_jac_sparsity did not "
@@ -228,6 +263,7 @@ void ADFun<Base>::rev_hes_sparsity(
 		// (sparsity pattern is emtpy after a resize)
 		local::sparse_list internal_hes;
 		internal_hes.resize(num_var_tape_, ell);
+		internal_hes.auto_compact(true);
 		//
 		// compute the Hessian sparsity pattern
 		local::sweep::rev_hes<addr_t>(
@@ -85,6 +85,9 @@ see $cref/pattern_out/rev_jac_sparsity/pattern_out/$$ below.
 $head internal_bool$$
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of sets of integers is used.
+In the case where it is false and
+$cref/internal_roaring/internal_roaring/$$ is true for $icode f$$,
+the sets are stored using compressed bitmaps.
 
 $head pattern_out$$
 This argument has prototype
@@ -150,6 +153,8 @@ This is used by the optimizer to obtain the correct dependency relations.
 \param internal_bool
 If this is true, calculations are done with sets represented by a vector
 of boolean values. Otherwise, a vector of standard sets is used.
+If it is false and internal_roaring_ is true,
+the sets are stored using compressed bitmaps.
 
 \param pattern_out
 The value of transpose is false (true),
@@ -168,7 +173,8 @@ void ADFun<Base>::rev_jac_sparsity(
 	bool                         dependency       ,
 	bool                         internal_bool    ,
 	sparse_rc<SizeVector>&       pattern_out      )
-{	// number or rows, columns, and non-zeros in pattern_in
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	// number or rows, columns, and non-zeros in pattern_in
 	size_t nr_in  = pattern_in.nr();
 	size_t nc_in  = pattern_in.nc();
 	//
@@ -187,7 +193,36 @@ void ADFun<Base>::rev_jac_sparsity(
 	//
 	bool zero_empty  = true;
 	bool input_empty = true;
-	if( internal_bool )
+	if( internal_roaring_ && ! internal_bool )
+	{	// allocate memory for compressed bitmap sparsity calculation
+		// (sparsity pattern is emtpy after a resize)
+		local::sparse_roaring internal_jac;
+		internal_jac.resize(num_var_tape_, ell);
+		//
+		// set sparsity patttern for dependent variables
+		local::set_internal_sparsity(
+			zero_empty            ,
+			input_empty           ,
+			! transpose           ,
+			dep_taddr_            ,
+			internal_jac          ,
+			pattern_in
+		);
+
+		// compute sparsity for other variables
+		local::sweep::rev_jac<addr_t>(
+			&play_,
+			dependency,
+			n,
+			num_var_tape_,
+			internal_jac
+		);
+		// get sparstiy pattern for independent variables
+		local::get_internal_sparsity(
+			! transpose, ind_taddr_, internal_jac, pattern_out
+		);
+	}
+	else if( internal_bool )
 	{	// allocate memory for bool sparsity calculation
 		// (sparsity pattern is emtpy after a resize)
 		local::sparse_pack internal_jac;
@@ -402,6 +402,7 @@ void ADFun<Base>::RevSparseHesCase(
 	// vector of sets that will hold reverse Hessain values
 	local::sparse_list rev_hes_pattern;
 	rev_hes_pattern.resize(num_var_tape_, q);
+	rev_hes_pattern.auto_compact(true);
 
 	// compute the Hessian sparsity patterns
 	local::sweep::rev_hes<addr_t>(
@@ -494,7 +495,8 @@ template <class VectorSet>
 VectorSet ADFun<Base>::RevSparseHes(
 	size_t q,  const VectorSet& s, bool transpose
 )
-{	VectorSet h;
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	VectorSet h;
 	typedef typename VectorSet::value_type Set_type;
 
 	// Should check to make sure q is same as in previous call to
@@ -576,6 +578,7 @@ void ADFun<Base>::RevSparseHesCheckpoint(
 	// holds reverse Hessian sparsity pattern for all variables
 	local::sparse_list rev_hes_pattern;
 	rev_hes_pattern.resize(num_var_tape_, q);
+	rev_hes_pattern.auto_compact(true);
 
 	// compute Hessian sparsity pattern for all variables
 	local::sweep::rev_hes<addr_t>(
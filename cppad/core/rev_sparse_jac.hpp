@@ -485,7 +485,7 @@ VectorSet ADFun<Base>::RevSparseJac(
 	const VectorSet&    r          ,
 	bool                transpose  ,
 	bool                dependency )
-{
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
 	VectorSet s;
 	typedef typename VectorSet::value_type Set_type;
 
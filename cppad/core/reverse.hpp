@@ -90,7 +90,8 @@ for the independent variables as specified by previous calls to Forward.
 template <typename Base>
 template <typename VectorBase>
 VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
-{	// constants
+{	thread_alloc::tag_scope scope(thread_alloc::taylor_tag);
+	// constants
 	const Base zero(0);
 
 	// temporary indices
@@ -134,7 +135,10 @@ VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
 	);
 
 	// initialize entire Partial matrix to zero
-	local::pod_vector_maybe<Base> Partial(num_var_tape_ * q);
+	// (use the same arena as the Taylor coefficients)
+	local::pod_vector_maybe<Base> Partial;
+	Partial.set_arena( taylor_.arena() );
+	Partial.extend(num_var_tape_ * q);
 	for(i = 0; i < num_var_tape_; i++)
 		for(j = 0; j < q; j++)
 			Partial[i * q + j] = zero;
@@ -147,20 +151,19 @@ VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
 			Partial[dep_taddr_[i] * q + q - 1] += w[i];
 		else
 		{	for(k = 0; k < q; k++)
-				// ? should use += here, first make test to demonstrate bug
-				Partial[ dep_taddr_[i] * q + k ] = w[i * q + k ];
+				Partial[ dep_taddr_[i] * q + k ] += w[i * q + k ];
 		}
 	}
 
 	// evaluate the derivatives
-	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
-	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
-	local::play::const_sequential_iterator play_itr = play_.end();
+	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_ptr()->num_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_ptr()->num_load_op_rec() );
+	local::play::const_sequential_iterator play_itr = play_ptr()->end();
 	local::sweep::reverse(
 		q - 1,
 		n,
 		num_var_tape_,
-		&play_,
+		play_ptr(),
 		cap_order_taylor_,
 		taylor_.data(),
 		q,
@@ -176,7 +179,9 @@ VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
 	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
 
 		// independent variable taddr equals its operator taddr
-		CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == local::InvOp );
+		CPPAD_ASSERT_UNKNOWN(
+			play_ptr()->GetOp( ind_taddr_[j] ) == local::InvOp
+		);
 
 		// by the Reverse Identity Theorem
 		// partial of y^{(k)} w.r.t. u^{(0)} is equal to
@@ -12,6 +12,8 @@ A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
+//
+# include <cppad/core/internal_roaring.hpp>
 //
 # include <cppad/core/for_jac_sparsity.hpp>
 # include <cppad/core/rev_jac_sparsity.hpp>
@@ -27,6 +29,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 //
 # include <cppad/core/sparse_jac.hpp>
 # include <cppad/core/sparse_hes.hpp>
+# include <cppad/core/sparse_cache.hpp>
 //
 # include <cppad/core/sparse_jacobian.hpp>
 # include <cppad/core/sparse_hessian.hpp>
@@ -34,5 +37,6 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/core/subgraph_sparsity.hpp>
 # include <cppad/core/subgraph_reverse.hpp>
 # include <cppad/core/subgraph_jac_rev.hpp>
+# include <cppad/core/subgraph_hes.hpp>
 
 # endif
@@ -0,0 +1,519 @@
+# ifndef CPPAD_CORE_SPARSE_CACHE_HPP
+# define CPPAD_CORE_SPARSE_CACHE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin sparse_cache$$
+$spell
+	const
+	bool
+	Jacobian
+	Jacobians
+	Hessians
+	jac
+	hes
+	rcv
+	nr
+	nc
+	std
+	ostream
+	istream
+	os
+	cppad
+$$
+$section Sparse Jacobians and Hessians With Cached Sparsity and Coloring$$
+
+$head Syntax$$
+$icode%f%.sparse_cache(%b%)
+%$$
+$icode%b% = %f%.sparse_cache()
+%$$
+$icode%n_sweep% = %f%.sparse_jac_full(%x%, %jac%, %n_thread%)
+%$$
+$icode%n_sweep% = %f%.sparse_hes_full(%x%, %w%, %hes%, %n_thread%)
+%$$
+$icode%f%.sparse_cache_write(%os%)
+%$$
+$icode%ok% = %f%.sparse_cache_read(%is%)
+%$$
+
+$head Purpose$$
+The routines $cref sparse_jac$$ and $cref sparse_hes$$ require
+a sparsity pattern and store the coloring in a work structure
+that the caller must keep.
+The routines $code sparse_jac_full$$ and $code sparse_hes_full$$
+compute all of the possibly non-zero elements of the Jacobian
+$latex F^{(1)} (x)$$ and Hessian
+$latex \[
+	H(x) = \sum_{i=0}^{m-1} w_i F_i^{(2)} (x)
+\] $$
+without a user supplied sparsity pattern.
+If $icode b$$ is true, the sparsity pattern and coloring are stored
+in $icode f$$ and only computed once for each operation sequence.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+For the syntax where $icode b$$ is the result
+and for $code sparse_cache_write$$,
+$icode f$$ can be $code const$$.
+
+$head b$$
+This argument or result has prototype
+$codei%
+	bool %b%
+%$$
+If it is true (false), the sparsity patterns and colorings computed by
+future calls to $code sparse_jac_full$$ and $code sparse_hes_full$$
+are (are not) stored in $icode f$$.
+Setting $icode b$$ to false frees the information currently stored.
+
+$subhead Coloring$$
+The colorings stored in $icode f$$ are also used by
+$cref sparse_jac$$ and $cref sparse_hes$$ when $icode b$$ is true,
+their $icode work$$ argument is empty,
+and their $icode pattern$$ and $icode subset$$ have the same
+row and column indices, in the same order,
+as the pattern stored by $code sparse_jac_full$$ or $code sparse_hes_full$$.
+In addition, $icode coloring$$ must be $code cppad$$ for $code sparse_jac_for$$
+(when the domain dimension is less than or equal the range dimension)
+and for $code sparse_jac_rev$$ (otherwise),
+and it must be $code cppad.symmetric$$ for $code sparse_hes$$.
+If the coloring has not yet been stored in $icode f$$, it is computed and
+stored.
+The colorings for other patterns and coloring methods are only stored in
+$icode work$$, because $icode f$$ stores one coloring for each of its
+two patterns.
+
+$subhead Default$$
+The value for this setting after construction of $icode f$$ is false.
+The value of this setting is not affected by calling
+$cref Dependent$$ for this function object.
+
+$subhead Operation Sequence$$
+The stored information is a property of the operation sequence,
+so it is copied by the $cref/assignment/FunConstruct/Assignment Operator/$$
+operator.
+It is freed when the operation sequence changes; i.e.,
+when $cref Dependent$$ or $cref optimize$$ are called.
+
+$head x$$
+This argument has prototype
+$codei%
+	const %BaseVector%& %x%
+%$$
+(see $cref/BaseVector/sparse_jac/BaseVector/$$)
+and its size is the dimension of the domain space for $icode f$$.
+It specifies the point at which to evaluate the derivatives.
+
+$head w$$
+This argument has prototype
+$codei%
+	const %BaseVector%& %w%
+%$$
+and its size is the dimension of the range space for $icode f$$.
+It specifies the weights for the components of $latex F$$ in
+the definition of $latex H(x)$$.
+
+$head jac$$
+This argument has prototype
+$codei%
+	sparse_rcv<%SizeVector%, %BaseVector%>& %jac%
+%$$
+(see $cref/SizeVector/sparse_jac/SizeVector/$$).
+Its input value does not matter.
+Upon return it is the sparse matrix representation of $latex F^{(1)} (x)$$
+for all of the elements in the Jacobian sparsity pattern.
+
+$head hes$$
+This argument has prototype
+$codei%
+	sparse_rcv<%SizeVector%, %BaseVector%>& %hes%
+%$$
+Its input value does not matter.
+Upon return it is the sparse matrix representation of $latex H(x)$$
+for all of the elements in the Hessian sparsity pattern
+(both the upper and lower triangle are included).
+The sparsity pattern is for all components of $latex F$$,
+so it does not depend on which components of $icode w$$ are zero.
+
+$head n_thread$$
+This optional argument has prototype
+$codei%
+	size_t %n_thread%
+%$$
+and its default value is one;
+see $cref/n_thread/sparse_jac/n_thread/$$.
+
+$head n_sweep$$
+The return value $icode n_sweep$$ has prototype
+$codei%
+	size_t %n_sweep%
+%$$
+It is the number of first order forward or reverse sweeps used to compute
+the requested values
+(forward for $code sparse_jac_full$$ when the domain dimension is less than
+or equal the range dimension,
+reverse otherwise).
+
+$head Method$$
+The Jacobian sparsity pattern is computed using $cref rev_jac_sparsity$$,
+the Hessian sparsity pattern is computed using $cref for_hes_sparsity$$,
+and the $code cppad$$ and $code cppad.symmetric$$ coloring methods are used.
+The forward Jacobian sparsity pattern stored in $icode f$$
+(see $cref/f/for_jac_sparsity/f/$$) is not affected.
+
+$head sparse_cache_write$$
+The argument $icode os$$ has prototype
+$codei%
+	std::ostream& %os%
+%$$
+The information stored in $icode f$$ is written to $icode os$$
+as text together with values that identify the operation sequence; i.e.,
+the domain and range dimensions, the number of variables and operations,
+and a hash code for the operators, their arguments,
+and the values of the constant parameters.
+
+$head sparse_cache_read$$
+The argument $icode is$$ has prototype
+$codei%
+	std::istream& %is%
+%$$
+The result $icode ok$$ has prototype
+$codei%
+	bool %ok%
+%$$
+If the information in $icode is$$ was written by $code sparse_cache_write$$
+for the same operation sequence, it is stored in $icode f$$,
+the value of $icode b$$ for $icode f$$ is set to true,
+and $icode ok$$ is true.
+Otherwise, $icode f$$ is not changed and $icode ok$$ is false.
+This can be used to save the sparsity patterns and colorings
+together with the function and avoid computing them again.
+
+$head Example$$
+$children%
+	example/sparse/sparse_cache.cpp
+%$$
+The file $cref sparse_cache.cpp$$
+contains an example and test of these operations.
+It returns true if it succeeds and false otherwise.
+
+$end
+*/
+# include <cppad/core/sparse_jac.hpp>
+# include <cppad/core/sparse_hes.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file core/sparse_cache.hpp
+Sparse Jacobians and Hessians using sparsity and coloring stored in ADFun.
+*/
+
+/*!
+Set sparse_cache
+
+\param value
+new value for this flag. If it is false, the cached information is freed.
+*/
+template <class Base>
+void ADFun<Base>::sparse_cache(bool value)
+{	sparse_cache_ = value;
+	if( ! value )
+		sparse_cache_info_.clear();
+}
+
+/*!
+Get sparse_cache
+
+\return
+current value of sparse_cache_.
+*/
+template <class Base>
+bool ADFun<Base>::sparse_cache(void) const
+{	return sparse_cache_; }
+
+/*!
+Values that identify the operation sequence for the cached information.
+
+\param key
+The input size and elements of key do not matter.
+Upon return it contains the domain and range dimensions,
+the number of variables and operators in the operation sequence,
+and a hash code for the operators, arguments, and constant parameters.
+*/
+template <class Base>
+void ADFun<Base>::sparse_cache_key(CppAD::vector<size_t>& key) const
+{	key.resize(5);
+	key[0] = Domain();
+	key[1] = Range();
+	key[2] = num_var_tape_;
+	key[3] = play_ptr()->num_op_rec();
+	key[4] = play_ptr()->hash_sequence();
+}
+
+/*!
+Write the cached sparsity patterns and colorings.
+
+\param os
+is the stream that the information is written to.
+It is identified by the values in sparse_cache_key.
+*/
+template <class Base>
+void ADFun<Base>::sparse_cache_write(std::ostream& os) const
+{	CppAD::vector<size_t> key;
+	sparse_cache_key(key);
+	sparse_cache_info_.write(os, key);
+}
+
+/*!
+Read the cached sparsity patterns and colorings.
+
+\param is
+is the stream that the information is read from.
+
+\return
+is true if the information corresponds to this operation sequence
+and it has been stored in this object.
+*/
+template <class Base>
+bool ADFun<Base>::sparse_cache_read(std::istream& is)
+{	size_t n = Domain();
+	size_t m = Range();
+	CppAD::vector<size_t> key;
+	sparse_cache_key(key);
+	local::sparse_cache_info info;
+	if( ! info.read(is, key) )
+		return false;
+	//
+	// Jacobian: check the pattern and work are for this function
+	bool ok = info.jac_pattern.nr() == 0 && info.jac_pattern.nc() == 0;
+	ok     |= info.jac_pattern.nr() == m && info.jac_pattern.nc() == n;
+	size_t K       = info.jac_pattern.nnz();
+	size_t n_color = n <= m ? n : m;
+	if( info.jac_color.size() != 0 )
+	{	ok &= info.jac_pattern.nr() != 0;
+		ok &= info.jac_color.size() == n_color;
+		ok &= info.jac_order.size() == K;
+	}
+	for(size_t j = 0; j < info.jac_color.size(); ++j)
+		ok &= info.jac_color[j] <= n_color;
+	for(size_t k = 0; k < info.jac_order.size(); ++k)
+		ok &= info.jac_order[k] < K;
+	//
+	// Hessian: check the pattern and work are for this function
+	ok &= info.hes_pattern.nr() == info.hes_pattern.nc();
+	ok &= info.hes_pattern.nr() == 0 || info.hes_pattern.nr() == n;
+	K   = info.hes_pattern.nnz();
+	if( info.hes_color.size() != 0 )
+	{	ok &= info.hes_pattern.nr() != 0;
+		ok &= info.hes_color.size() == n;
+		ok &= info.hes_row.size() == K;
+		ok &= info.hes_col.size() == K;
+		ok &= info.hes_order.size() == K;
+	}
+	for(size_t j = 0; j < info.hes_color.size(); ++j)
+		ok &= info.hes_color[j] <= n;
+	for(size_t k = 0; k < info.hes_row.size(); ++k)
+		ok &= info.hes_row[k] < n && info.hes_col[k] < n;
+	for(size_t k = 0; k < info.hes_order.size(); ++k)
+		ok &= info.hes_order[k] < K;
+	if( ! ok )
+		return false;
+	//
+	sparse_cache_        = true;
+	sparse_cache_info_   = info;
+	return true;
+}
+
+/*!
+Copy a sparse matrix to a user's sparse matrix type.
+
+\param src
+is the matrix that is copied.
+
+\param dest
+is the copy of the matrix.
+*/
+template <typename SizeVector, typename BaseVector>
+void sparse_cache_copy(
+	const sparse_rcv< CppAD::vector<size_t>, BaseVector>& src  ,
+	sparse_rcv<SizeVector, BaseVector>&                   dest )
+{	size_t nnz = src.nnz();
+	sparse_rc<SizeVector> pattern(src.nr(), src.nc(), nnz);
+	for(size_t k = 0; k < nnz; ++k)
+		pattern.set(k, src.row()[k], src.col()[k]);
+	dest = sparse_rcv<SizeVector, BaseVector>(pattern);
+	for(size_t k = 0; k < nnz; ++k)
+		dest.set(k, src.val()[k]);
+}
+
+/*!
+Calculate a sparse Jacobian using the sparsity pattern and coloring
+cached in this ADFun object.
+
+\tparam Base
+the base type for the recording that is stored in the ADFun object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param jac
+the input value does not matter.
+Upon return it contains all the possibly non-zero elements of the Jacobian.
+
+\param n_thread
+is the maximum number of threads to use for the sweeps.
+
+\return
+the number of first order forward or reverse sweeps used.
+*/
+template <class Base>
+template <typename SizeVector, typename BaseVector>
+size_t ADFun<Base>::sparse_jac_full(
+	const BaseVector&                    x        ,
+	sparse_rcv<SizeVector, BaseVector>&  jac      ,
+	size_t                               n_thread )
+{	typedef CppAD::vector<size_t> size_vector;
+	size_t n = Domain();
+	size_t m = Range();
+	local::sparse_cache_info& info( sparse_cache_info_ );
+	//
+	// Jacobian sparsity pattern
+	sparse_rc<size_vector>  temp_pattern;
+	sparse_rc<size_vector>* pattern = &temp_pattern;
+	if( sparse_cache_ )
+		pattern = &info.jac_pattern;
+	if( pattern->nr() == 0 )
+	{	// reverse mode does not change the sparsity stored in this object
+		sparse_rc<size_vector> identity(m, m, m);
+		for(size_t i = 0; i < m; ++i)
+			identity.set(i, i, i);
+		bool transpose     = false;
+		bool dependency    = false;
+		bool internal_bool = false;
+		rev_jac_sparsity(
+			identity, transpose, dependency, internal_bool, *pattern
+		);
+	}
+	//
+	// coloring (sparse_jac_for and sparse_jac_rev use the cached coloring)
+	sparse_jac_work work;
+	//
+	// compute the Jacobian
+	std::string coloring = "cppad";
+	sparse_rcv<size_vector, BaseVector> subset( *pattern );
+	size_t n_sweep;
+	if( n <= m )
+	{	size_t group_max = 1;
+		n_sweep = sparse_jac_for(
+			group_max, x, subset, *pattern, coloring, work, n_thread
+		);
+	}
+	else
+	{	n_sweep = sparse_jac_rev(
+			x, subset, *pattern, coloring, work, n_thread
+		);
+	}
+	//
+	sparse_cache_copy(subset, jac);
+	return n_sweep;
+}
+
+/*!
+Calculate a sparse Hessian using the sparsity pattern and coloring
+cached in this ADFun object.
+
+\tparam Base
+the base type for the recording that is stored in the ADFun object.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param w
+a vector of length m, the number of dependent variables in f
+(this ADFun object).
+
+\param hes
+the input value does not matter.
+Upon return it contains all the possibly non-zero elements of the Hessian
+of w^T * f(x).
+
+\param n_thread
+is the maximum number of threads to use for the sweeps.
+
+\return
+the number of first order forward sweeps used.
+*/
+template <class Base>
+template <typename SizeVector, typename BaseVector>
+size_t ADFun<Base>::sparse_hes_full(
+	const BaseVector&                    x        ,
+	const BaseVector&                    w        ,
+	sparse_rcv<SizeVector, BaseVector>&  hes      ,
+	size_t                               n_thread )
+{	typedef CppAD::vector<size_t> size_vector;
+	size_t n = Domain();
+	size_t m = Range();
+	local::sparse_cache_info& info( sparse_cache_info_ );
+	//
+	// Hessian sparsity pattern
+	sparse_rc<size_vector>  temp_pattern;
+	sparse_rc<size_vector>* pattern = &temp_pattern;
+	if( sparse_cache_ )
+		pattern = &info.hes_pattern;
+	if( pattern->nr() == 0 )
+	{	// pattern for sum of all the components of f
+		CppAD::vector<bool> select_domain(n), select_range(m);
+		for(size_t j = 0; j < n; ++j)
+			select_domain[j] = true;
+		for(size_t i = 0; i < m; ++i)
+			select_range[i] = true;
+		bool internal_bool = false;
+		for_hes_sparsity(
+			select_domain, select_range, internal_bool, *pattern
+		);
+	}
+	//
+	// coloring (sparse_hes uses the cached coloring)
+	sparse_hes_work work;
+	//
+	// compute the Hessian
+	std::string coloring = "cppad.symmetric";
+	sparse_rcv<size_vector, BaseVector> subset( *pattern );
+	size_t n_sweep = sparse_hes(
+		x, w, subset, *pattern, coloring, work, n_thread
+	);
+	//
+	sparse_cache_copy(subset, hes);
+	return n_sweep;
+}
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -26,13 +26,14 @@ $spell
 	colpack
 	cmake
 	Jacobian
+	lnext
 $$
 
 $section Computing Sparse Hessians$$
 
 $head Syntax$$
 $icode%n_sweep% = %f%.sparse_hes(
-	%x%, %w%, %subset%, %pattern%, %coloring%, %work%
+	%x%, %w%, %subset%, %pattern%, %coloring%, %work%, %n_thread%
 )%$$
 
 $head Purpose$$
@@ -152,6 +153,12 @@ This is the same as the sparse Jacobian
 $cref/cppad/sparse_jac/coloring/cppad/$$ method
 which does not take advantage of symmetry.
 
+$subhead cppad.parallel$$
+This is the same as the sparse Jacobian
+$cref/cppad.parallel/sparse_jac/coloring/cppad.parallel/$$ method
+which computes the coloring using multiple threads
+and does not take advantage of symmetry.
+
 $subhead colpack.symmetric$$
 If $cref colpack_prefix$$ was specified on the
 $cref/cmake command/cmake/CMake Command/$$ line,
@@ -188,6 +195,38 @@ and a different $icode subset$$ provided that Hessian sparsity pattern
 for $icode f$$ and the sparsity pattern in $icode subset$$ are the same.
 If either of these values change, use $icode%work%.clear()%$$ to
 empty this structure.
+If $icode work$$ is empty and $cref sparse_cache$$ is true for $icode f$$,
+the coloring may also be obtained from, and stored in, $icode f$$; see
+$cref/sparse_cache/sparse_cache/b/Coloring/$$.
+
+$head n_thread$$
+This optional argument has prototype
+$codei%
+	size_t %n_thread%
+%$$
+and its default value is one.
+If it is greater than one, and C++11 is available,
+up to $icode n_thread$$ standard threads are used to evaluate the
+first order forward and second order reverse sweeps;
+i.e., different colors are evaluated at the same time.
+The recording and zero order Taylor coefficients in $icode f$$
+are shared by the threads and each thread has its own work space
+for the other Taylor coefficients and partial derivatives.
+The threads are created and destroyed during the call to
+$code sparse_hes$$ and use $cref thread_alloc$$
+in parallel mode; see $cref/parallel_setup/ta_parallel_setup/$$.
+The values computed are the same as when $icode n_thread$$ is one.
+A single thread is used (and $icode n_thread$$ is ignored) if
+$list number$$
+the user has already set up $code thread_alloc$$ for
+parallel execution; i.e., $cref/num_threads/ta_num_threads/$$ is not one,
+$lnext
+a recording for $codei%AD<%Base%>%$$ is in progress,
+$lnext
+the recording in $icode f$$ contains a call to an
+$cref atomic$$ function (they need not be thread safe).
+$lend
+The operations for the type $icode Base$$ must be thread safe.
 
 $head n_sweep$$
 The return value $icode n_sweep$$ has prototype
@@ -235,6 +274,7 @@ $end
 # include <cppad/local/sparse_internal.hpp>
 # include <cppad/local/color_general.hpp>
 # include <cppad/local/color_symmetric.hpp>
+# include <cppad/local/color_sweep.hpp>
 
 /*!
 \file sparse_hes.hpp
@@ -303,14 +343,20 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad.symmetric, cppad.general, colpack.symmetic,
-or colpack.star.
+This must be cppad.symmetric, cppad.general, cppad.parallel,
+colpack.symmetic, or colpack.star.
 
 \param work
 this structure must be empty, or contain the information stored
 by a previous call to sparse_hes.
 The previous call must be for the same ADFun object f
 and the same subset.
+If it is empty, sparse_cache_ is true, and the pattern and subset
+correspond to the cached Hessian pattern, the cached coloring is used
+(and it is cached if it is not yet available).
+
+\param n_thread
+is the maximum number of threads to use for the sweeps.
 
 \return
 This is the number of first order forward
@@ -324,8 +370,10 @@ size_t ADFun<Base>::sparse_hes(
 	sparse_rcv<SizeVector , BaseVector>& subset   ,
 	const sparse_rc<SizeVector>&         pattern  ,
 	const std::string&                   coloring ,
-	sparse_hes_work&                     work     )
-{	size_t n = Domain();
+	sparse_hes_work&                     work     ,
+	size_t                               n_thread )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t n = Domain();
 	//
 	CPPAD_ASSERT_KNOWN(
 		subset.nr() == n,
@@ -390,6 +438,20 @@ size_t ADFun<Base>::sparse_hes(
 		}
 	}
 # endif
+	//
+	// check for a coloring cached in this object
+	local::sparse_cache_info& info( sparse_cache_info_ );
+	bool cache = sparse_cache_ && color.size() == 0;
+	cache     &= coloring == "cppad.symmetric";
+	if( cache ) cache = info.same_pattern(
+		info.hes_pattern, pattern, subset_row, subset_col
+	);
+	if( cache && info.hes_color.size() != 0 )
+	{	row   = info.hes_row;
+		col   = info.hes_col;
+		order = info.hes_order;
+		color = info.hes_color;
+	}
 	//
 	// check for case where input work is empty
 	if( color.size() == 0 )
@@ -433,6 +495,12 @@ size_t ADFun<Base>::sparse_hes(
 			local::color_general_cppad(internal_pattern, col, row, color);
 		else if( coloring == "cppad.symmetric" )
 			local::color_symmetric_cppad(internal_pattern, col, row, color);
+		else if( coloring == "cppad.parallel" )
+		{	size_t n_color_thread = local::run_threads_default();
+			local::color_general_parallel(
+				internal_pattern, col, row, color, n_color_thread
+			);
+		}
 		else if( coloring == "colpack.general" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -471,6 +539,13 @@ size_t ADFun<Base>::sparse_hes(
 		for(size_t k = 0; k < K; k++)
 			key[k] = color[ col[k] ];
 		index_sort(key, order);
+		//
+		if( cache )
+		{	info.hes_row   = row;
+			info.hes_col   = col;
+			info.hes_order = order;
+			info.hes_color = color;
+		}
 	}
 	// Base versions of zero and one
 	Base one(1.0);
@@ -484,6 +559,51 @@ size_t ADFun<Base>::sparse_hes(
 	for(size_t k = 0; k < K; k++)
 		subset.set(k, zero);
 	//
+	// check for case where the sweeps are evaluated using multiple threads
+	// (atomic functions in the recording need not be thread safe)
+	n_thread = local::run_threads_alloc_number(n_thread);
+	bool parallel = n_thread > 1 && AD<Base>::tape_ptr() == CPPAD_NULL;
+	if( parallel )
+		parallel = local::color_sweep_ok(play_);
+	if( parallel )
+	{	parallel_ad<Base>();
+		local::color_sweep<Base, SizeVector, BaseVector, vector<size_t> > sweep(
+			local::color_sweep_hes,
+			&play_,
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			color,
+			order,
+			row,
+			col,
+			&w,
+			subset,
+			1,
+			n_thread
+		);
+		local::run_threads_alloc(n_thread, sweep);
+		//
+		// repeat the last first order forward so that the Taylor
+		// coefficients in f are the same as when the colors are
+		// evaluated sequentially
+		if( K > 0 )
+		{	size_t ell = color[ col[ order[K - 1] ] ];
+			BaseVector dx(n);
+			for(size_t j = 0; j < n; j++)
+			{	dx[j] = zero;
+				if( color[j] == ell )
+					dx[j] = one;
+			}
+			Forward(1, dx);
+		}
+		return n_color;
+	}
+	//
 	// direction vector for calls to first order forward
 	BaseVector dx(n);
 	//
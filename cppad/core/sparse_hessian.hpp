@@ -657,7 +657,7 @@ size_t ADFun<Base>::SparseHessian(
 	const VectorSize&     col  ,
 	VectorBase&           hes  ,
 	sparse_hessian_work&  work )
-{
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
 	size_t n    = Domain();
 	size_t K    = hes.size();
 # ifndef NDEBUG
@@ -27,17 +27,20 @@ $spell
 	Cppad
 	Colpack
 	cmake
+	lnext
+	Gebremedhin
+	Manne
 $$
 
 $section Computing Sparse Jacobians$$
 
 $head Syntax$$
 $icode%n_sweep% = %f%.sparse_jac_for(
-	%group_max%, %x%, %subset%, %pattern%, %coloring%, %work%
+	%group_max%, %x%, %subset%, %pattern%, %coloring%, %work%, %n_thread%
 )
 %$$
 $icode%n_sweep% = %f%.sparse_jac_rev(
-	%x%, %subset%, %pattern%, %coloring%, %work%
+	%x%, %subset%, %pattern%, %coloring%, %work%, %n_thread%
 )%$$
 
 $head Purpose$$
@@ -146,6 +149,21 @@ after the $icode work$$ constructor or $icode%work%.clear()%$$.
 $subhead cppad$$
 This uses a general purpose coloring algorithm written for Cppad.
 
+$subhead cppad.parallel$$
+This uses the same conditions for two columns (rows)
+to have the same color as the $code cppad$$ method.
+The coloring is computed using multiple threads
+(if C++11 is available and the hardware supports concurrent threads).
+It uses speculative greedy coloring with conflict resolution; see
+A. H. Gebremedhin and F. Manne,
+$italic Scalable parallel graph coloring algorithms$$,
+Concurrency: Practice and Experience 12 (2000).
+This may result in more colors than the $code cppad$$ method,
+but is faster for very large sparsity patterns.
+The threads are created and destroyed during the coloring and do not
+use $cref thread_alloc$$, so it is not necessary to call
+$cref parallel_ad$$ before using this method.
+
 $subhead colpack$$
 If $cref colpack_prefix$$ is specified on the
 $cref/cmake command/cmake/CMake Command/$$ line,
@@ -169,6 +187,38 @@ and a different $icode subset$$ provided that Jacobian sparsity pattern
 for $icode f$$ and the sparsity pattern in $icode subset$$ are the same.
 If any of these values change, use $icode%work%.clear()%$$ to
 empty this structure.
+If $icode work$$ is empty and $cref sparse_cache$$ is true for $icode f$$,
+the coloring may also be obtained from, and stored in, $icode f$$; see
+$cref/sparse_cache/sparse_cache/b/Coloring/$$.
+
+$head n_thread$$
+This optional argument has prototype
+$codei%
+	size_t %n_thread%
+%$$
+and its default value is one.
+If it is greater than one, and C++11 is available,
+up to $icode n_thread$$ standard threads are used to evaluate the
+first order forward (reverse) sweeps;
+i.e., different colors are evaluated at the same time.
+The recording and zero order Taylor coefficients in $icode f$$
+are shared by the threads and each thread has its own work space
+for the other Taylor coefficients and partial derivatives.
+The threads are created and destroyed during the call to
+$code sparse_jac_for$$ or $code sparse_jac_rev$$ and use $cref thread_alloc$$
+in parallel mode; see $cref/parallel_setup/ta_parallel_setup/$$.
+The values computed are the same as when $icode n_thread$$ is one.
+A single thread is used (and $icode n_thread$$ is ignored) if
+$list number$$
+the user has already set up $code thread_alloc$$ for
+parallel execution; i.e., $cref/num_threads/ta_num_threads/$$ is not one,
+$lnext
+a recording for $codei%AD<%Base%>%$$ is in progress,
+$lnext
+the recording in $icode f$$ contains a call to an
+$cref atomic$$ function (they need not be thread safe).
+$lend
+The operations for the type $icode Base$$ must be thread safe.
 
 $head n_sweep$$
 The return value $icode n_sweep$$ has prototype
@@ -209,6 +259,7 @@ $end
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/sparse_internal.hpp>
 # include <cppad/local/color_general.hpp>
+# include <cppad/local/color_sweep.hpp>
 # include <cppad/utility/vector.hpp>
 
 /*!
@@ -271,13 +322,19 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, cppad.parallel, or colpack.
 
 \param work
 this structure must be empty, or contain the information stored
 by a previous call to sparse_jac_for.
 The previous call must be for the same ADFun object f
 and the same subset.
+If it is empty, sparse_cache_ is true, and the pattern and subset
+correspond to the cached Jacobian pattern, the cached coloring is used
+(and it is cached if it is not yet available).
+
+\param n_thread
+is the maximum number of threads to use for the forward sweeps.
 
 \return
 This is the number of first order forward sweeps used to compute
@@ -291,8 +348,10 @@ size_t ADFun<Base>::sparse_jac_for(
 	sparse_rcv<SizeVector, BaseVector>&  subset     ,
 	const sparse_rc<SizeVector>&         pattern    ,
 	const std::string&                   coloring   ,
-	sparse_jac_work&                     work       )
-{	size_t m = Range();
+	sparse_jac_work&                     work       ,
+	size_t                               n_thread   )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t m = Range();
 	size_t n = Domain();
 	//
 	CPPAD_ASSERT_KNOWN(
@@ -326,6 +385,18 @@ size_t ADFun<Base>::sparse_jac_for(
 	if( K == 0 )
 		return 0;
 	//
+	// check for a coloring cached in this object
+	// (sparse_jac_full uses forward mode when n <= m)
+	local::sparse_cache_info& info( sparse_cache_info_ );
+	bool cache = sparse_cache_ && color.size() == 0;
+	cache     &= coloring == "cppad" && n <= m;
+	if( cache )
+		cache = info.same_pattern(info.jac_pattern, pattern, row, col);
+	if( cache && info.jac_color.size() != 0 )
+	{	color = info.jac_color;
+		order = info.jac_order;
+	}
+	//
 	// check for case where input work is empty
 	if( color.size() == 0 )
 	{	// compute work color and order vectors
@@ -356,6 +427,12 @@ size_t ADFun<Base>::sparse_jac_for(
 		color.resize(n);
 		if(	coloring == "cppad" )
 			local::color_general_cppad(pattern_transpose, col, row, color);
+		else if( coloring == "cppad.parallel" )
+		{	size_t n_color_thread = local::run_threads_default();
+			local::color_general_parallel(
+				pattern_transpose, col, row, color, n_color_thread
+			);
+		}
 		else if( coloring == "colpack" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -379,6 +456,11 @@ size_t ADFun<Base>::sparse_jac_for(
 		for(size_t k = 0; k < K; k++)
 			key[k] = color[ col[k] ];
 		index_sort(key, order);
+		//
+		if( cache )
+		{	info.jac_color = color;
+			info.jac_order = order;
+		}
 	}
 	// Base versions of zero and one
 	Base one(1.0);
@@ -397,6 +479,42 @@ size_t ADFun<Base>::sparse_jac_for(
 	// number of colors computed so far
 	size_t color_count = 0;
 	//
+	// check for case where the sweeps are evaluated using multiple threads
+	// (atomic functions in the recording need not be thread safe)
+	n_thread = local::run_threads_alloc_number(n_thread);
+	bool parallel = n_thread > 1 && AD<Base>::tape_ptr() == CPPAD_NULL;
+	if( parallel )
+		parallel = local::color_sweep_ok(play_);
+	if( parallel )
+	{	parallel_ad<Base>();
+		local::color_sweep<Base, SizeVector, BaseVector, SizeVector> sweep(
+			local::color_sweep_jac_for,
+			&play_,
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			color,
+			order,
+			row,
+			col,
+			CPPAD_NULL,
+			subset,
+			group_max,
+			n_thread
+		);
+		local::run_threads_alloc(n_thread, sweep);
+		//
+		// repeat the last group below so that the Taylor coefficients
+		// in f are the same as when the groups are evaluated sequentially
+		color_count = ( (n_color - 1) / group_max ) * group_max;
+		while( k < K && color[ col[ order[k] ] ] < color_count )
+			++k;
+	}
+	//
 	while( color_count < n_color )
 	{	// number of colors that will be in this group
 		size_t group_size = std::min(group_max, n_color - color_count);
@@ -465,13 +583,19 @@ where m is number of dependent variables in f.
 
 \param coloring
 determines which coloring algorithm is used.
-This must be cppad or colpack.
+This must be cppad, cppad.parallel, or colpack.
 
 \param work
 this structure must be empty, or contain the information stored
 by a previous call to sparse_jac_rev.
 The previous call must be for the same ADFun object f
 and the same subset.
+If it is empty, sparse_cache_ is true, and the pattern and subset
+correspond to the cached Jacobian pattern, the cached coloring is used
+(and it is cached if it is not yet available).
+
+\param n_thread
+is the maximum number of threads to use for the reverse sweeps.
 
 \return
 This is the number of first order reverse sweeps used to compute
@@ -484,8 +608,10 @@ size_t ADFun<Base>::sparse_jac_rev(
 	sparse_rcv<SizeVector, BaseVector>&  subset   ,
 	const sparse_rc<SizeVector>&         pattern  ,
 	const std::string&                   coloring ,
-	sparse_jac_work&                     work     )
-{	size_t m = Range();
+	sparse_jac_work&                     work     ,
+	size_t                               n_thread )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t m = Range();
 	size_t n = Domain();
 	//
 	CPPAD_ASSERT_KNOWN(
@@ -519,6 +645,18 @@ size_t ADFun<Base>::sparse_jac_rev(
 	if( K == 0 )
 		return 0;
 	//
+	// check for a coloring cached in this object
+	// (sparse_jac_full uses reverse mode when n > m)
+	local::sparse_cache_info& info( sparse_cache_info_ );
+	bool cache = sparse_cache_ && color.size() == 0;
+	cache     &= coloring == "cppad" && n > m;
+	if( cache )
+		cache = info.same_pattern(info.jac_pattern, pattern, row, col);
+	if( cache && info.jac_color.size() != 0 )
+	{	color = info.jac_color;
+		order = info.jac_order;
+	}
+	//
 	// check for case where input work is empty
 	if( color.size() == 0 )
 	{	// compute work color and order vectors
@@ -548,6 +686,12 @@ size_t ADFun<Base>::sparse_jac_rev(
 		color.resize(m);
 		if(	coloring == "cppad" )
 			local::color_general_cppad(internal_pattern, row, col, color);
+		else if( coloring == "cppad.parallel" )
+		{	size_t n_color_thread = local::run_threads_default();
+			local::color_general_parallel(
+				internal_pattern, row, col, color, n_color_thread
+			);
+		}
 		else if( coloring == "colpack" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -571,6 +715,11 @@ size_t ADFun<Base>::sparse_jac_rev(
 		for(size_t k = 0; k < K; k++)
 			key[k] = color[ row[k] ];
 		index_sort(key, order);
+		//
+		if( cache )
+		{	info.jac_color = color;
+			info.jac_order = order;
+		}
 	}
 	// Base versions of zero and one
 	Base one(1.0);
@@ -584,6 +733,37 @@ size_t ADFun<Base>::sparse_jac_rev(
 	for(size_t k = 0; k < K; k++)
 		subset.set(k, zero);
 	//
+	// check for case where the sweeps are evaluated using multiple threads
+	// (atomic functions in the recording need not be thread safe)
+	n_thread = local::run_threads_alloc_number(n_thread);
+	bool parallel = n_thread > 1 && AD<Base>::tape_ptr() == CPPAD_NULL;
+	if( parallel )
+		parallel = local::color_sweep_ok(play_);
+	if( parallel )
+	{	parallel_ad<Base>();
+		local::color_sweep<Base, SizeVector, BaseVector, SizeVector> sweep(
+			local::color_sweep_jac_rev,
+			&play_,
+			num_var_tape_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			load_op_,
+			ind_taddr_,
+			dep_taddr_,
+			color,
+			order,
+			row,
+			col,
+			CPPAD_NULL,
+			subset,
+			1,
+			n_thread
+		);
+		local::run_threads_alloc(n_thread, sweep);
+		return n_color;
+	}
+	//
 	// weighting vector and return values for calls to Reverse
 	BaseVector w(m), dw(n);
 	//
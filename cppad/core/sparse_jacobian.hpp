@@ -933,7 +933,8 @@ template <class VectorBase, class VectorSet>
 VectorBase ADFun<Base>::SparseJacobian(
 	const VectorBase& x, const VectorSet& p
 )
-{	size_t i, j, k;
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t i, j, k;
 
 	size_t m = Range();
 	size_t n = Domain();
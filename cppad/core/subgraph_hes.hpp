@@ -0,0 +1,505 @@
+# ifndef CPPAD_CORE_SUBGRAPH_HES_HPP
+# define CPPAD_CORE_SUBGRAPH_HES_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin subgraph_hes$$
+$spell
+	Hessians
+	Hessian
+	Subgraphs
+	subgraph
+	rcv
+	Taylor
+	nr
+	nc
+	const
+	nnz
+	hes
+$$
+
+$section Compute Sparse Hessians Using Subgraphs$$
+
+$head Syntax$$
+$icode%f%.subgraph_hes(%x%, %w%, %subset%)
+%$$
+
+$head See Also$$
+$cref subgraph_jac_rev$$, $cref sparse_hes$$.
+
+$head Purpose$$
+We use $latex F : \B{R}^n \rightarrow \B{R}^m$$ to denote the
+function corresponding to $icode f$$.
+Here $icode n$$ is the $cref/domain/seq_property/Domain/$$ size,
+and $icode m$$ is the $cref/range/seq_property/Range/$$ size, or $icode f$$.
+The syntax above takes advantage of sparsity when computing the Hessian
+$latex \[
+	H(x) = \dpow{2}{x} \sum_{i=0}^{m-1} w_i F_i (x)
+\] $$
+for a specified subset of its elements.
+In the sparse case, this should be faster than $cref sparse_hes$$
+when the Hessian is hard to color; i.e., when $code sparse_hes$$
+requires many sweeps.
+
+$head Method$$
+This routine does not use coloring.
+The subgraph for each dependent variable
+$latex F_i (x)$$ that has $latex w_i \neq 0$$ is computed once.
+For each row index $latex j$$ that appears in $icode subset$$,
+it computes first order forward mode in the direction of the
+$th j$$ independent variable
+and then one second order reverse sweep.
+Both sweeps are restricted to the union of the subgraphs
+for the dependent variables that depend on $latex x_j$$.
+If this union is small, these sweeps are much faster than
+sweeps for the entire operation sequence.
+
+$head BaseVector$$
+The type $icode BaseVector$$ is a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$icode Base$$.
+
+$head SizeVector$$
+The type $icode SizeVector$$ is a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code size_t$$.
+
+$head f$$
+This object has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+Note that the Taylor coefficients stored in $icode f$$ are affected
+by this operation; see
+$cref/uses forward/subgraph_hes/Uses Forward/$$ below.
+
+$head x$$
+This argument has prototype
+$codei%
+	const %BaseVector%& %x%
+%$$
+and its size is $icode n$$.
+It is the value of $icode x$$ at which we are computing the Hessian.
+
+$head w$$
+This argument has prototype
+$codei%
+	const %BaseVector%& %w%
+%$$
+and its size is $icode m$$.
+It specifies the weight for each of the components of $latex F(x)$$;
+i.e. $latex w_i$$ is the weight for $latex F_i (x)$$.
+Components with $latex w_i = 0$$ are not included in the calculation.
+
+$head Uses Forward$$
+After each call to $cref Forward$$,
+the object $icode f$$ contains the corresponding
+$cref/Taylor coefficients/glossary/Taylor Coefficient/$$.
+After a call to $code subgraph_hes$$,
+the zero order coefficients correspond to
+$codei%
+	%f%.Forward(0, %x%)
+%$$
+All the other forward mode coefficients are unspecified.
+
+$head subset$$
+This argument has prototype
+$codei%
+	sparse_rcv<%SizeVector%, %BaseVector%>& %subset%
+%$$
+Its row size and column size are $icode%subset%.nr() == %n%$$ and
+$icode%subset%.nc() == %n%$$.
+It specifies which elements of the Hessian are computed.
+The input elements in its value vector
+$icode%subset%.val()%$$ do not matter.
+Upon return it contains the value of the corresponding elements
+of the Hessian.
+Elements of the Hessian that are identically zero
+(do not depend on both the corresponding row and column
+independent variables) are set to zero.
+The Hessian is symmetric, so the number of forward and reverse sweeps
+is reduced by only including the lower (or upper) triangle in $icode subset$$.
+
+$head Example$$
+$children%
+	example/sparse/subgraph_hes.cpp
+%$$
+The file $cref subgraph_hes.cpp$$
+is an example and test using $code subgraph_hes$$.
+It returns $code true$$ for success and $code false$$ for failure.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <algorithm>
+# include <cppad/core/ad_fun.hpp>
+# include <cppad/local/subgraph/info.hpp>
+# include <cppad/local/subgraph/entire_call.hpp>
+# include <cppad/local/sweep/forward1.hpp>
+# include <cppad/local/sweep/reverse.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file subgraph_hes.hpp
+Compute sparse Hessians using subgraphs.
+*/
+
+/*!
+Subgraph Hessian calculation for a specific address type.
+
+\tparam Addr
+type used for indices in random iterator
+(must correspond to play_.addr_type()).
+
+\tparam SizeVector
+is the simple vector with elements of type size_t that is used for
+row, column index sparsity patterns.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param w
+is the weighting vector for the components of the range.
+
+\param select_domain
+is the set of independent variables that appear in subset.
+
+\param subset
+specifices the subset of the Hessian that is evaluated.
+The value vector for subset is set to the corresponding Hessian values.
+
+\par Assumptions
+The zero order Taylor coefficients correspond to the point at which
+the Hessian is evaluated.
+*/
+template <typename Base>
+template <typename Addr, typename SizeVector, typename BaseVector>
+void ADFun<Base>::subgraph_hes_helper(
+	const BaseVector&                   w             ,
+	const local::pod_vector<bool>&      select_domain ,
+	sparse_rcv<SizeVector, BaseVector>& subset        )
+{	using local::pod_vector;
+	size_t n       = Domain();
+	size_t m       = Range();
+	size_t num_var = play_.num_var_rec();
+	//
+	// get a random iterator for this player
+	play_.template setup_random<Addr>();
+	typename local::play::const_random_iterator<Addr> random_itr =
+		play_.template get_random<Addr>();
+	//
+	// subgraph for one dependent variable
+	pod_vector<addr_t> subgraph;
+	//
+	// -----------------------------------------------------------------------
+	// sub_start and sub_list: the subgraph for the i-th dependent variable
+	// (including entire atomic function calls) is
+	// sub_list[k] for k = sub_start[i] , ... , sub_start[i+1] - 1.
+	//
+	// dep_start and dep_list: the dependent variables with non-zero weight
+	// that depend on the j-th independent variable are
+	// dep_list[k] for k = dep_start[j] , ... , dep_start[j+1] - 1.
+	Base zero(0);
+	pod_vector<size_t> pair_ind, pair_dep;
+	pod_vector<size_t> sub_start(m + 1);
+	pod_vector<addr_t> sub_list;
+	subgraph_reverse(select_domain);
+	for(size_t i = 0; i < m; ++i)
+	{	sub_start[i] = sub_list.size();
+		if( w[i] != zero )
+		{	subgraph_info_.get_rev(
+				random_itr, dep_taddr_, addr_t(i), subgraph
+			);
+			for(size_t k = 0; k < subgraph.size(); ++k)
+			{	// the InvOp operators have indices 1, ... , n
+				size_t i_op = size_t( subgraph[k] );
+				if( 0 < i_op && i_op <= n )
+				{	CPPAD_ASSERT_UNKNOWN( play_.GetOp(i_op) == local::InvOp );
+					pair_ind.push_back(i_op - 1);
+					pair_dep.push_back(i);
+				}
+			}
+			local::subgraph::entire_call(random_itr, subgraph);
+			for(size_t k = 0; k < subgraph.size(); ++k)
+				sub_list.push_back( subgraph[k] );
+		}
+	}
+	sub_start[m] = sub_list.size();
+	pod_vector<size_t> dep_start(n + 1);
+	for(size_t j = 0; j <= n; ++j)
+		dep_start[j] = 0;
+	for(size_t k = 0; k < pair_ind.size(); ++k)
+		++dep_start[ pair_ind[k] + 1 ];
+	for(size_t j = 0; j < n; ++j)
+		dep_start[j + 1] += dep_start[j];
+	pod_vector<size_t> dep_list( pair_ind.size() );
+	pod_vector<size_t> next(n);
+	for(size_t j = 0; j < n; ++j)
+		next[j] = dep_start[j];
+	for(size_t k = 0; k < pair_ind.size(); ++k)
+		dep_list[ next[ pair_ind[k] ]++ ] = pair_dep[k];
+	// -----------------------------------------------------------------------
+	//
+	// nnz and row, column, and row_major vectors for subset
+	size_t nnz = subset.nnz();
+	const SizeVector& row( subset.row() );
+	const SizeVector& col( subset.col() );
+	SizeVector row_major = subset.row_major();
+	//
+	// Allocate first order Taylor coefficients and set them to zero.
+	// The first order forward sweeps below only modify the coefficients
+	// on the union of the subgraphs and set them back to zero.
+	BaseVector dx(n);
+	for(size_t j = 0; j < n; ++j)
+		dx[j] = zero;
+	Forward(1, dx);
+	size_t C = cap_order_taylor_;
+	CPPAD_ASSERT_UNKNOWN( num_direction_taylor_ == 1 );
+	CPPAD_ASSERT_UNKNOWN( C >= 2 );
+	//
+	// union of the subgraphs for one row of the Hessian
+	pod_vector<addr_t> sub_union;
+	//
+	// which independent variables are in sub_union
+	pod_vector<bool> in_union(n);
+	for(size_t j = 0; j < n; ++j)
+		in_union[j] = false;
+	//
+	// partial derivatives for second order reverse mode
+	size_t q = 2;
+	local::pod_vector_maybe<Base>& partial( subgraph_partial_ );
+	partial.resize(num_var * q);
+	//
+	// not used because p != 0 in the first order forward sweeps
+	size_t compare_change_number   = 0;
+	size_t compare_change_op_index = 0;
+	//
+	size_t k = 0;
+	while( k < nnz )
+	{	size_t j = row[ row_major[k] ];
+		//
+		// union of subgraphs for dependent variables that depend on x_j
+		sub_union.resize(0);
+		if( dep_start[j] < dep_start[j + 1] )
+		{	for(size_t ell = dep_start[j]; ell < dep_start[j+1]; ++ell)
+			{	size_t i = dep_list[ell];
+				for(size_t s = sub_start[i]; s < sub_start[i+1]; ++s)
+					sub_union.push_back( sub_list[s] );
+			}
+			// add BeginOp and EndOp, sort, and remove duplicates
+			addr_t i_op_begin_op = 0;
+			addr_t i_op_end_op   = addr_t( play_.num_op_rec() - 1);
+			sub_union.push_back(i_op_begin_op);
+			sub_union.push_back(i_op_end_op);
+			addr_t* first = sub_union.data();
+			addr_t* last  = first + sub_union.size();
+			std::sort(first, last);
+			last = std::unique(first, last);
+			sub_union.resize( size_t(last - first) );
+		}
+		if( sub_union.size() > 0 )
+		{	// first order forward mode in the x_j direction
+			// on the union of the subgraphs
+			taylor_[ C * ind_taddr_[j] + 1 ] = Base(1);
+			local::play::const_subgraph_iterator<Addr> forward_itr =
+				play_.begin_subgraph(random_itr, &sub_union);
+			local::sweep::forward1(
+				&play_,
+				std::cout,
+				false,
+				1,
+				1,
+				n,
+				num_var,
+				C,
+				taylor_.data(),
+				cskip_op_.data(),
+				load_op_,
+				0,
+				compare_change_number,
+				compare_change_op_index,
+				forward_itr
+			);
+			//
+			// initialize partial to zero on the union of the subgraphs
+			for(size_t s = 0; s < sub_union.size(); ++s)
+			{	size_t        i_op = size_t( sub_union[s] );
+				local::OpCode op;
+				const addr_t* arg;
+				size_t        i_var;
+				random_itr.op_info(i_op, op, arg, i_var);
+				if( 0 < i_op && i_op <= n )
+					in_union[i_op - 1] = true;
+				if( NumRes(op) > 0 && op != local::BeginOp )
+				{	size_t j_var = i_var + 1 - NumRes(op);
+					for(size_t v = j_var; v <= i_var; ++v)
+					{	for(size_t d = 0; d < q; ++d)
+							partial[v * q + d] = zero;
+					}
+				}
+			}
+			//
+			// weight first order Taylor coefficient of each dependent
+			for(size_t ell = dep_start[j]; ell < dep_start[j+1]; ++ell)
+			{	size_t i = dep_list[ell];
+				partial[ dep_taddr_[i] * q + 1 ] += w[i];
+			}
+			//
+			// second order reverse mode on the union of the subgraphs
+			local::play::const_subgraph_iterator<Addr> subgraph_itr =
+				play_.end_subgraph(random_itr, &sub_union);
+			local::sweep::reverse(
+				q - 1,
+				n,
+				num_var,
+				&play_,
+				cap_order_taylor_,
+				taylor_.data(),
+				q,
+				partial.data(),
+				cskip_op_.data(),
+				load_op_,
+				subgraph_itr
+			);
+			//
+			// set first order Taylor coefficients back to zero
+			// (the InvOp for x_j is in sub_union)
+			for(size_t s = 0; s < sub_union.size(); ++s)
+			{	size_t        i_op = size_t( sub_union[s] );
+				local::OpCode op;
+				const addr_t* arg;
+				size_t        i_var;
+				random_itr.op_info(i_op, op, arg, i_var);
+				if( NumRes(op) > 0 && op != local::BeginOp )
+				{	size_t j_var = i_var + 1 - NumRes(op);
+					for(size_t v = j_var; v <= i_var; ++v)
+						taylor_[ C * v + 1 ] = zero;
+				}
+			}
+		}
+		//
+		// store the values for this row
+		while( k < nnz && row[ row_major[k] ] == j )
+		{	size_t c = col[ row_major[k] ];
+			if( in_union[c] )
+			{	size_t c_var = ind_taddr_[c];
+				subset.set( row_major[k], partial[c_var * q + 0] );
+			}
+			else
+				subset.set( row_major[k], zero );
+			++k;
+		}
+		//
+		// reset in_union
+		for(size_t s = 0; s < sub_union.size(); ++s)
+		{	size_t i_op = size_t( sub_union[s] );
+			if( 0 < i_op && i_op <= n )
+				in_union[i_op - 1] = false;
+		}
+	}
+	//
+	CPPAD_ASSERT_KNOWN( ! ( hasnan( subset.val() ) && check_for_nan_ ) ,
+		"f.subgraph_hes(x, w, subset): subset has a nan,\n"
+		"but none of f's Taylor coefficents are nan."
+	);
+	return;
+}
+
+/*!
+Subgraph sparse Hessian calculation.
+
+\tparam Base
+is the base type for this recording.
+
+\tparam SizeVector
+is the simple vector with elements of type size_t that is used for
+row, column index sparsity patterns.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param x
+a vector of length n, the number of independent variables in f
+(this ADFun object).
+
+\param w
+a vector of length m, the number of dependent variables in f.
+It is the weighting for the components of f.
+
+\param subset
+specifices the subset of the sparsity pattern where the Hessian is evaluated.
+subset.nr() == n,
+subset.nc() == n.
+*/
+template <typename Base>
+template <typename SizeVector, typename BaseVector>
+void ADFun<Base>::subgraph_hes(
+	const BaseVector&                   x        ,
+	const BaseVector&                   w        ,
+	sparse_rcv<SizeVector, BaseVector>& subset   )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t m = Range();
+	size_t n = Domain();
+	//
+	CPPAD_ASSERT_KNOWN(
+		size_t( x.size() ) == n,
+		"subgraph_hes: x.size() not equal domain dimension for f"
+	);
+	CPPAD_ASSERT_KNOWN(
+		size_t( w.size() ) == m,
+		"subgraph_hes: w.size() not equal range dimension for f"
+	);
+	CPPAD_ASSERT_KNOWN(
+		subset.nr() == n,
+		"subgraph_hes: subset.nr() not equal domain dimension for f"
+	);
+	CPPAD_ASSERT_KNOWN(
+		subset.nc() == n,
+		"subgraph_hes: subset.nc() not equal domain dimension for f"
+	);
+	//
+	// point at which we are evaluating Hessian
+	Forward(0, x);
+	//
+	// determine set of independent variables
+	size_t nnz = subset.nnz();
+	local::pod_vector<bool> select_domain(n);
+	for(size_t j = 0; j < n; j++)
+		select_domain[j] = false;
+	for(size_t k = 0; k < nnz; k++)
+	{	select_domain[ subset.row()[k] ] = true;
+		select_domain[ subset.col()[k] ] = true;
+	}
+	//
+	// call proper version of helper function
+	switch( play_.address_type() )
+	{
+		case local::play::unsigned_short_enum:
+		subgraph_hes_helper<unsigned short>(w, select_domain, subset);
+		break;
+
+		case local::play::unsigned_int_enum:
+		subgraph_hes_helper<unsigned int>(w, select_domain, subset);
+		break;
+
+		case local::play::size_t_enum:
+		subgraph_hes_helper<size_t>(w, select_domain, subset);
+		break;
+
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+	}
+	return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
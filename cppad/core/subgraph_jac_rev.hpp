@@ -27,15 +27,16 @@ $spell
 	const
 	Bool
 	nnz
+	std
 $$
 
 $section Compute Sparse Jacobians Using Subgraphs$$
 
 $head Syntax$$
-$icode%f%.subgraph_jac_rev(%x%, %subset%)
+$icode%f%.subgraph_jac_rev(%x%, %subset%, %n_thread%)
 %$$
 $icode%f%.subgraph_jac_rev(
-	%select_domain%, %select_range%, %x%, %matrix_out%
+	%select_domain%, %select_range%, %x%, %matrix_out%, %n_thread%
 )%$$
 
 $head See Also$$
@@ -158,6 +159,24 @@ $codei%
 It follows that the partial of $latex F_i (x)$$ with respect to
 $latex x_j$$ is equal to $latex v$$.
 
+$head n_thread$$
+This optional argument has prototype
+$codei%
+	size_t %n_thread%
+%$$
+and its default value is one.
+If it is greater than one, and C++11 is available,
+up to $icode n_thread$$ standard threads are used to compute the subgraphs
+and corresponding reverse sweeps; i.e.,
+different dependent variables are processed at the same time.
+The recording and zero order Taylor coefficients in $icode f$$
+are shared by the threads and each thread has its own
+subgraph work space and partial derivatives.
+The threads are created and destroyed during the call to
+$code subgraph_jac_rev$$ and use $cref thread_alloc$$ in parallel mode.
+The values computed are the same as when $icode n_thread$$ is one.
+A single thread is used for the same reasons as in
+$cref/sparse_jac/sparse_jac/n_thread/$$.
 
 $head Example$$
 $children%
@@ -173,9 +192,109 @@ $end
 */
 # include <cppad/core/ad_fun.hpp>
 # include <cppad/local/subgraph/info.hpp>
+# include <cppad/local/subgraph/reverse.hpp>
+# include <cppad/local/color_sweep.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 
+/*!
+Compute first order subgraph reverse mode derivatives using multiple threads.
+
+\tparam Base
+is the base type for this recording.
+
+\param dep_index
+is the set of dependent variables that are differentiated.
+
+\param n_thread
+is the number of threads and must be less than or equal
+<code>local::run_threads_alloc_number(n_thread)</code>.
+
+\param col_out
+this vector must have the same size as dep_index and
+its input elements do not matter.
+Upon return, col_out[r] is the sorted set of independent variables
+that the dependent variable dep_index[r] depends on.
+
+\param val_out
+this vector must have the same size as dep_index and
+its input elements do not matter.
+Upon return, val_out[r][c] is the partial of dependent variable
+dep_index[r] w.r.t. independent variable col_out[r][c].
+
+\par Assumptions
+The zero order Taylor coefficients correspond to the point at which
+the derivative is evaluated and subgraph_reverse(select_domain)
+has been called.
+*/
+template <typename Base>
+void ADFun<Base>::subgraph_jac_rev_thread(
+	const local::pod_vector<size_t>&     dep_index ,
+	size_t                               n_thread  ,
+	std::vector< std::vector<size_t> >&  col_out   ,
+	std::vector< std::vector<Base> >&    val_out   )
+{	CPPAD_ASSERT_UNKNOWN( n_thread <= local::run_threads_alloc_number(n_thread) );
+	CPPAD_ASSERT_UNKNOWN( num_order_taylor_ >= 1 );
+	CPPAD_ASSERT_UNKNOWN( num_direction_taylor_ == 1 );
+	CPPAD_ASSERT_UNKNOWN(
+		subgraph_info_.in_subgraph().size() == play_.num_op_rec()
+	);
+	//
+	// Base static values must be initialized before parallel mode
+	parallel_ad<Base>();
+	//
+	switch( play_.address_type() )
+	{
+		case local::play::unsigned_short_enum:
+		{	play_.template setup_random<unsigned short>();
+			local::subgraph::jac_rev_thread<unsigned short, Base> fun(
+				&play_, subgraph_info_, ind_taddr_, dep_taddr_,
+				cap_order_taylor_, taylor_.data(), cskip_op_.data(), load_op_,
+				dep_index, n_thread, col_out, val_out
+			);
+			local::run_threads_alloc(n_thread, fun);
+		}
+		break;
+
+		case local::play::unsigned_int_enum:
+		{	play_.template setup_random<unsigned int>();
+			local::subgraph::jac_rev_thread<unsigned int, Base> fun(
+				&play_, subgraph_info_, ind_taddr_, dep_taddr_,
+				cap_order_taylor_, taylor_.data(), cskip_op_.data(), load_op_,
+				dep_index, n_thread, col_out, val_out
+			);
+			local::run_threads_alloc(n_thread, fun);
+		}
+		break;
+
+		case local::play::size_t_enum:
+		{	play_.template setup_random<size_t>();
+			local::subgraph::jac_rev_thread<size_t, Base> fun(
+				&play_, subgraph_info_, ind_taddr_, dep_taddr_,
+				cap_order_taylor_, taylor_.data(), cskip_op_.data(), load_op_,
+				dep_index, n_thread, col_out, val_out
+			);
+			local::run_threads_alloc(n_thread, fun);
+		}
+		break;
+
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+	}
+	//
+# ifndef NDEBUG
+	if( check_for_nan_ )
+	{	for(size_t r = 0; r < val_out.size(); ++r)
+		{	CPPAD_ASSERT_KNOWN( ! hasnan( val_out[r] ),
+				"f.subgraph_jac_rev: result has a nan,\n"
+				"but none of f's Taylor coefficents are nan."
+			);
+		}
+	}
+# endif
+	return;
+}
+
 /*!
 Subgraph sparsity patterns.
 
@@ -197,13 +316,19 @@ a vector of length n, the number of independent variables in f
 specifices the subset of the sparsity pattern where the Jacobian is evaluated.
 subset.nr() == m,
 subset.nc() == n.
+
+\param n_thread
+is the maximum number of threads used to compute the subgraphs
+and the corresponding reverse sweeps.
 */
 template <typename Base>
 template <typename SizeVector, typename BaseVector>
 void ADFun<Base>::subgraph_jac_rev(
-	const BaseVector&                   x      ,
-	sparse_rcv<SizeVector, BaseVector>& subset )
-{	size_t m = Range();
+	const BaseVector&                   x        ,
+	sparse_rcv<SizeVector, BaseVector>& subset   ,
+	size_t                              n_thread )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t m = Range();
 	size_t n = Domain();
 	//
 	CPPAD_ASSERT_KNOWN(
@@ -234,42 +359,61 @@ void ADFun<Base>::subgraph_jac_rev(
 	// initialize reverse mode computation on subgraphs
 	subgraph_reverse(select_domain);
 	//
-	// memory used to hold subgraph_reverse results
-	BaseVector dw;
-	SizeVector dw_col;
+	// dependent variables that appear in subset (in increasing order)
+	local::pod_vector<size_t> dep_index;
+	for(size_t k = 0; k < nnz; k++)
+	{	size_t i_dep = row[ row_major[k] ];
+		if( k == 0 || i_dep != dep_index[ dep_index.size() - 1 ] )
+			dep_index.push_back(i_dep);
+	}
+	std::vector< std::vector<size_t> > col_out( dep_index.size() );
+	std::vector< std::vector<Base> >   val_out( dep_index.size() );
 	//
-	// initialize index in row_major
-	size_t k = 0;
-	Base zero(0);
-	while(k < nnz )
-	{	size_t q   = 1;
-		size_t i_dep = row[ row_major[k] ];
-		size_t i_ind = col[ row_major[k] ];
-		size_t ell   = i_dep;
-		subgraph_reverse(q, ell, dw_col, dw);
-		//
-		size_t c = 0;
-		while( i_dep == ell )
-		{	// check that subgraph_reverse has retured this value
-			if( c < size_t( dw_col.size() ) )
-			{	if( i_ind == dw_col[c++] )
-					subset.set( row_major[k], dw[i_ind] );
-				else
-					subset.set( row_major[k], zero);
+	// check for case where the subgraphs are processed using multiple threads
+	// (atomic functions in the recording need not be thread safe)
+	n_thread = local::run_threads_alloc_number(n_thread);
+	bool parallel = n_thread > 1 && AD<Base>::tape_ptr() == CPPAD_NULL;
+	if( parallel )
+		parallel = local::color_sweep_ok(play_);
+	if( parallel )
+		subgraph_jac_rev_thread(dep_index, n_thread, col_out, val_out);
+	else
+	{	// memory used to hold subgraph_reverse results
+		BaseVector dw;
+		SizeVector dw_col;
+		for(size_t r = 0; r < dep_index.size(); ++r)
+		{	size_t q   = 1;
+			size_t ell = dep_index[r];
+			subgraph_reverse(q, ell, dw_col, dw);
+			//
+			size_t col_size = size_t( dw_col.size() );
+			col_out[r].resize(col_size);
+			val_out[r].resize(col_size);
+			for(size_t c = 0; c < col_size; ++c)
+			{	col_out[r][c] = dw_col[c];
+				val_out[r][c] = dw[ dw_col[c] ];
 			}
+		}
+	}
+	//
+	// store results in subset
+	// (col_out[r] and the columns for each row in row_major are sorted)
+	Base zero(0);
+	size_t k = 0;
+	for(size_t r = 0; r < dep_index.size(); ++r)
+	{	size_t c = 0;
+		while( k < nnz && row[ row_major[k] ] == dep_index[r] )
+		{	size_t j = col[ row_major[k] ];
+			while( c < col_out[r].size() && col_out[r][c] < j )
+				++c;
+			if( c < col_out[r].size() && col_out[r][c] == j )
+				subset.set( row_major[k], val_out[r][c] );
 			else
-				subset.set( row_major[k], zero);
+				subset.set( row_major[k], zero );
 			++k;
-			if( k == nnz )
-			{	i_dep = m;
-				i_ind = n;
-			}
-			else
-			{	i_dep = row[ row_major[k] ];
-				i_ind = col[ row_major[k] ];
-			}
 		}
 	}
+	CPPAD_ASSERT_UNKNOWN( k == nnz );
 	return;
 }
 template <typename Base>
@@ -278,63 +422,75 @@ void ADFun<Base>::subgraph_jac_rev(
 	const BoolVector&                   select_domain  ,
 	const BoolVector&                   select_range   ,
 	const BaseVector&                   x              ,
-	sparse_rcv<SizeVector, BaseVector>& matrix_out     )
-{	size_t m = Range();
+	sparse_rcv<SizeVector, BaseVector>& matrix_out     ,
+	size_t                              n_thread       )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	size_t m = Range();
 	size_t n = Domain();
 	//
 	// point at which we are evaluating Jacobian
 	Forward(0, x);
 	//
-	// nnz and row, column, and row_major vectors for subset
-	local::pod_vector<size_t> row_out;
-	local::pod_vector<size_t> col_out;
-	local::pod_vector_maybe<Base>   val_out;
-	//
 	// initialize reverse mode computation on subgraphs
 	subgraph_reverse(select_domain);
 	//
-	// memory used to hold subgraph_reverse results
-	BaseVector dw;
-	SizeVector col;
-	//
-	// loop through selected independent variables
+	// selected dependent variables
+	local::pod_vector<size_t> dep_index;
 	for(size_t i = 0; i < m; ++i) if( select_range[i] )
-	{	// compute Jacobian and sparsity for this dependent variable
-		size_t q   = 1;
-		subgraph_reverse(q, i, col, dw);
-		CPPAD_ASSERT_UNKNOWN( size_t( dw.size() ) == n );
-		//
-		// offset for this dependent variable
-		size_t index = row_out.size();
-		CPPAD_ASSERT_UNKNOWN( col_out.size() == index );
-		CPPAD_ASSERT_UNKNOWN( val_out.size() == index );
-		//
-		// extend vectors to hold results for this dependent variable
-		size_t col_size = size_t( col.size() );
-		row_out.extend( col_size );
-		col_out.extend( col_size );
-		val_out.extend( col_size );
+		dep_index.push_back(i);
+	std::vector< std::vector<size_t> > col_out( dep_index.size() );
+	std::vector< std::vector<Base> >   val_out( dep_index.size() );
+	//
+	// check for case where the subgraphs are processed using multiple threads
+	// (atomic functions in the recording need not be thread safe)
+	n_thread = local::run_threads_alloc_number(n_thread);
+	bool parallel = n_thread > 1 && AD<Base>::tape_ptr() == CPPAD_NULL;
+	if( parallel )
+		parallel = local::color_sweep_ok(play_);
+	if( parallel )
+		subgraph_jac_rev_thread(dep_index, n_thread, col_out, val_out);
+	else
+	{	// memory used to hold subgraph_reverse results
+		BaseVector dw;
+		SizeVector col;
 		//
-		// store results for this dependent variable
-		for(size_t c = 0; c < col_size; ++c)
-		{	row_out[index + c] = i;
-			col_out[index + c] = col[c];
-			val_out[index + c] = dw[ col[c] ];
+		// loop through selected dependent variables
+		for(size_t r = 0; r < dep_index.size(); ++r)
+		{	// compute Jacobian and sparsity for this dependent variable
+			size_t q   = 1;
+			subgraph_reverse(q, dep_index[r], col, dw);
+			CPPAD_ASSERT_UNKNOWN( size_t( dw.size() ) == n );
+			//
+			size_t col_size = size_t( col.size() );
+			col_out[r].resize(col_size);
+			val_out[r].resize(col_size);
+			for(size_t c = 0; c < col_size; ++c)
+			{	col_out[r][c] = col[c];
+				val_out[r][c] = dw[ col[c] ];
+			}
 		}
 	}
 	//
-	// create sparsity pattern corresponding to row_out, col_out
+	// create sparsity pattern corresponding to col_out
 	size_t nr  = m;
 	size_t nc  = n;
-	size_t nnz = row_out.size();
+	size_t nnz = 0;
+	for(size_t r = 0; r < dep_index.size(); ++r)
+		nnz += col_out[r].size();
 	sparse_rc<SizeVector> pattern(nr, nc, nnz);
-	for(size_t k = 0; k < nnz; ++k)
-		pattern.set(k, row_out[k], col_out[k]);
+	size_t k = 0;
+	for(size_t r = 0; r < dep_index.size(); ++r)
+	{	for(size_t c = 0; c < col_out[r].size(); ++c)
+			pattern.set(k++, dep_index[r], col_out[r][c]);
+	}
 	//
 	// create sparse matrix
 	sparse_rcv<SizeVector, BaseVector> matrix(pattern);
-	for(size_t k = 0; k < nnz; ++k)
-		matrix.set(k,  val_out[k]);
+	k = 0;
+	for(size_t r = 0; r < dep_index.size(); ++r)
+	{	for(size_t c = 0; c < col_out[r].size(); ++c)
+			matrix.set(k++, val_out[r][c]);
+	}
 	//
 	// return matrix
 	matrix_out = matrix;
@@ -154,6 +154,8 @@ It returns true if it succeeds and false otherwise.
 
 $end
 */
+# include <cppad/local/subgraph/reverse.hpp>
+
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
 \file subgraph_reverse.hpp
@@ -331,119 +333,27 @@ void ADFun<Base>::subgraph_reverse_helper(
 
 	// subgraph of operators connected to dependent variable ell
 	pod_vector<addr_t> subgraph;
-	subgraph_info_.get_rev(
-		random_itr, dep_taddr_, addr_t(ell), subgraph
-	);
-
-	// Add all the atomic function call operators
-	// for calls that have first operator in the subgraph
-	local::subgraph::entire_call(random_itr, subgraph);
-
-	// First add the BeginOp and EndOp to the subgraph and then sort it
-	// sort the subgraph
-	addr_t i_op_begin_op = 0;
-	addr_t i_op_end_op   = addr_t( play_.num_op_rec() - 1);
-	subgraph.push_back(i_op_begin_op);
-	subgraph.push_back(i_op_end_op);
-	std::sort( subgraph.data(), subgraph.data() + subgraph.size() );
-	CPPAD_ASSERT_UNKNOWN( subgraph[0] == i_op_begin_op );
-	CPPAD_ASSERT_UNKNOWN( subgraph[subgraph.size()-1] == i_op_end_op );
-	/*
-	// Use this printout for debugging
-	std::cout << "{ ";
-	for(size_t k = 0; k < subgraph.size(); k++)
-	{	if( k > 0 )
-			std::cout << ", ";
-		std::cout << subgraph[k];
-	}
-	std::cout << "}\n";
-	*/
-
-	// initialize subgraph_partial_ matrix to zero on subgraph
-	Base zero(0);
-	subgraph_partial_.resize(num_var_tape_ * q);
-	for(size_t k = 0; k < subgraph.size(); ++k)
-	{
-		size_t               i_op = size_t( subgraph[k] );
-		local::OpCode        op;
-		const addr_t*        arg;
-		size_t               i_var;
-		random_itr.op_info(i_op, op, arg, i_var);
-		if( NumRes(op) == 0 )
-		{	CPPAD_ASSERT_UNKNOWN(
-				op == local::UserOp  ||
-				op == local::UsrapOp ||
-				op == local::UsravOp ||
-				op == local::UsrrpOp ||
-				op == local::EndOp
-			);
-		}
-		else if( op != local::BeginOp )
-		{	CPPAD_ASSERT_UNKNOWN( i_var >= NumRes(op) );
-			size_t j_var = i_var + 1 - NumRes(op);
-			for(size_t i = j_var; i <= i_var; ++i)
-			{	for(size_t j = 0; j < q; ++j)
-					subgraph_partial_[i * q + j] = zero;
-			}
-		}
-	}
-
-	// set partial to one for component we are differentiating
-	subgraph_partial_[ dep_taddr_[ell] * q + q - 1] = Base(1);
 
 	// evaluate the derivatives
 	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
 	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
-	size_t n = Domain();
-	//
-	local::play::const_subgraph_iterator<Addr> subgraph_itr =
-		play_.end_subgraph(random_itr, &subgraph);
-	//
-	local::sweep::reverse(
-		q - 1,
-		n,
-		num_var_tape_,
+	local::subgraph::reverse_dep(
 		&play_,
+		random_itr,
+		subgraph_info_,
+		ind_taddr_,
+		dep_taddr_,
 		cap_order_taylor_,
 		taylor_.data(),
-		q,
-		subgraph_partial_.data(),
 		cskip_op_.data(),
 		load_op_,
-		subgraph_itr
+		q,
+		ell,
+		subgraph,
+		subgraph_partial_,
+		col,
+		dw
 	);
-
-	// number of non-zero in return value
-	size_t col_size       = 0;
-	size_t subgraph_index = 0;
-	CPPAD_ASSERT_UNKNOWN( subgraph[subgraph_index] == 0 );
-	// Skip BeginOp
-	++subgraph_index;
-	while( subgraph_index < subgraph.size() )
-	{	// check for InvOp
-		if( subgraph[subgraph_index] > addr_t(n) )
-			subgraph_index = subgraph.size();
-		else
-		{	++col_size;
-			++subgraph_index;
-		}
-	}
-	col.resize(col_size);
-
-	// return the derivative values
-	dw.resize(n * q);
-	for(size_t c = 0; c < col_size; ++c)
-	{	size_t i_op = subgraph[c + 1];
-		CPPAD_ASSERT_UNKNOWN( play_.GetOp(i_op) == local::InvOp );
-		//
-		size_t j = i_op - 1;
-		CPPAD_ASSERT_UNKNOWN( i_op == random_itr.var2op( ind_taddr_[j] ) );
-		//
-		// return paritial for this independent variable
-		col[c] = j;
-		for(size_t k = 0; k < q; k++)
-			dw[j * q + k ] = subgraph_partial_[ind_taddr_[j] * q + k];
-	}
 	//
 	CPPAD_ASSERT_KNOWN( ! ( hasnan(dw) && check_for_nan_ ) ,
 		"f.subgraph_reverse(dw, q, ell): dw has a nan,\n"
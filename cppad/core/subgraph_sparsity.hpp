@@ -26,7 +26,7 @@ $section Subgraph Dependency Sparsity Patterns$$
 
 $head Syntax$$
 $icode%f%.subgraph_sparsity(
-	%select_domain%, %select_range%, %transpose%, %pattern_out%
+	%select_domain%, %select_range%, %transpose%, %pattern_out%, %n_thread%
 )%$$
 
 $head See Also$$
@@ -122,6 +122,25 @@ $latex \[
 where $latex D$$ ($latex R$$) is the diagonal matrix corresponding
 to $icode select_domain$$ ($icode select_range$$).
 
+$head n_thread$$
+This optional argument has prototype
+$codei%
+	size_t %n_thread%
+%$$
+and its default value is one.
+If it is greater than one, and C++11 is available,
+up to $icode n_thread$$ standard threads are used to compute the subgraphs;
+i.e., different dependent variables are processed at the same time.
+The recording in $icode f$$ is shared by the threads and each thread has
+its own subgraph work space.
+The threads are created and destroyed during the call to
+$code subgraph_sparsity$$ and use $cref thread_alloc$$ in parallel mode.
+The pattern computed is the same as when $icode n_thread$$ is one.
+A single thread is used (and $icode n_thread$$ is ignored) if
+the user has already set up $code thread_alloc$$ for
+parallel execution, or
+a recording for $codei%AD<%Base%>%$$ is in progress.
+
 $head Example$$
 $children%
 	example/sparse/subgraph_sparsity.cpp
@@ -165,6 +184,9 @@ The return value is a dependency sparsity pattern for  \f$ R F^{(1)} (x) D \f$
 where F is the function corresponding to the operation sequence
 and x is any argument value.
 is the sparsity pattern transposed.
+
+\param n_thread
+is the maximum number of threads used to compute the subgraphs.
 */
 template <typename Base>
 template <typename BoolVector, typename SizeVector>
@@ -172,8 +194,14 @@ void ADFun<Base>::subgraph_sparsity(
 	const BoolVector&            select_domain    ,
 	const BoolVector&            select_range     ,
 	bool                         transpose        ,
-	sparse_rc<SizeVector>&       pattern_out      )
-{
+	sparse_rc<SizeVector>&       pattern_out      ,
+	size_t                       n_thread         )
+{	thread_alloc::tag_scope scope(thread_alloc::sparsity_tag);
+	// check for case where multiple threads are used
+	n_thread = local::run_threads_alloc_number(n_thread);
+	if( AD<Base>::tape_ptr() != CPPAD_NULL )
+		n_thread = 1;
+
 	// compute the sparsity pattern in row, col
     local::pod_vector<size_t> row;
     local::pod_vector<size_t> col;
@@ -189,7 +217,8 @@ void ADFun<Base>::subgraph_sparsity(
 			select_domain,
 			select_range,
 			row,
-			col
+			col,
+			n_thread
 		);
 		break;
 
@@ -201,7 +230,8 @@ void ADFun<Base>::subgraph_sparsity(
 			select_domain,
 			select_range,
 			row,
-			col
+			col,
+			n_thread
 		);
 		break;
 
@@ -213,7 +243,8 @@ void ADFun<Base>::subgraph_sparsity(
 			select_domain,
 			select_range,
 			row,
-			col
+			col,
+			n_thread
 		);
 		break;
 
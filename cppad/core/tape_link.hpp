@@ -233,6 +233,25 @@ local::ADTape<Base>*  AD<Base>::tape_manage(tape_manage_job job)
 	return *tape_h;
 }
 
+/*!
+Delete the tape (if any) that was left by a thread that exited.
+
+\tparam Base
+is the base type corresponding to AD<Base> operations.
+
+\param thread
+is a thread number that was released by a thread that exited
+and is being given to the current thread (see thread_alloc::parallel_setup).
+If there is a tape for this thread number, it is deleted and
+<tt>*tape_id_ptr(thread)</tt> is advanced by \c CPPAD_MAX_NUM_THREADS.
+*/
+template <class Base>
+void AD<Base>::tape_reset(size_t thread)
+{	CPPAD_ASSERT_UNKNOWN( thread == thread_alloc::thread_num() );
+	if( *tape_handle(thread) != CPPAD_NULL )
+		tape_manage(tape_manage_delete);
+}
+
 /*!
 Get a pointer to tape that records AD<Base> operations for the current thread.
 
@@ -66,6 +66,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/core/lu_ratio.hpp>
 # include <cppad/core/bender_quad.hpp>
 # include <cppad/core/opt_val_hes.hpp>
+# include <cppad/core/multi_start_newton.hpp>
 
 // undo definitions in Define.h
 # include <cppad/core/undef.hpp>
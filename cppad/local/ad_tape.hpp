@@ -102,6 +102,8 @@ private:
 	/// Number of independent variables in this tapes reconding.
 	/// Set by Independent and effectively const
 	size_t         size_independent_;
+	/// thread_alloc tag before this tape was created (restored by destructor)
+	thread_alloc::tag_enum       old_tag_;
 	/// This is where the information is recorded.
 	local::recorder<Base>              Rec_;
 	// ----------------------------------------------------------------------
@@ -127,6 +129,16 @@ private:
 	);
 
 public:
+	/// memory used while this tape exists is attributed to recorder_tag
+	ADTape(void)
+	: id_(0)
+	, size_independent_(0)
+	, old_tag_( thread_alloc::set_tag(thread_alloc::recorder_tag) )
+	{ }
+	/// restore the thread_alloc tag
+	~ADTape(void)
+	{	thread_alloc::set_tag(old_tag_); }
+
 	// public function only used by CppAD::Independent
 	template <typename VectorADBase>
 	void Independent(
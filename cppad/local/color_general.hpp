@@ -14,6 +14,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 
 # include <cppad/configure.hpp>
 # include <cppad/local/cppad_colpack.hpp>
+# include <cppad/local/run_threads.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -199,6 +200,489 @@ void color_general_cppad(
 	return;
 }
 
+// --------------------------------------------------------------------------
+/*!
+Work done by each thread during color_general_parallel.
+
+The same threads are used for all of the rounds.
+All of the vectors are allocated by the thread that calls
+color_general_parallel. The threads only read and write elements of the
+vectors, and resize them to smaller sizes; i.e., they do not allocate memory.
+*/
+class color_general_parallel_team {
+public:
+	/// number of threads
+	const size_t                 n_thread;
+	/// number of rows in the sparsity pattern
+	const size_t                 m;
+	/// number of stamps for each thread (an upper bound for the colors)
+	const size_t                 n_stamp;
+	/// pattern (i, j): pat_col[ pat_start[i] ... pat_start[i+1]-1 ]
+	const CppAD::vector<size_t>& pat_start;
+	/// column indices corresponding to pat_start
+	const CppAD::vector<size_t>& pat_col;
+	/// appear (r, j): c2r_row[ c2r_start[j] ... c2r_start[j+1]-1 ]
+	const CppAD::vector<size_t>& c2r_start;
+	/// row indices corresponding to c2r_start
+	const CppAD::vector<size_t>& c2r_row;
+	/// appear (i, j): r2c_col[ r2c_start[i] ... r2c_start[i+1]-1 ]
+	const CppAD::vector<size_t>& r2c_start;
+	/// column indices corresponding to r2c_start
+	const CppAD::vector<size_t>& r2c_col;
+	/// pattern but not appear (r, j): na_row[ na_start[j] ... ]
+	const CppAD::vector<size_t>& na_start;
+	/// row indices corresponding to na_start
+	const CppAD::vector<size_t>& na_row;
+	/// rows that are colored during the current round
+	CppAD::vector<size_t>&       work;
+	/// owner[r] is the thread that colors row r during the current round
+	CppAD::vector<size_t>&       owner;
+	/// colors determined during previous rounds (m if not yet determined)
+	CppAD::vector<size_t>&       color;
+	/// colors determined by this round (only valid for rows in work)
+	CppAD::vector<size_t>&       tentative;
+	/// forbidden[thread * n_stamp + ell] is stamp for when ell was
+	/// last forbidden by thread
+	CppAD::vector<size_t>&       forbidden;
+	/// conflict[k] is true if work[k] must be colored again
+	CppAD::vector<bool>&         conflict;
+	/// used to synchronize the threads between the phases of a round
+	run_threads_barrier&         barrier;
+	/// stamps used by the current round are greater than stamp_offset
+	/// (stamps are never reused, so forbidden need not be cleared)
+	size_t&                      stamp_offset;
+	//
+	/// constructor
+	color_general_parallel_team(
+		size_t                       n_thread_     ,
+		size_t                       m_            ,
+		size_t                       n_stamp_      ,
+		const CppAD::vector<size_t>& pat_start_    ,
+		const CppAD::vector<size_t>& pat_col_      ,
+		const CppAD::vector<size_t>& c2r_start_    ,
+		const CppAD::vector<size_t>& c2r_row_      ,
+		const CppAD::vector<size_t>& r2c_start_    ,
+		const CppAD::vector<size_t>& r2c_col_      ,
+		const CppAD::vector<size_t>& na_start_     ,
+		const CppAD::vector<size_t>& na_row_       ,
+		CppAD::vector<size_t>&       work_         ,
+		CppAD::vector<size_t>&       owner_        ,
+		CppAD::vector<size_t>&       color_        ,
+		CppAD::vector<size_t>&       tentative_    ,
+		CppAD::vector<size_t>&       forbidden_    ,
+		CppAD::vector<bool>&         conflict_     ,
+		run_threads_barrier&         barrier_      ,
+		size_t&                      stamp_offset_ )
+	: n_thread(n_thread_)
+	, m(m_)
+	, n_stamp(n_stamp_)
+	, pat_start(pat_start_)
+	, pat_col(pat_col_)
+	, c2r_start(c2r_start_)
+	, c2r_row(c2r_row_)
+	, r2c_start(r2c_start_)
+	, r2c_col(r2c_col_)
+	, na_start(na_start_)
+	, na_row(na_row_)
+	, work(work_)
+	, owner(owner_)
+	, color(color_)
+	, tentative(tentative_)
+	, forbidden(forbidden_)
+	, conflict(conflict_)
+	, barrier(barrier_)
+	, stamp_offset(stamp_offset_)
+	{ }
+	/*!
+	Color of row r as seen by row i during this round.
+
+	\param phase [in]
+	is zero for speculative coloring and one for conflict detection.
+
+	\param thread [in]
+	is the thread that is coloring row i.
+
+	\param i [in]
+	is the row we are coloring or checking.
+
+	\param r [in]
+	is a row that conflicts with row i if they have the same color.
+
+	\return
+	During phase zero, this is the color for row r determined by a previous
+	round, or by this thread earlier during this round.
+	During phase one, this is the color determined for row r by a
+	different thread during this round and is only returned when r < i.
+	Otherwise, the return value is m.
+	*/
+	size_t other_color(size_t phase, size_t thread, size_t i, size_t r) const
+	{	if( r == i )
+			return m;
+		if( phase == 0 )
+		{	if( color[r] < m )
+				return color[r];
+			if( owner[r] == thread )
+				return tentative[r];
+			return m;
+		}
+		if( owner[r] < n_thread && owner[r] != thread && r < i )
+			return tentative[r];
+		return m;
+	}
+	/*!
+	Index range in work that corresponds to a thread.
+
+	\param thread [in]
+	is the thread.
+
+	\param begin [out]
+	is the first index in work for this thread.
+
+	\param end [out]
+	is one greater than the last index in work for this thread.
+	*/
+	void work_range(size_t thread, size_t& begin, size_t& end) const
+	{	size_t n_work = work.size();
+		begin = (thread * n_work) / n_thread;
+		end   = ((thread + 1) * n_work) / n_thread;
+	}
+	/*!
+	Set the owner and tentative color for the rows in work.
+	This is done by one thread at the beginning of each round.
+	*/
+	void start_round(void) const
+	{	for(size_t thread = 0; thread < n_thread; thread++)
+		{	size_t begin, end;
+			work_range(thread, begin, end);
+			for(size_t k = begin; k < end; k++)
+			{	owner[ work[k] ]     = thread;
+				tentative[ work[k] ] = m;
+			}
+		}
+		conflict.resize( work.size() );
+	}
+	/*!
+	Accept the colors that do not conflict and set up the next round
+	for the rows that do.
+	This is done by one thread at the end of each round.
+	*/
+	void end_round(void) const
+	{	size_t n_work     = work.size();
+		size_t n_conflict = 0;
+		for(size_t k = 0; k < n_work; k++)
+		{	size_t i = work[k];
+			owner[i] = n_thread;
+			if( conflict[k] )
+				work[n_conflict++] = i;
+			else
+				color[i] = tentative[i];
+		}
+		CPPAD_ASSERT_UNKNOWN( n_conflict < n_work );
+		work.resize(n_conflict);
+		// the stamps used by this round are stamp_offset + k + 1
+		stamp_offset += n_work;
+		start_round();
+	}
+	/*!
+	One phase of a round for one thread.
+
+	\param phase [in]
+	is zero for speculative coloring and one for conflict detection.
+
+	\param thread [in]
+	is the thread (between zero and n_thread - 1).
+	*/
+	void color_phase(size_t phase, size_t thread) const
+	{	size_t begin, end;
+		work_range(thread, begin, end);
+		size_t* stamp_vec = forbidden.data() + thread * n_stamp;
+		//
+		for(size_t k = begin; k < end; ++k)
+		{	size_t i     = work[k];
+			// stamp that identifies this row and round
+			size_t stamp = stamp_offset + k + 1;
+			bool   found = false;
+			//
+			// for each column that is non-zero for this row
+			for(size_t p = pat_start[i]; p < pat_start[i+1]; ++p)
+			{	size_t j = pat_col[p];
+				// for each row that appears with this column
+				for(size_t q = c2r_start[j]; q < c2r_start[j+1]; ++q)
+				{	size_t ell = other_color(phase, thread, i, c2r_row[q]);
+					if( ell < m )
+					{	CPPAD_ASSERT_UNKNOWN( ell < n_stamp );
+						if( phase == 0 )
+							stamp_vec[ell] = stamp;
+						else
+							found |= ell == tentative[i];
+					}
+				}
+			}
+			// for each column that appears with this row
+			for(size_t p = r2c_start[i]; p < r2c_start[i+1]; ++p)
+			{	size_t j = r2c_col[p];
+				// for each row that is non-zero for this column and
+				// does not appear with this column
+				for(size_t q = na_start[j]; q < na_start[j+1]; ++q)
+				{	size_t ell = other_color(phase, thread, i, na_row[q]);
+					if( ell < m )
+					{	CPPAD_ASSERT_UNKNOWN( ell < n_stamp );
+						if( phase == 0 )
+							stamp_vec[ell] = stamp;
+						else
+							found |= ell == tentative[i];
+					}
+				}
+			}
+			if( phase == 0 )
+			{	// pick the color with smallest index
+				size_t ell = 0;
+				while( stamp_vec[ell] == stamp )
+				{	ell++;
+					CPPAD_ASSERT_UNKNOWN( ell < n_stamp );
+				}
+				tentative[i] = ell;
+			}
+			else
+				conflict[k] = found;
+		}
+	}
+	/*!
+	All of the rounds for one thread.
+
+	\param thread [in]
+	is the thread (between zero and n_thread - 1).
+	*/
+	void operator()(size_t thread) const
+	{	while( work.size() > 0 )
+		{	// speculative coloring
+			color_phase(0, thread);
+			barrier.wait();
+			//
+			// conflict detection
+			color_phase(1, thread);
+			barrier.wait();
+			//
+			// accept colors that do not conflict, rows that do are done again
+			if( thread == 0 )
+				end_round();
+			barrier.wait();
+		}
+	}
+};
+// --------------------------------------------------------------------------
+/*!
+Parallel version of the general coloring algorithm.
+
+This uses speculative coloring with conflict resolution; see
+A. H. Gebremedhin and F. Manne,
+Scalable parallel graph coloring algorithms,
+Concurrency: Practice and Experience 12 (2000).
+During each round, the rows that do not yet have a color are split into
+contiguous blocks, one for each thread, and each thread colors its block
+with the greedy algorithm (ignoring the colors chosen by other threads
+during this round). Then each thread checks its rows for conflicts with
+rows colored by the other threads during the round.
+If there is a conflict, the row with the larger index is colored again
+during the next round.
+The same threads are used for all the rounds
+(they wait at a barrier between the phases of a round).
+The result only depends on the number of threads, not on their timing.
+
+\copydetails color_general_cppad
+
+\param n_thread [in]
+is the number of threads to use for the coloring.
+If <code>n_thread == 1</code>, or C++11 is not available,
+no extra threads are created.
+*/
+template <class VectorSet, class VectorSize>
+void color_general_parallel(
+	const VectorSet&        pattern  ,
+	const VectorSize&       row      ,
+	const VectorSize&       col      ,
+	CppAD::vector<size_t>&  color    ,
+	size_t                  n_thread )
+{	size_t K = row.size();
+	size_t m = pattern.n_set();
+	size_t n = pattern.end();
+
+	CPPAD_ASSERT_UNKNOWN( size_t( col.size() )   == K );
+	CPPAD_ASSERT_UNKNOWN( size_t( color.size() ) == m );
+	CPPAD_ASSERT_UNKNOWN( n_thread > 0 );
+
+	// The sets below are stored in compressed row (column) format so that
+	// the threads do not need to use iterators or allocate memory.
+
+	// pattern in compressed row format
+	CppAD::vector<size_t> pat_start(m + 1), pat_col;
+	pat_start[0] = 0;
+	for(size_t i = 0; i < m; i++)
+	{	typename VectorSet::const_iterator pattern_itr(pattern, i);
+		size_t j = *pattern_itr;
+		while( j != pattern.end() )
+		{	pat_col.push_back(j);
+			j = *(++pattern_itr);
+		}
+		pat_start[i+1] = pat_col.size();
+	}
+
+	// rows and columns that appear in compressed row format
+	// (duplicate pairs are removed)
+	CppAD::vector<size_t> r2c_start(m + 1), r2c_col(K), mark(n);
+	for(size_t i = 0; i <= m; i++)
+		r2c_start[i] = 0;
+	for(size_t k = 0; k < K; k++)
+	{	CPPAD_ASSERT_UNKNOWN( pattern.is_element(row[k], col[k]) );
+		r2c_start[ row[k] + 1 ]++;
+	}
+	for(size_t i = 0; i < m; i++)
+		r2c_start[i+1] += r2c_start[i];
+	CppAD::vector<size_t> next(m);
+	for(size_t i = 0; i < m; i++)
+		next[i] = r2c_start[i];
+	for(size_t k = 0; k < K; k++)
+		r2c_col[ next[ row[k] ]++ ] = col[k];
+	for(size_t j = 0; j < n; j++)
+		mark[j] = m;
+	size_t n_appear = 0;
+	for(size_t i = 0; i < m; i++)
+	{	size_t begin = r2c_start[i];
+		r2c_start[i] = n_appear;
+		for(size_t p = begin; p < r2c_start[i+1]; p++)
+		{	size_t j = r2c_col[p];
+			if( mark[j] != i )
+			{	mark[j]               = i;
+				r2c_col[n_appear++]   = j;
+			}
+		}
+	}
+	r2c_start[m] = n_appear;
+	r2c_col.resize(n_appear);
+
+	// columns and rows that appear in compressed column format
+	CppAD::vector<size_t> c2r_start(n + 1), c2r_row(n_appear);
+	for(size_t j = 0; j <= n; j++)
+		c2r_start[j] = 0;
+	for(size_t p = 0; p < n_appear; p++)
+		c2r_start[ r2c_col[p] + 1 ]++;
+	for(size_t j = 0; j < n; j++)
+		c2r_start[j+1] += c2r_start[j];
+	next.resize(n);
+	for(size_t j = 0; j < n; j++)
+		next[j] = c2r_start[j];
+	for(size_t i = 0; i < m; i++)
+	{	for(size_t p = r2c_start[i]; p < r2c_start[i+1]; p++)
+			c2r_row[ next[ r2c_col[p] ]++ ] = i;
+	}
+
+	// for each column, which rows are non-zero and do not appear
+	CppAD::vector<size_t> na_start(n + 1), na_row;
+	for(size_t j = 0; j < n; j++)
+		mark[j] = m;
+	for(size_t j = 0; j <= n; j++)
+		na_start[j] = 0;
+	for(size_t i = 0; i < m; i++)
+	{	for(size_t p = r2c_start[i]; p < r2c_start[i+1]; p++)
+			mark[ r2c_col[p] ] = i;
+		for(size_t p = pat_start[i]; p < pat_start[i+1]; p++)
+		{	if( mark[ pat_col[p] ] != i )
+				na_start[ pat_col[p] + 1 ]++;
+		}
+	}
+	for(size_t j = 0; j < n; j++)
+		na_start[j+1] += na_start[j];
+	na_row.resize( na_start[n] );
+	for(size_t j = 0; j < n; j++)
+	{	next[j] = na_start[j];
+		mark[j] = m;
+	}
+	for(size_t i = 0; i < m; i++)
+	{	for(size_t p = r2c_start[i]; p < r2c_start[i+1]; p++)
+			mark[ r2c_col[p] ] = i;
+		for(size_t p = pat_start[i]; p < pat_start[i+1]; p++)
+		{	size_t j = pat_col[p];
+			if( mark[j] != i )
+				na_row[ next[j]++ ] = i;
+		}
+	}
+
+	// rows that appear and still need to be colored
+	CppAD::vector<size_t> work;
+	for(size_t i = 0; i < m; i++)
+	{	color[i] = m;
+		if( r2c_start[i] < r2c_start[i+1] )
+			work.push_back(i);
+	}
+
+	// use fewer threads when there is very little work
+# if ! CPPAD_USE_CPLUSPLUS_2011
+	// run_threads would make all the calls using this thread
+	n_thread = 1;
+# endif
+	n_thread = std::min(n_thread, work.size());
+	if( n_thread == 0 )
+		return;
+
+	// The color chosen for a row is at most the number of rows that it
+	// conflicts with, so the stamps for each thread only need max_degree + 1
+	// elements (max_degree counts conflicting rows with multiplicity).
+	size_t max_degree = 0;
+	for(size_t k = 0; k < work.size(); k++)
+	{	size_t i      = work[k];
+		size_t degree = 0;
+		for(size_t p = pat_start[i]; p < pat_start[i+1]; p++)
+		{	size_t j = pat_col[p];
+			degree  += c2r_start[j+1] - c2r_start[j];
+		}
+		for(size_t p = r2c_start[i]; p < r2c_start[i+1]; p++)
+		{	size_t j = r2c_col[p];
+			degree  += na_start[j+1] - na_start[j];
+		}
+		max_degree = std::max(max_degree, degree);
+	}
+	size_t n_stamp = std::min(max_degree + 1, m);
+
+	// work space used by the threads
+	CppAD::vector<size_t> owner(m), tentative(m);
+	CppAD::vector<size_t> forbidden(n_thread * n_stamp);
+	CppAD::vector<bool>   conflict;
+	for(size_t i = 0; i < m; i++)
+	{	owner[i]     = n_thread;
+		tentative[i] = m;
+	}
+	for(size_t ell = 0; ell < n_thread * n_stamp; ell++)
+		forbidden[ell] = 0;
+	//
+	// one team of threads does all the rounds
+	run_threads_barrier barrier(n_thread);
+	size_t              stamp_offset = 0;
+	color_general_parallel_team team(
+		n_thread, m, n_stamp,
+		pat_start, pat_col, c2r_start, c2r_row,
+		r2c_start, r2c_col, na_start, na_row,
+		work, owner, color, tentative, forbidden, conflict,
+		barrier, stamp_offset
+	);
+	team.start_round();
+	run_threads(n_thread, team);
+	CPPAD_ASSERT_UNKNOWN( work.size() == 0 );
+	//
+	// A color chosen during a round may only have been used by rows that
+	// had conflicts, so remove colors that are not used.
+	CppAD::vector<size_t> new_color(m);
+	for(size_t ell = 0; ell < m; ell++)
+		new_color[ell] = m;
+	for(size_t i = 0; i < m; i++) if( color[i] < m )
+		new_color[ color[i] ] = 0;
+	size_t n_color = 0;
+	for(size_t ell = 0; ell < m; ell++) if( new_color[ell] == 0 )
+		new_color[ell] = n_color++;
+	for(size_t i = 0; i < m; i++) if( color[i] < m )
+		color[i] = new_color[ color[i] ];
+	return;
+}
+
 # if CPPAD_HAS_COLPACK
 /*!
 Colpack version of determining which rows of a sparse matrix
@@ -0,0 +1,406 @@
+# ifndef CPPAD_LOCAL_COLOR_SWEEP_HPP
+# define CPPAD_LOCAL_COLOR_SWEEP_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/run_threads.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/player.hpp>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/sparse_rcv.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file color_sweep.hpp
+Evaluate the sweeps for the colors of a sparse derivative using
+multiple threads.
+*/
+
+/// type of sweep that is used for each color
+enum color_sweep_mode {
+	/// first order forward, (sparse_jac_for)
+	color_sweep_jac_for,
+	/// first order reverse, (sparse_jac_rev)
+	color_sweep_jac_rev,
+	/// first order forward followed by second order reverse, (sparse_hes)
+	color_sweep_hes
+};
+
+/*!
+Can the sweeps for a recording be evaluated by multiple threads.
+
+\param play
+is the player for the recording.
+
+\return
+is false if the recording contains a call to an atomic function
+(atomic functions are not required to be thread safe).
+*/
+template <class Base>
+bool color_sweep_ok(const player<Base>& play)
+{	size_t num_op = play.num_op_rec();
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	if( play.GetOp(i_op) == UserOp )
+			return false;
+	}
+	return true;
+}
+
+/*!
+Function object that evaluates the sweeps corresponding to a subset of
+the colors for a sparse Jacobian or Hessian.
+
+\tparam Base
+is the base type for the recording.
+
+\tparam SizeVector
+is the simple vector type used for the subset row and column indices.
+
+\tparam BaseVector
+is the simple vector type used for the subset values and for w.
+
+\tparam IndexVector
+is the simple vector type for the row and column vectors that correspond to
+the subset (for sparse_hes these may be transposed from the subset).
+
+\par Thread Safety
+The zero order Taylor coefficients, the recording, and the color and order
+vectors are shared by all the threads (and not modified).
+Each thread has its own Taylor coefficient and partial derivative
+work space and a thread only writes to the subset elements that
+correspond to its colors.
+*/
+template <class Base, class SizeVector, class BaseVector, class IndexVector>
+class color_sweep {
+private:
+	/// type of sweep for each color
+	const color_sweep_mode                 mode_;
+	/// player for the recording
+	const player<Base>*                    play_;
+	/// number of independent variables
+	const size_t                           n_;
+	/// number of variables in the recording
+	const size_t                           num_var_;
+	/// order capacity for the Taylor coefficients in taylor_
+	const size_t                           cap_order_;
+	/// Taylor coefficients with zero order equal to the point for derivative
+	const Base*                            taylor_;
+	/// which operations can be skipped (not modified by the sweeps)
+	bool*                                  cskip_op_;
+	/// variable index corresponding to each load operation
+	const pod_vector<addr_t>&              load_op_;
+	/// variable index for each independent variable
+	const vector<size_t>&                  ind_taddr_;
+	/// variable index for each dependent variable
+	const vector<size_t>&                  dep_taddr_;
+	/// color for each column (jac_for and hes) or each row (jac_rev)
+	const vector<size_t>&                  color_;
+	/// indices that sort the subset elements by color
+	const vector<size_t>&                  order_;
+	/// row indices for the subset
+	const IndexVector&                     row_;
+	/// column indices for the subset
+	const IndexVector&                     col_;
+	/// range space weight vector (only used for hes)
+	const BaseVector*                      w_;
+	/// where the results are stored
+	sparse_rcv<SizeVector, BaseVector>&    subset_;
+	/// maximum number of colors in a group (only used for jac_for)
+	const size_t                           group_max_;
+	/// number of threads
+	const size_t                           n_thread_;
+	/// number of colors
+	size_t                                 n_color_;
+	/// color_start_[c] is first index in order_ that has color c
+	vector<size_t>                         color_start_;
+	// -----------------------------------------------------------------------
+	/// color for subset element with index k
+	size_t color_k(size_t k) const
+	{	if( mode_ == color_sweep_jac_rev )
+			return color_[ row_[k] ];
+		return color_[ col_[k] ];
+	}
+	/// evaluate the sweep for colors c_begin, ..., c_end-1 (jac_for)
+	void jac_for(
+		size_t c_begin, size_t c_end, pod_vector_maybe<Base>& taylor
+	) const
+	{	size_t r = c_end - c_begin;
+		taylor.resize( (r + 1) * num_var_ );
+		//
+		// zero order Taylor coefficients
+		for(size_t i = 0; i < num_var_; ++i)
+			taylor[ (r + 1) * i ] = taylor_[ cap_order_ * i ];
+		//
+		// first order for independent variables
+		for(size_t j = 0; j < n_; ++j)
+		{	for(size_t ell = 0; ell < r; ++ell)
+			{	size_t index = (r + 1) * ind_taddr_[j] + ell + 1;
+				if( color_[j] == c_begin + ell )
+					taylor[index] = Base(1.0);
+				else
+					taylor[index] = Base(0.0);
+			}
+		}
+		sweep::forward2(
+			play_, 1, r, n_, num_var_, 2, taylor.data(), cskip_op_, load_op_
+		);
+		//
+		// store results
+		for(size_t k = color_start_[c_begin]; k < color_start_[c_end]; ++k)
+		{	size_t ell   = color_k( order_[k] ) - c_begin;
+			size_t i     = row_[ order_[k] ];
+			size_t index = (r + 1) * dep_taddr_[i] + ell + 1;
+			subset_.set( order_[k], taylor[index] );
+		}
+	}
+	/// evaluate the sweep for color c (jac_rev)
+	void jac_rev(size_t c, pod_vector_maybe<Base>& partial) const
+	{	partial.resize(num_var_);
+		for(size_t i = 0; i < num_var_; ++i)
+			partial[i] = Base(0.0);
+		//
+		// use += because two dependent variables can have same index
+		for(size_t i = 0; i < dep_taddr_.size(); ++i)
+		{	if( color_[i] == c )
+				partial[ dep_taddr_[i] ] += Base(1.0);
+		}
+		play::const_sequential_iterator play_itr = play_->end();
+		sweep::reverse(
+			0,
+			n_,
+			num_var_,
+			play_,
+			cap_order_,
+			taylor_,
+			1,
+			partial.data(),
+			cskip_op_,
+			load_op_,
+			play_itr
+		);
+		//
+		// store results
+		for(size_t k = color_start_[c]; k < color_start_[c+1]; ++k)
+		{	size_t j = col_[ order_[k] ];
+			subset_.set( order_[k], partial[ ind_taddr_[j] ] );
+		}
+	}
+	/// evaluate the sweeps for color c (hes)
+	void hes(
+		size_t                  c       ,
+		pod_vector_maybe<Base>& taylor  ,
+		pod_vector_maybe<Base>& partial ) const
+	{	taylor.resize(2 * num_var_);
+		partial.resize(2 * num_var_);
+		for(size_t i = 0; i < num_var_; ++i)
+		{	taylor[2 * i]      = taylor_[ cap_order_ * i ];
+			partial[2 * i]     = Base(0.0);
+			partial[2 * i + 1] = Base(0.0);
+		}
+		//
+		// first order forward in direction for this color
+		for(size_t j = 0; j < n_; ++j)
+		{	if( color_[j] == c )
+				taylor[ 2 * ind_taddr_[j] + 1 ] = Base(1.0);
+			else
+				taylor[ 2 * ind_taddr_[j] + 1 ] = Base(0.0);
+		}
+		sweep::forward2(
+			play_, 1, 1, n_, num_var_, 2, taylor.data(), cskip_op_, load_op_
+		);
+		//
+		// second order reverse for w^T F'(x) times the direction
+		const BaseVector& w(*w_);
+		for(size_t i = 0; i < dep_taddr_.size(); ++i)
+			partial[ 2 * dep_taddr_[i] + 1 ] += w[i];
+		play::const_sequential_iterator play_itr = play_->end();
+		sweep::reverse(
+			1,
+			n_,
+			num_var_,
+			play_,
+			2,
+			taylor.data(),
+			2,
+			partial.data(),
+			cskip_op_,
+			load_op_,
+			play_itr
+		);
+		//
+		// store results
+		for(size_t k = color_start_[c]; k < color_start_[c+1]; ++k)
+		{	size_t i = row_[ order_[k] ];
+			subset_.set( order_[k], partial[ 2 * ind_taddr_[i] ] );
+		}
+	}
+public:
+	/*!
+	Constructor
+
+	\param mode
+	type of sweep for each color.
+
+	\param play
+	player for the recording.
+
+	\param num_var
+	number of variables in the recording.
+
+	\param cap_order
+	order capacity for taylor (which has one direction).
+
+	\param taylor
+	Taylor coefficients where the zero order coefficients
+	correspond to the point at which the derivatives are evaluated.
+
+	\param cskip_op
+	the operators that are skipped during the sweeps.
+
+	\param load_op
+	variable index corresponding to each load operation.
+
+	\param ind_taddr
+	variable index for each independent variable.
+
+	\param dep_taddr
+	variable index for each dependent variable.
+
+	\param color
+	is the coloring for the columns (jac_for, hes) or rows (jac_rev).
+
+	\param order
+	indices that sort the subset elements by color.
+
+	\param row
+	row indices corresponding to the subset.
+
+	\param col
+	column indices corresponding to the subset.
+
+	\param w
+	range space weight vector (only used for hes).
+
+	\param subset
+	the values corresponding to each color are stored in subset
+	by the thread that evaluates the sweeps for that color.
+
+	\param group_max
+	maximum number of colors in a forward sweep (only used for jac_for).
+
+	\param n_thread
+	number of threads that will call this function object.
+	*/
+	color_sweep(
+		color_sweep_mode                    mode      ,
+		const player<Base>*                 play      ,
+		size_t                              num_var   ,
+		size_t                              cap_order ,
+		const Base*                         taylor    ,
+		bool*                               cskip_op  ,
+		const pod_vector<addr_t>&           load_op   ,
+		const vector<size_t>&               ind_taddr ,
+		const vector<size_t>&               dep_taddr ,
+		const vector<size_t>&               color     ,
+		const vector<size_t>&               order     ,
+		const IndexVector&                  row       ,
+		const IndexVector&                  col       ,
+		const BaseVector*                   w         ,
+		sparse_rcv<SizeVector, BaseVector>& subset    ,
+		size_t                              group_max ,
+		size_t                              n_thread  )
+	:
+	mode_(mode)             ,
+	play_(play)             ,
+	n_( ind_taddr.size() )  ,
+	num_var_(num_var)       ,
+	cap_order_(cap_order)   ,
+	taylor_(taylor)         ,
+	cskip_op_(cskip_op)     ,
+	load_op_(load_op)       ,
+	ind_taddr_(ind_taddr)   ,
+	dep_taddr_(dep_taddr)   ,
+	color_(color)           ,
+	order_(order)           ,
+	row_(row)               ,
+	col_(col)               ,
+	w_(w)                   ,
+	subset_(subset)         ,
+	group_max_(group_max)   ,
+	n_thread_(n_thread)
+	{	CPPAD_ASSERT_UNKNOWN( group_max > 0 );
+		CPPAD_ASSERT_UNKNOWN( mode != color_sweep_hes || w != CPPAD_NULL );
+		size_t K = order.size();
+		//
+		// number of colors (colors not in the subset are color.size())
+		n_color_ = 0;
+		for(size_t k = 0; k < K; ++k)
+			n_color_ = std::max(n_color_, color_k(order[k]) + 1);
+		//
+		// start of each color in order
+		color_start_.resize(n_color_ + 1);
+		size_t k = 0;
+		for(size_t c = 0; c <= n_color_; ++c)
+		{	while( k < K && color_k( order[k] ) < c )
+				++k;
+			color_start_[c] = k;
+		}
+	}
+	/// number of colors in the subset
+	size_t n_color(void) const
+	{	return n_color_; }
+	/*!
+	Evaluate the sweeps for the colors that correspond to one thread.
+
+	\param thread
+	is the index for this thread. If mode is jac_for, the colors are
+	split into groups of size group_max and
+	this thread evaluates the groups with index g such that
+	<code>g % n_thread == thread</code>.
+	Otherwise each group has one color.
+	*/
+	void operator()(size_t thread) const
+	{	size_t group_size = 1;
+		if( mode_ == color_sweep_jac_for )
+			group_size = group_max_;
+		size_t n_group = (n_color_ + group_size - 1) / group_size;
+		//
+		// work space for this thread
+		pod_vector_maybe<Base> taylor, partial;
+		//
+		for(size_t g = thread; g < n_group; g += n_thread_)
+		{	size_t c_begin = g * group_size;
+			size_t c_end   = std::min(c_begin + group_size, n_color_);
+			//
+			// skip colors that are not in subset (colpack kludge)
+			if( color_start_[c_begin] == color_start_[c_end] )
+				continue;
+			//
+			switch( mode_ )
+			{	case color_sweep_jac_for:
+				jac_for(c_begin, c_end, taylor);
+				break;
+
+				case color_sweep_jac_rev:
+				jac_rev(c_begin, partial);
+				break;
+
+				case color_sweep_hes:
+				hes(c_begin, taylor, partial);
+				break;
+			}
+		}
+	}
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
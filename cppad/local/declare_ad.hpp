@@ -49,9 +49,13 @@ namespace CppAD {
 	class sparse_jac_work;
 	class sparse_jacobian_work;
 	class sparse_hessian_work;
+	struct optimize_report;
 	template <class Base> class AD;
 	template <class Base> class ADFun;
 	template <class Base> class atomic_base;
+	template <class Base> class checkpoint;
+	template <class Base> class reroll;
+	template <class Base> class memory_checkpoint;
 	template <class Base> class discrete;
 	template <class Base> class VecAD;
 	template <class Base> class VecAD_reference;
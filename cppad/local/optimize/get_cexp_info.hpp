@@ -164,31 +164,31 @@ void get_cexp_info(
 	size_t i_op = 0;
 	while(i_op < num_op)
 	{	size_t j_op = i_op;
+		if( play->GetOp(i_op) == UserOp )
+		{	// i_op is the first operations in this user atomic call.
+			// Find the last operation in this call. The operations in
+			// the call are skipped as a block; i.e., the results of the
+			// call are not skipped separately.
+			++j_op;
+			while( play->GetOp(j_op) != UserOp )
+			{	switch( play->GetOp(j_op) )
+				{	case UsrapOp:
+					case UsravOp:
+					case UsrrpOp:
+					case UsrrvOp:
+					break;
+
+					default:
+					CPPAD_ASSERT_UNKNOWN(false);
+				}
+				++j_op;
+			}
+		}
 		bool keep = op_usage[i_op] != usage_t(no_usage);
 		keep     &= op_usage[i_op] != usage_t(csum_usage);
 		keep     &= op_previous[i_op] == 0;
 		if( keep )
 		{	sparse_list_const_iterator itr(cexp_set, i_op);
-			if( *itr != cexp_set.end() )
-			{	if( play->GetOp(i_op) == UserOp )
-				{	// i_op is the first operations in this user atomic call.
-					// Find the last operation in this call.
-					++j_op;
-					while( play->GetOp(j_op) != UserOp )
-					{	switch( play->GetOp(j_op) )
-						{	case UsrapOp:
-							case UsravOp:
-							case UsrrpOp:
-							case UsrrvOp:
-							break;
-
-							default:
-							CPPAD_ASSERT_UNKNOWN(false);
-						}
-						++j_op;
-					}
-				}
-			}
 			while( *itr != cexp_set.end() )
 			{	size_t element = *itr;
 				size_t index   = element / 2;
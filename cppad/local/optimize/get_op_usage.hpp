@@ -176,12 +176,24 @@ If the comparision for the j-th conditional expression is equal to bool(k),
 the i-th operator can be skipped (is not used by any of the results).
 Note the the j indexs the CExpOp operators in the operation sequence.
 
+\param forward_op
+is the forward_op vector computed by get_vecad_forward.
+The loads that it replaces by a variable use that variable
+instead of the VecAD vector.
+
+\param forward_par
+is the forward_par vector computed by get_vecad_forward.
+The loads that it replaces by a parameter do not use the VecAD vector.
+
 \param vecad_used
 The input size of this vector must be zero.
 Upon retun it has size equal to the number of VecAD vectors
 in the operations sequences; i.e., play->num_vecad_vec_rec().
 The VecAD vectors are indexed in the order that thier indices apprear
 in the one large play->GetVecInd that holds all the VecAD vectors.
+A store using a parameter index is only used if a load that is not
+replaced by get_vecad_forward may use the value it stores; i.e.,
+dead stores are not used.
 
 \param op_usage
 The input size of this vector must be zero.
@@ -202,6 +214,8 @@ void get_op_usage(
 	const vector<size_t>&                       dep_taddr           ,
 	pod_vector<addr_t>&                         cexp2op             ,
 	sparse_list&                                cexp_set            ,
+	const pod_vector<addr_t>&                   forward_op          ,
+	const pod_vector<addr_t>&                   forward_par         ,
 	pod_vector<bool>&                           vecad_used          ,
 	pod_vector<usage_t>&                        op_usage            )
 {
@@ -273,6 +287,25 @@ void get_op_usage(
 		arg_0        += length + 1;
 	}
 	CPPAD_ASSERT_UNKNOWN( arg_0 == num_vecad_ind + 1 );
+	//
+	// Dead store information, where the time for an operator is the number
+	// of operators after it (plus one); i.e., it increases during the
+	// reverse pass. The elements of the VecAD vectors are indexed by their
+	// location in play->GetVecInd; i.e., arg[0] + i_vec.
+	// load_time[e]:      last load of element e using a parameter index
+	// store_time[e]:     last store to element e using a parameter index
+	// vec_load_time[i]:  last load of the i-th vector using a variable index
+	CPPAD_ASSERT_UNKNOWN( forward_op.size()  == play->num_load_op_rec() );
+	CPPAD_ASSERT_UNKNOWN( forward_par.size() == play->num_load_op_rec() );
+	pod_vector<size_t> load_time(num_vecad_ind);
+	pod_vector<size_t> store_time(num_vecad_ind);
+	pod_vector<size_t> vec_load_time(num_vecad);
+	for(size_t e = 0; e < num_vecad_ind; ++e)
+	{	load_time[e]  = 0;
+		store_time[e] = 0;
+	}
+	for(size_t i = 0; i < num_vecad; ++i)
+		vec_load_time[i] = 0;
 	// -----------------------------------------------------------------------
 	// conditional expression information
 	//
@@ -572,8 +605,18 @@ void get_op_usage(
 			case LdpOp:
 			CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
 			if( use_result != usage_t(no_usage) )
-			{	size_t i_vec = arg2vecad[ arg[0] ];
-				vecad_used[i_vec] = true;
+			{	if( forward_op[ arg[2] ] != 0 )
+				{	// replaced by the variable that was stored
+					size_t j_op = size_t( forward_op[ arg[2] ] );
+					op_inc_arg_usage(
+						play, sum_op, i_op, j_op, op_usage, cexp_set
+					);
+				}
+				else if( size_t( forward_par[ arg[2] ] ) == num_par )
+				{	size_t i_vec = arg2vecad[ arg[0] ];
+					vecad_used[i_vec] = true;
+					load_time[ arg[0] + arg[1] ] = num_op - i_op;
+				}
 			}
 			break; // --------------------------------------------
 
@@ -583,23 +626,52 @@ void get_op_usage(
 			if( use_result != usage_t(no_usage) )
 			{	size_t i_vec = arg2vecad[ arg[0] ];
 				vecad_used[i_vec] = true;
+				vec_load_time[i_vec] = num_op - i_op;
 				//
 				size_t j_op = random_itr.var2op(arg[1]);
 				op_usage[j_op] = usage_t(yes_usage);
 			}
 			break; // --------------------------------------------
 
-			// Store a variable using a parameter index
-			case StpvOp:
+			// Store a parameter using a parameter index
+			case StppOp:
+			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 0 );
+			{	size_t e     = size_t( arg[0] + arg[1] );
+				size_t i_vec = arg2vecad[ arg[0] ];
+				size_t last  = std::max(load_time[e], vec_load_time[i_vec]);
+				if( store_time[e] < last )
+					op_usage[i_op] = usage_t(yes_usage);
+				store_time[e] = num_op - i_op;
+			}
+			break; // --------------------------------------------
+
+			// Store a parameter using a variable index
+			case StvpOp:
 			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 0 );
 			if( vecad_used[ arg2vecad[ arg[0] ] ] )
 			{	op_usage[i_op] = usage_t(yes_usage);
 				//
-				size_t j_op = random_itr.var2op(arg[2]);
+				size_t j_op = random_itr.var2op(arg[1]);
 				op_usage[j_op] = usage_t(yes_usage);
 			}
 			break; // --------------------------------------------
 
+			// Store a variable using a parameter index
+			case StpvOp:
+			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 0 );
+			{	size_t e     = size_t( arg[0] + arg[1] );
+				size_t i_vec = arg2vecad[ arg[0] ];
+				size_t last  = std::max(load_time[e], vec_load_time[i_vec]);
+				if( store_time[e] < last )
+				{	op_usage[i_op] = usage_t(yes_usage);
+					//
+					size_t j_op = random_itr.var2op(arg[2]);
+					op_usage[j_op] = usage_t(yes_usage);
+				}
+				store_time[e] = num_op - i_op;
+			}
+			break; // --------------------------------------------
+
 			// Store a variable using a variable index
 			case StvvOp:
 			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 0 );
@@ -618,6 +690,7 @@ void get_op_usage(
 			// ============================================================
 			case CSumOp:
 			CPPAD_ASSERT_UNKNOWN( NumRes(op) == 1 );
+			if( use_result != usage_t(no_usage) )
 			{
 				for(size_t i = 5; i < size_t(arg[2]); i++)
 				{	size_t j_op = random_itr.var2op( arg[i] );
@@ -626,6 +699,7 @@ void get_op_usage(
 					);
 				}
 			}
+			break;
 			// =============================================================
 			// user defined atomic operators
 			// ============================================================
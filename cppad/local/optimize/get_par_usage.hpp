@@ -42,6 +42,10 @@ in the operation sequence; i.e., num_op = play->nun_var_rec().
 The value op_usage[i] have been set to the usage for
 the i-th operator in the operation sequence.
 
+\param forward_par
+is the forward_par vector computed by get_vecad_forward.
+The loads that it replaces by a parameter use that parameter.
+
 \param vecad_used
 This argument has size equal to the number of VecAD vectors
 in the operations sequences; i.e., play->num_vecad_vec_rec().
@@ -61,6 +65,7 @@ void get_par_usage(
 	const player<Base>*                         play                ,
 	const play::const_random_iterator<Addr>&    random_itr          ,
 	const pod_vector<usage_t>&                  op_usage            ,
+	const pod_vector<addr_t>&                   forward_par         ,
 	pod_vector<bool>&                           vecad_used          ,
 	pod_vector<bool>&                           par_usage           )
 {
@@ -184,7 +189,6 @@ void get_par_usage(
 			case ExpOp:
 			case Expm1Op:
 			case InvOp:
-			case LdpOp:
 			case LdvOp:
 			case LevvOp:
 			case LogOp:
@@ -220,7 +224,6 @@ void get_par_usage(
 
 
 			// cases where only first argument is a parameter
-			case CSumOp:
 			case EqpvOp:
 			case DivpvOp:
 			case LepvOp:
@@ -246,12 +249,26 @@ void get_par_usage(
 			par_usage[arg[1]] = true;
 			break;
 
+			// load that is replaced by a parameter
+			case LdpOp:
+			if( size_t( forward_par[ arg[2] ] ) != num_par )
+				par_usage[ forward_par[ arg[2] ] ] = true;
+			break;
+
 			// cases where only third argument is a parameter
 			case StppOp:
 			case StvpOp:
 			par_usage[arg[2]] = true;
 			break;
 
+			// cumulative summation operator
+			case CSumOp:
+			CPPAD_ASSERT_UNKNOWN( 0 == NumArg(op) )
+			par_usage[arg[0]] = true;
+			for(size_t i = size_t(arg[2]); i < size_t(arg[4]); ++i)
+				par_usage[arg[i]] = true;
+			break;
+
 			// conditional expression operator
 			case CExpOp:
 			CPPAD_ASSERT_UNKNOWN( 6 == NumArg(op) )
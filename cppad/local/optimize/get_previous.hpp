@@ -17,6 +17,7 @@ Create operator information tables
 */
 
 # include <cppad/local/optimize/match_op.hpp>
+# include <cppad/local/optimize/match_parallel.hpp>
 # include <cppad/local/optimize/usage.hpp>
 
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
@@ -68,6 +69,12 @@ On input, op_usage[i] is the usage for
 the i-th operator in the operation sequence not counting previous
 optimization.
 On output, it is the usage counting previous optimization.
+
+\param num_threads
+is the number of threads used to compute op_previous (see match_parallel).
+If it is greater than one, and CPPAD_USE_CPLUSPLUS_2011 is true,
+match_parallel is used. Otherwise, the operators are matched sequentially.
+The value of op_previous does not depend on num_threads.
 */
 
 template <class Addr, class Base>
@@ -76,7 +83,8 @@ void get_previous(
 	const play::const_random_iterator<Addr>&    random_itr          ,
 	sparse_list&                                cexp_set            ,
 	pod_vector<addr_t>&                         op_previous         ,
-	pod_vector<usage_t>&                        op_usage            )
+	pod_vector<usage_t>&                        op_usage            ,
+	size_t                                      num_threads         )
 {
 	CPPAD_ASSERT_UNKNOWN( op_previous.size() == 0 );
 
@@ -95,112 +103,48 @@ void get_previous(
 	// ----------------------------------------------------------------------
 	// compute op_previous
 	// ----------------------------------------------------------------------
-	sparse_list  hash_table_op;
-	hash_table_op.resize(CPPAD_HASH_TABLE_SIZE, num_op);
-	//
-	pod_vector<bool> work_bool;
-	pod_vector<addr_t> work_addr_t;
 	for(size_t i_op = 0; i_op < num_op; ++i_op)
-	{	op_previous[i_op] = 0;
-
-		if( op_usage[i_op] == usage_t(yes_usage) )
-		switch( random_itr.get_op(i_op) )
-		{
-			// ----------------------------------------------------------------
-			// these operators never match pevious operators
-			case BeginOp:
-			case CExpOp:
-			case CSkipOp:
-			case CSumOp:
-			case EndOp:
-			case InvOp:
-			case LdpOp:
-			case LdvOp:
-			case ParOp:
-			case PriOp:
-			case StppOp:
-			case StpvOp:
-			case StvpOp:
-			case StvvOp:
-			case UserOp:
-			case UsrapOp:
-			case UsravOp:
-			case UsrrpOp:
-			case UsrrvOp:
-			break;
-
-			// ----------------------------------------------------------------
-			// check for a previous match
-			case AbsOp:
-			case AcosOp:
-			case AcoshOp:
-			case AddpvOp:
-			case AddvvOp:
-			case AsinOp:
-			case AsinhOp:
-			case AtanOp:
-			case AtanhOp:
-			case CosOp:
-			case CoshOp:
-			case DisOp:
-			case DivpvOp:
-			case DivvpOp:
-			case DivvvOp:
-			case EqpvOp:
-			case EqvvOp:
-			case ErfOp:
-			case ExpOp:
-			case Expm1Op:
-			case LepvOp:
-			case LevpOp:
-			case LevvOp:
-			case LogOp:
-			case Log1pOp:
-			case LtpvOp:
-			case LtvpOp:
-			case LtvvOp:
-			case MulpvOp:
-			case MulvvOp:
-			case NepvOp:
-			case NevvOp:
-			case PowpvOp:
-			case PowvpOp:
-			case PowvvOp:
-			case SignOp:
-			case SinOp:
-			case SinhOp:
-			case SqrtOp:
-			case SubpvOp:
-			case SubvpOp:
-			case SubvvOp:
-			case TanOp:
-			case TanhOp:
-			case ZmulpvOp:
-			case ZmulvpOp:
-			case ZmulvvOp:
-			match_op(
-				random_itr,
-				op_previous,
-				i_op,
-				hash_table_op,
-				work_bool,
-				work_addr_t
-			);
-			if( op_previous[i_op] != 0 )
-			{	// like a unary operator that assigns i_op equal to previous.
-				size_t previous = op_previous[i_op];
-				bool sum_op = false;
-				CPPAD_ASSERT_UNKNOWN( previous < i_op );
-				op_inc_arg_usage(
-					play, sum_op, i_op, previous, op_usage, cexp_set
-				);
+		op_previous[i_op] = 0;
+# if CPPAD_USE_CPLUSPLUS_2011
+	if( num_threads > 1 )
+		match_parallel(random_itr, op_usage, op_previous, num_threads);
+	else
+# endif
+	{	// hash table of operators that can be matched (grows as needed)
+		op_hash_table hash_table_op(num_op);
+		//
+		pod_vector<bool> work_bool;
+		pod_vector<addr_t> work_addr_t;
+		for(size_t i_op = 0; i_op < num_op; ++i_op)
+		{	if( op_usage[i_op] == usage_t(yes_usage) )
+			{	if( match_op_candidate( random_itr.get_op(i_op) ) )
+				{	match_op(
+						random_itr,
+						op_previous,
+						i_op,
+						hash_table_op,
+						work_bool,
+						work_addr_t
+					);
+				}
 			}
-			break;
-
-			// ----------------------------------------------------------------
-			default:
-			CPPAD_ASSERT_UNKNOWN(false);
-			break;
+		}
+	}
+	// ----------------------------------------------------------------------
+	// usage counting previous optimization
+	// ----------------------------------------------------------------------
+	// This only changes the usage (and cexp_set) for operators that other
+	// operators match, and they are not matched themselves. Hence it does not
+	// change op_previous and can be done after op_previous is computed.
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	if( op_previous[i_op] != 0 )
+		{	// like a unary operator that assigns i_op equal to previous.
+			size_t previous = op_previous[i_op];
+			bool sum_op = false;
+			CPPAD_ASSERT_UNKNOWN( previous < i_op );
+			op_inc_arg_usage(
+				play, sum_op, i_op, previous, op_usage, cexp_set
+			);
 		}
 	}
 }
@@ -0,0 +1,155 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_GET_VECAD_FORWARD_HPP
+# define CPPAD_LOCAL_OPTIMIZE_GET_VECAD_FORWARD_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*!
+\file get_vecad_forward.hpp
+Determine the VecAD loads that can be replaced by the value that was stored.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize {
+
+/*!
+Store to load forwarding for VecAD loads that use a parameter index.
+
+If a VecAD vector element is loaded using a parameter index,
+and the value of the element is known to be a certain variable or
+parameter at that point in the operation sequence,
+the load can be replaced by the variable or parameter.
+The value of an element is known from its initial value,
+or a previous store to the element using a parameter index.
+It is not known after a store to the same vector using a variable index.
+
+\tparam Addr
+Type used by random iterator for the player.
+
+\tparam Base
+Base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param play
+This is the operation sequence.
+
+\param random_itr
+This is a random iterator for the operation sequence.
+
+\param forward_op
+The input size of this vector does not matter.
+Upon return it has size equal to the number of load operators;
+i.e., play->num_load_op_rec().
+If forward_op[k] is not zero, the k-th load operator is an LdpOp and its
+result is equal to the primary result of the operator
+with index forward_op[k].
+
+\param forward_par
+The input size of this vector does not matter.
+Upon return it has size equal to the number of load operators.
+If forward_par[k] is not equal to the number of parameters,
+the k-th load operator is an LdpOp and its
+result is equal to the parameter with index forward_par[k].
+*/
+template <class Addr, class Base>
+void get_vecad_forward(
+	const player<Base>*                         play                ,
+	const play::const_random_iterator<Addr>&    random_itr          ,
+	pod_vector<addr_t>&                         forward_op          ,
+	pod_vector<addr_t>&                         forward_par         )
+{	size_t num_op        = random_itr.num_op();
+	size_t num_par       = play->num_par_rec();
+	size_t num_load_op   = play->num_load_op_rec();
+	size_t num_vecad_ind = play->num_vec_ind_rec();
+	CPPAD_ASSERT_UNKNOWN(
+		size_t( std::numeric_limits<addr_t>::max() ) >= num_par
+	);
+	forward_op.resize(num_load_op);
+	forward_par.resize(num_load_op);
+	for(size_t k = 0; k < num_load_op; ++k)
+	{	forward_op[k]  = 0;
+		forward_par[k] = addr_t( num_par );
+	}
+	if( num_load_op == 0 )
+		return;
+	//
+	// The elements of the VecAD vectors are indexed by their location in
+	// play->GetVecInd; i.e., arg[0] + i_vec for the load and store operators.
+	// elem_op[e]:    operator that stored a variable in the element
+	//                (zero if the element is a parameter)
+	// elem_par[e]:   parameter index if the element is a parameter
+	// elem_epoch[e]: value of vec_epoch for this vector when element stored
+	// vec_epoch[arg[0]]: number of stores to this vector with variable index
+	pod_vector<addr_t> elem_op(num_vecad_ind);
+	pod_vector<addr_t> elem_par(num_vecad_ind);
+	pod_vector<size_t> elem_epoch(num_vecad_ind);
+	pod_vector<size_t> vec_epoch(num_vecad_ind);
+	for(size_t e = 0; e < num_vecad_ind; ++e)
+	{	// initial values for the elements (and lengths of the vectors)
+		elem_op[e]    = 0;
+		elem_par[e]   = addr_t( play->GetVecInd(e) );
+		elem_epoch[e] = 0;
+		vec_epoch[e]  = 0;
+	}
+	//
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		size_t e;
+		switch( op )
+		{
+			// load using a parameter index
+			case LdpOp:
+			e = size_t( arg[0] + arg[1] );
+			CPPAD_ASSERT_UNKNOWN( e < num_vecad_ind );
+			if( elem_epoch[e] == vec_epoch[ arg[0] ] )
+			{	if( elem_op[e] != 0 )
+					forward_op[ arg[2] ]  = elem_op[e];
+				else
+					forward_par[ arg[2] ] = elem_par[e];
+			}
+			break;
+
+			// store a parameter using a parameter index
+			case StppOp:
+			e = size_t( arg[0] + arg[1] );
+			CPPAD_ASSERT_UNKNOWN( e < num_vecad_ind );
+			elem_op[e]    = 0;
+			elem_par[e]   = arg[2];
+			elem_epoch[e] = vec_epoch[ arg[0] ];
+			break;
+
+			// store a variable using a parameter index
+			case StpvOp:
+			e = size_t( arg[0] + arg[1] );
+			CPPAD_ASSERT_UNKNOWN( e < num_vecad_ind );
+			elem_op[e]    = addr_t( random_itr.var2op( size_t(arg[2]) ) );
+			elem_par[e]   = addr_t( num_par );
+			elem_epoch[e] = vec_epoch[ arg[0] ];
+			CPPAD_ASSERT_UNKNOWN( elem_op[e] != 0 );
+			break;
+
+			// store using a variable index
+			case StvpOp:
+			case StvvOp:
+			++vec_epoch[ arg[0] ];
+			break;
+
+			default:
+			break;
+		}
+	}
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
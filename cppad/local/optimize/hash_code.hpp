@@ -35,22 +35,37 @@ is a vector of length num_arg
 containing the corresponding argument indices for this operator.
 
 \return
-is a hash code that is between zero and CPPAD_HASH_TABLE_SIZE - 1.
+is a hash code for the operator.
+Each argument is combined with the code using a multiply and shift
+so that all the bits of the arguments affect the low order bits
+of the result (a sum of the arguments has many collisions because
+operators tend to use variables with nearby indices).
+The low order bits of the code are used to index op_hash_table.
 */
 
 inline size_t optimize_hash_code(
-	OpCode        op      ,
-	size_t        num_arg ,
-	const addr_t* arg     )
+	OpCode        op       ,
+	size_t        num_arg  ,
+	const addr_t* arg      )
 {
 	// there is only one case where num_arg == 3
 	CPPAD_ASSERT_UNKNOWN( op == ErfOp || num_arg <= 2 );
 	CPPAD_ASSERT_UNKNOWN( num_arg <= 3 );
-	size_t sum = size_t(op);
+	//
+	// golden ratio multiplier for the number of bits in a size_t
+	// (the shifts avoid a 32 bit shift when size_t has 32 bits)
+	const size_t half_bits  = 4 * sizeof(size_t);
+	size_t       multiplier = size_t(0x9E3779B9);
+	if( half_bits == 32 )
+		multiplier = ( (multiplier << 16) << 16 ) | size_t(0x7F4A7C15);
+	//
+	size_t code = size_t(op) + 1;
 	for(size_t i = 0; i < num_arg; i++)
-		sum += size_t(arg[i]);
+	{	code  = ( code ^ size_t(arg[i]) ) * multiplier;
+		code ^= code >> half_bits;
+	}
 	//
-	return sum % CPPAD_HASH_TABLE_SIZE;
+	return code;
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
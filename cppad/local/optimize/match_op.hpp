@@ -11,12 +11,109 @@ A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 # include <cppad/local/optimize/hash_code.hpp>
+# include <cppad/local/optimize/op_hash_table.hpp>
 /*!
 \file match_op.hpp
 Check if current operator matches a previous operator.
 */
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
+/*!
+Can an operator match a previous operator (see match_op).
+
+\param op
+is the operator.
+
+\return
+is true if op is an unary or binary operator, that is not a load or
+store operator, and the operator is a candidate for matching
+a previous operator.
+*/
+inline bool match_op_candidate(OpCode op)
+{	bool result = false;
+	switch( op )
+	{
+		// ----------------------------------------------------------------
+		// these operators never match pevious operators
+		case BeginOp:
+		case CExpOp:
+		case CSkipOp:
+		case CSumOp:
+		case EndOp:
+		case InvOp:
+		case LdpOp:
+		case LdvOp:
+		case ParOp:
+		case PriOp:
+		case StppOp:
+		case StpvOp:
+		case StvpOp:
+		case StvvOp:
+		case UserOp:
+		case UsrapOp:
+		case UsravOp:
+		case UsrrpOp:
+		case UsrrvOp:
+		break;
+		// ----------------------------------------------------------------
+		// check for a previous match
+		case AbsOp:
+		case AcosOp:
+		case AcoshOp:
+		case AddpvOp:
+		case AddvvOp:
+		case AsinOp:
+		case AsinhOp:
+		case AtanOp:
+		case AtanhOp:
+		case CosOp:
+		case CoshOp:
+		case DisOp:
+		case DivpvOp:
+		case DivvpOp:
+		case DivvvOp:
+		case EqpvOp:
+		case EqvvOp:
+		case ErfOp:
+		case ExpOp:
+		case Expm1Op:
+		case LepvOp:
+		case LevpOp:
+		case LevvOp:
+		case LogOp:
+		case Log1pOp:
+		case LtpvOp:
+		case LtvpOp:
+		case LtvvOp:
+		case MulpvOp:
+		case MulvvOp:
+		case NepvOp:
+		case NevvOp:
+		case PowpvOp:
+		case PowvpOp:
+		case PowvvOp:
+		case SignOp:
+		case SinOp:
+		case SinhOp:
+		case SqrtOp:
+		case SubpvOp:
+		case SubvpOp:
+		case SubvvOp:
+		case TanOp:
+		case TanhOp:
+		case ZmulpvOp:
+		case ZmulvpOp:
+		case ZmulvvOp:
+		result = true;
+		break;
+		// ----------------------------------------------------------------
+		default:
+		CPPAD_ASSERT_UNKNOWN(false);
+		break;
+	}
+	return result;
+}
+
 /*!
 Search for a previous operator that matches the current one.
 
@@ -58,13 +155,11 @@ LtpvOp, LtvpOp, LtvvOp, StppOp, StpvOp, StvpOp, StvvOp.
 It also must not be an independent variable operator InvOp.
 
 \param hash_table_op
-is a vector of sets,
-hash_table_op.n_set() == CPPAD_HASH_TABLE_SIZE and
-hash_table_op.end() == op_previous.size().
-If i_op is an element of set[j],
-then the operation op_previous[i_op] has hash code j,
-and op_previous[i_op] does not match any other element of set[j].
-An entry to set[j] is added each time match_op is called
+is a hash table of operator indices (initially empty).
+If i_op is in the table with hash code j,
+then optimize_hash_code for the operator i_op is j,
+and i_op does not match any other operator in the table.
+The current operator is added to the table each time match_op is called
 and a match for the current operator is not found.
 
 \param work_bool
@@ -83,7 +178,7 @@ void match_op(
 	const play::const_random_iterator<Addr>&    random_itr     ,
 	pod_vector<addr_t>&                         op_previous    ,
 	size_t                                      current        ,
-	sparse_list&                                hash_table_op  ,
+	op_hash_table&                              hash_table_op  ,
 	pod_vector<bool>&                           work_bool      ,
 	pod_vector<addr_t>&                         work_addr_t    )
 {	//
@@ -107,10 +202,6 @@ void match_op(
 	CPPAD_ASSERT_UNKNOWN( var2previous_var.size() == num_var );
 	CPPAD_ASSERT_UNKNOWN( num_op == op_previous.size() );
 	CPPAD_ASSERT_UNKNOWN( op_previous[current] == 0 );
-	CPPAD_ASSERT_UNKNOWN(
-		hash_table_op.n_set() == CPPAD_HASH_TABLE_SIZE
-	);
-	CPPAD_ASSERT_UNKNOWN( hash_table_op.end() == num_op );
 	CPPAD_ASSERT_UNKNOWN( current < num_op );
 	//
 	// op, arg, i_var
@@ -139,16 +230,14 @@ void match_op(
 	//
 	size_t code = optimize_hash_code(op, num_arg, arg_match);
 	//
-	// iterator for the set with this hash code
-	sparse_list_const_iterator itr(hash_table_op, code);
-	//
 	// check for a match
-	size_t count = 0;
-	while( *itr != num_op )
-	{	++count;
+	size_t slot = hash_table_op.first(code);
+	for( ; ! hash_table_op.empty(slot); slot = hash_table_op.next(slot) )
+	{	if( ! hash_table_op.check(slot, code) )
+			continue;
 		//
 		// candidate previous for current operator
-		size_t  candidate  = *itr;
+		size_t  candidate  = hash_table_op.op(slot);
 		CPPAD_ASSERT_UNKNOWN( candidate < current );
 		CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
 		//
@@ -175,7 +264,6 @@ void match_op(
 			}
 			return;
 		}
-		++itr;
 	}
 
 	// special case where operator is commutative
@@ -183,11 +271,14 @@ void match_op(
 	{	CPPAD_ASSERT_UNKNOWN( NumArg(op) == 2 );
 		std::swap( arg_match[0], arg_match[1] );
 		//
-		code      = optimize_hash_code(op, num_arg, arg_match);
-		sparse_list_const_iterator itr_swap(hash_table_op, code);
-		while( *itr_swap != num_op )
-		{
-			size_t candidate  = *itr_swap;
+		// (operators are added to the table using their unswapped hash code)
+		size_t code_swap = optimize_hash_code(op, num_arg, arg_match);
+		slot             = hash_table_op.first(code_swap);
+		for( ; ! hash_table_op.empty(slot); slot = hash_table_op.next(slot) )
+		{	if( ! hash_table_op.check(slot, code_swap) )
+				continue;
+			//
+			size_t candidate  = hash_table_op.op(slot);
 			CPPAD_ASSERT_UNKNOWN( candidate < current );
 			CPPAD_ASSERT_UNKNOWN( op_previous[candidate] == 0 );
 			//
@@ -211,16 +302,10 @@ void match_op(
 				}
 				return;
 			}
-			++itr_swap;
 		}
 	}
-	CPPAD_ASSERT_UNKNOWN( count < 11 );
-	if( count == 10 )
-	{	// restart the list
-		hash_table_op.clear(code);
-	}
-	// no match was found, add this operator the the set for this hash code
-	hash_table_op.add_element(code, current);
+	// no match was found, add this operator to the hash table
+	hash_table_op.insert(code, current);
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
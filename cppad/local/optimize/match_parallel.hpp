@@ -0,0 +1,230 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_MATCH_PARALLEL_HPP
+# define CPPAD_LOCAL_OPTIMIZE_MATCH_PARALLEL_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*!
+\file match_parallel.hpp
+Use multiple threads to check if operators match previous operators.
+*/
+
+# include <cppad/configure.hpp>
+# include <cppad/local/optimize/match_op.hpp>
+# include <cppad/local/optimize/usage.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <thread>
+# include <atomic>
+# include <vector>
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+
+/*!
+Information used by one of the threads in match_parallel.
+*/
+struct match_thread_info {
+	/// operators that are matched by this thread (in increasing order)
+	pod_vector<addr_t> owned;
+	/// hash table of the operators, matched by this thread, that do not
+	/// match a previous operator
+	op_hash_table      hash_table_op;
+	/// work space used by this thread when it calls match_op
+	pod_vector<bool>   work_bool;
+	/// constructor
+	match_thread_info(void) : hash_table_op(0)
+	{ }
+};
+
+/*!
+Match the operators that are owned by one thread.
+
+\param random_itr
+is a random iterator for the old operation sequence.
+
+\param done
+done[i_op] is true when op_previous[i_op], and the value of
+var2previous_var for the result of i_op, are final.
+This routine waits for the operators that compute the variable arguments
+of an operator it owns, and sets done for the operators that it owns.
+
+\param op_previous
+see match_op (only the elements for the operators owned
+by this thread are modified).
+
+\param var2previous_var
+mapping from each variable to the previous variable that will be
+used in its place (only the elements for the results of the operators
+owned by this thread are modified).
+
+\param info
+is the information for this thread.
+No memory is allocated by this routine, so it does not use thread_alloc;
+i.e., info.hash_table_op and info.work_bool must have enough capacity.
+*/
+template <class Addr>
+void match_thread(
+	const play::const_random_iterator<Addr>*    random_itr       ,
+	std::atomic<bool>*                          done             ,
+	pod_vector<addr_t>*                         op_previous      ,
+	pod_vector<addr_t>*                         var2previous_var ,
+	match_thread_info*                          info             )
+{	for(size_t k = 0; k < info->owned.size(); ++k)
+	{	size_t        i_op = size_t( info->owned[k] );
+		OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr->op_info(i_op, op, arg, i_var);
+		//
+		// wait for the operators that compute the variable arguments
+		arg_is_variable(op, arg, info->work_bool);
+		for(size_t j = 0; j < info->work_bool.size(); ++j)
+		{	if( info->work_bool[j] )
+			{	size_t j_op = random_itr->var2op( size_t(arg[j]) );
+				while( ! done[j_op].load(std::memory_order_acquire) )
+					std::this_thread::yield();
+			}
+		}
+		match_op(
+			*random_itr,
+			*op_previous,
+			i_op,
+			info->hash_table_op,
+			info->work_bool,
+			*var2previous_var
+		);
+		done[i_op].store(true, std::memory_order_release);
+	}
+}
+
+/*!
+Use multiple threads to compute the previous operator that
+matches each operator.
+
+Each of the operators that can match a previous operator is assigned
+a structural hash code that only depends on its operator, its parameter
+arguments, and the structural hash codes for its variable arguments.
+Operators that match have the same structural code and are assigned
+to the same thread. Each thread processes its operators in increasing order,
+using its own hash table, so the first operator in a set of matching
+operators is found. Hence the result is the same as for the sequential
+algorithm; i.e., does not depend on the number of threads
+or the order in which the threads execute.
+
+\param random_itr
+This is a random iterator for the old operation sequence.
+
+\param op_usage
+is the usage for each operator.
+Only operators with op_usage[i_op] == usage_t(yes_usage)
+are matched.
+
+\param op_previous
+The input size of this vector must be the number of operators
+and all its elements must be zero.
+Upon return, op_previous[i_op] is the index of the first operator
+that matches i_op, or zero if there is no such operator.
+
+\param num_threads
+is the number of threads to use (including the current thread).
+*/
+template <class Addr>
+void match_parallel(
+	const play::const_random_iterator<Addr>&    random_itr       ,
+	const pod_vector<usage_t>&                  op_usage         ,
+	pod_vector<addr_t>&                         op_previous      ,
+	size_t                                      num_threads      )
+{	CPPAD_ASSERT_UNKNOWN( num_threads > 1 );
+	size_t num_op  = random_itr.num_op();
+	size_t num_var = random_itr.num_var();
+	CPPAD_ASSERT_UNKNOWN( op_previous.size() == num_op );
+	//
+	// mapping from each variable to the previous variable that replaces it
+	pod_vector<addr_t> var2previous_var(num_var);
+	for(size_t i = 0; i < num_var; ++i)
+		var2previous_var[i] = addr_t(i);
+	//
+	// structural hash code for each variable (the variable index for
+	// variables that are not the result of an operator that can be matched)
+	pod_vector<addr_t> var_code(num_var);
+	for(size_t i = 0; i < num_var; ++i)
+		var_code[i] = addr_t(i);
+	//
+	// information for each thread
+	std::vector<match_thread_info> info(num_threads);
+	//
+	// done flag for each operator (value initialized to false)
+	std::vector< std::atomic<bool> > done(num_op);
+	//
+	pod_vector<bool> variable;
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		//
+		bool candidate = op_usage[i_op] == usage_t(yes_usage);
+		candidate     &= match_op_candidate(op);
+		if( ! candidate )
+			done[i_op].store(true, std::memory_order_relaxed);
+		else
+		{	size_t num_arg = NumArg(op);
+			CPPAD_ASSERT_UNKNOWN( num_arg <= 3 );
+			arg_is_variable(op, arg, variable);
+			addr_t arg_code[3];
+			for(size_t j = 0; j < num_arg; ++j)
+			{	arg_code[j] = arg[j];
+				if( variable[j] )
+					arg_code[j] = var_code[ arg[j] ];
+			}
+			// matching for these operators does not depend on argument order
+			if( (op == AddvvOp) | (op == MulvvOp) )
+			{	if( arg_code[1] < arg_code[0] )
+					std::swap(arg_code[0], arg_code[1]);
+			}
+			size_t code = optimize_hash_code(op, num_arg, arg_code);
+			if( NumRes(op) > 0 )
+				var_code[i_var] = addr_t(code);
+			info[ code % num_threads ].owned.push_back( addr_t(i_op) );
+		}
+	}
+	// allocate all the memory used by the threads
+	// (so the other threads do not use thread_alloc)
+	for(size_t thread = 0; thread < num_threads; ++thread)
+	{	info[thread].hash_table_op.reserve( info[thread].owned.size() );
+		info[thread].work_bool.resize(3);
+	}
+	//
+	// match the operators
+	std::vector<std::thread> worker;
+	for(size_t thread = 1; thread < num_threads; ++thread)
+	{	worker.push_back( std::thread(
+			match_thread<Addr>,
+			&random_itr,
+			done.data(),
+			&op_previous,
+			&var2previous_var,
+			&info[thread]
+		) );
+	}
+	match_thread(
+		&random_itr, done.data(), &op_previous, &var2previous_var, &info[0]
+	);
+	for(size_t k = 0; k < worker.size(); ++k)
+		worker[k].join();
+	//
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif // CPPAD_USE_CPLUSPLUS_2011
+# endif
@@ -0,0 +1,176 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_OP_HASH_TABLE_HPP
+# define CPPAD_LOCAL_OPTIMIZE_OP_HASH_TABLE_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <cppad/local/pod_vector.hpp>
+
+/*!
+\file op_hash_table.hpp
+Hash table used to find previous operators that match the current one.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+/*!
+Open addressing hash table of operator indices.
+
+Each slot in the table contains an operator index and the low order
+bits of its hash code (see optimize_hash_code), both of type addr_t.
+The slots for a hash code are searched using linear probing starting at
+the slot with index equal to the low order bits of the code.
+Storing the bits of the code skips most of the operators that
+do not match without looking at the operation sequence.
+The number of slots is a power of two and is doubled when more than half
+of the slots are in use; i.e., the table grows with the number of
+operators in it and the probe sequences stay short.
+The number of slots is not more than the number of values an addr_t
+can represent, so the slot for an operator can be recomputed from the
+bits of its code that are stored.
+*/
+class op_hash_table {
+private:
+	/// entry_[2*slot] is the operator index plus one for this slot
+	/// (zero for empty slots) and entry_[2*slot+1] is the corresponding
+	/// check value (see check); i.e., one cache line access per slot.
+	pod_vector<addr_t> entry_;
+
+	/// number of slots that are not empty
+	size_t n_element_;
+
+	/// number of slots minus one (number of slots is a power of two)
+	size_t mask_;
+	// -----------------------------------------------------------------------
+	/// value stored with an operator to check its hash code
+	static addr_t check(size_t code)
+	{	return addr_t( code ); }
+
+	/// set the number of slots and mark them all as empty
+	void set_n_slot(size_t n_slot)
+	{	entry_.resize(2 * n_slot);
+		for(size_t slot = 0; slot < n_slot; ++slot)
+			entry_[2 * slot] = 0;
+		mask_ = n_slot - 1;
+	}
+
+	/// double the number of slots
+	void grow(void)
+	{	pod_vector<addr_t> old_entry;
+		old_entry.swap(entry_);
+		set_n_slot( old_entry.size() );
+		//
+		size_t old_n_slot = old_entry.size() / 2;
+		for(size_t old_slot = 0; old_slot < old_n_slot; ++old_slot)
+		{	addr_t i_op_p1 = old_entry[2 * old_slot];
+			if( i_op_p1 != 0 )
+			{	// the low order bits of the code determine the slot
+				size_t code = size_t( old_entry[2 * old_slot + 1] );
+				size_t slot = first(code);
+				while( entry_[2 * slot] != 0 )
+					slot = next(slot);
+				entry_[2 * slot]     = i_op_p1;
+				entry_[2 * slot + 1] = old_entry[2 * old_slot + 1];
+			}
+		}
+	}
+public:
+	/*!
+	Constructor
+
+	\param num_op
+	is the number of operators in the operation sequence.
+	The initial number of slots is the smallest power of two that is
+	greater than or equal the minimum of num_op and 1024.
+	*/
+	op_hash_table(size_t num_op)
+	: n_element_(0)
+	{	CPPAD_ASSERT_UNKNOWN(
+			size_t( std::numeric_limits<addr_t>::max() ) > num_op
+		);
+		size_t n_slot = 1;
+		while( n_slot < std::min(num_op, size_t(1024)) )
+			n_slot *= 2;
+		set_n_slot(n_slot);
+	}
+	/// first slot in the probe sequence for a hash code
+	size_t first(size_t code) const
+	{	return code & mask_; }
+
+	/// next slot in a probe sequence
+	size_t next(size_t slot) const
+	{	return (slot + 1) & mask_; }
+
+	/// is this slot empty (the probe sequence ends at an empty slot)
+	bool empty(size_t slot) const
+	{	return entry_[2 * slot] == 0; }
+
+	/// might the operator in this slot have the specified hash code
+	bool check(size_t slot, size_t code) const
+	{	CPPAD_ASSERT_UNKNOWN( ! empty(slot) );
+		return entry_[2 * slot + 1] == check(code);
+	}
+
+	/// operator index for a slot that is not empty
+	size_t op(size_t slot) const
+	{	CPPAD_ASSERT_UNKNOWN( ! empty(slot) );
+		return size_t( entry_[2 * slot] ) - 1;
+	}
+
+	/// number of operators in the table
+	size_t size(void) const
+	{	return n_element_; }
+
+	/// number of slots in the table
+	size_t n_slot(void) const
+	{	return mask_ + 1; }
+
+	/*!
+	Make sure that the table does not grow during insertions.
+
+	\param n_element
+	The table must be empty. Upon return, inserting n_element operators
+	in the table does not allocate memory.
+	*/
+	void reserve(size_t n_element)
+	{	CPPAD_ASSERT_UNKNOWN( n_element_ == 0 );
+		// (the table does not grow when mask_ is the maximum addr_t value)
+		size_t max_mask = size_t( std::numeric_limits<addr_t>::max() );
+		size_t n_slot   = mask_ + 1;
+		while( n_slot < 2 * (n_element + 1) && n_slot - 1 < max_mask )
+			n_slot *= 2;
+		if( n_slot > mask_ + 1 )
+			set_n_slot(n_slot);
+	}
+	/*!
+	Add an operator to the table
+
+	\param code
+	is the hash code for the operator.
+
+	\param i_op
+	is the operator index.
+	*/
+	void insert(size_t code, size_t i_op)
+	{	CPPAD_ASSERT_UNKNOWN( n_element_ < mask_ );
+		bool full = 2 * (n_element_ + 1) > mask_ + 1;
+		if( full && mask_ < size_t( std::numeric_limits<addr_t>::max() ) )
+			grow();
+		size_t slot = first(code);
+		while( entry_[2 * slot] != 0 )
+			slot = next(slot);
+		entry_[2 * slot]     = addr_t( i_op + 1 );
+		entry_[2 * slot + 1] = check(code);
+		++n_element_;
+	}
+};
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
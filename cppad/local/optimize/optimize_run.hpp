@@ -14,6 +14,8 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 
 # include <stack>
 # include <iterator>
+# include <cstdlib>
+# include <cppad/local/optimize/get_vecad_forward.hpp>
 # include <cppad/local/optimize/get_op_usage.hpp>
 # include <cppad/local/optimize/get_par_usage.hpp>
 # include <cppad/local/optimize/get_previous.hpp>
@@ -25,6 +27,9 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/optimize/record_vp.hpp>
 # include <cppad/local/optimize/record_vv.hpp>
 # include <cppad/local/optimize/record_csum.hpp>
+# include <cppad/local/optimize/simplify_run.hpp>
+# include <cppad/local/optimize/renumber_run.hpp>
+# include <cppad/utility/elapsed_seconds.hpp>
 
 /*!
 \file optimize_run.hpp
@@ -34,6 +39,22 @@ Convert a player object to an optimized recorder object
 // BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
 namespace CppAD { namespace local { namespace optimize  {
 
+/*!
+Elapsed seconds since a previous time.
+
+\param time [in,out]
+On input, it is a previous value returned by elapsed_seconds.
+Upon return, it is the current value returned by elapsed_seconds.
+
+\return
+is the difference between the output and input values of time.
+*/
+inline double optimize_time(double& time)
+{	double previous = time;
+	time            = elapsed_seconds();
+	return time - previous;
+}
+
 /*!
 Convert a player object to an optimized recorder object
 
@@ -64,6 +85,18 @@ If the sub-string "no_print_for" appears,
 then print forward (PriOp) operators will be removed from the optimized tape.
 These operators are useful for reporting problems evaluating derivatives
 at independent variable values different from those used to record a function.
+\li
+If the sub-string "simplify" appears,
+algebraic simplification and constant folding (see simplify_run)
+is done before the other optimizations.
+\li
+If the sub-string "renumber" appears,
+the operators are renumbered (see renumber_run) to improve memory locality
+before the other optimizations.
+\li
+If the sub-string "num_threads=value" appears,
+value threads are used to match operators with previous operators
+(see match_parallel). This does not change the optimized tape.
 
 \param n
 is the number of independent variables on the tape.
@@ -83,6 +116,12 @@ The input contents of this recording must be empty; i.e.,
 it corresponds to directly after the default constructor.
 Upon return, it contains an optimized verison of the
 operation sequence corresponding to \a play.
+
+\param report
+If this is null, it is not used. Otherwise, upon return,
+the counts and times for the phases of the optimization are set in *report;
+i.e., n_match, n_csum, n_cskip, time_simplify, time_renumber, time_usage,
+time_match, time_cexp, and time_record.
 */
 
 template <class Addr, class Base>
@@ -91,10 +130,16 @@ void optimize_run(
 	size_t                                     n          ,
 	vector<size_t>&                            dep_taddr  ,
 	player<Base>*                              play       ,
-	recorder<Base>*                            rec        )
+	recorder<Base>*                            rec        ,
+	optimize_report*                           report     )
 {	// check that recorder is empty
 	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
 	//
+	// start time for the current phase
+	double time = 0.0;
+	if( report != CPPAD_NULL )
+		time = elapsed_seconds();
+	//
 	// get a random iterator for this player
 	play->template setup_random<Addr>();
 	local::play::const_random_iterator<Addr> random_itr =
@@ -103,6 +148,9 @@ void optimize_run(
 	bool conditional_skip = true;
 	bool compare_op       = true;
 	bool print_for_op     = true;
+	bool simplify         = false;
+	bool renumber         = false;
+	size_t num_threads    = 1;
 	size_t index = 0;
 	while( index < options.size() )
 	{	while( index < options.size() && options[index] == ' ' )
@@ -117,12 +165,50 @@ void optimize_run(
 				compare_op = false;
 			else if( option == "no_print_for_op" )
 				print_for_op = false;
+			else if( option == "simplify" )
+				simplify = true;
+			else if( option == "renumber" )
+				renumber = true;
+			else if( option.compare(0, 12, "num_threads=") == 0 )
+			{	num_threads = size_t( std::atoi( option.c_str() + 12 ) );
+				CPPAD_ASSERT_KNOWN(
+					num_threads > 0,
+					"optimize: num_threads=value option: value is not "
+					"a positive integer"
+				);
+			}
 			else
 			{	option += " is not a valid optimize option";
 				CPPAD_ASSERT_KNOWN( false , option.c_str() );
 			}
 		}
 	}
+	// Simplified version of the operation sequence. It does not have more
+	// operators, arguments, or variables, so Addr can be used to iterate it.
+	player<Base> play_simplify;
+	if( simplify )
+	{	recorder<Base> rec_simplify;
+		simplify_run(dep_taddr, play, random_itr, &rec_simplify);
+		play_simplify.get_recording(rec_simplify, n);
+		play = &play_simplify;
+		play->template setup_random<Addr>();
+		random_itr = play->template get_random<Addr>();
+		if( report != CPPAD_NULL )
+			report->time_simplify = optimize_time(time);
+	}
+	// Renumbered version of the operation sequence. The other optimizations
+	// do not change the relative order of the operators that they keep.
+	player<Base> play_renumber;
+	if( renumber )
+	{	recorder<Base> rec_renumber;
+		renumber_run(dep_taddr, play, random_itr, &rec_renumber);
+		play_renumber.get_recording(rec_renumber, n);
+		play = &play_renumber;
+		play->template setup_random<Addr>();
+		random_itr = play->template get_random<Addr>();
+		if( report != CPPAD_NULL )
+			report->time_renumber = optimize_time(time);
+	}
 	// number of operators in the player
 	const size_t num_op = play->num_op_rec();
 	CPPAD_ASSERT_UNKNOWN(
@@ -147,6 +233,16 @@ void optimize_run(
 	// number of dynamic parameters
 	CPPAD_ASSERT_UNKNOWN( num_dynamic_ind <= play->num_dynamic_par () );
 
+	// -----------------------------------------------------------------------
+	// VecAD loads that are replaced by the value that was stored
+	pod_vector<addr_t>        forward_op;
+	pod_vector<addr_t>        forward_par;
+	get_vecad_forward(
+		play,
+		random_itr,
+		forward_op,
+		forward_par
+	);
 	// -----------------------------------------------------------------------
 	// operator information
 	pod_vector<addr_t>        cexp2op;
@@ -162,17 +258,38 @@ void optimize_run(
 		dep_taddr,
 		cexp2op,
 		cexp_set,
+		forward_op,
+		forward_par,
 		vecad_used,
 		op_usage
 	);
+	if( report != CPPAD_NULL )
+		report->time_usage = optimize_time(time);
 	pod_vector<addr_t>        op_previous;
 	get_previous(
 		play,
 		random_itr,
 		cexp_set,
 		op_previous,
-		op_usage
+		op_usage,
+		num_threads
 	);
+	if( report != CPPAD_NULL )
+	{	report->time_match = optimize_time(time);
+		for(size_t i_op = 0; i_op < num_op; ++i_op)
+		{	if( op_previous[i_op] != 0 )
+				report->n_match++;
+		}
+	}
+	// loads that are replaced by the variable that was stored
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		if( op == LdpOp && op_usage[i_op] == usage_t(yes_usage) )
+			op_previous[i_op] = forward_op[ arg[2] ];
+	}
 	size_t num_cexp = cexp2op.size();
 	CPPAD_ASSERT_UNKNOWN( conditional_skip || num_cexp == 0 );
 	vector<struct_cexp_info>  cexp_info; // struct_cexp_info not POD
@@ -191,6 +308,9 @@ void optimize_run(
 		skip_op_false
 	);
 
+	if( report != CPPAD_NULL )
+		report->time_cexp = optimize_time(time);
+
 	// We no longer need cexp_set, and cexp2op, so free their memory
 	cexp_set.resize(0, 0);
 	cexp2op.clear();
@@ -201,9 +321,12 @@ void optimize_run(
 		play,
 		random_itr,
 		op_usage,
+		forward_par,
 		vecad_used,
 		par_usage
 	);
+	if( report != CPPAD_NULL )
+		report->time_usage += optimize_time(time);
 	// -----------------------------------------------------------------------
 
 	// nan with type Base
@@ -358,6 +481,9 @@ void optimize_run(
 	// temporary work space used by record_csum
 	// (decalared here to avoid realloaction of memory)
 	struct_csum_stacks csum_work;
+	//
+	// number of cumulative summation operators formed
+	size_t n_csum = 0;
 
 	// tempory used to hold a size_pair
 	struct_size_pair size_pair;
@@ -536,6 +662,7 @@ void optimize_run(
 					rec                 ,
 					csum_work
 				);
+				++n_csum;
 				new_op[i_op]  = addr_t( size_pair.i_op );
 				new_var[i_op] = addr_t( size_pair.i_var );
 				// abort rest of this case
@@ -595,6 +722,7 @@ void optimize_run(
 					rec                 ,
 					csum_work
 				);
+				++n_csum;
 				new_op[i_op]  = addr_t( size_pair.i_op );
 				new_var[i_op] = addr_t( size_pair.i_var );
 				// abort rest of this case
@@ -641,6 +769,7 @@ void optimize_run(
 					rec                 ,
 					csum_work
 				);
+				++n_csum;
 				new_op[i_op]  = addr_t( size_pair.i_op );
 				new_var[i_op] = addr_t( size_pair.i_var );
 				// abort rest of this case
@@ -664,6 +793,24 @@ void optimize_run(
 			}
 			break;
 			// ---------------------------------------------------
+			// Cumulative summation operator (from a previous optimization)
+			case CSumOp:
+			CPPAD_ASSERT_UNKNOWN( previous == 0 );
+			CPPAD_ASSERT_NARG_NRES(op, 0, 1);
+			{	size_t n_arg = size_t( arg[4] ) + 1;
+				rec->PutArg( new_par[ arg[0] ] );
+				for(size_t i = 1; i < 5; i++)
+					rec->PutArg( arg[i] );
+				for(size_t i = 5; i < size_t( arg[2] ); i++)
+					rec->PutArg( new_var[ random_itr.var2op(arg[i]) ] );
+				for(size_t i = size_t( arg[2] ); i < size_t( arg[4] ); i++)
+					rec->PutArg( new_par[ arg[i] ] );
+				rec->PutArg( arg[n_arg - 1] );
+				new_op[i_op]  = addr_t( rec->num_op_rec() );
+				new_var[i_op] = rec->PutOp(CSumOp);
+			}
+			break;
+			// ---------------------------------------------------
 			// Conditional expression operators
 			case CExpOp:
 			CPPAD_ASSERT_UNKNOWN( previous == 0 );
@@ -823,8 +970,18 @@ void optimize_run(
 
 			// Load using a parameter index
 			case LdpOp:
-			CPPAD_ASSERT_UNKNOWN( previous == 0 );
 			CPPAD_ASSERT_NARG_NRES(op, 3, 1);
+			if( previous != 0 )
+				break;
+			if( size_t( forward_par[ arg[2] ] ) != num_par )
+			{	// replace load by the parameter that was stored
+				new_arg[0] = new_par[ forward_par[ arg[2] ] ];
+				rec->PutArg( new_arg[0] );
+				//
+				new_op[i_op]  = addr_t( rec->num_op_rec() );
+				new_var[i_op] = rec->PutOp(ParOp);
+				break;
+			}
 			new_arg[0] = new_vecad_ind[ arg[0] ];
 			new_arg[1] = arg[1];
 			CPPAD_ASSERT_UNKNOWN(
@@ -867,7 +1024,7 @@ void optimize_run(
 			CPPAD_ASSERT_UNKNOWN( previous == 0 );
 			CPPAD_ASSERT_NARG_NRES(op, 3, 0);
 			new_arg[0] = new_vecad_ind[ arg[0] ];
-			new_arg[1] = new_par[ arg[1] ];
+			new_arg[1] = arg[1];
 			new_arg[2] = new_par[ arg[2] ];
 			CPPAD_ASSERT_UNKNOWN( size_t(new_arg[0]) < num_vecad_ind );
 			rec->PutArg(
@@ -902,7 +1059,7 @@ void optimize_run(
 			CPPAD_ASSERT_UNKNOWN( previous == 0 );
 			CPPAD_ASSERT_NARG_NRES(op, 3, 0);
 			new_arg[0] = new_vecad_ind[ arg[0] ];
-			new_arg[1] = new_par[ arg[1] ];
+			new_arg[1] = arg[1];
 			new_arg[2] = new_var[ random_itr.var2op(arg[2]) ];
 			CPPAD_ASSERT_UNKNOWN( size_t(new_arg[0]) < num_vecad_ind );
 			CPPAD_ASSERT_UNKNOWN( size_t(new_arg[2]) < num_var );
@@ -1057,6 +1214,15 @@ void optimize_run(
 # endif
 		}
 	}
+	if( report != CPPAD_NULL )
+	{	report->n_csum  = n_csum;
+		report->n_cskip = 0;
+		for(size_t i = 0; i < num_cexp; i++)
+		{	if( cskip_new[i].i_arg > 0 )
+				report->n_cskip++;
+		}
+		report->time_record = optimize_time(time);
+	}
 }
 
 } } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
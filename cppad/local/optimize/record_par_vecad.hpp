@@ -0,0 +1,122 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_RECORD_PAR_VECAD_HPP
+# define CPPAD_LOCAL_OPTIMIZE_RECORD_PAR_VECAD_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*!
+\file record_par_vecad.hpp
+Record all the parameters and VecAD vectors from an old recording.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+/*!
+Record all the parameters and VecAD vectors, in the same order,
+from an old recording in a new recording.
+
+This is used by the passes that create an operation sequence that
+is then optimized; e.g., simplify_run.
+The parameters that are not used are removed by optimize_run.
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param play
+is the old recording.
+
+\param rec
+is the new recording. It must not contain any parameters or
+VecAD vectors on input.
+Upon return, the number of independent dynamic parameters in rec
+is the same as in play.
+
+\param new_par [out]
+The input size of this vector does not matter.
+Upon return, it has size play->num_par_rec() and
+maps old parameter indices to new parameter indices.
+
+\param new_vecad_ind [out]
+The input size of this vector does not matter.
+Upon return, it has size play->num_vec_ind_rec() and
+maps the old VecAD indices (arg[0] for VecAD operators) to the new indices.
+*/
+template <class Base>
+void record_par_vecad(
+	const player<Base>*  play          ,
+	recorder<Base>*      rec           ,
+	pod_vector<addr_t>&  new_par       ,
+	pod_vector<addr_t>&  new_vecad_ind )
+{	// --------------------------------------------------------------------
+	// parameters
+	size_t num_par         = play->num_par_rec();
+	size_t num_dynamic_ind = play->num_dynamic_ind();
+	const pod_vector<bool>&     dyn_par_is( play->dyn_par_is() );
+	const pod_vector<opcode_t>& dyn_par_op( play->dyn_par_op() );
+	const pod_vector<addr_t>&   dyn_par_arg( play->dyn_par_arg() );
+	//
+	rec->set_num_dynamic_ind(num_dynamic_ind);
+	new_par.resize(num_par);
+	size_t i_arg = 0;  // dynamic parameter argument index
+	size_t i_dyn = 0;  // dynamic parameter index
+	for(size_t i_par = 0; i_par < num_par; ++i_par)
+	{	Base par = play->GetPar(i_par);
+		if( ! dyn_par_is[i_par] )
+			new_par[i_par] = rec->put_con_par(par);
+		else
+		{	op_code_dyn op = op_code_dyn( dyn_par_op[i_dyn] );
+			size_t n_arg   = num_arg_dyn(op);
+			// new parameter indices for the arguments
+			// (first argument for cond_exp_dyn is a comparison operator)
+			addr_t a[5];
+			size_t k_start = size_t( op == cond_exp_dyn );
+			for(size_t k = k_start; k < n_arg; ++k)
+				a[k] = new_par[ dyn_par_arg[i_arg + k] ];
+			if( op == cond_exp_dyn )
+			{	CPPAD_ASSERT_UNKNOWN( n_arg == 5 );
+				CompareOp cop = CompareOp( dyn_par_arg[i_arg + 0] );
+				new_par[i_par] = rec->put_dyn_cond_exp(
+					par, cop, a[1], a[2], a[3], a[4]
+				);
+			}
+			else if( n_arg == 2 )
+				new_par[i_par] = rec->put_dyn_par(par, op, a[0], a[1]);
+			else if( n_arg == 1 )
+				new_par[i_par] = rec->put_dyn_par(par, op, a[0]);
+			else
+			{	CPPAD_ASSERT_UNKNOWN( op == ind_dyn && n_arg == 0 );
+				new_par[i_par] = rec->put_dyn_par(par, op);
+			}
+			++i_dyn;
+			i_arg += n_arg;
+		}
+	}
+	// --------------------------------------------------------------------
+	// VecAD vectors
+	size_t num_vecad_ind = play->num_vec_ind_rec();
+	new_vecad_ind.resize(num_vecad_ind);
+	size_t j = 0;
+	while( j < num_vecad_ind )
+	{	size_t length    = play->GetVecInd(j);
+		new_vecad_ind[j] = rec->PutVecInd(length);
+		for(size_t k = 1; k <= length; ++k)
+		{	new_vecad_ind[j+k] = rec->PutVecInd(
+				new_par[ play->GetVecInd(j+k) ]
+			);
+		}
+		j += length + 1;
+	}
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -0,0 +1,434 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_RENUMBER_RUN_HPP
+# define CPPAD_LOCAL_OPTIMIZE_RENUMBER_RUN_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/optimize/record_par_vecad.hpp>
+
+/*!
+\file renumber_run.hpp
+Renumber the operators in an operation sequence to improve memory locality.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+
+/*!
+Can an operator be moved to a different location in the operation sequence.
+
+\param op
+is the operator.
+
+\return
+is true if op has a result, its result only depends on the value
+of its arguments, and it is not part of an atomic function call.
+Other operators (e.g., store and load operators, comparison operators,
+print operators and atomic function calls) keep their relative order.
+*/
+inline bool renumber_can_move(OpCode op)
+{	if( NumRes(op) == 0 )
+		return false;
+	switch( op )
+	{	case BeginOp:
+		case InvOp:
+		case LdpOp:
+		case LdvOp:
+		case UsrrvOp:
+		return false;
+
+		default:
+		break;
+	}
+	return true;
+}
+
+/*!
+Is an argument for an operator a parameter index.
+
+\param op
+is the operator.
+
+\param arg
+are the arguments for the operator.
+
+\param is_variable
+is the value returned by arg_is_variable for this operator.
+
+\param j
+is the index of the argument.
+*/
+template <class Addr>
+bool renumber_arg_is_parameter(
+	OpCode                  op          ,
+	const Addr*             arg         ,
+	const pod_vector<bool>& is_variable ,
+	size_t                  j           )
+{	if( is_variable[j] )
+		return false;
+	switch( op )
+	{	case ParOp:
+		case UsrapOp:
+		case UsrrpOp:
+		case AddpvOp:
+		case DivpvOp:
+		case EqpvOp:
+		case LepvOp:
+		case LtpvOp:
+		case MulpvOp:
+		case NepvOp:
+		case PowpvOp:
+		case SubpvOp:
+		case ZmulpvOp:
+		return j == 0;
+
+		case DivvpOp:
+		case LevpOp:
+		case LtvpOp:
+		case PowvpOp:
+		case SubvpOp:
+		case ZmulvpOp:
+		return j == 1;
+
+		case EqppOp:
+		case LeppOp:
+		case LtppOp:
+		case NeppOp:
+		return true;
+
+		case ErfOp:
+		return j > 0;
+
+		case StppOp:
+		case StvpOp:
+		return j == 2;
+
+		case PriOp:
+		return j == 1 || j == 3;
+
+		case CExpOp:
+		return j >= 2;
+
+		case CSumOp:
+		return j == 0 || ( size_t(arg[2]) <= j && j < size_t(arg[4]) );
+
+		default:
+		break;
+	}
+	return false;
+}
+
+/*!
+Determine a locality improving order for the operators.
+
+The operators that cannot be moved (see renumber_can_move) are kept in
+the same relative order. Just before one of these operators,
+and before the EndOp, the operators that compute its arguments
+(and that have not yet been placed) are placed in depth first order;
+i.e., the arguments for an operator are computed just before the operator.
+This keeps each result close to the operators that use it.
+Operators that are not needed by the EndOp, or by an operator that
+cannot be moved, are not included (they are not used).
+CSkipOp operators are not included.
+
+\tparam Addr
+Type used by random iterator for the player.
+
+\param dep_taddr
+is a vector of variable indices for the dependent variables.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param order [out]
+The input size of this vector does not matter.
+Upon return, order[k] is the old index of the operator that
+has index k in the new operation sequence.
+*/
+template <class Addr>
+void get_renumber_order(
+	const vector<size_t>&                     dep_taddr  ,
+	const play::const_random_iterator<Addr>&  random_itr ,
+	pod_vector<size_t>&                       order      )
+{	size_t num_op = random_itr.num_op();
+	//
+	// state of each operator; 0 not visited, 1 visited (arguments are
+	// on the stack), 2 placed in order
+	pod_vector<unsigned char> state(num_op);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+		state[i_op] = 0;
+	//
+	// stack for the depth first search, variables for the current operator
+	pod_vector<size_t> stack, variable;
+	pod_vector<bool>   is_variable;
+	//
+	order.resize(0);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		//
+		// operators that are placed when they are needed
+		if( renumber_can_move(op) || op == CSkipOp )
+			continue;
+		//
+		// operators that are placed in this iteration
+		size_t start_op = i_op;
+		size_t end_op   = i_op + 1;
+		if( op == UserOp )
+		{	// all the operators in this atomic function call
+			OpCode op_j = NumberOp;
+			while( op_j != UserOp )
+				op_j = random_itr.get_op(end_op++);
+		}
+		//
+		// variables that must be computed before this iteration
+		variable.resize(0);
+		for(size_t j_op = start_op; j_op < end_op; ++j_op)
+		{	random_itr.op_info(j_op, op, arg, i_var);
+			if( op == EndOp )
+			{	for(size_t i = 0; i < dep_taddr.size(); ++i)
+					variable.push_back( dep_taddr[i] );
+			}
+			else
+			{	arg_is_variable(op, arg, is_variable);
+				for(size_t j = 0; j < is_variable.size(); ++j)
+				{	if( is_variable[j] )
+						variable.push_back( size_t(arg[j]) );
+				}
+			}
+		}
+		// depth first search that places the operators for these variables
+		// (in reverse order so first variable is placed first)
+		for(size_t k = variable.size(); k > 0; --k)
+			stack.push_back( random_itr.var2op( variable[k-1] ) );
+		while( stack.size() > 0 )
+		{	size_t j_op = stack[ stack.size() - 1 ];
+			if( state[j_op] == 2 )
+				stack.resize( stack.size() - 1 );
+			else if( state[j_op] == 1 )
+			{	// all the arguments for this operator have been placed
+				stack.resize( stack.size() - 1 );
+				order.push_back(j_op);
+				state[j_op] = 2;
+			}
+			else
+			{	// place the arguments before this operator
+				state[j_op] = 1;
+				random_itr.op_info(j_op, op, arg, i_var);
+				CPPAD_ASSERT_UNKNOWN( renumber_can_move(op) );
+				arg_is_variable(op, arg, is_variable);
+				for(size_t j = is_variable.size(); j > 0; --j)
+				{	if( is_variable[j-1] )
+					{	size_t k_op = random_itr.var2op( size_t(arg[j-1]) );
+						// operators that cannot move have already been placed
+						// and state[k_op] == 1 would imply a cycle
+						CPPAD_ASSERT_UNKNOWN( state[k_op] != 1 );
+						if( state[k_op] == 0 )
+							stack.push_back(k_op);
+					}
+				}
+			}
+		}
+		// place the operators for this iteration
+		for(size_t j_op = start_op; j_op < end_op; ++j_op)
+		{	order.push_back(j_op);
+			state[j_op] = 2;
+		}
+		i_op = end_op - 1;
+	}
+	return;
+}
+
+/*!
+Record a copy of an operator in a new recording.
+
+\tparam Addr
+Type used by random iterator for the player.
+
+\tparam Base
+base type for the operator.
+
+\param play
+is the old operation sequence.
+
+\param random_itr
+is a random iterator for the operation sequence in play.
+
+\param new_par
+maps old parameter indices to new parameter indices
+(see record_par_vecad).
+
+\param new_vecad_ind
+maps old VecAD indices to new VecAD indices
+(see record_par_vecad).
+
+\param new_var
+maps old operator indices to the new variable index for the primary result
+of the operator. It must be non-zero for the operators that compute the
+variable arguments for this operator.
+
+\param i_op
+is the index of the operator in the old operation sequence.
+It must not be a CSkipOp operator.
+
+\param is_variable
+work space used to hold the value returned by arg_is_variable.
+
+\param rec
+is the new recording.
+
+\return
+is the value returned by rec->PutOp (or rec->PutLoadOp); i.e.,
+the new variable index for the primary result of the operator
+(if it has a result).
+*/
+template <class Addr, class Base>
+addr_t renumber_record_op(
+	const player<Base>*                        play          ,
+	const play::const_random_iterator<Addr>&   random_itr    ,
+	const pod_vector<addr_t>&                  new_par       ,
+	const pod_vector<addr_t>&                  new_vecad_ind ,
+	const pod_vector<addr_t>&                  new_var       ,
+	size_t                                     i_op          ,
+	pod_vector<bool>&                          is_variable   ,
+	recorder<Base>*                            rec           )
+{	OpCode        op;
+	const addr_t* arg;
+	size_t        i_var;
+	random_itr.op_info(i_op, op, arg, i_var);
+	CPPAD_ASSERT_UNKNOWN( op != CSkipOp );
+	arg_is_variable(op, arg, is_variable);
+	//
+	// true number of arguments
+	size_t n_arg = is_variable.size();
+	if( op == CSumOp )
+		n_arg = size_t( arg[4] ) + 1;
+	//
+	for(size_t j = 0; j < n_arg; ++j)
+	{	addr_t new_arg = arg[j];
+		if( j < is_variable.size() && is_variable[j] )
+		{	new_arg = new_var[ random_itr.var2op( size_t(arg[j]) ) ];
+			CPPAD_ASSERT_UNKNOWN( 0 < new_arg );
+		}
+		else if( j < is_variable.size() &&
+			renumber_arg_is_parameter(op, arg, is_variable, j) )
+		{	new_arg = new_par[ arg[j] ];
+		}
+		else switch( op )
+		{	case PriOp:
+			if( j == 2 || j == 4 )
+				new_arg = rec->PutTxt( play->GetTxt( size_t(arg[j]) ) );
+			break;
+
+			case LdpOp:
+			case LdvOp:
+			if( j == 2 )
+				new_arg = addr_t( rec->num_load_op_rec() );
+			// fall through
+			case StppOp:
+			case StpvOp:
+			case StvpOp:
+			case StvvOp:
+			if( j == 0 )
+				new_arg = new_vecad_ind[ arg[0] ];
+			break;
+
+			default:
+			break;
+		}
+		rec->PutArg( size_t(new_arg) );
+	}
+	if( op == LdpOp || op == LdvOp )
+		return rec->PutLoadOp(op);
+	return rec->PutOp(op);
+}
+
+/*!
+Renumber the operators in an operation sequence to improve memory locality.
+
+The operators are placed in the order determined by get_renumber_order.
+Forward and reverse mode sweeps access the values for the arguments of
+an operator; e.g., the Taylor coefficients. Placing the operators that
+compute these values close to the operator that uses them reduces the
+distance between these memory accesses.
+
+\tparam Addr
+Type to use with player random iterators. Must correspond to the
+result for play->addr_type().
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param dep_taddr
+On input this vector contains the indices for each of the dependent
+variable values in the operation sequence corresponding to \a play.
+Upon return it contains the indices for the same variables but in
+the operation sequence corresponding to \a rec.
+
+\param play
+This is the operation sequence that we are renumbering.
+
+\param random_itr
+is a random iterator for the operation sequence in play.
+
+\param rec
+The input contents of this recording must be empty.
+Upon return, it contains the renumbered operation sequence.
+It has the same parameters and VecAD vectors as play.
+It does not have more operators, arguments, or variables than play,
+so \a Addr can also be used for its random iterator.
+It does not contain any CSkipOp operators.
+*/
+template <class Addr, class Base>
+void renumber_run(
+	vector<size_t>&                            dep_taddr  ,
+	const player<Base>*                        play       ,
+	const play::const_random_iterator<Addr>&   random_itr ,
+	recorder<Base>*                            rec        )
+{	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
+	//
+	// parameters and VecAD vectors (kept in the same order)
+	pod_vector<addr_t> new_par, new_vecad_ind;
+	record_par_vecad(play, rec, new_par, new_vecad_ind);
+	//
+	// new order for the operators
+	pod_vector<size_t> order;
+	get_renumber_order(dep_taddr, random_itr, order);
+	//
+	// mapping from old operator index to new variable index for its
+	// primary result
+	size_t num_op = random_itr.num_op();
+	pod_vector<addr_t> new_var(num_op);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+		new_var[i_op] = 0;
+	//
+	pod_vector<bool> is_variable;
+	for(size_t k = 0; k < order.size(); ++k)
+	{	size_t i_op   = order[k];
+		new_var[i_op] = renumber_record_op(
+			play, random_itr, new_par, new_vecad_ind, new_var, i_op,
+			is_variable, rec
+		);
+	}
+	// dependent variables
+	for(size_t i = 0; i < dep_taddr.size(); ++i)
+	{	size_t j_op  = random_itr.var2op( dep_taddr[i] );
+		dep_taddr[i] = size_t( new_var[j_op] );
+		CPPAD_ASSERT_UNKNOWN( 0 < dep_taddr[i] );
+	}
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -0,0 +1,800 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_REROLL_RUN_HPP
+# define CPPAD_LOCAL_OPTIMIZE_REROLL_RUN_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/optimize/renumber_run.hpp>
+
+/*!
+\file reroll_run.hpp
+Replace repeated segments of an operation sequence by atomic function calls.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+
+/*!
+A group of consecutive segments of an operation sequence that are
+isomorphic; i.e., each segment computes the same function of its arguments.
+*/
+struct reroll_group {
+	/// index of the first operator in the first segment
+	size_t start_op;
+	/// number of operators in each segment
+	size_t n_op;
+	/// number of segments in this group
+	size_t n_repeat;
+	/// number of arguments for the function corresponding to a segment
+	size_t n_in;
+	/// number of results for the function corresponding to a segment
+	size_t n_out;
+};
+
+/*!
+Can an operator be part of a repeated segment.
+
+\param play
+is the operation sequence.
+
+\param op
+is the operator.
+
+\param arg
+are the arguments for the operator.
+
+\param is_variable
+work space used to hold the value returned by arg_is_variable.
+
+\return
+is true if op has a result, its result only depends on the value of
+its arguments, all of its arguments are variables or constant parameters,
+and it has a fixed number of arguments.
+*/
+template <class Base>
+bool reroll_can_repeat(
+	const player<Base>*  play        ,
+	OpCode               op          ,
+	const addr_t*        arg         ,
+	pod_vector<bool>&    is_variable )
+{	if( ! renumber_can_move(op) )
+		return false;
+	switch( op )
+	{	case CExpOp:
+		case CSumOp:
+		case DisOp:
+		return false;
+
+		default:
+		break;
+	}
+	const pod_vector<bool>& dyn_par_is( play->dyn_par_is() );
+	arg_is_variable(op, arg, is_variable);
+	for(size_t j = 0; j < is_variable.size(); ++j)
+	{	if( ! is_variable[j] )
+		{	CPPAD_ASSERT_UNKNOWN(
+				renumber_arg_is_parameter(op, arg, is_variable, j)
+			);
+			if( dyn_par_is[ arg[j] ] )
+				return false;
+		}
+	}
+	return true;
+}
+
+/*!
+Information about the first segment in a group of repeated segments,
+and checking if other segments are isomorphic to the first segment.
+
+A variable argument, for an operator in a segment, is internal if it is
+the result of an operator in the segment, otherwise it is external.
+The external arguments are the arguments for the function
+corresponding to the segment.
+A variable is a result for this function if it is the primary result
+of an operator in the segment and it is used after the segment,
+or it is a dependent variable.
+*/
+template <class Addr, class Base>
+class reroll_segment {
+private:
+	/// the operation sequence
+	const player<Base>*                       play_;
+	/// random iterator for the operation sequence
+	const play::const_random_iterator<Addr>&  random_itr_;
+	/// index of the last operator that uses each variable
+	/// (number of operators for dependent variables)
+	const pod_vector<size_t>&                 last_use_;
+	/// index of the first operator in the first segment
+	size_t                                    start_op_;
+	/// number of operators in a segment
+	size_t                                    n_op_;
+	/// number of arguments for the function corresponding to a segment
+	size_t                                    n_in_;
+	/// argument index for each external argument of the first segment
+	pod_vector<size_t>                        slot_input_;
+	/// is the primary result of each operator in the first segment
+	/// a result of the function (for any of the segments checked so far)
+	pod_vector<bool>                          is_output_;
+	/// variable for each argument of the segment most recently checked
+	pod_vector<size_t>                        input_var_;
+	/// argument index for each variable (num_var if not an argument)
+	pod_vector<size_t>                        var_input_;
+	/// work space used to hold values returned by arg_is_variable
+	pod_vector<bool>                          is_variable_;
+	/// external arguments that were split from their argument index
+	/// by the most recent call to match
+	pod_vector<size_t>                        split_slot_;
+	/// argument index, before the split, for each element of split_slot_
+	pod_vector<size_t>                        split_input_;
+	/// argument index that each new argument was split from
+	pod_vector<size_t>                        split_from_;
+	// ------------------------------------------------------------------------
+	/// index of the first variable that is a result of the segment that
+	/// starts at operator start
+	size_t first_var(size_t start) const
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr_.op_info(start, op, arg, i_var);
+		CPPAD_ASSERT_UNKNOWN( NumRes(op) > 0 );
+		return i_var + 1 - NumRes(op);
+	}
+public:
+	/*!
+	constructor
+
+	\param play
+	is the operation sequence.
+
+	\param random_itr
+	is a random iterator for the operation sequence.
+
+	\param last_use
+	is the index of the last operator that uses each variable
+	(number of operators for dependent variables).
+	If this vector is empty, the results of the function are not computed;
+	i.e., is_output(k) and n_out() are not valid.
+	*/
+	reroll_segment(
+		const player<Base>*                       play       ,
+		const play::const_random_iterator<Addr>&  random_itr ,
+		const pod_vector<size_t>&                 last_use   )
+	: play_(play)
+	, random_itr_(random_itr)
+	, last_use_(last_use)
+	, start_op_(0)
+	, n_op_(0)
+	, n_in_(0)
+	{	size_t num_var = random_itr.num_var();
+		var_input_.resize(num_var);
+		for(size_t i = 0; i < num_var; ++i)
+			var_input_[i] = num_var;
+	}
+	/// number of arguments for the function corresponding to a segment
+	size_t n_in(void) const
+	{	return n_in_; }
+	/// number of results for the function corresponding to a segment
+	size_t n_out(void) const
+	{	size_t count = 0;
+		for(size_t k = 0; k < n_op_; ++k)
+			count += size_t( is_output_[k] );
+		return count;
+	}
+	/// is the primary result of an operator in the first segment a result
+	bool is_output(size_t k) const
+	{	return is_output_[k]; }
+	/// variable for each argument of the segment most recently checked
+	const pod_vector<size_t>& input_var(void) const
+	{	return input_var_; }
+	/// argument index for each external argument of the first segment
+	const pod_vector<size_t>& slot_input(void) const
+	{	return slot_input_; }
+	/// undo the splits by the most recent call to match
+	bool undo_split(size_t n_in)
+	{	for(size_t i = 0; i < split_slot_.size(); ++i)
+			slot_input_[ split_slot_[i] ] = split_input_[i];
+		n_in_ = n_in;
+		return false;
+	}
+	// ------------------------------------------------------------------------
+	/*!
+	Set the first segment.
+
+	\param start_op
+	is the index of the first operator in the first segment.
+
+	\param n_op
+	is the number of operators in each segment.
+	All of these operators must satisfy reroll_can_repeat
+	(or split_can_move when there is only one segment).
+	*/
+	void set_first(size_t start_op, size_t n_op)
+	{	size_t num_var = random_itr_.num_var();
+		start_op_      = start_op;
+		n_op_          = n_op;
+		n_in_          = 0;
+		slot_input_.resize(0);
+		input_var_.resize(0);
+		is_output_.resize(n_op);
+		//
+		size_t start_var = first_var(start_op);
+		size_t end_op    = start_op + n_op;
+		for(size_t i_op = start_op; i_op < end_op; ++i_op)
+		{	OpCode        op;
+			const addr_t* arg;
+			size_t        i_var;
+			random_itr_.op_info(i_op, op, arg, i_var);
+			arg_is_variable(op, arg, is_variable_);
+			for(size_t j = 0; j < is_variable_.size(); ++j)
+			{	size_t a = size_t( arg[j] );
+				if( is_variable_[j] && a < start_var )
+				{	if( var_input_[a] == num_var )
+					{	var_input_[a] = n_in_++;
+						input_var_.push_back(a);
+					}
+					slot_input_.push_back( var_input_[a] );
+				}
+			}
+			is_output_[i_op - start_op] = false;
+			if( last_use_.size() > 0 )
+				is_output_[i_op - start_op] = end_op <= last_use_[i_var];
+		}
+		// restore var_input_
+		for(size_t k = 0; k < n_in_; ++k)
+			var_input_[ input_var_[k] ] = num_var;
+	}
+	// ------------------------------------------------------------------------
+	/*!
+	Check if a segment is isomorphic to the first segment.
+
+	\param start_k
+	is the index of the first operator in the segment that is checked.
+	The operators in this segment must satisfy reroll_can_repeat.
+	If two external arguments of the first segment are the same variable,
+	and they are different variables for this segment, they are split into
+	different arguments for the function (this is undone if the return
+	value is false).
+
+	\return
+	is true if the segment is isomorphic to the first segment.
+	In this case, the primary results of the operators in this segment
+	that are used after this segment are added to the function results,
+	and input_var() is the arguments for this segment.
+	*/
+	bool match(size_t start_k)
+	{	size_t num_var   = random_itr_.num_var();
+		size_t start_var = first_var(start_op_);
+		size_t start_k_var = first_var(start_k);
+		size_t n_in        = n_in_;
+		input_var_.resize(n_in_);
+		for(size_t k = 0; k < n_in_; ++k)
+			input_var_[k] = num_var;
+		split_slot_.resize(0);
+		split_input_.resize(0);
+		split_from_.resize(0);
+		//
+		size_t slot = 0;
+		for(size_t k = 0; k < n_op_; ++k)
+		{	OpCode        op, op_k;
+			const addr_t* arg;
+			const addr_t* arg_k;
+			size_t        i_var, i_var_k;
+			random_itr_.op_info(start_op_ + k, op,   arg,   i_var);
+			random_itr_.op_info(start_k   + k, op_k, arg_k, i_var_k);
+			if( op != op_k )
+				return undo_split(n_in);
+			arg_is_variable(op, arg, is_variable_);
+			for(size_t j = 0; j < is_variable_.size(); ++j)
+			{	size_t a   = size_t( arg[j] );
+				size_t a_k = size_t( arg_k[j] );
+				if( ! is_variable_[j] )
+				{	// constant parameters
+					if( a != a_k && ! IdenticalEqualCon(
+						play_->GetPar(a), play_->GetPar(a_k) )
+					)	return undo_split(n_in);
+				}
+				else if( start_var <= a )
+				{	// internal variables
+					if( a_k < start_k_var )
+						return undo_split(n_in);
+					if( a - start_var != a_k - start_k_var )
+						return undo_split(n_in);
+				}
+				else
+				{	// external variables
+					if( start_k_var <= a_k )
+						return undo_split(n_in);
+					size_t q = slot_input_[slot];
+					if( input_var_[q] == num_var )
+						input_var_[q] = a_k;
+					else if( input_var_[q] != a_k )
+					{	// split this argument from q
+						size_t q_new = n_in;
+						while( q_new < n_in_ && (
+							split_from_[q_new - n_in] != q ||
+							input_var_[q_new] != a_k
+						) ) ++q_new;
+						if( q_new == n_in_ )
+						{	++n_in_;
+							input_var_.push_back(a_k);
+							split_from_.push_back(q);
+						}
+						split_slot_.push_back(slot);
+						split_input_.push_back(q);
+						slot_input_[slot] = q_new;
+					}
+					++slot;
+				}
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( slot == slot_input_.size() );
+		//
+		// results of the function for this segment
+		size_t end_k = start_k + n_op_;
+		if( last_use_.size() > 0 )
+		{	for(size_t k = 0; k < n_op_; ++k)
+			{	OpCode        op;
+				const addr_t* arg;
+				size_t        i_var;
+				random_itr_.op_info(start_k + k, op, arg, i_var);
+				is_output_[k] |= end_k <= last_use_[i_var];
+			}
+		}
+		return true;
+	}
+	// ------------------------------------------------------------------------
+	/*!
+	Set the first segment and check the other segments in a group.
+
+	\param start_op
+	is the index of the first operator in the first segment.
+
+	\param n_op
+	is the number of operators in each segment.
+
+	\param n_repeat
+	is the number of segments in the group.
+
+	\return
+	is the number of segments, at the beginning of the group,
+	that are isomorphic to the first segment.
+	Upon return, the arguments of the function correspond to these segments.
+	*/
+	size_t set_group(size_t start_op, size_t n_op, size_t n_repeat)
+	{	set_first(start_op, n_op);
+		for(size_t k = 1; k < n_repeat; ++k)
+		{	if( ! match(start_op + k * n_op) )
+				return k;
+		}
+		return n_repeat;
+	}
+};
+
+/*!
+Determine the groups of isomorphic segments that are replaced by
+atomic function calls.
+
+\param max_op
+is the maximum number of operators in a segment.
+
+\param dep_taddr
+is a vector of variable indices for the dependent variables.
+
+\param play
+is the operation sequence.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param group [out]
+The input size of this vector does not matter.
+Upon return, it contains the groups in increasing order of their
+first operator. The segments in different groups do not overlap.
+Each group has at least two segments and replacing its segments by
+calls to the corresponding function reduces the total number of operators
+(including the operators for the function).
+
+\param is_output [out]
+The input size of this vector does not matter.
+Upon return, it has size equal to the number of operators.
+If i_op is an operator in the first segment of a group,
+is_output[i_op] is true if the primary result for i_op is a result
+of the function corresponding to the group.
+*/
+template <class Addr, class Base>
+void reroll_find(
+	size_t                                    max_op     ,
+	const vector<size_t>&                     dep_taddr  ,
+	const player<Base>*                       play       ,
+	const play::const_random_iterator<Addr>&  random_itr ,
+	vector<reroll_group>&                     group      ,
+	pod_vector<bool>&                         is_output  )
+{	size_t num_op  = random_itr.num_op();
+	size_t num_var = random_itr.num_var();
+	group.resize(0);
+	is_output.resize(num_op);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+		is_output[i_op] = false;
+	//
+	// last_use
+	pod_vector<size_t> last_use(num_var);
+	for(size_t i_var = 0; i_var < num_var; ++i_var)
+		last_use[i_var] = 0;
+	//
+	// code for each operator that can repeat (zero for other operators)
+	// depends on the operator and the value of its parameter arguments
+	pod_vector<size_t> code(num_op);
+	pod_vector<bool>   is_variable;
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		//
+		arg_is_variable(op, arg, is_variable);
+		for(size_t j = 0; j < is_variable.size(); ++j)
+		{	if( is_variable[j] )
+				last_use[ arg[j] ] = i_op;
+		}
+		code[i_op] = 0;
+		if( reroll_can_repeat(play, op, arg, is_variable) )
+		{	size_t c = size_t(op);
+			for(size_t j = 0; j < is_variable.size(); ++j)
+			{	if( ! is_variable[j] )
+					c = 31 * c + hash_code( play->GetPar( size_t(arg[j]) ) );
+			}
+			code[i_op] = c + 1;
+		}
+	}
+	for(size_t i = 0; i < dep_taddr.size(); ++i)
+		last_use[ dep_taddr[i] ] = num_op;
+	//
+	// next_op[i_op] is the next operator with the same hash code for code
+	// (num_op if there is no such operator)
+	pod_vector<size_t> next_op(num_op);
+	pod_vector<size_t> table(CPPAD_HASH_TABLE_SIZE);
+	for(size_t h = 0; h < CPPAD_HASH_TABLE_SIZE; ++h)
+		table[h] = num_op;
+	for(size_t i_op = num_op; i_op > 0; --i_op)
+	{	size_t h        = code[i_op-1] % CPPAD_HASH_TABLE_SIZE;
+		next_op[i_op-1] = table[h];
+		table[h]        = i_op - 1;
+	}
+	//
+	// polynomial hash of code for the first i_op operators (prefix[i_op]),
+	// the corresponding powers, and number of operators that cannot repeat
+	// (n_fixed[i_op])
+	const size_t base = 1000003;
+	pod_vector<size_t> prefix(num_op + 1), power(num_op + 1), n_fixed(num_op + 1);
+	prefix[0]  = 0;
+	power[0]   = 1;
+	n_fixed[0] = 0;
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	prefix[i_op+1]  = prefix[i_op] + code[i_op] * power[i_op];
+		power[i_op+1]   = power[i_op] * base;
+		n_fixed[i_op+1] = n_fixed[i_op] + size_t( code[i_op] == 0 );
+	}
+	//
+	// maximum number of candidate segment lengths checked for each operator
+	const size_t max_try = 32;
+	//
+	reroll_segment<Addr, Base> segment(play, random_itr, last_use);
+	size_t i_op = 0;
+	while( i_op < num_op )
+	{	size_t best_n_op    = 0;
+		size_t best_repeat  = 0;
+		size_t best_cover   = 0;
+		size_t j_op         = next_op[i_op];
+		size_t n_try        = 0;
+		bool   candidate    = code[i_op] != 0;
+		while( candidate && j_op < num_op && n_try < max_try )
+		{	size_t n_op = j_op - i_op;
+			// all the operators in [i_op, j_op) must be able to repeat
+			candidate = n_op <= max_op && n_fixed[i_op] == n_fixed[j_op];
+			++n_try;
+			//
+			// number of segments in this group
+			size_t n_repeat = 1;
+			size_t n_out    = 0;
+			size_t n_call   = 0;
+			size_t k_op     = j_op;
+			bool   more     = candidate;
+			if( more )
+				segment.set_first(i_op, n_op);
+			while( more )
+			{	// check for an isomorphic segment starting at k_op
+				more = k_op + n_op <= num_op;
+				more = more && n_fixed[k_op] == n_fixed[k_op + n_op];
+				more = more &&
+					(prefix[i_op + n_op] - prefix[i_op]) * power[k_op] ==
+					(prefix[k_op + n_op] - prefix[k_op]) * power[i_op];
+				more = more && segment.match(k_op);
+				if( more )
+				{	// number of operators for each function call
+					size_t n_out_k  = segment.n_out();
+					size_t n_call_k = 2 + segment.n_in() + n_out_k;
+					// stop at the previous repeat when this one makes
+					// the call as long as the segment
+					more = n_call_k < n_op;
+					if( more )
+					{	++n_repeat;
+						k_op  += n_op;
+						n_out  = n_out_k;
+						n_call = n_call_k;
+					}
+				}
+			}
+			if( candidate && n_repeat > 1 && n_out > 0 )
+			{	// reduction in number of operators must be more than the
+				// number of operators in the function
+				bool reduce = n_repeat * (n_op - n_call) > n_op;
+				//
+				// choose the candidate that covers the most operators
+				// (smallest segment when there is a tie)
+				if( reduce && n_repeat * n_op > best_cover )
+				{	best_n_op   = n_op;
+					best_repeat = n_repeat;
+					best_cover  = n_repeat * n_op;
+				}
+			}
+			j_op = next_op[j_op];
+		}
+		if( best_n_op == 0 )
+			++i_op;
+		else
+		{	// recompute the results for the best choice
+			size_t n_repeat = segment.set_group(i_op, best_n_op, best_repeat);
+			CPPAD_ASSERT_UNKNOWN( n_repeat == best_repeat );
+			best_repeat = n_repeat;
+			reroll_group info;
+			info.start_op = i_op;
+			info.n_op     = best_n_op;
+			info.n_repeat = best_repeat;
+			info.n_in     = segment.n_in();
+			info.n_out    = segment.n_out();
+			group.push_back(info);
+			for(size_t k = 0; k < best_n_op; ++k)
+				is_output[i_op + k] = segment.is_output(k);
+			//
+			i_op += best_n_op * best_repeat;
+		}
+	}
+	return;
+}
+
+/*!
+Record the function corresponding to a group of repeated segments.
+
+\param play
+is the operation sequence.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param info
+is the group of segments.
+
+\param is_output
+is the value returned by reroll_find.
+
+\param rec [out]
+The input contents of this recording must be empty.
+Upon return, it contains the operation sequence for the function.
+
+\param dep_taddr [out]
+The input size of this vector does not matter.
+Upon return, it contains the indices in rec for the results of the function.
+*/
+template <class Addr, class Base>
+void reroll_record_body(
+	const player<Base>*                       play       ,
+	const play::const_random_iterator<Addr>&  random_itr ,
+	const reroll_group&                       info       ,
+	const pod_vector<bool>&                   is_output  ,
+	recorder<Base>*                           rec        ,
+	vector<size_t>&                           dep_taddr  )
+{	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
+	//
+	// argument index for each external argument of the first segment
+	pod_vector<size_t> last_use(0);
+	reroll_segment<Addr, Base> segment(play, random_itr, last_use);
+	size_t n_repeat = segment.set_group(info.start_op, info.n_op, info.n_repeat);
+	CPPAD_ASSERT_UNKNOWN( n_repeat == info.n_repeat );
+	if( n_repeat != info.n_repeat ) // avoid warning when NDEBUG is defined
+		return;
+	const pod_vector<size_t>& slot_input( segment.slot_input() );
+	CPPAD_ASSERT_UNKNOWN( segment.n_in() == info.n_in );
+	//
+	// independent variables
+	CPPAD_ASSERT_NARG_NRES(BeginOp, 1, 1);
+	rec->PutOp(BeginOp);
+	rec->PutArg(0);
+	CPPAD_ASSERT_NARG_NRES(InvOp, 0, 1);
+	for(size_t j = 0; j < info.n_in; ++j)
+		rec->PutOp(InvOp);
+	//
+	// mapping from operators in the first segment to new variable index
+	pod_vector<addr_t> new_var(info.n_op);
+	//
+	// first variable in the segment
+	OpCode        op;
+	const addr_t* arg;
+	size_t        i_var;
+	random_itr.op_info(info.start_op, op, arg, i_var);
+	size_t start_var = i_var + 1 - NumRes(op);
+	//
+	pod_vector<bool> is_variable;
+	size_t slot = 0;
+	dep_taddr.resize(0);
+	for(size_t k = 0; k < info.n_op; ++k)
+	{	random_itr.op_info(info.start_op + k, op, arg, i_var);
+		arg_is_variable(op, arg, is_variable);
+		for(size_t j = 0; j < is_variable.size(); ++j)
+		{	size_t a = size_t( arg[j] );
+			if( op == CSumOp && 0 < j && j < 5 )
+				rec->PutArg(a); // end of each type of argument
+			else if( ! is_variable[j] )
+				rec->PutArg( size_t( rec->put_con_par( play->GetPar(a) ) ) );
+			else if( start_var <= a )
+			{	size_t k_op = random_itr.var2op(a) - info.start_op;
+				rec->PutArg( size_t( new_var[k_op] ) );
+			}
+			else
+				rec->PutArg( 1 + slot_input[slot++] );
+		}
+		if( op == CSumOp )
+		{	// number of arguments (see split_can_move)
+			CPPAD_ASSERT_UNKNOWN( arg[2] == arg[4] );
+			rec->PutArg( size_t( arg[4] ) );
+		}
+		new_var[k] = rec->PutOp(op);
+		if( is_output[info.start_op + k] )
+			dep_taddr.push_back( size_t( new_var[k] ) );
+	}
+	CPPAD_ASSERT_UNKNOWN( slot == slot_input.size() );
+	CPPAD_ASSERT_NARG_NRES(EndOp, 0, 0);
+	rec->PutOp(EndOp);
+	CPPAD_ASSERT_UNKNOWN( dep_taddr.size() == info.n_out );
+	return;
+}
+
+/*!
+Replace groups of repeated segments by atomic function calls.
+
+\tparam Addr
+Type used by random iterator for the player.
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param dep_taddr
+On input this vector contains the indices for each of the dependent
+variable values in the operation sequence corresponding to \a play.
+Upon return it contains the indices for the same variables but in
+the operation sequence corresponding to \a rec.
+
+\param play
+This is the old operation sequence.
+
+\param random_itr
+is a random iterator for the operation sequence in play.
+
+\param group
+is the groups of segments returned by reroll_find.
+
+\param is_output
+is the vector returned by reroll_find.
+
+\param atom_index
+atom_index[i_group] is the index, in the list of atomic functions,
+for the function corresponding to group[i_group].
+
+\param rec
+The input contents of this recording must be empty.
+Upon return, it contains the new operation sequence.
+It has the same parameters and VecAD vectors as play.
+It does not contain any CSkipOp operators.
+*/
+template <class Addr, class Base>
+void reroll_run(
+	vector<size_t>&                            dep_taddr  ,
+	const player<Base>*                        play       ,
+	const play::const_random_iterator<Addr>&   random_itr ,
+	const vector<reroll_group>&                group      ,
+	const pod_vector<bool>&                    is_output  ,
+	const vector<size_t>&                      atom_index ,
+	recorder<Base>*                            rec        )
+{	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
+	CPPAD_ASSERT_UNKNOWN( group.size() == atom_index.size() );
+	//
+	// parameters and VecAD vectors (kept in the same order)
+	pod_vector<addr_t> new_par, new_vecad_ind;
+	record_par_vecad(play, rec, new_par, new_vecad_ind);
+	//
+	// mapping from old operator index to new variable index for its
+	// primary result
+	size_t num_op = random_itr.num_op();
+	pod_vector<addr_t> new_var(num_op);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+		new_var[i_op] = 0;
+	//
+	pod_vector<size_t> last_use(0);
+	reroll_segment<Addr, Base> segment(play, random_itr, last_use);
+	pod_vector<bool> is_variable;
+	size_t i_group = 0;
+	size_t i_op    = 0;
+	while( i_op < num_op )
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		//
+		if( i_group < group.size() && group[i_group].start_op == i_op )
+		{	const reroll_group& info( group[i_group] );
+			size_t n_repeat =
+				segment.set_group(info.start_op, info.n_op, info.n_repeat);
+			CPPAD_ASSERT_UNKNOWN( n_repeat == info.n_repeat );
+			CPPAD_ASSERT_UNKNOWN( segment.n_in() == info.n_in );
+			for(size_t k = 0; k < info.n_repeat; ++k)
+			{	size_t start_k = info.start_op + k * info.n_op;
+				// arguments for this segment
+				bool ok = segment.match(start_k);
+				CPPAD_ASSERT_UNKNOWN( ok && segment.n_in() == info.n_in );
+				if( ! ok ) // avoid warning when NDEBUG is defined
+					break;
+				const pod_vector<size_t>& input_var( segment.input_var() );
+				//
+				// atomic function call
+				CPPAD_ASSERT_NARG_NRES(UserOp, 4, 0);
+				rec->PutArg(atom_index[i_group], 0, info.n_in, info.n_out);
+				rec->PutOp(UserOp);
+				CPPAD_ASSERT_NARG_NRES(UsravOp, 1, 0);
+				for(size_t j = 0; j < info.n_in; ++j)
+				{	size_t j_op = random_itr.var2op( input_var[j] );
+					CPPAD_ASSERT_UNKNOWN( 0 < new_var[j_op] );
+					rec->PutArg( size_t( new_var[j_op] ) );
+					rec->PutOp(UsravOp);
+				}
+				CPPAD_ASSERT_NARG_NRES(UsrrvOp, 0, 1);
+				for(size_t j = 0; j < info.n_op; ++j)
+				{	if( is_output[info.start_op + j] )
+						new_var[start_k + j] = rec->PutOp(UsrrvOp);
+				}
+				rec->PutArg(atom_index[i_group], 0, info.n_in, info.n_out);
+				rec->PutOp(UserOp);
+			}
+			i_op += info.n_op * info.n_repeat;
+			++i_group;
+		}
+		else
+		{	if( op != CSkipOp )
+			{	new_var[i_op] = renumber_record_op(
+					play, random_itr, new_par, new_vecad_ind, new_var, i_op,
+					is_variable, rec
+				);
+			}
+			++i_op;
+		}
+	}
+	CPPAD_ASSERT_UNKNOWN( i_group == group.size() );
+	//
+	// dependent variables
+	for(size_t i = 0; i < dep_taddr.size(); ++i)
+	{	size_t j_op  = random_itr.var2op( dep_taddr[i] );
+		dep_taddr[i] = size_t( new_var[j_op] );
+		CPPAD_ASSERT_UNKNOWN( 0 < dep_taddr[i] );
+	}
+	return;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -0,0 +1,1082 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_SIMPLIFY_RUN_HPP
+# define CPPAD_LOCAL_OPTIMIZE_SIMPLIFY_RUN_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/optimize/record_par_vecad.hpp>
+
+/*!
+\file simplify_run.hpp
+Algebraic simplification and constant folding of an operation sequence.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+
+/// An operand for an operator during simplify_run
+template <class Base>
+struct struct_simplify_operand {
+	/// is this operand a variable in the new recording
+	bool   is_var;
+
+	/// is this operand a constant with a known value
+	bool   is_con;
+
+	/// If is_var, the index of this variable in the new recording.
+	/// Otherwise, if this operand is a parameter in the old recording,
+	/// the index of this parameter in the new recording.
+	addr_t index;
+
+	/// If this operand is a variable in the old recording, the index of
+	/// the operator (in the old recording) that created it,
+	/// otherwise zero.
+	size_t j_op;
+
+	/// if is_con, the value of this operand
+	Base   value;
+};
+
+/*!
+Class used to simplify an operation sequence.
+
+An operator in the old recording can be replaced by
+\li
+a constant; e.g., x - x is replaced by zero.
+The operators that use this constant are folded or
+use it as a parameter instead of a variable.
+A constant is only converted to a variable (using ParOp)
+if it is used where a variable is required; e.g., a dependent variable.
+\li
+a previous variable; e.g., x * 1 and -(-x) are replaced by x.
+\li
+a less expensive operator; e.g., pow(x, 2) is replaced by x * x
+and x - (-y) is replaced by x + y.
+*/
+template <class Addr, class Base>
+class simplify_tape {
+private:
+	typedef struct_simplify_operand<Base> operand;
+
+	/// player for the old operation sequence
+	const player<Base>*                       play_;
+
+	/// random iterator for the old operation sequence
+	const play::const_random_iterator<Addr>&  random_itr_;
+
+	/// recorder for the new operation sequence
+	recorder<Base>*                           rec_;
+
+	/// mapping from old parameter index to new parameter index
+	pod_vector<addr_t>                        new_par_;
+
+	/// Mapping from old operator index to new variable index for its
+	/// primary result. This is zero if the result is a constant that
+	/// has not been converted to a variable.
+	pod_vector<addr_t>                        new_var_;
+
+	/// is the primary result for an old operator a constant
+	pod_vector<bool>                          is_con_;
+
+	/// value of the primary result for old operators that are constants
+	vector<Base>                              con_value_;
+
+	/// If neg_var_[v] is not zero, the new variable with index v
+	/// is the negative of the new variable with index neg_var_[v].
+	pod_vector<addr_t>                        neg_var_;
+	// -----------------------------------------------------------------------
+	/// operand corresponding to a variable in the old recording
+	operand var_operand(addr_t old_var) const
+	{	operand x;
+		x.j_op   = random_itr_.var2op(old_var);
+		x.is_con = is_con_[x.j_op];
+		x.is_var = ! x.is_con;
+		x.index  = new_var_[x.j_op];
+		if( x.is_con )
+			x.value = con_value_[x.j_op];
+		CPPAD_ASSERT_UNKNOWN( 0 < x.j_op );
+		return x;
+	}
+
+	/// operand corresponding to a parameter in the old recording
+	operand par_operand(addr_t old_par) const
+	{	operand x;
+		x.j_op   = 0;
+		x.is_var = false;
+		x.index  = new_par_[old_par];
+		x.value  = play_->GetPar(old_par);
+		x.is_con = ! play_->dyn_par_is()[old_par];
+		x.is_con = x.is_con && IdenticalCon(x.value);
+		return x;
+	}
+
+	/// new variable index for the primary result of an old operator
+	/// (constants are converted to variables)
+	addr_t new_var(size_t j_op)
+	{	if( new_var_[j_op] == 0 )
+		{	CPPAD_ASSERT_UNKNOWN( is_con_[j_op] );
+			addr_t p = rec_->put_con_par( con_value_[j_op] );
+			rec_->PutArg(p);
+			new_var_[j_op] = rec_->PutOp(ParOp);
+		}
+		return new_var_[j_op];
+	}
+
+	/// convert an operand, that is a variable in the old recording,
+	/// to a variable in the new recording
+	void to_var(operand& x)
+	{	CPPAD_ASSERT_UNKNOWN( 0 < x.j_op );
+		x.index  = new_var(x.j_op);
+		x.is_var = true;
+		x.is_con = false;
+	}
+
+	/// new parameter index for an operand that is not a variable
+	addr_t par_index(const operand& x)
+	{	CPPAD_ASSERT_UNKNOWN( ! x.is_var );
+		if( x.j_op != 0 )
+		{	CPPAD_ASSERT_UNKNOWN( x.is_con );
+			return rec_->put_con_par(x.value);
+		}
+		return x.index;
+	}
+
+	/// the primary result of an old operator is a constant
+	void set_con(size_t i_op, const Base& value)
+	{	is_con_[i_op]    = true;
+		con_value_[i_op] = value;
+		new_var_[i_op]   = 0;
+	}
+
+	/// the primary result of an old operator is a new variable
+	void set_var(size_t i_op, addr_t i_var)
+	{	CPPAD_ASSERT_UNKNOWN( 0 < i_var && size_t(i_var) < neg_var_.size() );
+		new_var_[i_op] = i_var;
+	}
+
+	/// the primary result of an old operator is equal to an operand
+	void set_operand(size_t i_op, const operand& x)
+	{	if( x.is_var )
+			set_var(i_op, x.index);
+		else if( x.is_con )
+			set_con(i_op, x.value);
+		else
+		{	// dynamic parameter
+			rec_->PutArg(x.index);
+			set_var(i_op, rec_->PutOp(ParOp) );
+		}
+	}
+
+	/// record an operator with two arguments
+	addr_t put_op(OpCode op, addr_t arg0, addr_t arg1)
+	{	CPPAD_ASSERT_NARG_NRES(op, 2, 1);
+		rec_->PutArg(arg0, arg1);
+		return rec_->PutOp(op);
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Value of a unary operator.
+
+	\param op
+	is the operator (with one variable argument).
+
+	\param x
+	is the value of the argument.
+
+	\param z [out]
+	is the value of the result.
+
+	\return
+	is false if the value of this operator cannot be computed
+	(because the corresponding Base function may not be available).
+	*/
+	static bool eval_unary(OpCode op, const Base& x, Base& z)
+	{	switch( op )
+		{	case AbsOp:   z = fabs(x);  break;
+			case AcosOp:  z = acos(x);  break;
+			case AsinOp:  z = asin(x);  break;
+			case AtanOp:  z = atan(x);  break;
+			case CosOp:   z = cos(x);   break;
+			case CoshOp:  z = cosh(x);  break;
+			case ExpOp:   z = exp(x);   break;
+			case LogOp:   z = log(x);   break;
+			case SignOp:  z = sign(x);  break;
+			case SinOp:   z = sin(x);   break;
+			case SinhOp:  z = sinh(x);  break;
+			case SqrtOp:  z = sqrt(x);  break;
+			case TanOp:   z = tan(x);   break;
+			case TanhOp:  z = tanh(x);  break;
+# if CPPAD_USE_CPLUSPLUS_2011
+			case AcoshOp: z = acosh(x); break;
+			case AsinhOp: z = asinh(x); break;
+			case AtanhOp: z = atanh(x); break;
+			case ErfOp:   z = erf(x);   break;
+			case Expm1Op: z = expm1(x); break;
+			case Log1pOp: z = log1p(x); break;
+# endif
+			default:
+			return false;
+		}
+		return true;
+	}
+
+	/// value of a binary operator (op is the variable op variable version)
+	static Base eval_binary(OpCode op, const Base& x, const Base& y)
+	{	switch( op )
+		{	case AddvvOp:  return x + y;
+			case SubvvOp:  return x - y;
+			case MulvvOp:  return x * y;
+			case DivvvOp:  return x / y;
+			case PowvvOp:  return pow(x, y);
+			case ZmulvvOp: return azmul(x, y);
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+		return x;
+	}
+
+	/// parameter op variable version of a binary operator
+	static OpCode pv_op(OpCode op)
+	{	switch( op )
+		{	case AddvvOp:  return AddpvOp;
+			case SubvvOp:  return SubpvOp;
+			case MulvvOp:  return MulpvOp;
+			case DivvvOp:  return DivpvOp;
+			case PowvvOp:  return PowpvOp;
+			case ZmulvvOp: return ZmulpvOp;
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+		return op;
+	}
+
+	/// variable op parameter version of a binary operator
+	/// (AddvvOp and MulvvOp do not have one)
+	static OpCode vp_op(OpCode op)
+	{	switch( op )
+		{	case SubvvOp:  return SubvpOp;
+			case DivvvOp:  return DivvpOp;
+			case PowvvOp:  return PowvpOp;
+			case ZmulvvOp: return ZmulvpOp;
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+		return op;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Simplify a unary operator.
+
+	\param i_op
+	is the index of the operator in the old recording.
+
+	\param op
+	is the operator; i.e., ErfOp or an operator with one argument
+	that is a variable and has one primary result.
+
+	\param arg
+	are the arguments for this operator in the old recording.
+	*/
+	void unary(size_t i_op, OpCode op, const addr_t* arg)
+	{	operand x = var_operand(arg[0]);
+		if( x.is_con )
+		{	Base z;
+			if( eval_unary(op, x.value, z) )
+			{	set_con(i_op, z);
+				return;
+			}
+			to_var(x);
+		}
+		rec_->PutArg(x.index);
+		if( op == ErfOp )
+		{	CPPAD_ASSERT_NARG_NRES(op, 3, 5);
+			rec_->PutArg( new_par_[arg[1]], new_par_[arg[2]] );
+		}
+		set_var(i_op, rec_->PutOp(op) );
+	}
+	/*!
+	Simplify a binary operator.
+
+	\param i_op
+	is the index of the operator in the old recording.
+
+	\param op
+	is the variable op variable version of the operator; i.e.,
+	AddvvOp, SubvvOp, MulvvOp, DivvvOp, PowvvOp, or ZmulvvOp.
+
+	\param left
+	is the left operand.
+
+	\param right
+	is the right operand.
+	*/
+	void binary(size_t i_op, OpCode op, operand left, operand right)
+	{	CPPAD_ASSERT_UNKNOWN( left.j_op != 0 || right.j_op != 0 );
+		//
+		// constant folding
+		if( left.is_con && right.is_con )
+		{	set_con(i_op, eval_binary(op, left.value, right.value) );
+			return;
+		}
+		Base zero(0.0), one(1.0), two(2.0);
+		bool left_zero  = left.is_con  && IdenticalZero(left.value);
+		bool left_one   = left.is_con  && IdenticalOne(left.value);
+		bool right_zero = right.is_con && IdenticalZero(right.value);
+		bool right_one  = right.is_con && IdenticalOne(right.value);
+		bool same = left.is_var && right.is_var && left.index == right.index;
+		//
+		// variables that left and right are the negative of
+		addr_t left_neg  = 0;
+		addr_t right_neg = 0;
+		if( left.is_var )
+			left_neg = neg_var_[left.index];
+		if( right.is_var )
+			right_neg = neg_var_[right.index];
+		//
+		switch( op )
+		{	case AddvvOp:
+			if( left_zero )
+			{	// 0 + y = y
+				set_operand(i_op, right);
+				return;
+			}
+			if( right_zero )
+			{	// x + 0 = x
+				set_operand(i_op, left);
+				return;
+			}
+			if( right_neg != 0 || left_neg != 0 )
+			{	// x + (-w) = x - w, (-w) + y = y - w
+				operand x = left;
+				addr_t  w = right_neg;
+				if( right_neg == 0 )
+				{	x = right;
+					w = left_neg;
+				}
+				if( x.is_var )
+					set_var(i_op, put_op(SubvvOp, x.index, w) );
+				else
+					set_var(i_op, put_op(SubpvOp, par_index(x), w) );
+				return;
+			}
+			break;
+
+			case SubvvOp:
+			if( right_zero )
+			{	// x - 0 = x
+				set_operand(i_op, left);
+				return;
+			}
+			if( same )
+			{	// x - x = 0
+				set_con(i_op, zero);
+				return;
+			}
+			if( right_neg != 0 )
+			{	// x - (-w) = x + w
+				if( left_zero )
+					set_var(i_op, right_neg);
+				else if( left.is_var )
+					set_var(i_op, put_op(AddvvOp, left.index, right_neg) );
+				else
+					set_var(i_op, put_op(AddpvOp, par_index(left), right_neg));
+				return;
+			}
+			break;
+
+			case MulvvOp:
+			if( left_zero || right_zero )
+			{	// 0 * y = x * 0 = 0
+				set_con(i_op, zero);
+				return;
+			}
+			if( left_one )
+			{	// 1 * y = y
+				set_operand(i_op, right);
+				return;
+			}
+			if( right_one )
+			{	// x * 1 = x
+				set_operand(i_op, left);
+				return;
+			}
+			break;
+
+			case DivvvOp:
+			if( right_one )
+			{	// x / 1 = x
+				set_operand(i_op, left);
+				return;
+			}
+			if( left_zero )
+			{	// 0 / y = 0
+				set_con(i_op, zero);
+				return;
+			}
+			if( same )
+			{	// x / x = 1
+				set_con(i_op, one);
+				return;
+			}
+			break;
+
+			case PowvvOp:
+			if( right_zero )
+			{	// pow(x, 0) = 1
+				set_con(i_op, one);
+				return;
+			}
+			if( right_one )
+			{	// pow(x, 1) = x
+				set_operand(i_op, left);
+				return;
+			}
+			if( right.is_con && left.is_var )
+			{	if( IdenticalEqualCon(right.value, two) )
+				{	// pow(x, 2) = x * x
+					set_var(i_op, put_op(MulvvOp, left.index, left.index) );
+					return;
+				}
+			}
+			break;
+
+			case ZmulvvOp:
+			if( left_zero )
+			{	// azmul(0, y) = 0
+				set_con(i_op, zero);
+				return;
+			}
+			if( left_one )
+			{	// azmul(1, y) = y
+				set_operand(i_op, right);
+				return;
+			}
+			if( right_one )
+			{	// azmul(x, 1) = x
+				set_operand(i_op, left);
+				return;
+			}
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+		}
+		// at least one of the operands must be a variable
+		if( ! (left.is_var || right.is_var) )
+		{	if( left.j_op != 0 )
+				to_var(left);
+			else
+				to_var(right);
+		}
+		addr_t i_var;
+		if( left.is_var && right.is_var )
+			i_var = put_op(op, left.index, right.index);
+		else if( right.is_var )
+		{	i_var = put_op(pv_op(op), par_index(left), right.index);
+			if( op == SubvvOp && left_zero )
+			{	// -y
+				neg_var_[i_var] = right.index;
+			}
+		}
+		else if( op == AddvvOp || op == MulvvOp )
+			i_var = put_op(pv_op(op), par_index(right), left.index);
+		else
+			i_var = put_op(vp_op(op), left.index, par_index(right));
+		//
+		set_var(i_op, i_var);
+	}
+	/*!
+	Simplify a conditional expression.
+
+	\param i_op
+	is the index of the CExpOp operator in the old recording.
+
+	\param arg
+	are the arguments for this operator in the old recording.
+	*/
+	void cexp(size_t i_op, const addr_t* arg)
+	{	CPPAD_ASSERT_NARG_NRES(CExpOp, 6, 1);
+		CompareOp cop  = CompareOp( arg[0] );
+		size_t    flag = size_t( arg[1] );
+		//
+		// left, right, if_true, if_false
+		operand x[4];
+		for(size_t k = 0; k < 4; ++k)
+		{	if( flag & (size_t(1) << k) )
+				x[k] = var_operand(arg[2 + k]);
+			else
+				x[k] = par_operand(arg[2 + k]);
+		}
+		if( x[0].is_con && x[1].is_con )
+		{	// the result of the comparison is known
+			Base one(1.0), zero(0.0);
+			Base c = CondExpOp(cop, x[0].value, x[1].value, one, zero);
+			if( IdenticalOne(c) )
+				set_operand(i_op, x[2]);
+			else
+				set_operand(i_op, x[3]);
+			return;
+		}
+		// If left or right was a variable, keep one of them a variable
+		// (conditional skips are only generated for this case).
+		if( ! (x[0].is_var || x[1].is_var) )
+		{	if( x[0].j_op != 0 )
+				to_var(x[0]);
+			else if( x[1].j_op != 0 )
+				to_var(x[1]);
+		}
+		// at least one of the operands must be a variable
+		bool any_var = false;
+		for(size_t k = 0; k < 4; ++k)
+			any_var |= x[k].is_var;
+		for(size_t k = 0; k < 4 && ! any_var; ++k)
+		{	if( x[k].j_op != 0 )
+			{	to_var(x[k]);
+				any_var = true;
+			}
+		}
+		addr_t new_arg[4];
+		size_t new_flag = 0;
+		for(size_t k = 0; k < 4; ++k)
+		{	if( x[k].is_var )
+			{	new_flag  |= size_t(1) << k;
+				new_arg[k] = x[k].index;
+			}
+			else
+				new_arg[k] = par_index(x[k]);
+		}
+		rec_->PutArg(
+			arg[0], addr_t(new_flag),
+			new_arg[0], new_arg[1], new_arg[2], new_arg[3]
+		);
+		set_var(i_op, rec_->PutOp(CExpOp) );
+	}
+	/*!
+	Simplify a comparison operator that has a variable argument.
+
+	\param op
+	is the operator; e.g., LtvpOp.
+
+	\param arg
+	are the arguments for this operator in the old recording.
+	*/
+	void compare(OpCode op, const addr_t* arg)
+	{	CPPAD_ASSERT_NARG_NRES(op, 2, 0);
+		// vv, pv, and vp versions of this comparison
+		OpCode op_vv, op_pv, op_vp;
+		switch( op )
+		{	case LevvOp: case LepvOp: case LevpOp:
+			op_vv = LevvOp; op_pv = LepvOp; op_vp = LevpOp;
+			break;
+
+			case LtvvOp: case LtpvOp: case LtvpOp:
+			op_vv = LtvvOp; op_pv = LtpvOp; op_vp = LtvpOp;
+			break;
+
+			case EqvvOp: case EqpvOp:
+			op_vv = EqvvOp; op_pv = EqpvOp; op_vp = NumberOp;
+			break;
+
+			case NevvOp: case NepvOp:
+			op_vv = NevvOp; op_pv = NepvOp; op_vp = NumberOp;
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN(false);
+			op_vv = op_pv = op_vp = NumberOp;
+		}
+		operand left, right;
+		if( op == op_pv )
+			left = par_operand(arg[0]);
+		else
+			left = var_operand(arg[0]);
+		if( op == op_vp )
+			right = par_operand(arg[1]);
+		else
+			right = var_operand(arg[1]);
+		//
+		// the result of comparing two constants never changes
+		if( left.is_con && right.is_con )
+			return;
+		//
+		// at least one of the operands must be a variable
+		if( ! (left.is_var || right.is_var) )
+		{	if( left.j_op != 0 )
+				to_var(left);
+			else
+				to_var(right);
+		}
+		if( left.is_var && right.is_var )
+		{	op = op_vv;
+			rec_->PutArg(left.index, right.index);
+		}
+		else if( right.is_var )
+		{	op = op_pv;
+			rec_->PutArg(par_index(left), right.index);
+		}
+		else if( op_vp == NumberOp )
+		{	// == and != are symmetric
+			op = op_pv;
+			rec_->PutArg(par_index(right), left.index);
+		}
+		else
+		{	op = op_vp;
+			rec_->PutArg(left.index, par_index(right));
+		}
+		rec_->PutOp(op);
+	}
+	/*!
+	Simplify a cumulative summation operator.
+
+	\param i_op
+	is the index of the CSumOp operator in the old recording.
+
+	\param arg
+	are the arguments for this operator in the old recording.
+	*/
+	void csum(size_t i_op, const addr_t* arg)
+	{	CPPAD_ASSERT_UNKNOWN( ! play_->dyn_par_is()[arg[0]] );
+		//
+		// check if there are any dynamic parameters in the summation
+		bool any_dyn = arg[2] < arg[4];
+		//
+		// variables that are not constants
+		Base sum = play_->GetPar(arg[0]);
+		pod_vector<addr_t> add_var, sub_var;
+		for(size_t i = 5; i < size_t(arg[2]); ++i)
+		{	operand x = var_operand(arg[i]);
+			if( x.is_con )
+			{	if( i < size_t(arg[1]) )
+					sum += x.value;
+				else
+					sum -= x.value;
+			}
+			else if( i < size_t(arg[1]) )
+				add_var.push_back( x.index );
+			else
+				sub_var.push_back( x.index );
+		}
+		if( add_var.size() + sub_var.size() == 0 )
+		{	if( ! any_dyn )
+			{	set_con(i_op, sum);
+				return;
+			}
+			// keep the variables so the result is a variable
+			sum = play_->GetPar(arg[0]);
+			for(size_t i = 5; i < size_t(arg[2]); ++i)
+			{	size_t j_op = random_itr_.var2op(arg[i]);
+				if( i < size_t(arg[1]) )
+					add_var.push_back( new_var(j_op) );
+				else
+					sub_var.push_back( new_var(j_op) );
+			}
+		}
+		size_t n_dyn = size_t( arg[4] - arg[2] );
+		rec_->PutArg( rec_->put_con_par(sum) ); // arg[0]: initial sum
+		size_t end = 5 + add_var.size();
+		rec_->PutArg( addr_t(end) );            // arg[1]: end add variables
+		end += sub_var.size();
+		rec_->PutArg( addr_t(end) );            // arg[2]: end sub variables
+		rec_->PutArg( addr_t(end + arg[3] - arg[2]) ); // arg[3]: end add dyn
+		end += n_dyn;
+		rec_->PutArg( addr_t(end) );            // arg[4]: end sub dynamics
+		for(size_t i = 0; i < add_var.size(); ++i)
+			rec_->PutArg( add_var[i] );
+		for(size_t i = 0; i < sub_var.size(); ++i)
+			rec_->PutArg( sub_var[i] );
+		for(size_t i = size_t(arg[2]); i < size_t(arg[4]); ++i)
+			rec_->PutArg( new_par_[ arg[i] ] );
+		rec_->PutArg( addr_t(end) );
+		set_var(i_op, rec_->PutOp(CSumOp) );
+	}
+public:
+	/*!
+	Constructor
+
+	\param play
+	is the player for the old operation sequence.
+
+	\param random_itr
+	is a random iterator for the old operation sequence.
+
+	\param rec
+	is the recorder for the new operation sequence. It must be empty
+	and the player must not change while this object is in use.
+	*/
+	simplify_tape(
+		const player<Base>*                       play        ,
+		const play::const_random_iterator<Addr>&  random_itr  ,
+		recorder<Base>*                           rec         )
+	: play_(play), random_itr_(random_itr), rec_(rec)
+	{	CPPAD_ASSERT_UNKNOWN( rec->num_op_rec() == 0 );
+		size_t num_op  = random_itr.num_op();
+		size_t num_var = play->num_var_rec();
+		new_var_.resize(num_op);
+		is_con_.resize(num_op);
+		con_value_.resize(num_op);
+		for(size_t i_op = 0; i_op < num_op; ++i_op)
+		{	new_var_[i_op] = 0;
+			is_con_[i_op]  = false;
+		}
+		// the new recording does not have more variables than the old one
+		neg_var_.resize(num_var);
+		for(size_t i_var = 0; i_var < num_var; ++i_var)
+			neg_var_[i_var] = 0;
+	}
+	/*!
+	Create the new operation sequence.
+
+	\param dep_taddr
+	On input this vector contains the indices for each of the dependent
+	variable values in the old operation sequence.
+	Upon return it contains the indices for the same variables in
+	the new operation sequence.
+	*/
+	void run(vector<size_t>& dep_taddr)
+	{	// parameters and VecAD vectors (kept in the same order)
+		pod_vector<addr_t> new_vecad_ind;
+		record_par_vecad(play_, rec_, new_par_, new_vecad_ind);
+		//
+		// --------------------------------------------------------------------
+		// operators
+		size_t num_op = random_itr_.num_op();
+		for(size_t i_op = 0; i_op < num_op; ++i_op)
+		{	OpCode        op;
+			const addr_t* arg;
+			size_t        i_var;
+			random_itr_.op_info(i_op, op, arg, i_var);
+			//
+			operand x;
+			switch( op )
+			{	// ------------------------------------------------------------
+				case BeginOp:
+				CPPAD_ASSERT_NARG_NRES(op, 1, 1);
+				rec_->PutArg(arg[0]);
+				new_var_[i_op] = rec_->PutOp(BeginOp);
+				break;
+
+				case EndOp:
+				CPPAD_ASSERT_NARG_NRES(op, 0, 0);
+				// dependent variables that are constants
+				for(size_t i = 0; i < dep_taddr.size(); ++i)
+					new_var( random_itr_.var2op( dep_taddr[i] ) );
+				rec_->PutOp(EndOp);
+				break;
+
+				case InvOp:
+				CPPAD_ASSERT_NARG_NRES(op, 0, 1);
+				set_var(i_op, rec_->PutOp(InvOp) );
+				break;
+
+				case ParOp:
+				CPPAD_ASSERT_NARG_NRES(op, 1, 1);
+				set_operand(i_op, par_operand(arg[0]) );
+				break;
+
+				// conditional skips are regenerated by optimize_run
+				case CSkipOp:
+				break;
+				// ------------------------------------------------------------
+				// unary operators
+				case AbsOp:
+				case AcosOp:
+				case AcoshOp:
+				case AsinOp:
+				case AsinhOp:
+				case AtanOp:
+				case AtanhOp:
+				case CosOp:
+				case CoshOp:
+				case ErfOp:
+				case ExpOp:
+				case Expm1Op:
+				case LogOp:
+				case Log1pOp:
+				case SignOp:
+				case SinOp:
+				case SinhOp:
+				case SqrtOp:
+				case TanOp:
+				case TanhOp:
+				unary(i_op, op, arg);
+				break;
+
+				case DisOp:
+				CPPAD_ASSERT_NARG_NRES(op, 2, 1);
+				x = var_operand(arg[1]);
+				if( x.is_con )
+					set_con(i_op, discrete<Base>::eval(arg[0], x.value) );
+				else
+					set_var(i_op, put_op(DisOp, arg[0], x.index) );
+				break;
+				// ------------------------------------------------------------
+				// binary operators
+				case AddvvOp:
+				case DivvvOp:
+				case MulvvOp:
+				case PowvvOp:
+				case SubvvOp:
+				case ZmulvvOp:
+				binary(i_op, op, var_operand(arg[0]), var_operand(arg[1]) );
+				break;
+
+				case AddpvOp:
+				binary(i_op, AddvvOp, par_operand(arg[0]), var_operand(arg[1]));
+				break;
+
+				case DivpvOp:
+				binary(i_op, DivvvOp, par_operand(arg[0]), var_operand(arg[1]));
+				break;
+
+				case MulpvOp:
+				binary(i_op, MulvvOp, par_operand(arg[0]), var_operand(arg[1]));
+				break;
+
+				case PowpvOp:
+				binary(i_op, PowvvOp, par_operand(arg[0]), var_operand(arg[1]));
+				break;
+
+				case SubpvOp:
+				binary(i_op, SubvvOp, par_operand(arg[0]), var_operand(arg[1]));
+				break;
+
+				case ZmulpvOp:
+				binary(i_op, ZmulvvOp, par_operand(arg[0]), var_operand(arg[1]));
+				break;
+
+				case DivvpOp:
+				binary(i_op, DivvvOp, var_operand(arg[0]), par_operand(arg[1]));
+				break;
+
+				case PowvpOp:
+				binary(i_op, PowvvOp, var_operand(arg[0]), par_operand(arg[1]));
+				break;
+
+				case SubvpOp:
+				binary(i_op, SubvvOp, var_operand(arg[0]), par_operand(arg[1]));
+				break;
+
+				case ZmulvpOp:
+				binary(i_op, ZmulvvOp, var_operand(arg[0]), par_operand(arg[1]));
+				break;
+				// ------------------------------------------------------------
+				case CExpOp:
+				cexp(i_op, arg);
+				break;
+
+				case CSumOp:
+				csum(i_op, arg);
+				break;
+				// ------------------------------------------------------------
+				// comparison operators
+				case EqpvOp:
+				case EqvvOp:
+				case LepvOp:
+				case LevpOp:
+				case LevvOp:
+				case LtpvOp:
+				case LtvpOp:
+				case LtvvOp:
+				case NepvOp:
+				case NevvOp:
+				compare(op, arg);
+				break;
+
+				case EqppOp:
+				case LeppOp:
+				case LtppOp:
+				case NeppOp:
+				CPPAD_ASSERT_NARG_NRES(op, 2, 0);
+				rec_->PutArg( new_par_[arg[0]], new_par_[arg[1]] );
+				rec_->PutOp(op);
+				break;
+				// ------------------------------------------------------------
+				case PriOp:
+				CPPAD_ASSERT_NARG_NRES(op, 5, 0);
+				{	addr_t new_arg[4];
+					for(size_t k = 0; k < 2; ++k)
+					{	if( arg[0] & (1 << k) )
+							new_arg[k] = new_var(
+								random_itr_.var2op(arg[1 + 2 * k])
+							);
+						else
+							new_arg[k] = new_par_[ arg[1 + 2 * k] ];
+					}
+					new_arg[2] = rec_->PutTxt( play_->GetTxt(arg[2]) );
+					new_arg[3] = rec_->PutTxt( play_->GetTxt(arg[4]) );
+					rec_->PutArg(
+						arg[0], new_arg[0], new_arg[2], new_arg[1], new_arg[3]
+					);
+					rec_->PutOp(PriOp);
+				}
+				break;
+				// ------------------------------------------------------------
+				// VecAD operators
+				case LdpOp:
+				CPPAD_ASSERT_NARG_NRES(op, 3, 1);
+				rec_->PutArg(
+					new_vecad_ind[ arg[0] ],
+					arg[1],
+					addr_t( rec_->num_load_op_rec() )
+				);
+				set_var(i_op, rec_->PutLoadOp(LdpOp) );
+				break;
+
+				case LdvOp:
+				CPPAD_ASSERT_NARG_NRES(op, 3, 1);
+				{	addr_t index = new_var( random_itr_.var2op(arg[1]) );
+					rec_->PutArg(
+						new_vecad_ind[ arg[0] ],
+						index,
+						addr_t( rec_->num_load_op_rec() )
+					);
+					set_var(i_op, rec_->PutLoadOp(LdvOp) );
+				}
+				break;
+
+				case StppOp:
+				CPPAD_ASSERT_NARG_NRES(op, 3, 0);
+				rec_->PutArg(new_vecad_ind[arg[0]], arg[1], new_par_[arg[2]]);
+				rec_->PutOp(StppOp);
+				break;
+
+				case StpvOp:
+				CPPAD_ASSERT_NARG_NRES(op, 3, 0);
+				x = var_operand(arg[2]);
+				if( x.is_con )
+				{	rec_->PutArg(
+						new_vecad_ind[arg[0]], arg[1], par_index(x)
+					);
+					rec_->PutOp(StppOp);
+				}
+				else
+				{	rec_->PutArg(new_vecad_ind[arg[0]], arg[1], x.index);
+					rec_->PutOp(StpvOp);
+				}
+				break;
+
+				case StvpOp:
+				CPPAD_ASSERT_NARG_NRES(op, 3, 0);
+				{	addr_t index = new_var( random_itr_.var2op(arg[1]) );
+					rec_->PutArg(
+						new_vecad_ind[arg[0]], index, new_par_[arg[2]]
+					);
+					rec_->PutOp(StvpOp);
+				}
+				break;
+
+				case StvvOp:
+				CPPAD_ASSERT_NARG_NRES(op, 3, 0);
+				{	addr_t index = new_var( random_itr_.var2op(arg[1]) );
+					x = var_operand(arg[2]);
+					if( x.is_con )
+					{	rec_->PutArg(
+							new_vecad_ind[arg[0]], index, par_index(x)
+						);
+						rec_->PutOp(StvpOp);
+					}
+					else
+					{	rec_->PutArg(new_vecad_ind[arg[0]], index, x.index);
+						rec_->PutOp(StvvOp);
+					}
+				}
+				break;
+				// ------------------------------------------------------------
+				// atomic function operators
+				case UserOp:
+				CPPAD_ASSERT_NARG_NRES(op, 4, 0);
+				rec_->PutArg(arg[0], arg[1], arg[2], arg[3]);
+				rec_->PutOp(UserOp);
+				break;
+
+				case UsrapOp:
+				case UsrrpOp:
+				CPPAD_ASSERT_NARG_NRES(op, 1, 0);
+				rec_->PutArg( new_par_[arg[0]] );
+				rec_->PutOp(op);
+				break;
+
+				case UsravOp:
+				CPPAD_ASSERT_NARG_NRES(op, 1, 0);
+				x = var_operand(arg[0]);
+				if( x.is_con )
+				{	// constant arguments are passed as parameters
+					rec_->PutArg( par_index(x) );
+					rec_->PutOp(UsrapOp);
+				}
+				else
+				{	rec_->PutArg( x.index );
+					rec_->PutOp(UsravOp);
+				}
+				break;
+
+				case UsrrvOp:
+				CPPAD_ASSERT_NARG_NRES(op, 0, 1);
+				set_var(i_op, rec_->PutOp(UsrrvOp) );
+				break;
+				// ------------------------------------------------------------
+
+				default:
+				CPPAD_ASSERT_UNKNOWN(false);
+			}
+		}
+		// dependent variables
+		for(size_t i = 0; i < dep_taddr.size(); ++i)
+		{	size_t j_op  = random_itr_.var2op( dep_taddr[i] );
+			dep_taddr[i] = size_t( new_var_[j_op] );
+			CPPAD_ASSERT_UNKNOWN( 0 < dep_taddr[i] );
+		}
+	}
+};
+
+/*!
+Algebraic simplification and constant folding of an operation sequence.
+
+\tparam Addr
+Type to use with player random iterators. Must correspond to the
+result for play->addr_type().
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD<Base> and computations by this routine are done using type Base.
+
+\param dep_taddr
+On input this vector contains the indices for each of the dependent
+variable values in the operation sequence corresponding to \a play.
+Upon return it contains the indices for the same variables but in
+the operation sequence corresponding to \a rec.
+
+\param play
+This is the operation sequence that we are simplifying.
+
+\param random_itr
+is a random iterator for the operation sequence in play.
+
+\param rec
+The input contents of this recording must be empty.
+Upon return, it contains a simplified version of the operation sequence
+in play. It has the same parameters and VecAD vectors as play.
+It does not have more operators, arguments, or variables than play,
+so \a Addr can also be used for its random iterator.
+The simplified version does not contain any CSkipOp operators.
+*/
+template <class Addr, class Base>
+void simplify_run(
+	vector<size_t>&                            dep_taddr  ,
+	const player<Base>*                        play       ,
+	const play::const_random_iterator<Addr>&   random_itr ,
+	recorder<Base>*                            rec        )
+{	simplify_tape<Addr, Base> tape(play, random_itr, rec);
+	tape.run(dep_taddr);
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
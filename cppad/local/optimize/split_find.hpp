@@ -0,0 +1,379 @@
+# ifndef CPPAD_LOCAL_OPTIMIZE_SPLIT_FIND_HPP
+# define CPPAD_LOCAL_OPTIMIZE_SPLIT_FIND_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/optimize/reroll_run.hpp>
+
+/*!
+\file split_find.hpp
+Split an operation sequence into segments that are replaced by
+atomic function calls so that reverse mode uses less memory.
+*/
+
+// BEGIN_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+namespace CppAD { namespace local { namespace optimize  {
+
+/*!
+Can an operator be part of a segment that is split from an operation sequence.
+
+\param play
+is the operation sequence.
+
+\param op
+is the operator.
+
+\param arg
+are the arguments for the operator.
+
+\param is_variable
+work space used to hold the value returned by arg_is_variable.
+
+\return
+is true if the operator satisfies reroll_can_repeat,
+or if it is a cumulative summation that does not use dynamic parameters.
+(A segment that is split is not compared with other segments, so the
+number of arguments for its operators does not need to be fixed.)
+*/
+template <class Base>
+bool split_can_move(
+	const player<Base>*  play        ,
+	OpCode               op          ,
+	const addr_t*        arg         ,
+	pod_vector<bool>&    is_variable )
+{	if( op == CSumOp )
+		return arg[2] == arg[4];
+	return reroll_can_repeat(play, op, arg, is_variable);
+}
+
+/*!
+Partition an operation sequence into segments with a maximum number of
+variables.
+
+\param max_seg
+is the maximum number of variables that are results of a segment.
+
+\param call_less
+If this is true, a segment is only included if the number of operators
+in the corresponding atomic function call
+(two plus the number of arguments and results)
+is less than the number of operators in the segment.
+Otherwise, a segment is only included if it has at least four variables.
+
+\param can_move
+is the value of split_can_move for each operator.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param segment
+is used to compute the arguments and results for each segment.
+
+\param group [out]
+The input size of this vector does not matter.
+Upon return, it contains the segments (each segment is a group with
+n_repeat equal to one) in increasing order of their first operator.
+Each run of consecutive operators that can move is split into
+segments of about the same size.
+A segment is only included if it has at least one result
+(a segment with no results is dead code
+and is left in the operation sequence),
+it has more variables than results,
+and it satisfies the condition specified by call_less.
+
+\return
+is the number of variables in the new operation sequence plus the maximum,
+with respect to the segments, of the number of variables for the
+corresponding function. This is the maximum number of variables that have
+Taylor coefficients stored at the same time during reverse mode
+(not counting the effect of optimization of the functions).
+*/
+template <class Addr, class Base>
+size_t split_partition(
+	size_t                                    max_seg    ,
+	bool                                      call_less  ,
+	const pod_vector<bool>&                   can_move   ,
+	const play::const_random_iterator<Addr>&  random_itr ,
+	reroll_segment<Addr, Base>&               segment    ,
+	vector<reroll_group>&                     group      )
+{	CPPAD_ASSERT_UNKNOWN( max_seg > 0 );
+	size_t num_op    = random_itr.num_op();
+	size_t num_var   = random_itr.num_var();
+	size_t n_var     = num_var;
+	size_t max_inner = 0;
+	group.resize(0);
+	//
+	size_t i_op = 0;
+	while( i_op < num_op )
+	{	if( ! can_move[i_op] )
+		{	++i_op;
+			continue;
+		}
+		// number of variables in this run of operators that can move
+		size_t end_run = i_op;
+		size_t n_run   = 0;
+		while( end_run < num_op && can_move[end_run] )
+			n_run += NumRes( random_itr.get_op(end_run++) );
+		//
+		// target number of variables for each segment in this run
+		size_t n_split = (n_run + max_seg - 1) / max_seg;
+		size_t target  = (n_run + n_split - 1) / n_split;
+		//
+		while( i_op < end_run )
+		{	// extend the segment to the target number of variables
+			// (without going over max_seg)
+			size_t start_op = i_op;
+			size_t n_seg    = NumRes( random_itr.get_op(i_op++) );
+			while( i_op < end_run && n_seg < target &&
+				n_seg + NumRes( random_itr.get_op(i_op) ) <= max_seg
+			)	n_seg += NumRes( random_itr.get_op(i_op++) );
+			//
+			size_t n_op = i_op - start_op;
+			segment.set_first(start_op, n_op);
+			size_t n_in  = segment.n_in();
+			size_t n_out = segment.n_out();
+			bool   keep  = 0 < n_out && n_out < n_seg;
+			if( call_less )
+				keep &= 2 + n_in + n_out < n_op;
+			else
+				keep &= 4 <= n_seg;
+			if( keep )
+			{	reroll_group info;
+				info.start_op = start_op;
+				info.n_op     = n_op;
+				info.n_repeat = 1;
+				info.n_in     = n_in;
+				info.n_out    = n_out;
+				group.push_back(info);
+				//
+				// the BeginOp, InvOp, and segment variables for the function
+				max_inner = std::max(max_inner, 1 + n_in + n_seg);
+				n_var    -= n_seg - n_out;
+			}
+		}
+	}
+	return n_var + max_inner;
+}
+
+/*!
+Search for the maximum segment size to use with split_partition.
+
+\param max_var
+is the maximum number of variables that should have
+Taylor coefficients stored at the same time during reverse mode.
+
+\param call_less
+is the call_less argument for split_partition.
+
+\param can_move
+is the value of split_can_move for each operator.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param segment
+is used to compute the arguments and results for each segment.
+
+\param group
+is work space used by split_partition.
+
+\param best_var [out]
+is the value returned by split_partition for the maximum segment size
+that is returned (the number of variables in the operation sequence
+if the return value is zero).
+
+\return
+is the largest maximum segment size that we found for which the
+split_partition return value is less than or equal max_var.
+If there is no such size, it is the size that minimizes the return value
+(zero if no size reduces the number of variables).
+*/
+template <class Addr, class Base>
+size_t split_search(
+	size_t                                    max_var    ,
+	bool                                      call_less  ,
+	const pod_vector<bool>&                   can_move   ,
+	const play::const_random_iterator<Addr>&  random_itr ,
+	reroll_segment<Addr, Base>&               segment    ,
+	vector<reroll_group>&                     group      ,
+	size_t&                                   best_var   )
+{	size_t num_var = random_itr.num_var();
+	//
+	// Decrease the maximum segment size, by a factor of about 3/4,
+	// until the memory bound is satisfied (and record the maximum segment
+	// size that minimizes the memory).
+	// The return value for split_partition is not monotone in max_seg,
+	// so this checks more sizes than bisection would.
+	size_t max_seg  = num_var;
+	size_t best_seg = 0;
+	best_var        = num_var;
+	size_t fit_seg  = 0;
+	size_t upper    = num_var + 1;
+	while( max_seg > 0 && fit_seg == 0 )
+	{	size_t n_var = split_partition(
+			max_seg, call_less, can_move, random_itr, segment, group
+		);
+		if( n_var < best_var )
+		{	best_seg = max_seg;
+			best_var = n_var;
+		}
+		if( n_var <= max_var )
+			fit_seg = max_seg;
+		else
+		{	upper    = max_seg;
+			max_seg -= std::max( size_t(1), max_seg / 4 );
+		}
+	}
+	if( fit_seg > 0 )
+	{	// bisection for a larger segment size that satisfies the bound
+		size_t lower = fit_seg;
+		while( lower + 1 < upper )
+		{	size_t mid   = (lower + upper) / 2;
+			size_t n_var = split_partition(
+				mid, call_less, can_move, random_itr, segment, group
+			);
+			if( n_var <= max_var )
+				lower = mid;
+			else
+				upper = mid;
+		}
+		best_seg = lower;
+		best_var = split_partition(
+			best_seg, call_less, can_move, random_itr, segment, group
+		);
+	}
+	return best_seg;
+}
+
+/*!
+Determine the segments of an operation sequence that are replaced by
+atomic function calls so that reverse mode uses less memory.
+
+\param max_var
+is the maximum number of variables that should have
+Taylor coefficients stored at the same time during reverse mode.
+
+\param dep_taddr
+is a vector of variable indices for the dependent variables.
+
+\param play
+is the operation sequence.
+
+\param random_itr
+is a random iterator for the operation sequence.
+
+\param group [out]
+The input size of this vector does not matter.
+Upon return, it contains the segments (each segment is a group with
+n_repeat equal to one) in increasing order of their first operator.
+If the number of variables in the operation sequence is less than
+or equal max_var, it is empty.
+Otherwise, the segments are as large as possible (to reduce the overhead
+of the atomic function calls) subject to the return value being
+less than or equal max_var.
+If this is not possible, the segments (with call_less true in
+split_partition) are chosen to minimize the return value.
+
+\param is_output [out]
+The input size of this vector does not matter.
+Upon return, it has size equal to the number of operators.
+If i_op is an operator in a segment,
+is_output[i_op] is true if the primary result for i_op is a result
+of the function corresponding to the segment.
+
+\return
+is the value returned by split_partition for the segments in group
+(the number of variables in the operation sequence if group is empty).
+*/
+template <class Addr, class Base>
+size_t split_find(
+	size_t                                    max_var    ,
+	const vector<size_t>&                     dep_taddr  ,
+	const player<Base>*                       play       ,
+	const play::const_random_iterator<Addr>&  random_itr ,
+	vector<reroll_group>&                     group      ,
+	pod_vector<bool>&                         is_output  )
+{	size_t num_op  = random_itr.num_op();
+	size_t num_var = random_itr.num_var();
+	group.resize(0);
+	is_output.resize(num_op);
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+		is_output[i_op] = false;
+	if( num_var <= max_var )
+		return num_var;
+	//
+	// last_use, can_move
+	pod_vector<size_t> last_use(num_var);
+	pod_vector<bool>   can_move(num_op);
+	pod_vector<bool>   is_variable;
+	for(size_t i_var = 0; i_var < num_var; ++i_var)
+		last_use[i_var] = 0;
+	for(size_t i_op = 0; i_op < num_op; ++i_op)
+	{	OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		//
+		arg_is_variable(op, arg, is_variable);
+		for(size_t j = 0; j < is_variable.size(); ++j)
+		{	if( is_variable[j] )
+				last_use[ arg[j] ] = i_op;
+		}
+		can_move[i_op] = split_can_move(play, op, arg, is_variable);
+	}
+	for(size_t i = 0; i < dep_taddr.size(); ++i)
+		last_use[ dep_taddr[i] ] = num_op;
+	//
+	reroll_segment<Addr, Base> segment(play, random_itr, last_use);
+	//
+	// First try segments that have more operators than the corresponding
+	// atomic function calls. If this does not satisfy the bound,
+	// use segments that have at least four variables when they satisfy it
+	// (small segments that do not satisfy the bound are not worth the
+	// overhead of their atomic function calls).
+	size_t best_var;
+	bool   call_less = true;
+	size_t best_seg  = split_search(
+		max_var, call_less, can_move, random_itr, segment, group,
+		best_var
+	);
+	if( max_var < best_var )
+	{	size_t other_var;
+		size_t other_seg = split_search(
+			max_var, false, can_move, random_itr, segment, group,
+			other_var
+		);
+		if( other_var <= max_var )
+		{	call_less = false;
+			best_seg  = other_seg;
+			best_var  = other_var;
+		}
+	}
+	if( best_seg == 0 )
+	{	group.resize(0);
+		return num_var;
+	}
+	best_var = split_partition(
+		best_seg, call_less, can_move, random_itr, segment, group
+	);
+	//
+	// is_output
+	for(size_t i = 0; i < group.size(); ++i)
+	{	segment.set_first(group[i].start_op, group[i].n_op);
+		for(size_t k = 0; k < group[i].n_op; ++k)
+			is_output[ group[i].start_op + k ] = segment.is_output(k);
+	}
+	return best_var;
+}
+
+} } } // END_CPPAD_LOCAL_OPTIMIZE_NAMESPACE
+
+# endif
@@ -59,6 +59,7 @@ public:
 	void operator=(const const_random_iterator& rhs)
 	{
 		op_vec_          = rhs.op_vec_;
+		arg_vec_         = rhs.arg_vec_;
 		op2arg_vec_      = rhs.op2arg_vec_;
 		op2var_vec_      = rhs.op2var_vec_;
 		var2op_vec_      = rhs.var2op_vec_;
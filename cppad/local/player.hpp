@@ -18,6 +18,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/play/random_setup.hpp>
 # include <cppad/local/user_state.hpp>
 # include <cppad/local/is_pod.hpp>
+# include <cppad/core/hash_code.hpp>
 
 namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
 /*!
@@ -694,6 +695,33 @@ public:
 		     + vecad_ind_vec_.size() * sizeof(addr_t)
 		;
 	}
+	/*!
+	Hash code for the operation sequence.
+
+	\return
+	is a hash code for the operators, their arguments, the VecAD indices,
+	and the values of the constant parameters
+	(the values of the dynamic parameters are not included).
+	*/
+	size_t hash_sequence(void) const
+	{	// Fowler-Noll-Vo (FNV-1a) style combination of the values
+		CPPAD_ASSERT_UNKNOWN( dyn_par_is_.size() == all_par_vec_.size() );
+		const size_t prime = 16777619;
+		size_t code        = 2166136261u;
+		for(size_t i = 0; i < op_vec_.size(); ++i)
+			code = (code ^ size_t( op_vec_[i] ) ) * prime;
+		for(size_t i = 0; i < arg_vec_.size(); ++i)
+			code = (code ^ size_t( arg_vec_[i] ) ) * prime;
+		for(size_t i = 0; i < vecad_ind_vec_.size(); ++i)
+			code = (code ^ size_t( vecad_ind_vec_[i] ) ) * prime;
+		for(size_t i = 0; i < all_par_vec_.size(); ++i)
+		{	size_t value = 0;
+			if( ! dyn_par_is_[i] )
+				value = size_t( hash_code( all_par_vec_[i] ) ) + 1;
+			code = (code ^ value) * prime;
+		}
+		return code;
+	}
 	/// A measure of amount of memory used for random access routine
 	/// In user api as f.size_random(); see the file seq_property.omh.
 	size_t size_random(void) const
@@ -752,11 +780,12 @@ public:
 	}
 	// -----------------------------------------------------------------------
 	/// const subgraph iterator begin
-	play::const_subgraph_iterator<addr_t>  begin_subgraph(
-		const play::const_random_iterator<addr_t>& random_itr ,
+	template <class Addr>
+	play::const_subgraph_iterator<Addr>  begin_subgraph(
+		const play::const_random_iterator<Addr>&   random_itr ,
 		const pod_vector<addr_t>*                  subgraph   ) const
 	{	size_t subgraph_index = 0;
-		return play::const_subgraph_iterator<addr_t>(
+		return play::const_subgraph_iterator<Addr>(
 			random_itr,
 			subgraph,
 			subgraph_index
@@ -45,13 +45,17 @@ private:
 	/// (not defined and should not be used when byte_capacity_ = 0)
 	Type   *data_;
 
+	/// arena that memory is obtained from (null for the thread_alloc pools)
+	thread_alloc_arena* arena_;
+
 	/// do not use the copy constructor
 	explicit pod_vector(const pod_vector& )
 	{	CPPAD_ASSERT_UNKNOWN(false); }
 public:
 	/// default constructor sets byte_capacity_ = byte_length_ = data_ = 0
 	pod_vector(void)
-	: byte_capacity_(0), byte_length_(0), data_(CPPAD_NULL)
+	: byte_capacity_(0), byte_length_(0), data_(CPPAD_NULL),
+	  arena_(CPPAD_NULL)
 	{	CPPAD_ASSERT_UNKNOWN( is_pod<Type>() );
 	}
 
@@ -59,7 +63,8 @@ public:
 	pod_vector(
 		/// number of elements in this vector
 		size_t n )
-	: byte_capacity_(0), byte_length_(0), data_(CPPAD_NULL)
+	: byte_capacity_(0), byte_length_(0), data_(CPPAD_NULL),
+	  arena_(CPPAD_NULL)
 	{	CPPAD_ASSERT_UNKNOWN( is_pod<Type>() );
 		extend(n);
 	}
@@ -94,6 +99,15 @@ public:
 	{	return reinterpret_cast< const pod_vector<Other>* >(this);
 	}
 
+	/// arena used for future allocations by this vector
+	/// (memory already in the vector is not moved).
+	void set_arena(thread_alloc_arena* arena)
+	{	arena_ = arena; }
+
+	/// arena used for allocations by this vector
+	thread_alloc_arena* arena(void) const
+	{	return arena_; }
+
 	/// current number of elements in this vector.
 	size_t size(void) const
 	{	return byte_length_ / sizeof(Type); }
@@ -141,7 +155,7 @@ public:
 	}
 
 	/*!
-	Swap all properties of this vector with another.
+	Swap all properties of this vector with another (except the arena).
 	This is useful when moving a vector that grows after it has reached
 	its final size (without copying every element).
 
@@ -184,17 +198,20 @@ public:
 		size_t old_capacity = byte_capacity_;
 		void* old_v_ptr     = reinterpret_cast<void*>(data_);
 
-		// get new memory and set capacity
-		void* v_ptr = thread_alloc::get_memory(byte_length_, byte_capacity_);
-		data_       = reinterpret_cast<Type*>(v_ptr);
-
-		// copy old data to new
-		if( old_length >  0 )
-			std::memcpy(v_ptr, old_v_ptr, old_length);
-
-		// return old memory to available pool
+		// get new memory, that contains the old data, and set capacity
+		// (large vectors are grown in place without copying when possible)
+		void* v_ptr;
 		if( old_capacity > 0 )
-			thread_alloc::return_memory(old_v_ptr);
+		{	v_ptr = thread_alloc::grow_memory(
+				old_v_ptr, old_length, byte_length_, byte_capacity_, arena_
+			);
+		}
+		else
+		{	v_ptr = thread_alloc::get_memory(
+				byte_length_, byte_capacity_, arena_
+			);
+		}
+		data_       = reinterpret_cast<Type*>(v_ptr);
 
 		// return value for extend(n) is the old length
 		CPPAD_ASSERT_UNKNOWN( byte_length_ <= byte_capacity_ );
@@ -234,8 +251,10 @@ public:
 			}
 			//
 			// get new memory and set capacity
-			v_ptr     = thread_alloc::get_memory(byte_length_, byte_capacity_);
-			data_     = reinterpret_cast<Type*>(v_ptr);
+			v_ptr = thread_alloc::get_memory(
+				byte_length_, byte_capacity_, arena_
+			);
+			data_ = reinterpret_cast<Type*>(v_ptr);
 			//
 		}
 		CPPAD_ASSERT_UNKNOWN( byte_length_ <= byte_capacity_ );
@@ -289,13 +308,16 @@ private:
 	/// (not defined and should not be used when capacity_ = 0)
 	Type   *data_;
 
+	/// arena that memory is obtained from (null for the thread_alloc pools)
+	thread_alloc_arena* arena_;
+
 	/// do not use the copy constructor
 	explicit pod_vector_maybe(const pod_vector_maybe& )
 	{	CPPAD_ASSERT_UNKNOWN(false); }
 public:
 	/// default constructor sets capacity_ = length_ = data_ = 0
 	pod_vector_maybe(void)
-	: capacity_(0), length_(0), data_(CPPAD_NULL)
+	: capacity_(0), length_(0), data_(CPPAD_NULL), arena_(CPPAD_NULL)
 	{	CPPAD_ASSERT_UNKNOWN( is_pod<size_t>() );
 	}
 
@@ -303,7 +325,7 @@ public:
 	pod_vector_maybe(
 		/// number of elements in this vector
 		size_t n )
-	: capacity_(0), length_(0), data_(CPPAD_NULL)
+	: capacity_(0), length_(0), data_(CPPAD_NULL), arena_(CPPAD_NULL)
 	{	extend(n); }
 
 
@@ -322,6 +344,15 @@ public:
 		}
 	}
 
+	/// arena used for future allocations by this vector
+	/// (memory already in the vector is not moved).
+	void set_arena(thread_alloc_arena* arena)
+	{	arena_ = arena; }
+
+	/// arena used for allocations by this vector
+	thread_alloc_arena* arena(void) const
+	{	return arena_; }
+
 	/// current number of elements in this vector.
 	size_t size(void) const
 	{	return length_; }
@@ -369,7 +400,7 @@ public:
 	}
 
 	/*!
-	Swap all properties of this vector with another.
+	Swap all properties of this vector with another (except the arena).
 	This is useful when moving a vector that grows after it has reached
 	its final size (without copying every element).
 
@@ -412,10 +443,27 @@ public:
 		size_t old_capacity = capacity_;
 		Type* old_data      = data_;
 
-		// get new memory and set capacity
+		// plain old data can be grown in place without copying
 		size_t length_bytes = length_ * sizeof(Type);
 		size_t capacity_bytes;
-		void* v_ptr = thread_alloc::get_memory(length_bytes, capacity_bytes);
+		if( is_pod<Type>() && old_capacity > 0 )
+		{	void* v_ptr = thread_alloc::grow_memory(
+				reinterpret_cast<void*>(old_data),
+				old_length * sizeof(Type),
+				length_bytes,
+				capacity_bytes,
+				arena_
+			);
+			capacity_   = capacity_bytes / sizeof(Type);
+			data_       = reinterpret_cast<Type*>(v_ptr);
+			CPPAD_ASSERT_UNKNOWN( length_ <= capacity_ );
+			return old_length;
+		}
+
+		// get new memory and set capacity
+		void* v_ptr = thread_alloc::get_memory(
+			length_bytes, capacity_bytes, arena_
+		);
 		capacity_   = capacity_bytes / sizeof(Type);
 		data_       = reinterpret_cast<Type*>(v_ptr);
 
@@ -484,7 +532,9 @@ public:
 			// get new memory and set capacity
 			size_t length_bytes = length_ * sizeof(Type);
 			size_t capacity_bytes;
-			v_ptr     = thread_alloc::get_memory(length_bytes, capacity_bytes);
+			v_ptr = thread_alloc::get_memory(
+				length_bytes, capacity_bytes, arena_
+			);
 			capacity_ = capacity_bytes / sizeof(Type);
 			data_     = reinterpret_cast<Type*>(v_ptr);
 			//
@@ -0,0 +1,298 @@
+# ifndef CPPAD_LOCAL_RUN_THREADS_HPP
+# define CPPAD_LOCAL_RUN_THREADS_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/configure.hpp>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/utility/thread_alloc.hpp>
+# include <algorithm>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <thread>
+# include <functional>
+# include <mutex>
+# include <condition_variable>
+# endif
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file run_threads.hpp
+Run a function object using multiple C++11 standard threads.
+*/
+# if CPPAD_USE_CPLUSPLUS_2011
+/*!
+Thread number for threads started by run_threads_alloc.
+
+\return
+is a reference to the thread number for the current thread
+(is zero for threads that were not started by run_threads_alloc).
+*/
+inline size_t& run_threads_alloc_thread(void)
+{	static thread_local size_t thread = 0;
+	return thread;
+}
+/*!
+Are threads started by run_threads_alloc currently running.
+
+\return
+is a reference to the flag that is true while the threads are running.
+*/
+inline bool& run_threads_alloc_running(void)
+{	static bool running = false;
+	return running;
+}
+/// in_parallel routine passed to thread_alloc by run_threads_alloc
+inline bool run_threads_alloc_in_parallel(void)
+{	return run_threads_alloc_running(); }
+
+/// thread_num routine passed to thread_alloc by run_threads_alloc
+inline size_t run_threads_alloc_thread_num(void)
+{	return run_threads_alloc_thread(); }
+
+/*!
+Function object that sets the run_threads_alloc thread number
+before calling another function object.
+*/
+template <class Functor>
+class run_threads_alloc_call {
+private:
+	/// function object that does the work
+	const Functor& fun_;
+public:
+	/// constructor
+	run_threads_alloc_call(const Functor& fun) : fun_(fun)
+	{ }
+	/// set thread number for this thread and then call fun_
+	void operator()(size_t thread) const
+	{	run_threads_alloc_thread() = thread;
+		fun_(thread);
+		run_threads_alloc_thread() = 0;
+	}
+};
+# endif
+
+/*!
+Default number of threads used by parallel algorithms in CppAD.
+
+\return
+If C++11 is available, this is the number of concurrent threads supported
+by the hardware (or one if that value is not computable).
+Otherwise, the return value is one.
+*/
+inline size_t run_threads_default(void)
+{	size_t n_thread = 1;
+# if CPPAD_USE_CPLUSPLUS_2011
+	n_thread = size_t( std::thread::hardware_concurrency() );
+	if( n_thread == 0 )
+		n_thread = 1;
+# endif
+	return n_thread;
+}
+
+/*!
+Call a function object once for each thread index and wait for completion.
+
+\tparam Functor
+is a class with a member function with prototype
+<code>void operator()(size_t thread)</code>.
+
+\param n_thread [in]
+is the number of threads; i.e., <code>fun(thread)</code> is called for
+<code>thread = 0 , ... , n_thread-1</code>.
+The call for thread zero is made by the current thread.
+If C++11 is not available, all of the calls are made by the current thread.
+
+\param fun [in]
+is the function object. It is shared by all of the threads
+(and hence must not modify its own state).
+The calls with different values of \c thread must not write to the
+same memory and must not allocate memory using thread_alloc
+(thread_alloc is not put in parallel mode by this routine).
+*/
+template <class Functor>
+void run_threads(size_t n_thread, const Functor& fun)
+{	CPPAD_ASSERT_UNKNOWN( n_thread > 0 );
+# if CPPAD_USE_CPLUSPLUS_2011
+	if( n_thread > 1 )
+	{	// not using CppAD::vector because it uses thread_alloc
+		std::thread* other = new std::thread[n_thread - 1];
+		for(size_t thread = 1; thread < n_thread; ++thread)
+			other[thread - 1] = std::thread( std::cref(fun), thread );
+		fun(0);
+		for(size_t thread = 1; thread < n_thread; ++thread)
+			other[thread - 1].join();
+		delete [] other;
+		return;
+	}
+# endif
+	for(size_t thread = 0; thread < n_thread; ++thread)
+		fun(thread);
+	return;
+}
+
+/*!
+Barrier used by the threads started by one call to run_threads.
+
+A function object passed to run_threads can use a barrier to
+synchronize its threads, so that one set of threads
+does several steps of an algorithm.
+If C++11 is not available, run_threads makes all the calls using the
+current thread, so a barrier can only be used with one thread.
+*/
+class run_threads_barrier {
+private:
+	/// number of threads that wait at this barrier
+	const size_t n_thread_;
+# if CPPAD_USE_CPLUSPLUS_2011
+	/// protects count_ and generation_
+	std::mutex mutex_;
+	/// used to wake up the threads that are waiting
+	std::condition_variable condition_;
+	/// number of threads that are waiting
+	size_t count_;
+	/// number of times that all the threads have reached the barrier
+	size_t generation_;
+# endif
+public:
+	/// constructor
+	run_threads_barrier(size_t n_thread)
+	: n_thread_(n_thread)
+# if CPPAD_USE_CPLUSPLUS_2011
+	, count_(0)
+	, generation_(0)
+# endif
+	{	CPPAD_ASSERT_UNKNOWN( n_thread > 0 );
+# if ! CPPAD_USE_CPLUSPLUS_2011
+		CPPAD_ASSERT_UNKNOWN( n_thread == 1 );
+# endif
+	}
+	/*!
+	Wait until all n_thread threads have called wait.
+	The memory writes done by each thread before it called wait
+	are visible to all the threads after they return.
+	*/
+	void wait(void)
+	{	if( n_thread_ == 1 )
+			return;
+# if CPPAD_USE_CPLUSPLUS_2011
+		std::unique_lock<std::mutex> lock(mutex_);
+		size_t generation = generation_;
+		if( ++count_ == n_thread_ )
+		{	count_ = 0;
+			++generation_;
+			condition_.notify_all();
+			return;
+		}
+		while( generation == generation_ )
+			condition_.wait(lock);
+# endif
+	}
+};
+/*!
+Number of threads that can be used by run_threads_alloc.
+
+\param n_thread [in]
+is the number of threads requested.
+
+\return
+is the number of threads that run_threads_alloc can use.
+This is one, if C++11 is not available, or thread_alloc is already set up
+for parallel execution (by the user), or we are in parallel mode.
+Otherwise, it is the minimum of n_thread and CPPAD_MAX_NUM_THREADS.
+*/
+inline size_t run_threads_alloc_number(size_t n_thread)
+{	if( n_thread <= 1 )
+		return 1;
+# if CPPAD_USE_CPLUSPLUS_2011
+	if( thread_alloc::num_threads() != 1 || thread_alloc::in_parallel() )
+		return 1;
+	return std::min(n_thread, size_t(CPPAD_MAX_NUM_THREADS) );
+# else
+	return 1;
+# endif
+}
+
+/*!
+Call a function object once for each thread index
+with thread_alloc in parallel mode.
+
+\tparam Functor
+is a class with a member function with prototype
+<code>void operator()(size_t thread)</code>.
+
+\param n_thread [in]
+is the number of threads and must be less than or equal
+<code>run_threads_alloc_number(n_thread)</code>.
+The call for thread zero is made by the current thread.
+
+\param fun [in]
+is the function object. It is shared by all of the threads
+(and hence must not modify its own state).
+The calls with different values of \c thread must not write to the
+same memory.
+They may use thread_alloc, but all of the memory allocated by a
+thread other than zero must be returned before its call completes.
+The routine parallel_ad must be called for every Base type that is used
+(before calling run_threads_alloc).
+
+\par thread_alloc
+During the call, thread_alloc is set up for parallel execution with
+<code>thread_alloc::thread_num()</code> equal to \c thread.
+This does not call thread_alloc::parallel_setup.
+Upon return, the settings for the most recent call to parallel_setup
+are restored (including the user's in_parallel and thread_num routines).
+The memory held by the current thread is not changed,
+and the memory held by the other threads is only freed if
+they did not hold any memory before the call.
+*/
+template <class Functor>
+void run_threads_alloc(size_t n_thread, const Functor& fun)
+{	CPPAD_ASSERT_UNKNOWN( n_thread > 0 );
+	CPPAD_ASSERT_UNKNOWN( n_thread <= run_threads_alloc_number(n_thread) );
+# if CPPAD_USE_CPLUSPLUS_2011
+	if( n_thread > 1 )
+	{	// settings for the most recent call to parallel_setup
+		thread_alloc::parallel_user_t user = thread_alloc::parallel_user();
+		//
+		// other threads that hold memory before this call
+		bool held[CPPAD_MAX_NUM_THREADS];
+		for(size_t thread = 1; thread < n_thread; thread++)
+			held[thread] = thread_alloc::available(thread) != 0;
+		//
+		thread_alloc::parallel_set(
+			n_thread,
+			run_threads_alloc_in_parallel,
+			run_threads_alloc_thread_num
+		);
+		run_threads_alloc_running() = true;
+		run_threads( n_thread, run_threads_alloc_call<Functor>(fun) );
+		run_threads_alloc_running() = false;
+		//
+		// return to the user's settings
+		thread_alloc::parallel_set(
+			user.num_threads, user.in_parallel, user.thread_num
+		);
+		for(size_t thread = 1; thread < n_thread; thread++)
+		{	CPPAD_ASSERT_UNKNOWN( thread_alloc::inuse(thread) == 0 );
+			if( ! held[thread] )
+				thread_alloc::free_available(thread);
+		}
+		return;
+	}
+# endif
+	fun(0);
+	return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
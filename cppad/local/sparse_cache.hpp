@@ -0,0 +1,247 @@
+# ifndef CPPAD_LOCAL_SPARSE_CACHE_HPP
+# define CPPAD_LOCAL_SPARSE_CACHE_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <iostream>
+# include <string>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/sparse_rc.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file sparse_cache.hpp
+Sparsity patterns and colorings attached to an operation sequence.
+*/
+
+/// class for the sparsity patterns and colorings cached in an ADFun object
+class sparse_cache_info {
+public:
+	/// type used for the cached sparsity patterns
+	typedef sparse_rc< CppAD::vector<size_t> > pattern_type;
+
+	/// Jacobian sparsity pattern (jac_pattern.nr() == 0 if not computed)
+	pattern_type jac_pattern;
+
+	/// sparse_jac_work::order for the Jacobian
+	CppAD::vector<size_t> jac_order;
+
+	/// sparse_jac_work::color for the Jacobian
+	CppAD::vector<size_t> jac_color;
+
+	/// Hessian sparsity pattern (hes_pattern.nr() == 0 if not computed)
+	pattern_type hes_pattern;
+
+	/// sparse_hes_work::row for the Hessian
+	CppAD::vector<size_t> hes_row;
+
+	/// sparse_hes_work::col for the Hessian
+	CppAD::vector<size_t> hes_col;
+
+	/// sparse_hes_work::order for the Hessian
+	CppAD::vector<size_t> hes_order;
+
+	/// sparse_hes_work::color for the Hessian
+	CppAD::vector<size_t> hes_color;
+
+	/// free all the cached information
+	void clear(void)
+	{	jac_pattern.resize(0, 0, 0);
+		jac_order.clear();
+		jac_color.clear();
+		hes_pattern.resize(0, 0, 0);
+		hes_row.clear();
+		hes_col.clear();
+		hes_order.clear();
+		hes_color.clear();
+	}
+
+	/// assignment (sizes of the CppAD::vector members may change)
+	void operator=(const sparse_cache_info& other)
+	{	clear();
+		jac_pattern = other.jac_pattern;
+		jac_order   = other.jac_order;
+		jac_color   = other.jac_color;
+		hes_pattern = other.hes_pattern;
+		hes_row     = other.hes_row;
+		hes_col     = other.hes_col;
+		hes_order   = other.hes_order;
+		hes_color   = other.hes_color;
+	}
+
+	/// amount of memory corresonding to this object
+	size_t memory(void) const
+	{	size_t sum = 2 * jac_pattern.nnz() + 2 * hes_pattern.nnz();
+		sum       += jac_order.size() + jac_color.size();
+		sum       += hes_row.size() + hes_col.size();
+		sum       += hes_order.size() + hes_color.size();
+		return sum * sizeof(size_t);
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Is a coloring for a cached pattern valid for a pattern and subset.
+
+	\param cached
+	is the cached pattern (jac_pattern or hes_pattern).
+
+	\param pattern
+	is the sparsity pattern used to compute the coloring.
+
+	\param row
+	is the row indices for the subset of the matrix that is computed.
+
+	\param col
+	is the column indices for the subset of the matrix that is computed.
+
+	\return
+	is true if cached is not empty, pattern has the same dimensions and
+	elements as cached, and the subset has the same row and column indices
+	as cached (in the same order).
+	*/
+	template <class SizeVector>
+	static bool same_pattern(
+		const pattern_type&          cached  ,
+		const sparse_rc<SizeVector>& pattern ,
+		const SizeVector&            row     ,
+		const SizeVector&            col     )
+	{	size_t K = cached.nnz();
+		bool ok  = cached.nr() != 0;
+		ok      &= pattern.nr() == cached.nr();
+		ok      &= pattern.nc() == cached.nc();
+		ok      &= pattern.nnz() == K;
+		ok      &= size_t( row.size() ) == K;
+		for(size_t k = 0; ok && k < K; ++k)
+		{	size_t r = cached.row()[k];
+			size_t c = cached.col()[k];
+			ok &= pattern.row()[k] == r && pattern.col()[k] == c;
+			ok &= row[k] == r && col[k] == c;
+		}
+		return ok;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Write the cached information to a stream.
+
+	\param os
+	is the stream that the information is written to.
+
+	\param key
+	is a vector of values that identify the operation sequence;
+	e.g. its domain, range, number of variables, and number of operators.
+	These values are written before the cached information.
+	*/
+	void write(std::ostream& os, const CppAD::vector<size_t>& key) const
+	{	os << "cppad_sparse_cache\n";
+		write_vec(os, key);
+		write_pattern(os, jac_pattern);
+		write_vec(os, jac_order);
+		write_vec(os, jac_color);
+		write_pattern(os, hes_pattern);
+		write_vec(os, hes_row);
+		write_vec(os, hes_col);
+		write_vec(os, hes_order);
+		write_vec(os, hes_color);
+	}
+	/*!
+	Read the cached information from a stream.
+
+	\param is
+	is the stream that the information is read from.
+
+	\param key
+	is the key for the operation sequence corresponding to this cache
+	(see write).
+
+	\return
+	is true if the information was read and its key is equal to key.
+	Otherwise, the return value is false and this cache is not changed.
+	*/
+	bool read(std::istream& is, const CppAD::vector<size_t>& key)
+	{	std::string header;
+		is >> header;
+		if( header != "cppad_sparse_cache" )
+			return false;
+		CppAD::vector<size_t> check;
+		if( ! read_vec(is, check) )
+			return false;
+		if( check.size() != key.size() )
+			return false;
+		for(size_t i = 0; i < key.size(); ++i)
+		{	if( check[i] != key[i] )
+				return false;
+		}
+		sparse_cache_info other;
+		bool ok = read_pattern(is, other.jac_pattern);
+		ok     &= read_vec(is, other.jac_order);
+		ok     &= read_vec(is, other.jac_color);
+		ok     &= read_pattern(is, other.hes_pattern);
+		ok     &= read_vec(is, other.hes_row);
+		ok     &= read_vec(is, other.hes_col);
+		ok     &= read_vec(is, other.hes_order);
+		ok     &= read_vec(is, other.hes_color);
+		if( ! ok )
+			return false;
+		//
+		*this = other;
+		return true;
+	}
+private:
+	/// write a vector as its size followed by its elements
+	static void write_vec(std::ostream& os, const CppAD::vector<size_t>& vec)
+	{	os << vec.size();
+		for(size_t i = 0; i < vec.size(); ++i)
+			os << " " << vec[i];
+		os << "\n";
+	}
+	/// read a vector written by write_vec
+	static bool read_vec(std::istream& is, CppAD::vector<size_t>& vec)
+	{	size_t size;
+		if( ! (is >> size) )
+			return false;
+		vec.resize(size);
+		for(size_t i = 0; i < size; ++i)
+		{	if( ! (is >> vec[i]) )
+				return false;
+		}
+		return true;
+	}
+	/// write a sparsity pattern as nr, nc, row indices, and column indices
+	static void write_pattern(std::ostream& os, const pattern_type& pattern)
+	{	os << pattern.nr() << " " << pattern.nc() << "\n";
+		write_vec(os, pattern.row());
+		write_vec(os, pattern.col());
+	}
+	/// read a sparsity pattern written by write_pattern
+	static bool read_pattern(std::istream& is, pattern_type& pattern)
+	{	size_t nr, nc;
+		if( ! (is >> nr >> nc) )
+			return false;
+		CppAD::vector<size_t> row, col;
+		if( ! ( read_vec(is, row) && read_vec(is, col) ) )
+			return false;
+		if( row.size() != col.size() )
+			return false;
+		size_t nnz = row.size();
+		for(size_t k = 0; k < nnz; ++k)
+		{	if( row[k] >= nr || col[k] >= nc )
+				return false;
+		}
+		pattern.resize(nr, nc, nnz);
+		for(size_t k = 0; k < nnz; ++k)
+			pattern.set(k, row[k], col[k]);
+		return true;
+	}
+};
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+# endif
@@ -23,6 +23,44 @@ with the element values strictly increasing.
 */
 class sparse_list_const_iterator;
 
+// =========================================================================
+/*!
+Statistics for the memory used by a sparse_list object.
+
+Sets that are equal can share the same list, in which case the reference
+count in the first entry of the list is the number of sets that share it.
+Only entire lists are shared; i.e., a list never shares its tail with
+another list. The counts below report this whole list sharing.
+
+All of the counts, except number_set and number_distinct_list,
+are in units of data entries (pairs of size_t values).
+*/
+struct sparse_list_statistics {
+	/// number of sets that are not empty
+	size_t number_set;
+
+	/// number of distinct lists used to represent the non-empty sets
+	size_t number_distinct_list;
+
+	/// number of entries used by the distinct lists
+	/// (including their reference counts)
+	size_t number_list_entry;
+
+	/// number of entries that would be used if each non-empty set had
+	/// its own list; i.e., number_unshared_entry - number_list_entry
+	/// entries are saved by sharing entire lists
+	size_t number_unshared_entry;
+
+	/// number of entries used by elements that are posted
+	size_t number_post;
+
+	/// number of entries that are not being used (garbage)
+	size_t number_not_used;
+
+	/// number of entries that fit in the memory currently allocated
+	size_t capacity;
+};
+
 // =========================================================================
 /*!
 Vector of sets of positive integers, each set stored as a singly
@@ -105,6 +143,12 @@ private:
 	*/
 	pod_vector<size_t> temporary_;
 
+	/*!
+	If true, data_ is compacted when a significant proportion of its
+	entries are not being used; see collect_garbage.
+	*/
+	bool auto_compact_;
+
 	// -----------------------------------------------------------------
 	/*!
 	Counts references to sets.
@@ -236,6 +280,22 @@ private:
 	}
 	// -----------------------------------------------------------------
 	/*!
+	Compacts data_ when indicated.
+
+	This routine should be called at the end of public member functions
+	that may increase number_not_used_.
+	If auto_compact_ is true and a significant propotion of the entries
+	in data_ are not being used, data_ is compacted.
+	*/
+	void collect_garbage(void)
+	{	if( ! auto_compact_ )
+			return;
+		if( number_not_used_ < data_.size() / 2 + 100 )
+			return;
+		compact();
+	}
+	// -----------------------------------------------------------------
+	/*!
 	Checks data structure
 	(effectively const, but modifies and restores values)
 	*/
@@ -597,7 +657,8 @@ public:
 	data_not_used_(0)    ,
 	data_(0)             ,
 	start_(0)            ,
-	post_(0)
+	post_(0)             ,
+	auto_compact_(false)
 	{ }
 	// -----------------------------------------------------------------
 	/// Destructor
@@ -633,6 +694,7 @@ public:
 		data_            = other.data_;
 		start_           = other.start_;
 		post_            = other.post_;
+		// auto_compact_ is an option for this object and is not copied
 	}
 	// -----------------------------------------------------------------
 	/*!
@@ -662,6 +724,7 @@ public:
 			data_.clear();
 			start_.clear();
 			post_.clear();
+			temporary_.clear();
 			number_not_used_  = 0;
 			data_not_used_    = 0;
 			end_              = 0;
@@ -777,6 +840,7 @@ public:
 			++number_not_used_;
 			//
 			add_element(i, value);
+			collect_garbage();
 			//
 			return;
 		}
@@ -808,6 +872,7 @@ public:
 		//
 		// add the elements to the set
 		binary_union(i, i, temporary_);
+		collect_garbage();
 		//
 		return;
 	}
@@ -969,6 +1034,7 @@ public:
 		// adjust number_not_used_
 		size_t number_drop = drop(target);
 		number_not_used_  += number_drop;
+		collect_garbage();
 
 		return;
 	}
@@ -1047,6 +1113,7 @@ public:
 
 		// set the new start value for this_target
 		start_[this_target] = this_start;
+		collect_garbage();
 
 		return;
 	}
@@ -1154,6 +1221,7 @@ public:
 
 		// set the new start value for this_target
 		start_[this_target] = start;
+		collect_garbage();
 
 		return;
 	}
@@ -1232,7 +1300,6 @@ public:
 				{	// this is the first element in the intersection
 					start               = get_data_index();
 					next                = start;
-					start_[this_target] = start;
 					data_[start].value  = 1; // reference count
 					CPPAD_ASSERT_UNKNOWN( start > 0 );
 				}
@@ -1268,6 +1335,7 @@ public:
 
 		// set new start for this_target
 		start_[this_target] = start;
+		collect_garbage();
 
 		return;
 	}
@@ -1288,6 +1356,19 @@ public:
 	size_t end(void) const
 	{	return end_; }
 	// -----------------------------------------------------------------
+	/*!
+	Use an arena for the future allocations by this vector of sets.
+
+	\param arena
+	is the arena (null for the thread_alloc pools).
+	*/
+	void set_arena(thread_alloc_arena* arena)
+	{	data_.set_arena(arena);
+		start_.set_arena(arena);
+		post_.set_arena(arena);
+		temporary_.set_arena(arena);
+	}
+	// -----------------------------------------------------------------
 	/*! Amount of memory used by this vector of sets
 
 	\return
@@ -1296,6 +1377,165 @@ public:
 	size_t memory(void) const
 	{	return data_.capacity() * sizeof(pair_size_t);
 	}
+	// -----------------------------------------------------------------
+	/*!
+	Remove the entries that are not being used from data_.
+
+	The lists (and their sharing between sets) and the posted elements
+	are copied to a new data_ vector that is just large enough to hold them.
+	The memory for the old data_ vector, and for temporary_,
+	is returned to thread_alloc.
+	Values returned by const_iterator objects for this vector of sets
+	are not valid after this operation.
+
+	\par vector_of_sets
+	This public member function is not yet part of
+	the vector_of_sets concept.
+	*/
+	void compact(void)
+	{	check_data_structure();
+		//
+		size_t n_set = start_.size();
+		if( n_set == 0 )
+			return;
+		//
+		// number of entries in the new data vector
+		size_t number_used = data_.size() - number_not_used_;
+		pod_vector<pair_size_t> data_tmp;
+		data_tmp.set_arena( data_.arena() );
+		data_tmp.extend(number_used);
+		//
+		// data_tmp[0] marks the end for all lists
+		data_tmp[0] = data_[0];
+		size_t index = 1;
+		//
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start != 0 )
+			{	size_t reference_count = data_[start].value;
+				if( reference_count == 0 )
+				{	// list already copied, its new start stored in next
+					start_[i] = data_[start].next;
+				}
+				else
+				{	// copy this list
+					size_t start_tmp       = index++;
+					data_tmp[start_tmp]    = data_[start];
+					size_t previous_tmp    = start_tmp;
+					size_t next            = data_[start].next;
+					while( next != 0 )
+					{	data_tmp[previous_tmp].next = index;
+						data_tmp[index].value       = data_[next].value;
+						previous_tmp                = index++;
+						next                        = data_[next].next;
+					}
+					data_tmp[previous_tmp].next = 0;
+					//
+					// flag that this list has been copied
+					data_[start].value = 0;
+					data_[start].next  = start_tmp;
+					start_[i]          = start_tmp;
+				}
+			}
+			// copy the posted elements for this set
+			size_t post = post_[i];
+			if( post != 0 )
+			{	post_[i]            = index;
+				size_t previous_tmp = 0;
+				while( post != 0 )
+				{	if( previous_tmp != 0 )
+						data_tmp[previous_tmp].next = index;
+					data_tmp[index].value = data_[post].value;
+					previous_tmp          = index++;
+					post                  = data_[post].next;
+				}
+				data_tmp[previous_tmp].next = 0;
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( index == number_used );
+		//
+		// swap the new data vector in and free the old one
+		data_.swap(data_tmp);
+		data_tmp.clear();
+		temporary_.clear();
+		number_not_used_ = 0;
+		data_not_used_   = 0;
+		//
+		check_data_structure();
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Should data_ be compacted automatically.
+
+	\param value
+	If true, data_ is compacted (see compact) at the end of a member function
+	when more than half of its entries are not being used.
+	This bounds the memory used by long sparsity sweeps but invalidates
+	const_iterator objects for all the sets in this vector of sets.
+	The default value (after construction) is false.
+	The Hessian sparsity routines (for_hes_sparsity, for_sparse_hes,
+	rev_hes_sparsity and rev_sparse_hes) set it to true for the
+	vector of sets that holds the Hessian pattern during their sweep.
+
+	\par vector_of_sets
+	This public member function is not yet part of
+	the vector_of_sets concept.
+	*/
+	void auto_compact(bool value)
+	{	auto_compact_ = value;
+		collect_garbage();
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Statistics for the memory used by this vector of sets.
+
+	\return
+	see sparse_list_statistics.
+
+	\par vector_of_sets
+	This public member function is not yet part of
+	the vector_of_sets concept.
+	*/
+	sparse_list_statistics statistics(void) const
+	{	sparse_list_statistics result;
+		result.number_set            = 0;
+		result.number_distinct_list  = 0;
+		result.number_list_entry     = 0;
+		result.number_unshared_entry = 0;
+		result.number_post           = 0;
+		result.number_not_used       = number_not_used_;
+		result.capacity              = data_.capacity();
+		//
+		size_t n_set = start_.size();
+		pod_vector<bool> counted( data_.size() );
+		for(size_t k = 0; k < data_.size(); k++)
+			counted[k] = false;
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start != 0 )
+			{	// number of entries in this list
+				size_t length = 1;
+				size_t next   = data_[start].next;
+				while( next != 0 )
+				{	++length;
+					next = data_[next].next;
+				}
+				++result.number_set;
+				result.number_unshared_entry += length;
+				if( ! counted[start] )
+				{	counted[start] = true;
+					++result.number_distinct_list;
+					result.number_list_entry += length;
+				}
+			}
+			size_t post = post_[i];
+			while( post != 0 )
+			{	++result.number_post;
+				post = data_[post].next;
+			}
+		}
+		return result;
+	}
 	/*!
 	Print the vector of sets (used for debugging)
 	*/
@@ -424,6 +424,16 @@ public:
 	{	return end_; }
 	// -----------------------------------------------------------------
 	/*!
+	Use an arena for the future allocations by this vector of sets.
+
+	\param arena
+	is the arena (null for the thread_alloc pools).
+	*/
+	void set_arena(thread_alloc_arena* arena)
+	{	data_.set_arena(arena);
+	}
+	// -----------------------------------------------------------------
+	/*!
 	Amount of memory used by this vector of sets
 
 	\return
@@ -0,0 +1,1414 @@
+# ifndef CPPAD_LOCAL_SPARSE_ROARING_HPP
+# define CPPAD_LOCAL_SPARSE_ROARING_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <algorithm>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/local/pod_vector.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file sparse_roaring.hpp
+Vector of sets of positive integers stored as compressed bitmaps.
+*/
+
+// forward declaration
+class sparse_roaring_const_iterator;
+
+// =========================================================================
+/*!
+Vector of sets of positive integers, each set stored as a compressed bitmap.
+
+The possible elements are split into chunks of 2^16 values and the
+elements of a set in each chunk are stored in a container
+that is the smallest of the following three representations:
+a sorted array of the low order 16 bits, a bitmap with 2^16 bits,
+or a sorted array of runs of consecutive elements.
+The representation is chosen each time a container is created,
+so sets that are dense in some chunks and sparse in others
+use the appropriate representation for each chunk; see
+S. Chambi, D. Lemire, O. Kaser, R. Godin,
+Better bitmap performance with Roaring bitmaps,
+Software: Practice and Experience 46 (2016).
+
+Sets are reference counted so that assignment, and unions where one
+operand is a subset of the other, do not copy the elements.
+
+All the public members for this class are also in the
+sparse_pack, sparse_list, and sparse_sizevec classes.
+This defines the CppAD vector_of_sets concept.
+*/
+class sparse_roaring {
+	friend class sparse_roaring_const_iterator;
+private:
+	/// type used for the words that store the sets
+	typedef unsigned short word_t;
+
+	/// constants that define the containers
+	enum {
+		/// number of bits in the low order part of an element
+		chunk_bits   = 16,
+		/// mask for the low order part of an element
+		chunk_mask   = 0xFFFF,
+		/// number of words in a bitmap container (and maximum array size)
+		bitmap_words = 4096,
+		/// number of words before the payload in a container
+		header_words = 4,
+		/// number of words used to store a size_t value
+		size_words   = sizeof(size_t) / sizeof(word_t),
+		/// number of words before the payload in a set
+		set_header_words = 3 * size_words
+	};
+
+	/// type of a container
+	enum container_type { array_type = 0, bitmap_type = 1, run_type = 2 };
+
+	/// Possible elements in each set are 0, 1, ..., end_ - 1;
+	size_t end_;
+
+	/// number of elements in data_ that have been allocated
+	/// and are no longer being used.
+	size_t data_not_used_;
+
+	/*!
+	The data for all the sets.
+
+	\li
+	data_[0] is not used so that start_[i] == 0 can denote the empty set.
+
+	\li
+	A set that starts at index s has reference count
+	get_size(data_ + s), payload length n = get_size(data_ + s + h),
+	and payload capacity get_size(data_ + s + 2 * h), where h = size_words.
+	The payload is data_[s + 3 * h], ... , data_[s + 3 * h + n - 1]
+	and the capacity is the number of words reserved for it (at least n).
+
+	\li
+	The payload is a sequence of containers in increasing key order.
+	A container c has key get32(c), type c[2], and c[3] + 1 is the
+	number of elements (array and bitmap) or the number of runs (run).
+	It is followed by the c[3] + 1 low order parts (array),
+	bitmap_words words of bits (bitmap),
+	or pairs (start, length - 1) of runs (run).
+	*/
+	pod_vector<word_t> data_;
+
+	/// start_[i] is the index in data_ where the i-th set starts
+	/// (zero if the i-th set is empty).
+	pod_vector<size_t> start_;
+
+	/*!
+	Elements that have not yet been added to corresponding sets.
+	If post_[i] is zero, there are no elements posted for set i.
+	Otherwise post_data_[ post_[i] - 1 ] is the last element posted,
+	and post_data_[ post_[i] ] is the post_ value before it was posted.
+	*/
+	pod_vector<size_t> post_;
+
+	/// element and link pairs for the posted elements
+	pod_vector<size_t> post_data_;
+
+	/// number of sets that have elements posted to them
+	size_t number_post_;
+
+	/// temporary vectors (used to avoid frequent memory allocation)
+	pod_vector<word_t> result_, low_a_, low_b_, low_, bitmap_a_, bitmap_b_;
+
+	/// temporary vector for the payload in process_post and add_element
+	pod_vector<word_t> payload_;
+
+	/// temporary vector for process_post
+	pod_vector<size_t> post_element_;
+	// -----------------------------------------------------------------
+	/// value corresponding to two words (used for container keys)
+	static size_t get32(const word_t* p)
+	{	return size_t(p[0]) + ( size_t(p[1]) << 16 ); }
+
+	/// set two words to a value (resize checks that the keys fit)
+	static void set32(word_t* p, size_t value)
+	{	CPPAD_ASSERT_UNKNOWN( ( (value >> 16) >> 16 ) == 0 );
+		p[0] = word_t( value & chunk_mask );
+		p[1] = word_t( (value >> 16) & chunk_mask );
+	}
+
+	/// value corresponding to size_words words
+	static size_t get_size(const word_t* p)
+	{	size_t value = 0;
+		for(size_t k = size_words; k > 0; --k)
+			value = (value << chunk_bits) | size_t( p[k - 1] );
+		return value;
+	}
+
+	/// set size_words words to a value
+	static void set_size(word_t* p, size_t value)
+	{	for(size_t k = 0; k < size_t(size_words); ++k)
+		{	p[k]    = word_t( value & chunk_mask );
+			value >>= chunk_bits;
+		}
+	}
+
+	/// reference count for the set that starts at data_[start]
+	size_t reference_count(size_t start) const
+	{	return get_size(data_.data() + start); }
+
+	/// set the reference count for the set that starts at data_[start]
+	void set_reference_count(size_t start, size_t value)
+	{	set_size(data_.data() + start, value); }
+
+	/// payload length for the set that starts at data_[start]
+	size_t payload_length(size_t start) const
+	{	return get_size(data_.data() + start + size_words); }
+
+	/// set the payload length for the set that starts at data_[start]
+	void set_payload_length(size_t start, size_t value)
+	{	set_size(data_.data() + start + size_words, value); }
+
+	/// payload capacity for the set that starts at data_[start]
+	size_t payload_capacity(size_t start) const
+	{	return get_size(data_.data() + start + 2 * size_words); }
+
+	/// set the payload capacity for the set that starts at data_[start]
+	void set_payload_capacity(size_t start, size_t value)
+	{	set_size(data_.data() + start + 2 * size_words, value); }
+
+	/// number of words in a container (including its header)
+	static size_t container_length(const word_t* c)
+	{	size_t count = size_t( c[3] ) + 1;
+		switch( c[2] )
+		{	case array_type:
+			return header_words + count;
+
+			case bitmap_type:
+			return header_words + bitmap_words;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN( c[2] == run_type );
+			break;
+		}
+		return header_words + 2 * count;
+	}
+
+	/// number of elements in a container
+	static size_t cardinality(const word_t* c)
+	{	size_t count = size_t( c[3] ) + 1;
+		if( c[2] != run_type )
+			return count;
+		size_t result = 0;
+		for(size_t k = 0; k < count; ++k)
+			result += size_t( c[header_words + 2 * k + 1] ) + 1;
+		return result;
+	}
+
+	/// number of bits that are one in a word
+	static size_t number_one(size_t word)
+	{	size_t count = 0;
+		while( word != 0 )
+		{	word &= word - 1;
+			++count;
+		}
+		return count;
+	}
+
+	/// add a container header to the end of out, return index of payload
+	static size_t add_header(
+		pod_vector<word_t>& out  ,
+		size_t              key  ,
+		container_type      type ,
+		size_t              count_m1 ,
+		size_t              payload  )
+	{	CPPAD_ASSERT_UNKNOWN( count_m1 <= size_t(chunk_mask) );
+		size_t index = out.extend(header_words + payload);
+		set32(out.data() + index, key);
+		out[index + 2] = word_t(type);
+		out[index + 3] = word_t(count_m1);
+		return index + header_words;
+	}
+
+	/// low order parts of the elements in a container in increasing order
+	static void decode_sorted(const word_t* c, pod_vector<word_t>& low)
+	{	low.resize(0);
+		const word_t* payload = c + header_words;
+		size_t count = size_t( c[3] ) + 1;
+		switch( c[2] )
+		{	case array_type:
+			low.resize(count);
+			for(size_t k = 0; k < count; ++k)
+				low[k] = payload[k];
+			break;
+
+			case bitmap_type:
+			low.resize(count);
+			count = 0;
+			for(size_t w = 0; w < size_t(bitmap_words); ++w)
+			{	size_t word = payload[w];
+				size_t bit  = 0;
+				while( word != 0 )
+				{	if( word & 1 )
+						low[count++] = word_t(16 * w + bit);
+					word >>= 1;
+					++bit;
+				}
+			}
+			CPPAD_ASSERT_UNKNOWN( count == low.size() );
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN( c[2] == run_type );
+			for(size_t k = 0; k < count; ++k)
+			{	size_t start  = payload[2 * k];
+				size_t length = size_t( payload[2 * k + 1] ) + 1;
+				for(size_t ell = 0; ell < length; ++ell)
+					low.push_back( word_t(start + ell) );
+			}
+			break;
+		}
+	}
+
+	/// or the elements in a container into a bitmap
+	static void decode_bitmap(const word_t* c, word_t* bitmap)
+	{	const word_t* payload = c + header_words;
+		size_t count = size_t( c[3] ) + 1;
+		switch( c[2] )
+		{	case array_type:
+			for(size_t k = 0; k < count; ++k)
+			{	size_t low = payload[k];
+				bitmap[low / 16] |= word_t( 1 << (low % 16) );
+			}
+			break;
+
+			case bitmap_type:
+			for(size_t w = 0; w < size_t(bitmap_words); ++w)
+				bitmap[w] |= payload[w];
+			break;
+
+			default:
+			CPPAD_ASSERT_UNKNOWN( c[2] == run_type );
+			for(size_t k = 0; k < count; ++k)
+			{	size_t start  = payload[2 * k];
+				size_t length = size_t( payload[2 * k + 1] ) + 1;
+				for(size_t low = start; low < start + length; ++low)
+					bitmap[low / 16] |= word_t( 1 << (low % 16) );
+			}
+			break;
+		}
+	}
+
+	/// add the container with the best representation for a
+	/// sorted vector of low order parts to the end of out
+	static void encode_sorted(
+		size_t              key   ,
+		const word_t*       low   ,
+		size_t              count ,
+		pod_vector<word_t>& out   )
+	{	if( count == 0 )
+			return;
+		size_t n_run = 1;
+		for(size_t k = 1; k < count; ++k)
+			if( size_t(low[k]) != size_t(low[k-1]) + 1 )
+				++n_run;
+		//
+		if( 2 * n_run < std::min(count, size_t(bitmap_words)) )
+		{	size_t index = add_header(out, key, run_type, n_run - 1, 2 * n_run);
+			size_t k = 0;
+			while( k < count )
+			{	size_t start = low[k];
+				size_t ell   = k + 1;
+				while( ell < count && size_t(low[ell]) == start + ell - k )
+					++ell;
+				out[index++] = word_t(start);
+				out[index++] = word_t(ell - k - 1);
+				k = ell;
+			}
+			return;
+		}
+		if( count <= size_t(bitmap_words) )
+		{	size_t index = add_header(out, key, array_type, count - 1, count);
+			for(size_t k = 0; k < count; ++k)
+				out[index + k] = low[k];
+			return;
+		}
+		size_t index = add_header(
+			out, key, bitmap_type, count - 1, size_t(bitmap_words)
+		);
+		for(size_t w = 0; w < size_t(bitmap_words); ++w)
+			out[index + w] = 0;
+		for(size_t k = 0; k < count; ++k)
+			out[index + low[k] / 16] |= word_t( 1 << (low[k] % 16) );
+	}
+
+	/// add the container with the best representation for a
+	/// bitmap to the end of out
+	void encode_bitmap(
+		size_t              key    ,
+		const word_t*       bitmap ,
+		pod_vector<word_t>& out    )
+	{	size_t count = 0;
+		size_t n_run = 0;
+		size_t carry = 0;
+		for(size_t w = 0; w < size_t(bitmap_words); ++w)
+		{	size_t word = bitmap[w];
+			count += number_one(word);
+			// bits that are one and the previous bit is zero
+			size_t previous = ( (word << 1) | carry ) & size_t(chunk_mask);
+			n_run += number_one( word & ~previous );
+			carry  = (word >> 15) & 1;
+		}
+		if( count == 0 )
+			return;
+		if( count <= size_t(bitmap_words) || 2 * n_run < size_t(bitmap_words) )
+		{	// use encode_sorted to choose between array and run
+			low_.resize(count);
+			size_t k = 0;
+			for(size_t w = 0; w < size_t(bitmap_words); ++w)
+			{	size_t word = bitmap[w];
+				size_t bit  = 0;
+				while( word != 0 )
+				{	if( word & 1 )
+						low_[k++] = word_t(16 * w + bit);
+					word >>= 1;
+					++bit;
+				}
+			}
+			CPPAD_ASSERT_UNKNOWN( k == count );
+			encode_sorted(key, low_.data(), count, out);
+			return;
+		}
+		size_t index = add_header(
+			out, key, bitmap_type, count - 1, size_t(bitmap_words)
+		);
+		for(size_t w = 0; w < size_t(bitmap_words); ++w)
+			out[index + w] = bitmap[w];
+	}
+
+	/*!
+	Add the union or intersection of two containers with the same key
+	to the end of out.
+	*/
+	void combine_container(
+		const word_t*       left  ,
+		const word_t*       right ,
+		bool                do_union ,
+		pod_vector<word_t>& out   )
+	{	size_t key = get32(left);
+		CPPAD_ASSERT_UNKNOWN( key == get32(right) );
+		size_t n_left  = cardinality(left);
+		size_t n_right = cardinality(right);
+		if( n_left + n_right <= size_t(bitmap_words) )
+		{	// merge the sorted low order parts
+			decode_sorted(left, low_a_);
+			decode_sorted(right, low_b_);
+			low_.resize(n_left + n_right);
+			size_t k = 0, k_left = 0, k_right = 0;
+			while( k_left < n_left && k_right < n_right )
+			{	word_t v_left  = low_a_[k_left];
+				word_t v_right = low_b_[k_right];
+				if( v_left < v_right )
+				{	if( do_union )
+						low_[k++] = v_left;
+					++k_left;
+				}
+				else if( v_right < v_left )
+				{	if( do_union )
+						low_[k++] = v_right;
+					++k_right;
+				}
+				else
+				{	low_[k++] = v_left;
+					++k_left;
+					++k_right;
+				}
+			}
+			if( do_union )
+			{	while( k_left < n_left )
+					low_[k++] = low_a_[k_left++];
+				while( k_right < n_right )
+					low_[k++] = low_b_[k_right++];
+			}
+			encode_sorted(key, low_.data(), k, out);
+			return;
+		}
+		// use bitmaps
+		bitmap_a_.resize(bitmap_words);
+		bitmap_b_.resize(bitmap_words);
+		for(size_t w = 0; w < size_t(bitmap_words); ++w)
+		{	bitmap_a_[w] = 0;
+			bitmap_b_[w] = 0;
+		}
+		decode_bitmap(left, bitmap_a_.data());
+		decode_bitmap(right, bitmap_b_.data());
+		for(size_t w = 0; w < size_t(bitmap_words); ++w)
+		{	if( do_union )
+				bitmap_a_[w] |= bitmap_b_[w];
+			else
+				bitmap_a_[w] &= bitmap_b_[w];
+		}
+		encode_bitmap(key, bitmap_a_.data(), out);
+	}
+
+	/*!
+	Set out to the payload for the union or intersection of two payloads.
+	*/
+	void combine_payload(
+		const word_t*       left     ,
+		size_t              n_left   ,
+		const word_t*       right    ,
+		size_t              n_right  ,
+		bool                do_union ,
+		pod_vector<word_t>& out      )
+	{	out.resize(0);
+		size_t i_left = 0, i_right = 0;
+		while( i_left < n_left || i_right < n_right )
+		{	if( i_right == n_right ||
+			( i_left < n_left && get32(left + i_left) < get32(right + i_right) )
+			)
+			{	size_t length = container_length(left + i_left);
+				if( do_union )
+				{	size_t index = out.extend(length);
+					for(size_t k = 0; k < length; ++k)
+						out[index + k] = left[i_left + k];
+				}
+				i_left += length;
+			}
+			else if( i_left == n_left ||
+				get32(right + i_right) < get32(left + i_left)
+			)
+			{	size_t length = container_length(right + i_right);
+				if( do_union )
+				{	size_t index = out.extend(length);
+					for(size_t k = 0; k < length; ++k)
+						out[index + k] = right[i_right + k];
+				}
+				i_right += length;
+			}
+			else
+			{	combine_container(
+					left + i_left, right + i_right, do_union, out
+				);
+				i_left  += container_length(left + i_left);
+				i_right += container_length(right + i_right);
+			}
+		}
+	}
+
+	/// is a payload equal to the payload for a set in this object
+	bool equal_payload(const pod_vector<word_t>& payload, size_t start) const
+	{	if( start == 0 )
+			return payload.size() == 0;
+		size_t n = payload_length(start);
+		if( n != payload.size() )
+			return false;
+		const word_t* p = data_.data() + start + set_header_words;
+		for(size_t k = 0; k < n; ++k)
+			if( p[k] != payload[k] )
+				return false;
+		return true;
+	}
+
+	/// store a payload as a new set in data_ and return its start index
+	size_t new_set(const pod_vector<word_t>& payload)
+	{	size_t n = payload.size();
+		if( n == 0 )
+			return 0;
+		size_t start = data_.extend(set_header_words + n);
+		set_reference_count(start, 1);
+		set_payload_length(start, n);
+		set_payload_capacity(start, n);
+		for(size_t k = 0; k < n; ++k)
+			data_[start + set_header_words + k] = payload[k];
+		return start;
+	}
+
+	/*!
+	drop a set.
+
+	\param i
+	is the index of the set that will be dropped.
+
+	\par reference_count
+	if the set is non-empty,
+	the reference count corresponding to index will be decremented.
+	*/
+	void drop(size_t i)
+	{	size_t start = start_[i];
+		if( start == 0 )
+			return;
+		start_[i] = 0;
+		size_t ref_count = reference_count(start);
+		CPPAD_ASSERT_UNKNOWN( ref_count > 0 );
+		set_reference_count(start, ref_count - 1);
+		if( ref_count == 1 )
+			data_not_used_ += set_header_words + payload_capacity(start);
+	}
+
+	/// replace set i by a new set with the specified payload
+	void replace(size_t i, const pod_vector<word_t>& payload)
+	{	size_t start = new_set(payload);
+		drop(i);
+		start_[i] = start;
+		collect_garbage();
+	}
+
+	/*!
+	Does garbage collection when indicated.
+
+	This routine should be called when more entries are not being used.
+	If a significant propotion are not being used, the data structure
+	will be compacted.
+	*/
+	void collect_garbage(void)
+	{	if( data_not_used_ < data_.size() / 2 +  100)
+			return;
+		check_data_structure();
+		//
+		size_t n_set  = start_.size();
+		pod_vector<word_t> data_tmp;
+		data_tmp.set_arena( data_.arena() );
+		data_tmp.extend(1); // data_tmp[0] will not be used
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start != 0 )
+			{	if( reference_count(start) == 0 )
+				{	// already copied, new start stored in length field
+					start_[i] = payload_length(start);
+				}
+				else
+				{	size_t n         = payload_length(start);
+					size_t tmp_start = data_tmp.extend(set_header_words + n);
+					for(size_t k = 0; k < set_header_words + n; ++k)
+						data_tmp[tmp_start + k] = data_[start + k];
+					// the copy does not have extra capacity
+					set_size(data_tmp.data() + tmp_start + 2 * size_words, n);
+					//
+					// flag that this set has been copied
+					set_reference_count(start, 0);
+					set_payload_length(start, tmp_start);
+					start_[i] = tmp_start;
+				}
+			}
+		}
+		data_.swap(data_tmp);
+		data_not_used_ = 0;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Checks data structure
+	(effectively const, but modifies and restores values)
+	*/
+# ifdef NDEBUG
+	void check_data_structure(void)
+	{	return; }
+# else
+	void check_data_structure(void)
+	{	size_t n_set = start_.size();
+		if( n_set == 0 )
+		{	CPPAD_ASSERT_UNKNOWN( data_.size() == 0 );
+			return;
+		}
+		// use reference count to count number of references
+		pod_vector<size_t> ref_count(n_set);
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			ref_count[i] = 0;
+			if( start != 0 )
+			{	ref_count[i] = reference_count(start);
+				CPPAD_ASSERT_UNKNOWN( ref_count[i] > 0 );
+			}
+		}
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start != 0 )
+				set_reference_count(start, 0);
+		}
+		size_t data_used = 1;
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start != 0 )
+			{	size_t count = reference_count(start);
+				if( count == 0 )
+					data_used += set_header_words + payload_capacity(start);
+				set_reference_count(start, count + 1);
+			}
+		}
+		for(size_t i = 0; i < n_set; i++)
+		{	size_t start = start_[i];
+			if( start != 0 )
+				CPPAD_ASSERT_UNKNOWN(
+					reference_count(start) == ref_count[i]
+				);
+			// check for elements that are not in increasing order
+			if( start != 0 && post_[i] == 0 )
+			{	size_t n       = payload_length(start);
+				size_t index   = start + set_header_words;
+				size_t key     = 0;
+				bool   first   = true;
+				while( index < start + set_header_words + n )
+				{	const word_t* c = data_.data() + index;
+					CPPAD_ASSERT_UNKNOWN( first || key < get32(c) );
+					key    = get32(c);
+					first  = false;
+					CPPAD_ASSERT_UNKNOWN( cardinality(c) > 0 );
+					index += container_length(c);
+				}
+				CPPAD_ASSERT_UNKNOWN( index == start + set_header_words + n );
+			}
+		}
+		CPPAD_ASSERT_UNKNOWN( data_used + data_not_used_ == data_.size() );
+	}
+# endif
+	// -----------------------------------------------------------------
+	/// set i equal to the union of set i and a payload
+	/// (that does not point into data_)
+	void union_payload(size_t i, const pod_vector<word_t>& payload)
+	{	size_t start = start_[i];
+		if( start == 0 )
+		{	replace(i, payload);
+			return;
+		}
+		const word_t* left = data_.data() + start + set_header_words;
+		size_t n_left      = payload_length(start);
+		combine_payload(
+			left, n_left, payload.data(), payload.size(), true, result_
+		);
+		if( equal_payload(result_, start) )
+			return;
+		replace(i, result_);
+	}
+public:
+	/// declare a const iterator
+	typedef sparse_roaring_const_iterator const_iterator;
+	// -----------------------------------------------------------------
+	/*!
+	Default constructor (no sets)
+	*/
+	sparse_roaring(void) :
+	end_(0)            ,
+	data_not_used_(0)  ,
+	data_(0)           ,
+	start_(0)          ,
+	post_(0)           ,
+	post_data_(0)      ,
+	number_post_(0)
+	{ }
+	// -----------------------------------------------------------------
+	/// Destructor
+	~sparse_roaring(void)
+	{	check_data_structure();
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Using copy constructor is a programing (not user) error
+
+	\param v
+	vector of sets that we are attempting to make a copy of.
+	*/
+	sparse_roaring(const sparse_roaring& v)
+	{	// Error: Probably a sparse_roaring argument has been passed by value
+		CPPAD_ASSERT_UNKNOWN(false);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assignement operator.
+
+	\param other
+	this sparse_roaring with be set to a deep copy of other.
+	*/
+	void operator=(const sparse_roaring& other)
+	{	end_             = other.end_;
+		data_not_used_   = other.data_not_used_;
+		data_            = other.data_;
+		start_           = other.start_;
+		post_            = other.post_;
+		post_data_       = other.post_data_;
+		number_post_     = other.number_post_;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Start a new vector of sets.
+
+	\param n_set
+	is the number of sets in this vector of sets.
+	\li
+	If n_set is zero, any memory currently allocated for this object
+	is freed.
+	\li
+	If n_set is non-zero, a vector of n_set sets is created and all
+	the sets are initilaized as empty.
+
+	\param end
+	is the maximum element plus one (the minimum element is 0).
+	If n_set is zero, end must also be zero.
+	*/
+	void resize(size_t n_set, size_t end)
+	{	check_data_structure();
+
+		if( n_set == 0 )
+		{	CPPAD_ASSERT_UNKNOWN( end == 0 );
+			//
+			// restore object to start after constructor
+			// (no memory allocated for this object)
+			data_.clear();
+			start_.clear();
+			post_.clear();
+			post_data_.clear();
+			result_.clear();
+			low_a_.clear();
+			low_b_.clear();
+			low_.clear();
+			bitmap_a_.clear();
+			bitmap_b_.clear();
+			payload_.clear();
+			post_element_.clear();
+			data_not_used_  = 0;
+			number_post_    = 0;
+			end_            = 0;
+			//
+			return;
+		}
+		// the key for an element is stored using two words
+		CPPAD_ASSERT_KNOWN(
+			end == 0 || ( ( ( (end - 1) >> chunk_bits ) >> 16 ) >> 16 ) == 0,
+			"sparse_roaring: the number of possible elements is too large"
+		);
+		end_                   = end;
+		//
+		start_.resize(n_set);
+		post_.resize(n_set);
+		for(size_t i = 0; i < n_set; i++)
+		{	start_[i] = 0;
+			post_[i]  = 0;
+		}
+		//
+		// data_[0] is not used
+		data_.resize(1);
+		data_[0]        = 0;
+		post_data_.resize(0);
+		data_not_used_  = 0;
+		number_post_    = 0;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Count number of elements in a set.
+
+	\param i
+	is the index in of the set we are counting the elements of.
+	*/
+	size_t number_elements(size_t i) const
+	{	CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+		size_t start = start_[i];
+		if( start == 0 )
+			return 0;
+		size_t n     = payload_length(start);
+		size_t index = start + set_header_words;
+		size_t count = 0;
+		while( index < start + set_header_words + n )
+		{	count += cardinality(data_.data() + index);
+			index += container_length(data_.data() + index);
+		}
+		return count;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Post an element for delayed addition to a set.
+
+	\param i
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the value of the element that we are posting.
+	The same element may be posted multiple times.
+
+	\par
+	It is faster to post multiple elements to set i and then call
+	process_post(i) then to add each element individually.
+	It is an error to call any member function,
+	that depends on the value of set i,
+	before processing the posts to set i.
+	*/
+	void post_element(size_t i, size_t element)
+	{	CPPAD_ASSERT_UNKNOWN( i < start_.size() );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		if( post_[i] == 0 )
+			++number_post_;
+		size_t index           = post_data_.extend(2);
+		post_data_[index]      = element;
+		post_data_[index + 1]  = post_[i];
+		post_[i]               = index + 1;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	process post entries for a specific set.
+
+	\param i
+	index of the set for which we are processing the post entries.
+
+	\par post_
+	Upon call, post_[i] is location in post_data_ of the elements that get
+	added to the i-th set.  Upon return, post_[i] is zero.
+	*/
+	void process_post(size_t i)
+	{	size_t post = post_[i];
+		if( post == 0 )
+			return;
+		post_element_.resize(0);
+		while( post != 0 )
+		{	post_element_.push_back( post_data_[post - 1] );
+			post = post_data_[post];
+		}
+		post_[i] = 0;
+		if( --number_post_ == 0 )
+			post_data_.resize(0);
+		//
+		size_t* first = post_element_.data();
+		size_t* last  = first + post_element_.size();
+		std::sort(first, last);
+		last = std::unique(first, last);
+		//
+		// payload corresponding to the posted elements
+		payload_.resize(0);
+		size_t* itr = first;
+		while( itr != last )
+		{	size_t key = *itr >> chunk_bits;
+			low_.resize(0);
+			while( itr != last && (*itr >> chunk_bits) == key )
+				low_.push_back( word_t( *itr++ & chunk_mask ) );
+			low_a_ = low_;
+			encode_sorted(key, low_a_.data(), low_a_.size(), payload_);
+		}
+		union_payload(i, payload_);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Add one element to a set.
+
+	\param i
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the element we are adding to the set.
+
+	\par
+	If the set is only used by set i, the container for the element is
+	changed in place. If the set does not have enough capacity for this,
+	it is first moved to the end of data_ with twice the capacity it needs
+	(so that adding elements to the same set seldom copies it).
+	*/
+	void add_element(size_t i, size_t element)
+	{	CPPAD_ASSERT_UNKNOWN( i   < start_.size() );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		if( is_element(i, element) )
+			return;
+		size_t key   = element >> chunk_bits;
+		word_t low   = word_t( element & chunk_mask );
+		size_t start = start_[i];
+		if( start == 0 || reference_count(start) != 1 )
+		{	// new set that is the union of this set and the element
+			payload_.resize(0);
+			encode_sorted(key, &low, 1, payload_);
+			union_payload(i, payload_);
+			return;
+		}
+		//
+		// index of the container for this key
+		// (or where it should be inserted)
+		size_t n     = payload_length(start);
+		size_t index = start + set_header_words;
+		size_t end   = index + n;
+		while( index < end && get32(data_.data() + index) < key )
+			index += container_length(data_.data() + index);
+		//
+		// low order parts of the container with the element added
+		size_t old_length = 0;
+		low_.resize(0);
+		if( index < end && get32(data_.data() + index) == key )
+		{	decode_sorted(data_.data() + index, low_);
+			old_length = container_length(data_.data() + index);
+		}
+		low_.push_back(low);
+		for(size_t k = low_.size() - 1; k > 0 && low_[k-1] > low; --k)
+		{	low_[k]   = low_[k-1];
+			low_[k-1] = low;
+		}
+		result_.resize(0);
+		encode_sorted(key, low_.data(), low_.size(), result_);
+		size_t new_length = result_.size();
+		//
+		// If the new payload does not fit in the capacity for this set,
+		// move the set to the end of data_ and double its capacity.
+		size_t new_n = n + new_length - old_length;
+		if( payload_capacity(start) < new_n )
+		{	size_t capacity  = 2 * new_n;
+			size_t new_start = data_.extend(set_header_words + capacity);
+			for(size_t k = 0; k < set_header_words + n; ++k)
+				data_[new_start + k] = data_[start + k];
+			data_not_used_ += set_header_words + payload_capacity(start);
+			index          += new_start - start;
+			end            += new_start - start;
+			start           = new_start;
+			start_[i]       = start;
+			set_payload_capacity(start, capacity);
+		}
+		//
+		// move the containers after this one
+		size_t tail = index + old_length;
+		if( new_length > old_length )
+		{	size_t shift = new_length - old_length;
+			for(size_t k = end; k > tail; --k)
+				data_[k - 1 + shift] = data_[k - 1];
+		}
+		else if( new_length < old_length )
+		{	size_t shift = old_length - new_length;
+			for(size_t k = tail; k < end; ++k)
+				data_[k - shift] = data_[k];
+		}
+		for(size_t k = 0; k < new_length; ++k)
+			data_[index + k] = result_[k];
+		set_payload_length(start, new_n);
+		collect_garbage();
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Is an element of a set.
+
+	\param i
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the element we are checking to see if it is in the set.
+	*/
+	bool is_element(size_t i, size_t element) const
+	{	CPPAD_ASSERT_UNKNOWN( post_[i] == 0 );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		size_t start = start_[i];
+		if( start == 0 )
+			return false;
+		size_t key   = element >> chunk_bits;
+		size_t low   = element & chunk_mask;
+		size_t n     = payload_length(start);
+		size_t index = start + set_header_words;
+		while( index < start + set_header_words + n )
+		{	const word_t* c = data_.data() + index;
+			size_t c_key    = get32(c);
+			if( key < c_key )
+				return false;
+			if( key == c_key )
+			{	const word_t* payload = c + header_words;
+				size_t count = size_t( c[3] ) + 1;
+				switch( c[2] )
+				{	case array_type:
+					return std::binary_search(
+						payload, payload + count, word_t(low)
+					);
+
+					case bitmap_type:
+					return ( (payload[low / 16] >> (low % 16)) & 1 ) != 0;
+
+					default:
+					CPPAD_ASSERT_UNKNOWN( c[2] == run_type );
+					for(size_t k = 0; k < count; ++k)
+					{	size_t begin = payload[2 * k];
+						if( low < begin )
+							return false;
+						if( low <= begin + size_t(payload[2 * k + 1]) )
+							return true;
+					}
+					return false;
+				}
+			}
+			index += container_length(c);
+		}
+		return false;
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign the empty set to one of the sets.
+
+	\param target
+	is the index of the set we are setting to the empty set.
+	*/
+	void clear(size_t target)
+	{	CPPAD_ASSERT_UNKNOWN( target < start_.size() );
+		drop(target);
+		collect_garbage();
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign one set equal to another set.
+
+	\param this_target
+	is the index in this sparse_roaring object of the set being assinged.
+
+	\param other_source
+	is the index in the other \c sparse_roaring object of the
+	set that we are using as the value to assign to the target set.
+
+	\param other
+	is the other sparse_roaring object (which may be the same as this
+	sparse_roaring object). This must have the same value for end_.
+	*/
+	void assignment(
+		size_t                  this_target  ,
+		size_t                  other_source ,
+		const sparse_roaring&   other        )
+	{	CPPAD_ASSERT_UNKNOWN( other.post_[ other_source ] == 0 );
+		CPPAD_ASSERT_UNKNOWN( this_target  <   start_.size()        );
+		CPPAD_ASSERT_UNKNOWN( other_source <   other.start_.size()  );
+		CPPAD_ASSERT_UNKNOWN( end_         == other.end_            );
+		//
+		if( &other == this )
+		{	if( this_target == other_source )
+				return;
+			size_t start = start_[other_source];
+			if( start != 0 )
+			{	// increment reference count before dropping target
+				size_t ref_count = reference_count(start);
+				set_reference_count(start, ref_count + 1);
+			}
+			drop(this_target);
+			start_[this_target] = start;
+			collect_garbage();
+			return;
+		}
+		size_t other_start = other.start_[other_source];
+		if( other_start == 0 )
+		{	clear(this_target);
+			return;
+		}
+		size_t n = other.payload_length(other_start);
+		result_.resize(n);
+		for(size_t k = 0; k < n; ++k)
+			result_[k] = other.data_[other_start + set_header_words + k];
+		replace(this_target, result_);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign a set equal to the union of two other sets.
+
+	\param this_target
+	is the index in this sparse_roaring object of the set being assinged.
+
+	\param this_left
+	is the index in this sparse_roaring object of the
+	left operand for the union operation.
+	It is OK for this_target and this_left to be the same value.
+
+	\param other_right
+	is the index in the other sparse_roaring object of the
+	right operand for the union operation.
+	It is OK for this_target and other_right to be the same value.
+
+	\param other
+	is the other sparse_roaring object (which may be the same as this
+	sparse_roaring object).
+	*/
+	void binary_union(
+		size_t                  this_target  ,
+		size_t                  this_left    ,
+		size_t                  other_right  ,
+		const sparse_roaring&   other        )
+	{	CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+		CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+		CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+		CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+		//
+		size_t start_left  = start_[this_left];
+		size_t start_right = other.start_[other_right];
+		//
+		// case where right is empty or left and right are the same set
+		bool same = &other == this && start_left == start_right;
+		if( start_right == 0 || same )
+		{	assignment(this_target, this_left, *this);
+			return;
+		}
+		// case where left is empty
+		if( start_left == 0 )
+		{	assignment(this_target, other_right, other);
+			return;
+		}
+		combine_payload(
+			data_.data() + start_left + set_header_words,
+			payload_length(start_left),
+			other.data_.data() + start_right + set_header_words,
+			other.payload_length(start_right),
+			true,
+			result_
+		);
+		// check if right is a subset of left
+		if( equal_payload(result_, start_left) )
+		{	assignment(this_target, this_left, *this);
+			return;
+		}
+		// check if left is a subset of right
+		if( other.equal_payload(result_, start_right) )
+		{	assignment(this_target, other_right, other);
+			return;
+		}
+		replace(this_target, result_);
+	}
+	// -----------------------------------------------------------------
+	/*!
+	Assign a set equal to the intersection of two other sets.
+
+	\param this_target
+	is the index in this sparse_roaring object of the set being assinged.
+
+	\param this_left
+	is the index in this sparse_roaring object of the
+	left operand for the intersection operation.
+	It is OK for this_target and this_left to be the same value.
+
+	\param other_right
+	is the index in the other sparse_roaring object of the
+	right operand for the intersection operation.
+	It is OK for this_target and other_right to be the same value.
+
+	\param other
+	is the other sparse_roaring object (which may be the same as this
+	sparse_roaring object).
+	*/
+	void binary_intersection(
+		size_t                  this_target  ,
+		size_t                  this_left    ,
+		size_t                  other_right  ,
+		const sparse_roaring&   other        )
+	{	CPPAD_ASSERT_UNKNOWN( post_[this_left] == 0 );
+		CPPAD_ASSERT_UNKNOWN( other.post_[ other_right ] == 0 );
+		CPPAD_ASSERT_UNKNOWN( this_target < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( this_left   < start_.size()         );
+		CPPAD_ASSERT_UNKNOWN( other_right < other.start_.size()   );
+		CPPAD_ASSERT_UNKNOWN( end_        == other.end_           );
+		//
+		size_t start_left  = start_[this_left];
+		size_t start_right = other.start_[other_right];
+		//
+		// case where left and right are the same set
+		if( &other == this && start_left == start_right )
+		{	assignment(this_target, this_left, *this);
+			return;
+		}
+		// case where left or right is empty
+		if( start_left == 0 || start_right == 0 )
+		{	clear(this_target);
+			return;
+		}
+		combine_payload(
+			data_.data() + start_left + set_header_words,
+			payload_length(start_left),
+			other.data_.data() + start_right + set_header_words,
+			other.payload_length(start_right),
+			false,
+			result_
+		);
+		// check if left is a subset of right
+		if( equal_payload(result_, start_left) )
+		{	assignment(this_target, this_left, *this);
+			return;
+		}
+		// check if right is a subset of left
+		if( other.equal_payload(result_, start_right) )
+		{	assignment(this_target, other_right, other);
+			return;
+		}
+		replace(this_target, result_);
+	}
+	// -----------------------------------------------------------------
+	/*! Fetch n_set for vector of sets object.
+
+	\return
+	Number of from sets for this vector of sets object
+	*/
+	size_t n_set(void) const
+	{	return start_.size(); }
+	// -----------------------------------------------------------------
+	/*! Fetch end for this vector of sets object.
+
+	\return
+	is the maximum element value plus one (the minimum element value is 0).
+	*/
+	size_t end(void) const
+	{	return end_; }
+	// -----------------------------------------------------------------
+	/*!
+	Use an arena for the future allocations by this vector of sets.
+
+	\param arena
+	is the arena (null for the thread_alloc pools).
+	*/
+	void set_arena(thread_alloc_arena* arena)
+	{	data_.set_arena(arena);
+		start_.set_arena(arena);
+		post_.set_arena(arena);
+		post_data_.set_arena(arena);
+		post_element_.set_arena(arena);
+	}
+	// -----------------------------------------------------------------
+	/*! Amount of memory used by this vector of sets
+
+	\return
+	The amount of memory in units of type unsigned char memory.
+	*/
+	size_t memory(void) const
+	{	return data_.capacity() * sizeof(word_t);
+	}
+	/*!
+	Print the vector of sets (used for debugging)
+	*/
+	void print(void) const;
+};
+// =========================================================================
+/*!
+cons_iterator for one set of positive integers in a sparse_roaring object.
+
+All the public member for this class are also in the
+sparse_pack_const_iterator, sparse_list_const_iterator, and
+sparse_sizevec_const_iterator classes.
+This defines the CppAD vector_of_sets iterator concept.
+*/
+class sparse_roaring_const_iterator {
+private:
+	/// type used by sparse_roaring to store the sets
+	typedef sparse_roaring::word_t word_t;
+
+	/// data for the entire vector of sets
+	const pod_vector<word_t>& data_;
+
+	/// Possible elements in a list are 0, 1, ..., end_ - 1;
+	const size_t              end_;
+
+	/// index in data_ of the current container
+	size_t                    container_;
+
+	/// index in data_ of the end of this set
+	size_t                    set_end_;
+
+	/// index of current entry in container (run index for run containers)
+	size_t                    entry_;
+
+	/// offset of the current element in the current run
+	size_t                    offset_;
+
+	/// value of the current element (end_ for past end of set)
+	size_t                    value_;
+
+	/// set value_ to the element corresponding to entry_, offset_
+	/// (if necessary advance to the next container)
+	void set_value(void)
+	{	while( container_ < set_end_ )
+		{	const word_t* c       = data_.data() + container_;
+			const word_t* payload = c + sparse_roaring::header_words;
+			size_t        count   = size_t( c[3] ) + 1;
+			size_t        base    =
+				sparse_roaring::get32(c) << sparse_roaring::chunk_bits;
+			switch( c[2] )
+			{	case sparse_roaring::array_type:
+				if( entry_ < count )
+				{	value_ = base + payload[entry_];
+					return;
+				}
+				break;
+
+				case sparse_roaring::bitmap_type:
+				while( entry_ < 16 * size_t(sparse_roaring::bitmap_words) )
+				{	size_t word = payload[entry_ / 16] >> (entry_ % 16);
+					if( word == 0 )
+						entry_ = 16 * (entry_ / 16 + 1);
+					else if( word & 1 )
+					{	value_ = base + entry_;
+						return;
+					}
+					else
+						++entry_;
+				}
+				break;
+
+				default:
+				CPPAD_ASSERT_UNKNOWN( c[2] == sparse_roaring::run_type );
+				if( entry_ < count )
+				{	value_ = base + payload[2 * entry_] + offset_;
+					return;
+				}
+				break;
+			}
+			// advance to next container
+			container_ += sparse_roaring::container_length(c);
+			entry_      = 0;
+			offset_     = 0;
+		}
+		value_ = end_;
+	}
+public:
+	/// construct a const_iterator for a set in a sparse_roaring object
+	sparse_roaring_const_iterator (const sparse_roaring& vec_set, size_t i)
+	:
+	data_( vec_set.data_ ) ,
+	end_ ( vec_set.end_ )  ,
+	entry_(0)              ,
+	offset_(0)
+	{	CPPAD_ASSERT_UNKNOWN( vec_set.post_[i] == 0 );
+		size_t start = vec_set.start_[i];
+		if( start == 0 )
+		{	container_ = 0;
+			set_end_   = 0;
+			value_     = end_;
+			return;
+		}
+		container_ = start + sparse_roaring::set_header_words;
+		set_end_   = container_ + vec_set.payload_length(start);
+		set_value();
+	}
+
+	/// advance to next element in this set
+	sparse_roaring_const_iterator& operator++(void)
+	{	CPPAD_ASSERT_UNKNOWN( value_ < end_ );
+		const word_t* c = data_.data() + container_;
+		if( c[2] == sparse_roaring::run_type )
+		{	size_t length = size_t( c[sparse_roaring::header_words + 2 * entry_ + 1] );
+			if( offset_ < length )
+				++offset_;
+			else
+			{	offset_ = 0;
+				++entry_;
+			}
+		}
+		else
+			++entry_;
+		set_value();
+		return *this;
+	}
+
+	/// obtain value of this element of the set of positive integers
+	/// (end_ for no such element)
+	size_t operator*(void) const
+	{	return value_; }
+};
+// =========================================================================
+/*!
+Print the vector of sets (used for debugging)
+*/
+inline void sparse_roaring::print(void) const
+{	std::cout << "sparse_roaring:\n";
+	for(size_t i = 0; i < n_set(); i++)
+	{	std::cout << "set[" << i << "] = {";
+		const_iterator itr(*this, i);
+		while( *itr != end() )
+		{	std::cout << *itr;
+			if( *(++itr) != end() )
+				std::cout << ",";
+		}
+		std::cout << "}\n";
+	}
+	return;
+}
+
+} } // END_CPPAD_LOCAL_NAMESPACE
+# endif
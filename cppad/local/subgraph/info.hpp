@@ -165,12 +165,17 @@ public:
 	}
 	// -----------------------------------------------------------------------
 	/// assignment operator
+	/// (a copy made after init_rev can be used to process dependent variables
+	/// independently of the original; e.g., by a different thread)
 	void operator=(const subgraph_info& info)
 	{	n_ind_            = info.n_ind_;
 		n_dep_            = info.n_dep_;
 		n_op_             = info.n_op_;
+		n_var_            = info.n_var_;
 		map_user_op_      = info.map_user_op_;
 		in_subgraph_      = info.in_subgraph_;
+		select_domain_    = info.select_domain_;
+		process_range_    = info.process_range_;
 		return;
 	}
 	// -----------------------------------------------------------------------
@@ -0,0 +1,345 @@
+# ifndef CPPAD_LOCAL_SUBGRAPH_REVERSE_HPP
+# define CPPAD_LOCAL_SUBGRAPH_REVERSE_HPP
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <vector>
+# include <algorithm>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/player.hpp>
+# include <cppad/local/subgraph/info.hpp>
+# include <cppad/local/subgraph/entire_call.hpp>
+# include <cppad/local/sweep/reverse.hpp>
+
+// BEGIN_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
+namespace CppAD { namespace local { namespace subgraph {
+/*!
+\file subgraph/reverse.hpp
+Reverse mode on the subgraph corresponding to one dependent variable.
+*/
+
+/*!
+Compute the derivative of one dependent variable using its subgraph.
+
+\tparam Addr
+type used for indices in random iterator
+(must correspond to play->addr_type())
+
+\tparam Base
+the operation sequence was recorded using AD<Base>.
+
+\tparam SizeVector
+simple vector class with elements of type size_t.
+
+\tparam BaseVector
+simple vector class with elements of type Base.
+
+\param play
+is the operation sequence.
+
+\param random_itr
+is a random iterator for this operation sequence.
+
+\param sub_info
+is the subgraph information for this operation sequence
+(see subgraph_info::get_rev).
+
+\param ind_taddr
+variable index for each independent variable.
+
+\param dep_taddr
+variable index for each dependent variable.
+
+\param cap_order
+order capacity for the Taylor coefficients in taylor.
+
+\param taylor
+Taylor coefficients for the point where the derivative is evaluated
+(at least q orders, one direction).
+
+\param cskip_op
+which operators are skipped (not modified).
+
+\param load_op
+variable index corresponding to each load operation.
+
+\param q
+is the number of Taylor coefficient we are differentiating.
+
+\param ell
+is the dependent variable we are differentiating.
+
+\param subgraph
+work space for the subgraph; input size and contents do not matter.
+
+\param partial
+work space for the partial derivatives; input size and contents
+do not matter.
+
+\param col
+the input size and contents do not matter.
+Upon return it is the sorted set of indices j for which the
+return value in dw is defined.
+
+\param dw
+Upon return, for j = col[c] and k = 0 , ... , q-1, dw[j * q + k]
+is the partial of the ell-th dependent variable q-1 order Taylor
+coefficient with respect to the j-th independent variable k-th order
+Taylor coefficient (see subgraph_reverse).
+*/
+template <typename Addr, typename Base, typename SizeVector, typename BaseVector>
+void reverse_dep(
+	const player<Base>*                        play        ,
+	const play::const_random_iterator<Addr>&   random_itr  ,
+	subgraph_info&                             sub_info    ,
+	const vector<size_t>&                      ind_taddr   ,
+	const vector<size_t>&                      dep_taddr   ,
+	size_t                                     cap_order   ,
+	const Base*                                taylor      ,
+	bool*                                      cskip_op    ,
+	const pod_vector<addr_t>&                  load_op     ,
+	size_t                                     q           ,
+	size_t                                     ell         ,
+	pod_vector<addr_t>&                        subgraph    ,
+	pod_vector_maybe<Base>&                    partial     ,
+	SizeVector&                                col         ,
+	BaseVector&                                dw          )
+{	size_t num_var = play->num_var_rec();
+	size_t n       = ind_taddr.size();
+	//
+	// subgraph of operators connected to dependent variable ell
+	sub_info.get_rev(random_itr, dep_taddr, addr_t(ell), subgraph);
+
+	// Add all the atomic function call operators
+	// for calls that have first operator in the subgraph
+	entire_call(random_itr, subgraph);
+
+	// First add the BeginOp and EndOp to the subgraph and then sort it
+	// sort the subgraph
+	addr_t i_op_begin_op = 0;
+	addr_t i_op_end_op   = addr_t( play->num_op_rec() - 1);
+	subgraph.push_back(i_op_begin_op);
+	subgraph.push_back(i_op_end_op);
+	std::sort( subgraph.data(), subgraph.data() + subgraph.size() );
+	CPPAD_ASSERT_UNKNOWN( subgraph[0] == i_op_begin_op );
+	CPPAD_ASSERT_UNKNOWN( subgraph[subgraph.size()-1] == i_op_end_op );
+
+	// initialize partial matrix to zero on subgraph
+	Base zero(0);
+	partial.resize(num_var * q);
+	for(size_t k = 0; k < subgraph.size(); ++k)
+	{
+		size_t        i_op = size_t( subgraph[k] );
+		OpCode        op;
+		const addr_t* arg;
+		size_t        i_var;
+		random_itr.op_info(i_op, op, arg, i_var);
+		if( NumRes(op) == 0 )
+		{	CPPAD_ASSERT_UNKNOWN(
+				op == UserOp  ||
+				op == UsrapOp ||
+				op == UsravOp ||
+				op == UsrrpOp ||
+				op == EndOp
+			);
+		}
+		else if( op != BeginOp )
+		{	CPPAD_ASSERT_UNKNOWN( i_var >= NumRes(op) );
+			size_t j_var = i_var + 1 - NumRes(op);
+			for(size_t i = j_var; i <= i_var; ++i)
+			{	for(size_t j = 0; j < q; ++j)
+					partial[i * q + j] = zero;
+			}
+		}
+	}
+
+	// set partial to one for component we are differentiating
+	partial[ dep_taddr[ell] * q + q - 1] = Base(1);
+
+	// evaluate the derivatives
+	play::const_subgraph_iterator<Addr> subgraph_itr =
+		play->end_subgraph(random_itr, &subgraph);
+	//
+	sweep::reverse(
+		q - 1,
+		n,
+		num_var,
+		play,
+		cap_order,
+		taylor,
+		q,
+		partial.data(),
+		cskip_op,
+		load_op,
+		subgraph_itr
+	);
+
+	// number of non-zero in return value
+	size_t col_size       = 0;
+	size_t subgraph_index = 0;
+	CPPAD_ASSERT_UNKNOWN( subgraph[subgraph_index] == 0 );
+	// Skip BeginOp
+	++subgraph_index;
+	while( subgraph_index < subgraph.size() )
+	{	// check for InvOp
+		if( subgraph[subgraph_index] > addr_t(n) )
+			subgraph_index = subgraph.size();
+		else
+		{	++col_size;
+			++subgraph_index;
+		}
+	}
+	col.resize(col_size);
+
+	// return the derivative values
+	dw.resize(n * q);
+	for(size_t c = 0; c < col_size; ++c)
+	{	size_t i_op = size_t( subgraph[c + 1] );
+		CPPAD_ASSERT_UNKNOWN( play->GetOp(i_op) == InvOp );
+		//
+		size_t j = i_op - 1;
+		CPPAD_ASSERT_UNKNOWN( i_op == random_itr.var2op( ind_taddr[j] ) );
+		//
+		// return paritial for this independent variable
+		col[c] = j;
+		for(size_t k = 0; k < q; k++)
+			dw[j * q + k ] = partial[ind_taddr[j] * q + k];
+	}
+	return;
+}
+
+/*!
+Function object that computes first order subgraph reverse mode derivatives
+for a subset of the dependent variables.
+
+\tparam Addr
+type used for indices in random iterator.
+
+\tparam Base
+the operation sequence was recorded using AD<Base>.
+
+\par Thread Safety
+The recording, the zero order Taylor coefficients, and the subgraph
+information (after init_rev) are shared by all the threads
+(and not modified).
+Each thread has its own copy of the subgraph information,
+subgraph, and partial derivative work space,
+and only writes the results for its dependent variables.
+*/
+template <typename Addr, typename Base>
+class jac_rev_thread {
+private:
+	/// player for the recording
+	const player<Base>*                    play_;
+	/// subgraph information after init_rev
+	const subgraph_info&                   sub_info_;
+	/// variable index for each independent variable
+	const vector<size_t>&                  ind_taddr_;
+	/// variable index for each dependent variable
+	const vector<size_t>&                  dep_taddr_;
+	/// order capacity for the Taylor coefficients in taylor_
+	const size_t                           cap_order_;
+	/// Taylor coefficients with zero order equal to the point for derivative
+	const Base*                            taylor_;
+	/// which operations can be skipped (not modified by the sweeps)
+	bool*                                  cskip_op_;
+	/// variable index corresponding to each load operation
+	const pod_vector<addr_t>&              load_op_;
+	/// dependent variables that are differentiated
+	const pod_vector<size_t>&              dep_index_;
+	/// number of threads
+	const size_t                           n_thread_;
+	/// col_out_[r] is the sorted columns for dependent variable dep_index_[r]
+	std::vector< std::vector<size_t> >&    col_out_;
+	/// val_out_[r][c] is the partial w.r.t. independent col_out_[r][c]
+	std::vector< std::vector<Base> >&      val_out_;
+public:
+	/// constructor (see the corresponding member variables)
+	jac_rev_thread(
+		const player<Base>*                  play      ,
+		const subgraph_info&                 sub_info  ,
+		const vector<size_t>&                ind_taddr ,
+		const vector<size_t>&                dep_taddr ,
+		size_t                               cap_order ,
+		const Base*                          taylor    ,
+		bool*                                cskip_op  ,
+		const pod_vector<addr_t>&            load_op   ,
+		const pod_vector<size_t>&            dep_index ,
+		size_t                               n_thread  ,
+		std::vector< std::vector<size_t> >&  col_out   ,
+		std::vector< std::vector<Base> >&    val_out   )
+	:
+	play_(play)             ,
+	sub_info_(sub_info)     ,
+	ind_taddr_(ind_taddr)   ,
+	dep_taddr_(dep_taddr)   ,
+	cap_order_(cap_order)   ,
+	taylor_(taylor)         ,
+	cskip_op_(cskip_op)     ,
+	load_op_(load_op)       ,
+	dep_index_(dep_index)   ,
+	n_thread_(n_thread)     ,
+	col_out_(col_out)       ,
+	val_out_(val_out)
+	{	CPPAD_ASSERT_UNKNOWN( col_out.size() == dep_index.size() );
+		CPPAD_ASSERT_UNKNOWN( val_out.size() == dep_index.size() );
+	}
+	/*!
+	Compute the derivatives for the dependent variables dep_index_[r]
+	where <code>r % n_thread == thread</code>.
+
+	\param thread
+	is the index for this thread.
+	*/
+	void operator()(size_t thread) const
+	{	play::const_random_iterator<Addr> random_itr =
+			play_->template get_random<Addr>();
+		//
+		// work space for this thread
+		subgraph_info          sub_info;
+		sub_info = sub_info_;
+		pod_vector<addr_t>     subgraph;
+		pod_vector_maybe<Base> partial;
+		pod_vector<size_t>     col;
+		pod_vector_maybe<Base> dw;
+		//
+		size_t q = 1;
+		for(size_t r = thread; r < dep_index_.size(); r += n_thread_)
+		{	reverse_dep(
+				play_,
+				random_itr,
+				sub_info,
+				ind_taddr_,
+				dep_taddr_,
+				cap_order_,
+				taylor_,
+				cskip_op_,
+				load_op_,
+				q,
+				dep_index_[r],
+				subgraph,
+				partial,
+				col,
+				dw
+			);
+			col_out_[r].resize( col.size() );
+			val_out_[r].resize( col.size() );
+			for(size_t c = 0; c < col.size(); ++c)
+			{	col_out_[r][c] = col[c];
+				val_out_[r][c] = dw[ col[c] ];
+			}
+		}
+	}
+};
+
+} } } // END_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
+
+# endif
@@ -15,6 +15,8 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/subgraph/arg_variable.hpp>
 # include <cppad/local/subgraph/info.hpp>
 # include <cppad/local/subgraph/entire_call.hpp>
+# include <cppad/local/run_threads.hpp>
+# include <vector>
 
 // BEGIN_CPPAD_LOCAL_SUBGRAPH_NAMESPACE
 namespace CppAD { namespace local { namespace subgraph {
@@ -24,6 +26,83 @@ Compute dependency sparsity pattern using subgraph technique.
 */
 // ===========================================================================
 /*!
+Function object that computes the dependency sparsity pattern for
+a subset of the dependent variables.
+
+\tparam Addr
+type used for indices in random iterator.
+
+\tparam Base
+the operation sequence was recorded using AD<Base>.
+
+\par Thread Safety
+The recording and the subgraph information (after init_rev) are shared
+by all the threads (and not modified). Each thread has its own copy of the
+subgraph information and only writes the results for its dependent variables.
+*/
+template <typename Addr, typename Base>
+class sparsity_thread {
+private:
+	/// player for the recording
+	const player<Base>*                    play_;
+	/// subgraph information after init_rev
+	const subgraph_info&                   sub_info_;
+	/// variable index for each dependent variable
+	const vector<size_t>&                  dep_taddr_;
+	/// dependent variables that are included in the sparsity pattern
+	const pod_vector<size_t>&              dep_index_;
+	/// number of threads
+	const size_t                           n_thread_;
+	/// col_out_[r] is the columns in the pattern for row dep_index_[r]
+	std::vector< std::vector<size_t> >&    col_out_;
+public:
+	/// constructor (see the corresponding member variables)
+	sparsity_thread(
+		const player<Base>*                  play      ,
+		const subgraph_info&                 sub_info  ,
+		const vector<size_t>&                dep_taddr ,
+		const pod_vector<size_t>&            dep_index ,
+		size_t                               n_thread  ,
+		std::vector< std::vector<size_t> >&  col_out   )
+	:
+	play_(play)             ,
+	sub_info_(sub_info)     ,
+	dep_taddr_(dep_taddr)   ,
+	dep_index_(dep_index)   ,
+	n_thread_(n_thread)     ,
+	col_out_(col_out)
+	{	CPPAD_ASSERT_UNKNOWN( col_out.size() == dep_index.size() ); }
+	/*!
+	Compute the pattern for the dependent variables dep_index_[r]
+	where <code>r % n_thread == thread</code>.
+
+	\param thread
+	is the index for this thread.
+	*/
+	void operator()(size_t thread) const
+	{	play::const_random_iterator<Addr> random_itr =
+			play_->template get_random<Addr>();
+		//
+		// work space for this thread
+		subgraph_info      sub_info;
+		sub_info = sub_info_;
+		pod_vector<addr_t> subgraph;
+		//
+		for(size_t r = thread; r < dep_index_.size(); r += n_thread_)
+		{	sub_info.get_rev(
+				random_itr, dep_taddr_, addr_t( dep_index_[r] ), subgraph
+			);
+			col_out_[r].resize(0);
+			for(size_t k = 0; k < subgraph.size(); k++)
+			{	size_t i_op = size_t( subgraph[k] );
+				if( play_->GetOp(i_op) == InvOp )
+					col_out_[r].push_back(i_op - 1);
+			}
+		}
+	}
+};
+// ===========================================================================
+/*!
 Compute dependency sparsity pattern for an ADFun<Base> function.
 
 \tparam Addr
@@ -78,6 +157,10 @@ the function corresponding to the recording.
 	select_domain[ col_out[k] ] == true
 \endcode
 
+\param n_thread
+is the number of threads used to compute the subgraphs and must be
+less than or equal <code>run_threads_alloc_number(n_thread)</code>.
+
 \par UserOp
 All of the inputs and outputs for an atomic function call are considered
 to be connected.
@@ -93,7 +176,8 @@ void subgraph_sparsity(
 	const BoolVector&                          select_domain ,
 	const BoolVector&                          select_range  ,
 	pod_vector<size_t>&                        row_out       ,
-	pod_vector<size_t>&                        col_out       )
+	pod_vector<size_t>&                        col_out       ,
+	size_t                                     n_thread      )
 {
 	// get random access iterator for this player
 	play->template setup_random<Addr>();
@@ -139,6 +223,31 @@ void subgraph_sparsity(
 		sub_info.in_subgraph().size() == play->num_op_rec()
 	);
 	//
+	// check for case where multiple threads are used
+	if( n_thread > 1 )
+	{	CPPAD_ASSERT_UNKNOWN(
+			n_thread <= run_threads_alloc_number(n_thread)
+		);
+		pod_vector<size_t> dep_index;
+		for(size_t i_dep = 0; i_dep < n_dep; ++i_dep) if( select_range[i_dep] )
+			dep_index.push_back(i_dep);
+		std::vector< std::vector<size_t> > col_dep( dep_index.size() );
+		sparsity_thread<Addr, Base> fun(
+			play, sub_info, dep_taddr, dep_index, n_thread, col_dep
+		);
+		run_threads_alloc(n_thread, fun);
+		//
+		// same order as when one thread is used
+		for(size_t r = 0; r < dep_index.size(); ++r)
+		{	for(size_t c = 0; c < col_dep[r].size(); ++c)
+			{	CPPAD_ASSERT_UNKNOWN( select_domain[ col_dep[r][c] ] );
+				row_out.push_back( dep_index[r] );
+				col_out.push_back( col_dep[r][c] );
+			}
+		}
+		return;
+	}
+	//
 # ifndef NDEBUG
 	addr_t depend_yes = addr_t( n_dep );
 # endif
@@ -178,9 +178,23 @@ If compare_change_count is zero, this value is set to zero.
 Otherwise it is the operator index (see forward_next) for the count-th
 comparision operation that has a different result from when the information in
 play was recorded.
+
+\tparam Iterator
+This is either play::const_sequential_iterator or
+play::const_subgraph_iterator.
+
+\param play_itr
+On input this is either play->begin(), for the entire graph,
+or play->begin_subgraph(random_itr, subgraph), for a subgraph.
+This routine will use ++play_itr to iterate over the graph or subgraph
+until it reaches the EndOp.
+If the operator for a variable is not in the subgraph,
+the Taylor coefficients for that variable are not modified.
+If part of an atomic function call is in the subgraph,
+the entire atomic function call must be in the subgraph.
 */
 
-template <class Addr, class Base>
+template <class Addr, class Base, class Iterator>
 void forward1(
 	const local::player<Base>* play,
 	std::ostream&              s_out,
@@ -195,7 +209,8 @@ void forward1(
 	pod_vector<Addr>&          var_by_load_op,
 	size_t                     compare_change_count,
 	size_t&                    compare_change_number,
-	size_t&                    compare_change_op_index
+	size_t&                    compare_change_op_index,
+	Iterator&                  play_itr
 )
 {
 	// number of directions
@@ -282,12 +297,11 @@ void forward1(
 	vector<size_t> user_iy;
 
 	// skip the BeginOp at the beginning of the recording
-	play::const_sequential_iterator itr = play->begin();
 	// op_info
 	OpCode op;
 	size_t i_var;
 	const Addr*   arg;
-	itr.op_info(op, arg, i_var);
+	play_itr.op_info(op, arg, i_var);
 	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
 	//
 # if CPPAD_FORWARD1_TRACE
@@ -300,11 +314,11 @@ void forward1(
 	while(more_operators)
 	{
 		// next op
-		(++itr).op_info(op, arg, i_var);
-		CPPAD_ASSERT_UNKNOWN( itr.op_index() < play->num_op_rec() );
+		(++play_itr).op_info(op, arg, i_var);
+		CPPAD_ASSERT_UNKNOWN( play_itr.op_index() < play->num_op_rec() );
 
 		// check if we are skipping this operation
-		while( cskip_op[itr.op_index()] )
+		while( cskip_op[play_itr.op_index()] )
 		{	switch(op)
 			{
 				case UserOp:
@@ -314,9 +328,9 @@ void forward1(
 					//
 					// skip to the second UserOp
 					for(i = 0; i < user_m + user_n + 1; ++i)
-						++itr;
+						++play_itr;
 # ifndef NDEBUG
-					itr.op_info(op, arg, i_var);
+					play_itr.op_info(op, arg, i_var);
 					CPPAD_ASSERT_UNKNOWN( op == UserOp );
 # endif
 				}
@@ -324,13 +338,13 @@ void forward1(
 
 				case CSkipOp:
 				case CSumOp:
-				itr.correct_before_increment();
+				play_itr.correct_before_increment();
 				break;
 
 				default:
 				break;
 			}
-			(++itr).op_info(op, arg, i_var);
+			(++play_itr).op_info(op, arg, i_var);
 		}
 
 		// action depends on the operator
@@ -427,7 +441,7 @@ void forward1(
 					i_var, arg, num_par, parameter, J, taylor, cskip_op
 				);
 			}
-			itr.correct_before_increment();
+			play_itr.correct_before_increment();
 			break;
 			// -------------------------------------------------
 
@@ -435,7 +449,7 @@ void forward1(
 			forward_csum_op(
 				p, q, i_var, arg, num_par, parameter, J, taylor
 			);
-			itr.correct_before_increment();
+			play_itr.correct_before_increment();
 			break;
 			// -------------------------------------------------
 
@@ -473,7 +487,7 @@ void forward1(
 					compare_change_number, arg, parameter
 				);
 				{	if( compare_change_count == compare_change_number )
-						compare_change_op_index = itr.op_index();
+						compare_change_op_index = play_itr.op_index();
 				}
 			}
 			break;
@@ -485,7 +499,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -496,7 +510,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -614,7 +628,7 @@ void forward1(
 					compare_change_number, arg, parameter
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -625,7 +639,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -636,7 +650,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -647,7 +661,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -670,7 +684,7 @@ void forward1(
 					compare_change_number, arg, parameter
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -681,7 +695,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -692,7 +706,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -703,7 +717,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -725,7 +739,7 @@ void forward1(
 					compare_change_number, arg, parameter
 				);
 				{	if( compare_change_count == compare_change_number )
-						compare_change_op_index = itr.op_index();
+						compare_change_op_index = play_itr.op_index();
 				}
 			}
 			break;
@@ -737,7 +751,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -748,7 +762,7 @@ void forward1(
 					compare_change_number, arg, parameter, J, taylor
 				);
 				if( compare_change_count == compare_change_number )
-					compare_change_op_index = itr.op_index();
+					compare_change_op_index = play_itr.op_index();
 			}
 			break;
 			// -------------------------------------------------
@@ -1043,7 +1057,7 @@ void forward1(
 			CPPAD_ASSERT_UNKNOWN( op == UserOp );
 			CPPAD_ASSERT_UNKNOWN( NumArg(UsrrvOp) == 0 );
 			for(i = 0; i < user_m; i++) if( user_iy[i] > 0 )
-			{	size_t i_tmp   = (itr.op_index() + i) - user_m;
+			{	size_t i_tmp   = (play_itr.op_index() + i) - user_m;
 				printOp(
 					std::cout,
 					play,
@@ -1069,7 +1083,7 @@ void forward1(
 			printOp(
 				std::cout,
 				play,
-				itr.op_index(),
+				play_itr.op_index(),
 				i_var,
 				op,
 				arg
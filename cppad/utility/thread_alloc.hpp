@@ -15,6 +15,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <sstream>
 # include <limits>
 # include <memory>
+# include <cstring>
 
 
 # ifdef _MSC_VER
@@ -27,12 +28,55 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/local/define.hpp>
 # include <cppad/local/set_get_in_parallel.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <mutex>
+# include <atomic>
+# endif
+
+/*!
+\def CPPAD_THREAD_ALLOC_SYSTEM
+If this is not zero, and the system is Linux, the POSIX headers
+sys/mman.h, sys/syscall.h, and unistd.h are included so that thread_alloc
+can use huge pages and NUMA nodes.
+It can be defined as zero before this file is included
+(and must have the same value for all files that include it).
+*/
+# ifndef CPPAD_THREAD_ALLOC_SYSTEM
+# define CPPAD_THREAD_ALLOC_SYSTEM 1
+# endif
+# if CPPAD_THREAD_ALLOC_SYSTEM && defined(__linux__)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# endif
+# ifdef MADV_HUGEPAGE
+# define CPPAD_THREAD_ALLOC_MMAP 1
+# else
+# define CPPAD_THREAD_ALLOC_MMAP 0
+# endif
+# if CPPAD_THREAD_ALLOC_MMAP && defined(MREMAP_MAYMOVE)
+# define CPPAD_THREAD_ALLOC_MREMAP 1
+# else
+# define CPPAD_THREAD_ALLOC_MREMAP 0
+# endif
+# if defined(SYS_getcpu) && defined(SYS_mbind)
+# define CPPAD_THREAD_ALLOC_NUMA 1
+# else
+# define CPPAD_THREAD_ALLOC_NUMA 0
+# endif
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
 \file thread_alloc.hpp
 File used to define the CppAD multi-threading allocator class
 */
 
+namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+	// friend of thread_alloc (see parallel_set)
+	template <class Functor>
+	void run_threads_alloc(size_t n_thread, const Functor& fun);
+} // END_CPPAD_LOCAL_NAMESPACE
+
 /*!
 \def CPPAD_MAX_NUM_CAPACITY
 Maximum number of different capacities the allocator will attempt.
@@ -62,6 +106,46 @@ that correspond to this thead and capacity CPPAD_TRACE_CAPACITY.
 */
 # define CPPAD_TRACE_THREAD 0
 
+/*!
+\def CPPAD_THREAD_ALLOC_ALIGN
+The memory returned by \c get_memory for the capacities that are aligned
+(see CPPAD_THREAD_ALLOC_ALIGN_BYTES) is a multiple of this value
+(a power of two equal to a typical cache line size).
+*/
+# define CPPAD_THREAD_ALLOC_ALIGN 64
+
+/*!
+\def CPPAD_THREAD_ALLOC_ALIGN_BYTES
+Capacities greater than or equal this value (and capacities that use
+huge pages) are aligned to a multiple of CPPAD_THREAD_ALLOC_ALIGN.
+Smaller capacities do not use extra memory for padding and have the
+alignment of the system allocator.
+It can be defined before this file is included
+(and must have the same value for all files that include it).
+*/
+# ifndef CPPAD_THREAD_ALLOC_ALIGN_BYTES
+# define CPPAD_THREAD_ALLOC_ALIGN_BYTES 4096
+# endif
+
+/*!
+\def CPPAD_THREAD_ALLOC_HUGE_BYTES
+If this is not zero, and the system supports transparent huge pages,
+capacities greater than or equal this value are obtained directly from
+the operating system and huge pages are requested for them.
+It can be defined before this file is included
+(and must have the same value for all files that include it).
+*/
+# ifndef CPPAD_THREAD_ALLOC_HUGE_BYTES
+# define CPPAD_THREAD_ALLOC_HUGE_BYTES 16777216
+# endif
+
+/*!
+\def CPPAD_MAX_NUM_NUMA
+Number of NUMA nodes that memory statistics are kept for.
+Nodes with a larger index are counted as node CPPAD_MAX_NUM_NUMA - 1.
+*/
+# define CPPAD_MAX_NUM_NUMA 16
+
 /*
 Note that Section 3.6.2 of ISO/IEC 14882:1998(E) states: "The storage for
 objects with static storage duration (3.7.1) shall be zero-initialized
@@ -75,11 +159,37 @@ Only one of these objects should be created and used as a
 static variable inside of the \c thread_alloc::capacity_info function.
 */
 
+/*!
+Interface for a memory arena that thread_alloc can use in place of its pools
+(see the arena argument to thread_alloc::get_memory).
+*/
+class thread_alloc_arena {
+public:
+	/// allocate at least num_bytes of memory (must not return null)
+	virtual void* allocate(size_t num_bytes) = 0;
+	/// deallocate memory that was obtained from this arena by allocate
+	virtual void deallocate(void* v_ptr, size_t num_bytes) = 0;
+	/// destructor
+	virtual ~thread_alloc_arena(void)
+	{ }
+};
+
 /*!
 Allocator class that works well with an multi-threading environment.
 */
 class thread_alloc{
 // ============================================================================
+public:
+	/// subsystem that memory allocations are tagged with (see ta_statistics)
+	enum tag_enum {
+		general_tag,
+		recorder_tag,
+		taylor_tag,
+		sparsity_tag,
+		optimize_tag,
+		number_tag
+	};
+// ============================================================================
 private:
 
 	class capacity_t {
@@ -115,10 +225,18 @@ private:
 		size_t             tc_index_;
 		/// pointer to the next memory allocation with the same tc_index_
 		void*              next_;
+		/// memory obtained from the system that contains this block
+		void*              raw_;
+		/// NUMA node where this block was first touched (or moved to)
+		size_t             numa_;
+		/// tag for the subsystem that is using this block (see tag_enum)
+		size_t             tag_;
 		// -----------------------------------------------------------------
 		/// make default constructor private. It is only used by constructor
 		/// for `root arrays below.
-		block_t(void) : extra_(0), tc_index_(0), next_(CPPAD_NULL)
+		block_t(void)
+		: extra_(0), tc_index_(0), next_(CPPAD_NULL), raw_(CPPAD_NULL),
+		numa_(0), tag_(0)
 		{ }
 	};
 
@@ -136,6 +254,14 @@ private:
 		size_t  count_inuse_;
 		/// count of inuse bytes for this thread
 		size_t  count_available_;
+		/// count of inuse bytes for this thread and each NUMA node
+		size_t  count_inuse_numa_[CPPAD_MAX_NUM_NUMA];
+		/// count of available bytes for this thread and each NUMA node
+		size_t  count_available_numa_[CPPAD_MAX_NUM_NUMA];
+		/// NUMA node for this thread the last time it was determined
+		size_t  numa_node_;
+		/// number of numa_node calls before it is determined again
+		size_t  numa_count_;
 		/// root of available list for this thread and each capacity
 		block_t root_available_[CPPAD_MAX_NUM_CAPACITY];
 		/*!
@@ -146,6 +272,29 @@ private:
 		*/
 		block_t root_inuse_[CPPAD_MAX_NUM_CAPACITY];
 	};
+	/*!
+	Statistics for each thread.
+	These are separate from thread_alloc_info so that they are not cleared
+	by free_available; i.e., they are only reset by reset_peak.
+	*/
+	struct thread_stat_t {
+		/// maximum of count_inuse_ (since start or reset_peak)
+		size_t  count_peak_;
+		/// count of inuse bytes for this thread and each tag
+		size_t  count_tag_inuse_[number_tag];
+		/// maximum of count_tag_inuse_ (since start or reset_peak)
+		size_t  count_tag_peak_[number_tag];
+		/// number of get_memory calls for this thread and each capacity
+		size_t  num_get_[CPPAD_MAX_NUM_CAPACITY];
+		/// number of return_memory calls for this thread and each capacity
+		size_t  num_return_[CPPAD_MAX_NUM_CAPACITY];
+	};
+	/// statistics for the specified thread (zero initialized)
+	static thread_stat_t* thread_stat(size_t thread)
+	{	static thread_stat_t stat[CPPAD_MAX_NUM_THREADS];
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
+		return stat + thread;
+	}
 	// ---------------------------------------------------------------------
 	/*!
 	Set and Get hold available memory flag.
@@ -168,6 +317,18 @@ private:
 	}
 	// ---------------------------------------------------------------------
 	/*!
+	Set and Get NUMA local memory flag.
+
+	\copydetails set_get_hold_memory
+	*/
+	static bool set_get_numa_local(bool set, bool new_value = false)
+	{	static bool value = false;
+		if( set )
+			value = new_value;
+		return value;
+	}
+	// ---------------------------------------------------------------------
+	/*!
 	Get pointer to the information for this thread.
 
 	\param thread [in]
@@ -210,6 +371,12 @@ private:
 					info->count_inuse_     == 0 &&
 					info->count_available_ == 0
 				);
+				for(size_t k = 0; k < CPPAD_MAX_NUM_NUMA; k++)
+				{	CPPAD_ASSERT_UNKNOWN(
+						info->count_inuse_numa_[k]     == 0 &&
+						info->count_available_numa_[k] == 0
+					);
+				}
 				for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
 				{	CPPAD_ASSERT_UNKNOWN(
 						info->root_inuse_[c].next_     == CPPAD_NULL &&
@@ -240,6 +407,12 @@ private:
 			}
 			info->count_inuse_     = 0;
 			info->count_available_ = 0;
+			for(size_t k = 0; k < CPPAD_MAX_NUM_NUMA; k++)
+			{	info->count_inuse_numa_[k]     = 0;
+				info->count_available_numa_[k] = 0;
+			}
+			info->numa_node_  = 0;
+			info->numa_count_ = 0;
 		}
 		return info;
 	}
@@ -256,8 +429,11 @@ private:
 	(must be less than \c num_threads).
 	Durring parallel execution, this must be the thread
 	that is currently executing.
+
+	\param numa [in]
+	NUMA node for the memory (must be less than CPPAD_MAX_NUM_NUMA).
 	*/
-	static void inc_inuse(size_t inc, size_t thread)
+	static void inc_inuse(size_t inc, size_t thread, size_t numa)
 	{
 		CPPAD_ASSERT_UNKNOWN( thread < num_threads() );
 		CPPAD_ASSERT_UNKNOWN(
@@ -270,6 +446,67 @@ private:
 		CPPAD_ASSERT_UNKNOWN( result >= info->count_inuse_ );
 
 		info->count_inuse_ = result;
+		thread_stat_t* stat = thread_stat(thread);
+		if( stat->count_peak_ < result )
+			stat->count_peak_ = result;
+		CPPAD_ASSERT_UNKNOWN( numa < CPPAD_MAX_NUM_NUMA );
+		info->count_inuse_numa_[numa] += inc;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Current tag for each thread (see set_tag).
+	This is separate from thread_info so that it is not cleared
+	by free_available.
+	*/
+	static size_t* thread_tag(void)
+	{	static size_t tag[CPPAD_MAX_NUM_THREADS];
+		return tag;
+	}
+	/*!
+	Record the statistics for a block of memory that was obtained for use.
+
+	\param node [in,out]
+	is the thread_alloc information at the front of the memory.
+	The tag for this block is set to the current tag for the thread.
+
+	\param thread [in]
+	is the thread that is currently executing.
+
+	\param c_index [in]
+	is the capacity index for this memory.
+	*/
+	static void stat_get(block_t* node, size_t thread, size_t c_index)
+	{	thread_stat_t* stat = thread_stat(thread);
+		size_t capacity     = capacity_info()->value[c_index];
+		size_t tag          = thread_tag()[thread];
+		node->tag_          = tag;
+		++stat->num_get_[c_index];
+		size_t result = stat->count_tag_inuse_[tag] + capacity;
+		stat->count_tag_inuse_[tag] = result;
+		if( stat->count_tag_peak_[tag] < result )
+			stat->count_tag_peak_[tag] = result;
+	}
+	/*!
+	Record the statistics for a block of memory that is no longer in use.
+
+	\param node [in]
+	is the thread_alloc information at the front of the memory.
+
+	\param thread [in]
+	is the thread that allocated the memory
+	(during parallel execution it must be the thread that is executing).
+
+	\param c_index [in]
+	is the capacity index for this memory.
+	*/
+	static void stat_return(block_t* node, size_t thread, size_t c_index)
+	{	thread_stat_t* stat = thread_stat(thread);
+		size_t capacity     = capacity_info()->value[c_index];
+		size_t tag          = node->tag_;
+		CPPAD_ASSERT_UNKNOWN( tag < number_tag );
+		CPPAD_ASSERT_UNKNOWN( stat->count_tag_inuse_[tag] >= capacity );
+		++stat->num_return_[c_index];
+		stat->count_tag_inuse_[tag] -= capacity;
 	}
 	// -----------------------------------------------------------------------
 	/*!
@@ -278,7 +515,7 @@ private:
 
 	\copydetails inc_inuse
 	*/
-	static void inc_available(size_t inc, size_t thread)
+	static void inc_available(size_t inc, size_t thread, size_t numa)
 	{
 		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
 		CPPAD_ASSERT_UNKNOWN(
@@ -290,6 +527,8 @@ private:
 		CPPAD_ASSERT_UNKNOWN( result >= info->count_available_ );
 
 		info->count_available_ = result;
+		CPPAD_ASSERT_UNKNOWN( numa < CPPAD_MAX_NUM_NUMA );
+		info->count_available_numa_[numa] += inc;
 	}
 	// -----------------------------------------------------------------------
 	/*!
@@ -304,8 +543,11 @@ private:
 	(must be less than \c num_threads).
 	Durring parallel execution, this must be the thread
 	that is currently executing.
+
+	\param numa [in]
+	NUMA node for the memory (must be less than CPPAD_MAX_NUM_NUMA).
 	*/
-	static void dec_inuse(size_t dec, size_t thread)
+	static void dec_inuse(size_t dec, size_t thread, size_t numa)
 	{
 		CPPAD_ASSERT_UNKNOWN(
 			thread < num_threads() || (! in_parallel())
@@ -318,6 +560,8 @@ private:
 		// do the subtraction
 		CPPAD_ASSERT_UNKNOWN( info->count_inuse_ >= dec );
 		info->count_inuse_ = info->count_inuse_ - dec;
+		CPPAD_ASSERT_UNKNOWN( info->count_inuse_numa_[numa] >= dec );
+		info->count_inuse_numa_[numa] -= dec;
 	}
 	// -----------------------------------------------------------------------
 	/*!
@@ -326,7 +570,7 @@ private:
 
 	\copydetails dec_inuse
 	*/
-	static void dec_available(size_t dec, size_t thread)
+	static void dec_available(size_t dec, size_t thread, size_t numa)
 	{
 		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
 		CPPAD_ASSERT_UNKNOWN(
@@ -336,6 +580,8 @@ private:
 		// do the subtraction
 		CPPAD_ASSERT_UNKNOWN( info->count_available_ >= dec );
 		info->count_available_ =  info->count_available_ - dec;
+		CPPAD_ASSERT_UNKNOWN( info->count_available_numa_[numa] >= dec );
+		info->count_available_numa_[numa] -= dec;
 	}
 
 	// ----------------------------------------------------------------------
@@ -364,138 +610,946 @@ private:
 
 		return number_user;
 	}
+	// -----------------------------------------------------------------------
+	/// maximum number of routines that can be added by thread_reset_add
+	static const size_t thread_reset_max = 32;
+	/// list of routines that reset the state for a thread number
+	/// (the list is terminated by CPPAD_NULL)
+	static void (**thread_reset_list(void))(size_t)
+	{	static void (*list[thread_reset_max + 1])(size_t);
+		return list;
+	}
 	/*!
-	Set and call the routine that determine the current thread number.
+	Reset the state for a thread number that is being reused.
 
-	\return
-	returns value for the most recent setting for \a thread_num_new.
-	If \a set is true,
-	or the most recent setting is \c CPPAD_NULL (its initial value),
-	the return value is zero.
-	Otherwise the routine corresponding to the most recent setting
-	is called and its value returned by \c set_get_thread_num.
+	\param thread
+	is the thread number. The memory that is available for this thread
+	is returned to the system and the routines in thread_reset_list
+	are called with this thread number.
+	*/
+	static void thread_reset(size_t thread)
+	{	free_available(thread);
+		// the new thread may be running on a different NUMA node
+		thread_info(thread)->numa_count_ = 0;
+		void (**list)(size_t) = thread_reset_list();
+		for(size_t i = 0; list[i] != CPPAD_NULL; ++i)
+			list[i](thread);
+	}
+	// -----------------------------------------------------------------------
+	/// settings for the most recent call to parallel_setup
+	class parallel_user_t {
+	public:
+		/// number of threads
+		size_t num_threads;
+		/// routine that determines if we are in parallel mode
+		bool (*in_parallel)(void);
+		/// routine that determines the thread number
+		/// (thread_register when threads are registered)
+		size_t (*thread_num)(void);
+	};
+	/// the settings for the most recent call to parallel_setup
+	static parallel_user_t& parallel_user(void)
+	{	static parallel_user_t user = { 1, CPPAD_NULL, CPPAD_NULL };
+		return user;
+	}
+	/*!
+	Change the parallel settings without changing the settings for the
+	most recent call to parallel_setup or the memory held by any thread.
 
-	\param thread_num_new [in]
-	If \a set is false, \a thread_num_new it is not used.
-	Otherwise, the current value of \c thread_num_new becomes the
-	most recent setting for thread_num.
+	This must be called in sequential execution mode.
+	It is used by run_threads_alloc, which uses it again to restore
+	the values in parallel_user when its threads are done.
 
-	\param set
-	If \a set is true, then \a thread_num_new is becomes the most
-	recent setting for this \c set_get_thread_num.
+	\param num_threads
+	is the number of threads.
+
+	\param in_parallel
+	is the routine that determines if we are in parallel mode
+	(must be CPPAD_NULL if num_threads is one).
+
+	\param thread_num
+	is the routine that determines the thread number
+	(must be CPPAD_NULL if num_threads is one).
 	*/
-	static size_t set_get_thread_num(
-		size_t (*thread_num_new)(void)  ,
-		bool set = false                )
-	{	static size_t (*thread_num_user)(void) = CPPAD_NULL;
+	static void parallel_set(
+		size_t num_threads         ,
+		bool (*in_parallel)(void)  ,
+		size_t (*thread_num)(void) )
+	{	CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() );
+		CPPAD_ASSERT_UNKNOWN( 0 < num_threads );
+		CPPAD_ASSERT_UNKNOWN( num_threads <= CPPAD_MAX_NUM_THREADS );
+		CPPAD_ASSERT_UNKNOWN( num_threads > 1 || in_parallel == CPPAD_NULL );
+		CPPAD_ASSERT_UNKNOWN( num_threads > 1 || thread_num == CPPAD_NULL );
+		if( num_threads > 1 )
+		{	// constructors for static variables called in sequential mode
+			for(size_t thread = 0; thread < num_threads; thread++)
+				thread_info(thread);
+			capacity_info();
+			thread_reset_list();
+		}
+		bool set = true;
+		set_get_num_threads(num_threads);
+		// emphasize that this routine is outside thread_alloc class
+		CppAD::local::set_get_in_parallel(in_parallel, set);
+		set_get_thread_num(thread_num, set);
+	}
+	// run_threads_alloc uses parallel_user and parallel_set
+	template <class Functor>
+	friend void local::run_threads_alloc(size_t n_thread, const Functor& fun);
+# if CPPAD_USE_CPLUSPLUS_2011
+	// -----------------------------------------------------------------------
+	/*!
+	Registration of the current thread when thread_num is determined
+	using C++11 thread_local storage (see parallel_setup).
+	*/
+	class thread_register_t {
+	public:
+		/// registration generation that thread corresponds to
+		/// (zero means this thread is not registered)
+		size_t generation;
+		/// thread number for this thread (if it is registered)
+		size_t thread;
+		/// ctor
+		thread_register_t(void) : generation(0), thread(0)
+		{ }
+		/// dtor: called when the thread exits, releases its thread number
+		~thread_register_t(void)
+		{	thread_register_release(generation, thread); }
+	};
+	/// registration for the current thread
+	static thread_register_t& thread_register_local(void)
+	{	static thread_local thread_register_t reg;
+		return reg;
+	}
+	/// current registration generation (zero means not using registration)
+	static size_t& thread_register_generation(void)
+	{	static size_t generation = 0;
+		return generation;
+	}
+	/// mutex used when registering and releasing thread numbers
+	static std::mutex& thread_register_mutex(void)
+	{	static std::mutex mutex;
+		return mutex;
+	}
+	/// flags that are true for the thread numbers that are registered
+	static bool* thread_register_inuse(void)
+	{	static bool inuse[CPPAD_MAX_NUM_THREADS];
+		return inuse;
+	}
+	/// flags that are true for the thread numbers that have been released
+	/// by a thread that exited (during the current generation)
+	static bool* thread_register_released(void)
+	{	static bool released[CPPAD_MAX_NUM_THREADS];
+		return released;
+	}
+	/*!
+	Start a new registration generation.
+	This must be called in sequential execution mode.
+	The current thread becomes thread zero and all the other
+	thread numbers are available.
+	*/
+	static void thread_register_start(void)
+	{	thread_register_mutex();
+		size_t generation = ++thread_register_generation();
+		bool* inuse       = thread_register_inuse();
+		bool* released    = thread_register_released();
+		inuse[0]          = true;
+		released[0]       = false;
+		for(size_t thread = 1; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+		{	inuse[thread]    = false;
+			released[thread] = false;
+		}
+		thread_register_t& reg = thread_register_local();
+		reg.generation = generation;
+		reg.thread     = 0;
+	}
+	/*!
+	Release a thread number.
 
-		if( set )
-		{	thread_num_user = thread_num_new;
-			return 0;
+	\param generation
+	is the generation when the thread number was registered.
+	If it is not the current generation, this routine does nothing.
+
+	\param thread
+	is the thread number that is released (thread zero is not released).
+	*/
+	static void thread_register_release(size_t generation, size_t thread)
+	{	if( generation == 0 || thread == 0 )
+			return;
+		std::lock_guard<std::mutex> lock( thread_register_mutex() );
+		if( generation == thread_register_generation() )
+		{	thread_register_inuse()[thread]    = false;
+			thread_register_released()[thread] = true;
 		}
+	}
+	/*!
+	Thread number for the current thread when using registration.
+	If the current thread is not registered for the current generation,
+	the smallest thread number that is not in use is registered for it.
+	If that number was released by a thread that exited,
+	the state left behind by that thread is reset (see thread_reset).
+	This routine is used in place of the user's thread_num routine.
 
-		if( thread_num_user == CPPAD_NULL )
-			return 0;
+	\return
+	is the thread number for the current thread.
+	*/
+	static size_t thread_register(void)
+	{	thread_register_t& reg = thread_register_local();
+		size_t generation      = thread_register_generation();
+		bool   reset           = false;
+		if( reg.generation != generation )
+		{	std::lock_guard<std::mutex> lock( thread_register_mutex() );
+			size_t num_threads = set_get_num_threads(0);
+			bool*  inuse       = thread_register_inuse();
+			size_t thread      = 1;
+			while( thread < num_threads && inuse[thread] )
+				++thread;
+			CPPAD_ASSERT_KNOWN(
+				thread < num_threads,
+				"thread_alloc: more than num_threads threads are "
+				"registered at the same time"
+			);
+			inuse[thread]  = true;
+			reg.generation = generation;
+			reg.thread     = thread;
+			reset          = thread_register_released()[thread];
+			thread_register_released()[thread] = false;
+		}
+		// reset outside of the lock (resets may use this thread's number)
+		if( reset )
+			thread_reset(reg.thread);
+		return reg.thread;
+	}
+# endif
+	// -----------------------------------------------------------------------
+	// -----------------------------------------------------------------------
+	/*!
+	Number of bytes obtained from the system for a block of memory.
 
-		size_t thread = thread_num_user();
-		CPPAD_ASSERT_KNOWN(
-			thread < set_get_num_threads(0) ,
-			"parallel_setup: thread_num() >= num_threads"
-		);
-		return thread;
+	\param cap_bytes [in]
+	is the capacity of the block; i.e., the number of bytes for use by
+	the caller of \c get_memory.
+	*/
+	static size_t system_size(size_t cap_bytes)
+	{	size_t size = sizeof(block_t) + cap_bytes;
+		if( system_aligned(cap_bytes) )
+			size += CPPAD_THREAD_ALLOC_ALIGN - 1;
+		return size;
 	}
-// ============================================================================
-public:
-/*
-$begin ta_parallel_setup$$
-$spell
-	alloc
-	num
-	bool
-$$
-$section Setup thread_alloc For Use in Multi-Threading Environment$$
-$mindex parallel initialize$$
+	/*!
+	Is huge page backing used for a block of memory.
 
+	\param cap_bytes [in]
+	is the capacity of the block.
+	*/
+	static bool system_huge(size_t cap_bytes)
+	{	return CPPAD_THREAD_ALLOC_MMAP &&
+			CPPAD_THREAD_ALLOC_HUGE_BYTES > 0 &&
+			cap_bytes >= size_t(CPPAD_THREAD_ALLOC_HUGE_BYTES);
+	}
+	/*!
+	Is a block of memory aligned to a multiple of CPPAD_THREAD_ALLOC_ALIGN.
 
+	\param cap_bytes [in]
+	is the capacity of the block.
+	*/
+	static bool system_aligned(size_t cap_bytes)
+	{	return cap_bytes >= size_t(CPPAD_THREAD_ALLOC_ALIGN_BYTES) ||
+			system_huge(cap_bytes);
+	}
+	/*!
+	Place a block in memory obtained from the system (or an arena).
 
+	\param v_raw [in]
+	is the beginning of the memory, which must have at least
+	<code>system_size(cap_bytes)</code> bytes.
 
-$head Syntax$$
-$codei%thread_alloc::parallel_setup(%num_threads%, %in_parallel%, %thread_num%)
-%$$
+	\param cap_bytes [in]
+	is the capacity of the block.
 
-$head Purpose$$
-By default there is only one thread and all execution is in sequential mode,
-i.e., multiple threads are not sharing the same memory; i.e.
-not in parallel mode.
+	\return
+	is the thread_alloc information at the front of the block
+	and <code>node->raw_</code> is equal to v_raw.
+	If <code>system_aligned(cap_bytes)</code>,
+	the memory after it is a multiple of CPPAD_THREAD_ALLOC_ALIGN.
+	Otherwise, the block is at the beginning of the memory.
+	*/
+	static block_t* system_align(void* v_raw, size_t cap_bytes)
+	{	block_t* node = reinterpret_cast<block_t*>(v_raw);
+		if( system_aligned(cap_bytes) )
+		{	size_t align = CPPAD_THREAD_ALLOC_ALIGN;
+			size_t raw   = reinterpret_cast<size_t>(v_raw);
+			size_t ptr   = (raw + sizeof(block_t) + align - 1) / align;
+			node         = reinterpret_cast<block_t*>(ptr * align) - 1;
+		}
+		node->raw_ = v_raw;
+		return node;
+	}
+	/*!
+	Get a new block of memory from the system.
+	This may have to wait for a lock on the system allocator.
 
-$head Speed$$
-It should be faster, even when $icode num_thread$$ is equal to one,
-for $code thread_alloc$$ to hold onto memory.
-This can be accomplished using the function call
-$codei%
-	thread_alloc::hold_memory(true)
-%$$
-see $cref/hold_memory/ta_hold_memory/$$.
+	\param cap_bytes [in]
+	is the capacity of the block.
 
-$head num_threads$$
-This argument has prototype
-$codei%
-	size_t %num_threads%
-%$$
-and must be greater than zero.
-It specifies the number of threads that are sharing memory.
-The case $icode%num_threads% == 1%$$ is a special case that is
-used to terminate a multi-threading environment.
+	\return
+	is the thread_alloc information at the front of the block.
+	If <code>system_aligned(cap_bytes)</code>,
+	the memory for use by the caller, <code>node + 1</code>,
+	is a multiple of CPPAD_THREAD_ALLOC_ALIGN.
+	*/
+	static block_t* system_new(size_t cap_bytes)
+	{	size_t size  = system_size(cap_bytes);
+		void*  v_raw = CPPAD_NULL;
+# if CPPAD_THREAD_ALLOC_MMAP
+		if( system_huge(cap_bytes) )
+		{	v_raw = mmap(
+				CPPAD_NULL,
+				size,
+				PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS,
+				-1,
+				0
+			);
+			if( v_raw == MAP_FAILED )
+				throw std::bad_alloc();
+			// huge pages are only a hint, so ignore a failure here
+			madvise(v_raw, size, MADV_HUGEPAGE);
+		}
+		else
+# endif
+			v_raw = ::operator new(size);
+		//
+		block_t* node = system_align(v_raw, cap_bytes);
+		//
+		// the caller is the first to touch this memory
+		node->numa_   = numa_node();
+		return node;
+	}
+	/*!
+	Return a block of memory to the system.
 
-$head in_parallel$$
-This function has prototype
-$codei%
-	bool %in_parallel%(void)
-%$$
-It must return $code true$$ if there is more than one thread
-currently executing.
-Otherwise it can return false.
-$pre
+	\param node [in]
+	is the thread_alloc information at the front of the block
+	(as returned by \c system_new).
 
-$$
-In the special case where $icode%num_threads% == 1%$$,
-the routine $icode in_parallel$$ is not used.
+	\param cap_bytes [in]
+	is the capacity of the block.
+	*/
+	static void system_delete(block_t* node, size_t cap_bytes)
+	{	void* v_raw = node->raw_;
+# if CPPAD_THREAD_ALLOC_MMAP
+		if( system_huge(cap_bytes) )
+		{	munmap(v_raw, system_size(cap_bytes) );
+			return;
+		}
+# endif
+		::operator delete(v_raw);
+	}
+	/// number of numa_node calls between calls to numa_node_system
+	static const size_t numa_refresh = 64;
+	/*!
+	NUMA node for the processor that the current thread is running on
+	as determined by the system.
 
-$head thread_num$$
-This function has prototype
-$codei%
-	size_t %thread_num%(void)
-%$$
-It must return a thread number that uniquely identifies the
-currently executing thread.
-Furthermore
-$codei%
-	0 <= %thread_num%() < %num_threads%
-%$$.
-In the special case where $icode%num_threads% == 1%$$,
-the routine $icode thread_num$$ is not used.
-$pre
+	\return
+	is less than CPPAD_MAX_NUM_NUMA (zero if it cannot be determined).
+	*/
+	static size_t numa_node_system(void)
+	{	size_t numa = 0;
+# if CPPAD_THREAD_ALLOC_NUMA
+		unsigned int cpu, node;
+		if( syscall(SYS_getcpu, &cpu, &node, CPPAD_NULL) == 0 )
+			numa = size_t(node);
+# endif
+		if( numa >= CPPAD_MAX_NUM_NUMA )
+			numa = CPPAD_MAX_NUM_NUMA - 1;
+		return numa;
+	}
+	/*!
+	Move the pages for a block of memory to a NUMA node.
 
-$$
-Note that this function is called by other routines so,
-as soon as a new thread is executing,
-one must be certain that $icode thread_num()$$ will
-work for that thread.
+	\param node [in,out]
+	is the thread_alloc information at the front of the block.
+	If the block can be moved, node->numa_ is set to numa.
 
-$head Restrictions$$
-The function $code parallel_setup$$ must be called before
-the program enters $cref/parallel/ta_in_parallel/$$ execution mode.
-In addition, this function cannot be called while in parallel mode.
+	\param cap_bytes [in]
+	is the capacity of the block.
 
-$head Example$$
-The files
-$cref simple_ad_openmp.cpp$$,
-$cref simple_ad_bthread.cpp$$, and
-$cref simple_ad_pthread.cpp$$,
-contain examples and tests that use this function.
+	\param numa [in]
+	is the NUMA node the pages are moved to.
 
-$end
-*/
+	\return
+	is true if the block was moved; i.e., it was obtained using mmap
+	and the mbind system call succeeded.
+	(Other blocks may share pages with memory that is not in the block.)
+	*/
+	static bool numa_move(block_t* node, size_t cap_bytes, size_t numa)
+	{
+# if CPPAD_THREAD_ALLOC_NUMA && CPPAD_THREAD_ALLOC_MMAP
+		if( system_huge(cap_bytes) )
+		{	// values for MPOL_PREFERRED and MPOL_MF_MOVE in numaif.h
+			int           mpol_preferred = 1;
+			unsigned long mpol_mf_move   = 2;
+			unsigned long mask           = 1ul << numa;
+			unsigned long max_node       = 8 * sizeof(mask);
+			// the pages are only moved if the system allows it
+			long flag = syscall(SYS_mbind,
+				node->raw_,
+				system_size(cap_bytes),
+				mpol_preferred,
+				&mask,
+				max_node,
+				mpol_mf_move
+			);
+			if( flag == 0 )
+			{	node->numa_ = numa;
+				return true;
+			}
+		}
+# endif
+		return false;
+	}
+	/*!
+	Find memory that is available and local to the NUMA node for the
+	current thread.
+
+	\param available_root [in,out]
+	is the root of the available list for this thread and capacity.
+
+	\param cap_bytes [in]
+	is the capacity for this list.
+
+	\return
+	is the block before the one that should be used; i.e.,
+	if <code>previous->next_</code> is null, a new block should be
+	obtained from the system.
+	If there is no available block for the current NUMA node,
+	the first block in the list is moved to the current node if possible.
+	Otherwise, the available blocks are left for use on their nodes
+	(or until \c free_available is called) and a new block is used
+	so that the current thread is the first to touch its pages.
+	*/
+	static block_t* numa_previous(block_t* available_root, size_t cap_bytes)
+	{	size_t numa       = numa_node();
+		block_t* previous = available_root;
+		while( previous->next_ != CPPAD_NULL )
+		{	block_t* node = reinterpret_cast<block_t*>(previous->next_);
+			if( node->numa_ == numa )
+				return previous;
+			previous = node;
+		}
+		block_t* node = reinterpret_cast<block_t*>(available_root->next_);
+		if( node == CPPAD_NULL )
+			return available_root;
+		size_t old_numa = node->numa_;
+		if( numa_move(node, cap_bytes, numa) )
+		{	size_t  thread = thread_num();
+			dec_available(cap_bytes, thread, old_numa);
+			inc_available(cap_bytes, thread, numa);
+			return available_root;
+		}
+		return previous;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Get memory from an arena.
+
+	\param arena [in]
+	is the arena that the memory is obtained from.
+
+	\param cap_bytes [in]
+	is the capacity for this allocation.
+
+	\param c_index [in]
+	is the capacity index for this allocation.
+
+	\return
+	is the memory for use by the caller.
+	The corresponding block has thread index CPPAD_MAX_NUM_THREADS
+	(which identifies arena memory), <code>next_</code> is the arena,
+	and <code>raw_</code> is the memory returned by the arena.
+	*/
+	static void* arena_get(
+		thread_alloc_arena* arena, size_t cap_bytes, size_t c_index
+	)
+	{	void* v_raw = arena->allocate( system_size(cap_bytes) );
+		CPPAD_ASSERT_KNOWN(
+			v_raw != CPPAD_NULL,
+			"thread_alloc: an arena allocate returned null"
+		);
+		size_t num_cap    = capacity_info()->number;
+		block_t* node     = system_align(v_raw, cap_bytes);
+		node->tc_index_   = CPPAD_MAX_NUM_THREADS * num_cap + c_index;
+		node->next_       = static_cast<void*>(arena);
+		node->numa_       = 0;
+		return reinterpret_cast<void*>(node + 1);
+	}
+	/*!
+	Return memory to the arena that it was obtained from.
+
+	\param node [in]
+	is the thread_alloc information at the front of the memory.
+
+	\param cap_bytes [in]
+	is the capacity for this memory.
+	*/
+	static void arena_return(block_t* node, size_t cap_bytes)
+	{	thread_alloc_arena* arena =
+			static_cast<thread_alloc_arena*>(node->next_);
+		arena->deallocate(node->raw_, system_size(cap_bytes) );
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Remove memory from the debugging list of memory in use
+	(does nothing if NDEBUG or CPPAD_DEBUG_AND_RELEASE is defined).
+
+	\param node [in]
+	is the thread_alloc information at the front of the memory.
+
+	\param thread [in]
+	is the thread that allocated the memory.
+	During parallel execution, this must be the thread
+	that is currently executing.
+
+	\param c_index [in]
+	is the capacity index for this memory.
+	*/
+	static void inuse_remove(
+		block_t* node    ,
+		size_t   thread  ,
+		size_t   c_index )
+	{
+# ifndef NDEBUG
+# ifndef CPPAD_DEBUG_AND_RELEASE
+		thread_alloc_info* info = thread_info(thread);
+		size_t capacity  = capacity_info()->value[c_index];
+		void*  v_ptr     = reinterpret_cast<void*>(node + 1);
+		// remove node from inuse list
+		void* v_node         = reinterpret_cast<void*>(node);
+		block_t* inuse_root  = info->root_inuse_ + c_index;
+		block_t* previous    = inuse_root;
+		while( (previous->next_ != CPPAD_NULL) & (previous->next_ != v_node) )
+			previous = reinterpret_cast<block_t*>(previous->next_);
+
+		// check that v_ptr is valid
+		if( previous->next_ != v_node )
+		{	using std::endl;
+			std::ostringstream oss;
+			oss << "return_memory: attempt to return memory not in use";
+			oss << endl;
+			oss << "v_ptr    = " << v_ptr    << endl;
+			oss << "thread   = " << thread   << endl;
+			oss << "capacity = " << capacity << endl;
+			oss << "See CPPAD_TRACE_THREAD & CPPAD_TRACE_CAPACITY in";
+			oss << endl << "%# include <cppad/utility/thread_alloc.hpp>" << endl;
+			// oss.str() returns a string object with a copy of the current
+			// contents in the stream buffer.
+			std::string msg_str       = oss.str();
+			// msg_str.c_str() returns a pointer to the c-string
+			// representation of the string object's value.
+			const char* msg_char_star = msg_str.c_str();
+			CPPAD_ASSERT_KNOWN(false, msg_char_star );
+		}
+		// remove v_ptr from inuse list
+		previous->next_  = node->next_;
+# endif
+# endif
+	}
+	/*!
+	Add memory to the debugging list of memory in use
+	(does nothing if NDEBUG or CPPAD_DEBUG_AND_RELEASE is defined).
+
+	\copydetails inuse_remove
+	*/
+	static void inuse_add(
+		block_t* node    ,
+		size_t   thread  ,
+		size_t   c_index )
+	{
+# ifndef NDEBUG
+# ifndef CPPAD_DEBUG_AND_RELEASE
+		block_t* inuse_root = thread_info(thread)->root_inuse_ + c_index;
+		node->next_         = inuse_root->next_;
+		inuse_root->next_   = reinterpret_cast<void*>(node);
+# endif
+# endif
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Return memory to the pool for the thread that allocated it.
+
+	\param node [in]
+	is the thread_alloc information at the front of the memory that is
+	being returned (the corresponding memory must be in use).
+
+	\param thread [in]
+	is the thread that allocated the memory.
+	During parallel execution, this must be the thread
+	that is currently executing.
+
+	\param c_index [in]
+	is the capacity index for this memory.
+	*/
+	static void return_memory_owner(
+		block_t* node    ,
+		size_t   thread  ,
+		size_t   c_index )
+	{	size_t capacity  = capacity_info()->value[c_index];
+# ifndef NDEBUG
+		void*  v_ptr     = reinterpret_cast<void*>(node + 1);
+# endif
+		thread_alloc_info* info = thread_info(thread);
+		inuse_remove(node, thread, c_index);
+# ifndef NDEBUG
+		// trace option
+		if( capacity==CPPAD_TRACE_CAPACITY && thread==CPPAD_TRACE_THREAD )
+		{	std::cout << "return_memory: v_ptr = " << v_ptr << std::endl; }
+
+# endif
+		// capacity bytes are removed from the inuse pool
+		dec_inuse(capacity, thread, node->numa_);
+		stat_return(node, thread, c_index);
+
+		// check for case where we just return the memory to the system
+		if( ! set_get_hold_memory(false) )
+		{	system_delete(node, capacity);
+			return;
+		}
+
+		// add this node to available list for this thread and capacity
+		block_t* available_root = info->root_available_ + c_index;
+		node->next_             = available_root->next_;
+		available_root->next_   = reinterpret_cast<void*>(node);
+
+		// capacity bytes are added to the available pool
+		inc_available(capacity, thread, node->numa_);
+	}
+# if CPPAD_USE_CPLUSPLUS_2011
+	// -----------------------------------------------------------------------
+	/*!
+	Lock-free lists of memory returned by threads other than the one that
+	allocated it.
+
+	\return
+	The list for thread and capacity index c_index is element
+	<code>thread * CPPAD_MAX_NUM_CAPACITY + c_index</code>.
+	Any thread can push a node onto a list,
+	only the thread that allocated the memory removes nodes from its lists.
+	*/
+	static std::atomic<void*>* remote_root(void)
+	{	static std::atomic<void*> root[
+			CPPAD_MAX_NUM_THREADS * CPPAD_MAX_NUM_CAPACITY
+		];
+		return root;
+	}
+	/*!
+	Add memory to the remote list for the thread that allocated it.
+
+	\param node [in]
+	is the thread_alloc information at the front of the memory.
+
+	\param thread [in]
+	is the thread that allocated the memory
+	(not the thread that is currently executing).
+
+	\param c_index [in]
+	is the capacity index for this memory.
+	*/
+	static void remote_push(block_t* node, size_t thread, size_t c_index)
+	{	std::atomic<void*>& root =
+			remote_root()[thread * CPPAD_MAX_NUM_CAPACITY + c_index];
+		void* v_node = reinterpret_cast<void*>(node);
+		void* head   = root.load(std::memory_order_relaxed);
+		do
+			node->next_ = head;
+		while( ! root.compare_exchange_weak(
+			head, v_node, std::memory_order_release, std::memory_order_relaxed
+		) );
+	}
+	/*!
+	Return the memory in a remote list to the pool for its thread.
+
+	\param thread [in]
+	is the thread that allocated the memory in the list.
+	During parallel execution, this must be the thread
+	that is currently executing.
+
+	\param c_index [in]
+	is the capacity index for the list.
+	*/
+	static void remote_drain(size_t thread, size_t c_index)
+	{	std::atomic<void*>& root =
+			remote_root()[thread * CPPAD_MAX_NUM_CAPACITY + c_index];
+		if( root.load(std::memory_order_relaxed) == CPPAD_NULL )
+			return;
+		void* v_node = root.exchange(CPPAD_NULL, std::memory_order_acquire);
+		while( v_node != CPPAD_NULL )
+		{	block_t* node = reinterpret_cast<block_t*>(v_node);
+			v_node        = node->next_;
+			return_memory_owner(node, thread, c_index);
+		}
+	}
+	/*!
+	Count the memory in a remote list (this does not change the list).
+
+	\param thread [in]
+	is the thread that allocated the memory in the list.
+	During parallel execution, this must be the thread
+	that is currently executing.
+
+	\param c_index [in]
+	is the capacity index for the list.
+
+	\param numa [in]
+	If this is less than CPPAD_MAX_NUM_NUMA,
+	only the blocks on this NUMA node are counted.
+
+	\param tag [in]
+	If this is less than number_tag,
+	only the blocks with this tag are counted.
+
+	\return
+	is the number of blocks in the list that are counted.
+	*/
+	static size_t remote_count(
+		size_t thread, size_t c_index, size_t numa, size_t tag
+	)
+	{	std::atomic<void*>& root =
+			remote_root()[thread * CPPAD_MAX_NUM_CAPACITY + c_index];
+		size_t count = 0;
+		void* v_node = root.load(std::memory_order_acquire);
+		while( v_node != CPPAD_NULL )
+		{	block_t* node = reinterpret_cast<block_t*>(v_node);
+			bool ok_numa  = numa >= CPPAD_MAX_NUM_NUMA || node->numa_ == numa;
+			bool ok_tag   = tag >= number_tag || node->tag_ == tag;
+			count        += size_t( ok_numa && ok_tag );
+			v_node        = node->next_;
+		}
+		return count;
+	}
+# endif
+	/*!
+	Return the memory in all the remote lists for a thread
+	(does nothing if C++11 is not available).
+
+	\param thread [in]
+	During parallel execution, this must be the thread
+	that is currently executing.
+	*/
+	static void remote_drain_all(size_t thread)
+	{
+# if CPPAD_USE_CPLUSPLUS_2011
+		size_t num_cap = capacity_info()->number;
+		for(size_t c_index = 0; c_index < num_cap; ++c_index)
+			remote_drain(thread, c_index);
+# endif
+	}
+	/*!
+	Number of bytes in all the remote lists for a thread
+	(this does not change the lists and is zero if C++11 is not available).
+
+	\param thread [in]
+	During parallel execution, this must be the thread
+	that is currently executing.
+
+	\param numa [in]
+	If this is less than CPPAD_MAX_NUM_NUMA,
+	only the blocks on this NUMA node are counted.
+
+	\param tag [in]
+	If this is less than number_tag,
+	only the blocks with this tag are counted.
+	*/
+	static size_t remote_bytes(size_t thread, size_t numa, size_t tag)
+	{	size_t bytes = 0;
+# if CPPAD_USE_CPLUSPLUS_2011
+		size_t num_cap              = capacity_info()->number;
+		const size_t* capacity_vec  = capacity_info()->value;
+		for(size_t c_index = 0; c_index < num_cap; ++c_index)
+		{	size_t count = remote_count(thread, c_index, numa, tag);
+			bytes       += count * capacity_vec[c_index];
+		}
+# endif
+		return bytes;
+	}
+	/*!
+	Set and call the routine that determine the current thread number.
+
+	\return
+	returns value for the most recent setting for \a thread_num_new.
+	If \a set is true,
+	or the most recent setting is \c CPPAD_NULL (its initial value),
+	the return value is zero.
+	Otherwise the routine corresponding to the most recent setting
+	is called and its value returned by \c set_get_thread_num.
+
+	\param thread_num_new [in]
+	If \a set is false, \a thread_num_new it is not used.
+	Otherwise, the current value of \c thread_num_new becomes the
+	most recent setting for thread_num.
+
+	\param set
+	If \a set is true, then \a thread_num_new is becomes the most
+	recent setting for this \c set_get_thread_num.
+	*/
+	static size_t set_get_thread_num(
+		size_t (*thread_num_new)(void)  ,
+		bool set = false                )
+	{	static size_t (*thread_num_user)(void) = CPPAD_NULL;
+
+		if( set )
+		{	thread_num_user = thread_num_new;
+			return 0;
+		}
+
+		if( thread_num_user == CPPAD_NULL )
+			return 0;
+# if CPPAD_USE_CPLUSPLUS_2011
+		// registered threads do not call a user routine
+		if( thread_num_user == thread_register )
+			return thread_register();
+# endif
+
+		size_t thread = thread_num_user();
+		CPPAD_ASSERT_KNOWN(
+			thread < set_get_num_threads(0) ,
+			"parallel_setup: thread_num() >= num_threads"
+		);
+		return thread;
+	}
+// ============================================================================
+public:
+/*
+$begin ta_parallel_setup$$
+$spell
+	alloc
+	num
+	bool
+	inuse
+$$
+$section Setup thread_alloc For Use in Multi-Threading Environment$$
+$mindex parallel initialize$$
+
+
+
+
+$head Syntax$$
+$codei%thread_alloc::parallel_setup(%num_threads%, %in_parallel%, %thread_num%)
+%$$
+
+$head Purpose$$
+By default there is only one thread and all execution is in sequential mode,
+i.e., multiple threads are not sharing the same memory; i.e.
+not in parallel mode.
+
+$head Speed$$
+It should be faster, even when $icode num_thread$$ is equal to one,
+for $code thread_alloc$$ to hold onto memory.
+This can be accomplished using the function call
+$codei%
+	thread_alloc::hold_memory(true)
+%$$
+see $cref/hold_memory/ta_hold_memory/$$.
+
+$head num_threads$$
+This argument has prototype
+$codei%
+	size_t %num_threads%
+%$$
+and must be greater than zero.
+It specifies the number of threads that are sharing memory.
+It must also be less than or equal
+$cref/CPPAD_MAX_NUM_THREADS/multi_thread/CPPAD_MAX_NUM_THREADS/$$
+(the number of threads that CppAD was configured for).
+The case $icode%num_threads% == 1%$$ is a special case that is
+used to terminate a multi-threading environment.
+
+$head in_parallel$$
+This function has prototype
+$codei%
+	bool %in_parallel%(void)
+%$$
+It must return $code true$$ if there is more than one thread
+currently executing.
+Otherwise it can return false.
+$pre
+
+$$
+In the special case where $icode%num_threads% == 1%$$,
+the routine $icode in_parallel$$ is not used.
+
+$head thread_num$$
+This function has prototype
+$codei%
+	size_t %thread_num%(void)
+%$$
+It must return a thread number that uniquely identifies the
+currently executing thread.
+Furthermore
+$codei%
+	0 <= %thread_num%() < %num_threads%
+%$$.
+In the special case where $icode%num_threads% == 1%$$,
+the routine $icode thread_num$$ is not used.
+$pre
+
+$$
+Note that this function is called by other routines so,
+as soon as a new thread is executing,
+one must be certain that $icode thread_num()$$ will
+work for that thread.
+
+$subhead Registration$$
+If C++11 is available, $icode thread_num$$ may be $code CPPAD_NULL$$
+(when $icode%num_threads% > 1%$$).
+In this case, the thread that calls $code parallel_setup$$ is thread zero.
+Each other thread is registered the first time it uses
+$cref/thread_num/ta_thread_num/$$
+(or any other CppAD routine that needs its thread number)
+and is given the smallest thread number that is not in use.
+The thread number is stored using C++11 $code thread_local$$ storage,
+so determining the current thread number does not require a call to a user
+routine (which is faster).
+When a registered thread exits, its thread number becomes available.
+Thus $icode num_threads$$ is the maximum number of threads
+that are registered at the same time, and an
+elastic thread pool may create and destroy any number of threads.
+Before a thread exits, it should call
+$codei%
+	thread_alloc::free_available( thread_alloc::thread_num() )
+%$$
+(the inuse memory for that thread should be zero).
+If it does not, the available memory is freed when its thread number
+is given to another thread.
+In addition, if a thread exits while it is recording
+$codei%AD<%Base%>%$$ operations, the tape is deleted when its thread number
+is given to another thread
+(provided $cref parallel_ad$$ was called for $icode Base$$).
+$pre
+
+$$
+Note that the number of threads registered at the same time
+is still limited by
+$cref/CPPAD_MAX_NUM_THREADS/multi_thread/CPPAD_MAX_NUM_THREADS/$$
+(because $icode num_threads$$ cannot be greater than this value).
+Calling $code parallel_setup$$ again starts a new registration;
+i.e., threads that are still running will be registered again.
+
+$head Restrictions$$
+The function $code parallel_setup$$ must be called before
+the program enters $cref/parallel/ta_in_parallel/$$ execution mode.
+In addition, this function cannot be called while in parallel mode.
+
+$head Example$$
+The files
+$cref simple_ad_openmp.cpp$$,
+$cref simple_ad_bthread.cpp$$, and
+$cref simple_ad_pthread.cpp$$,
+contain examples and tests that use this function.
+
+$end
+*/
 	/*!
 	Set thread_alloc up for parallel mode usage.
 
@@ -508,6 +1562,8 @@ $end
 	\param thread_num [in]
 	Is the routine that determines the current thread number
 	(between zero and num_threads minus one).
+	If C++11 is available and this is CPPAD_NULL,
+	thread_register is used to determine the thread numbers.
 	*/
 	static void parallel_setup(
 		size_t num_threads         ,
@@ -522,6 +1578,10 @@ $end
 			// emphasize that this routine is outside thread_alloc class
 			CppAD::local::set_get_in_parallel(CPPAD_NULL, set);
 			set_get_thread_num(CPPAD_NULL, set);
+			parallel_user_t& user( parallel_user() );
+			user.num_threads = 1;
+			user.in_parallel = CPPAD_NULL;
+			user.thread_num  = CPPAD_NULL;
 			return;
 		}
 
@@ -537,10 +1597,15 @@ $end
 			in_parallel != CPPAD_NULL ,
 			"parallel_setup: num_threads != 1 and in_parallel == CPPAD_NULL"
 		);
+# if CPPAD_USE_CPLUSPLUS_2011
+		// use registration of threads to determine thread numbers
+		bool use_register = thread_num == CPPAD_NULL;
+# else
 		CPPAD_ASSERT_KNOWN(
 			thread_num != CPPAD_NULL ,
 			"parallel_setup: num_threads != 1 and thread_num == CPPAD_NULL"
 		);
+# endif
 
 		// Make sure that constructors for all static variables in this file
 		// are called in sequential mode.
@@ -559,10 +1624,94 @@ $end
 		if( num_threads > 1 )
 		{	bool set = true;
 			set_get_num_threads(num_threads);
+# if CPPAD_USE_CPLUSPLUS_2011
+			if( use_register )
+			{	thread_register_start();
+				thread_num = thread_register;
+			}
+# endif
 			// emphasize that this routine is outside thread_alloc class
 			CppAD::local::set_get_in_parallel(in_parallel, set);
 			set_get_thread_num(thread_num, set);
+			parallel_user_t& user( parallel_user() );
+			user.num_threads = num_threads;
+			user.in_parallel = in_parallel;
+			user.thread_num  = thread_num;
 		}
+		// make sure static list is initialized in sequential mode
+		thread_reset_list();
+	}
+/* -----------------------------------------------------------------------
+$begin ta_thread_reset_add$$
+$spell
+	alloc
+	num
+	CppAD
+$$
+$section Add a Routine that Resets a Reused Thread Number$$
+
+$head Syntax$$
+$codei%thread_alloc::thread_reset_add(%reset%)
+%$$
+
+$head Purpose$$
+When threads are $cref/registered/ta_parallel_setup/thread_num/Registration/$$,
+the thread number of a thread that exits is given to the next new thread.
+The routine $icode reset$$ is called with this thread number
+before the new thread uses it, so that the new thread does not see
+state that was left by the thread that exited.
+CppAD uses this to delete the tape for a thread that exited while it was
+recording (see $cref parallel_ad$$).
+
+$head reset$$
+This argument has prototype
+$codei%
+	void %reset%(size_t %thread%)
+%$$
+where $icode thread$$ is the thread number that is being reused.
+It is called by the new thread, after the memory that is
+$cref/available/ta_available/$$ for $icode thread$$ has been freed.
+Adding a routine that is already in the list has no effect.
+
+$head Limit$$
+At most 32 different routines can be added
+(this includes the routines added by CppAD).
+
+$head Restrictions$$
+This routine cannot be called while in
+$cref/parallel/ta_in_parallel/$$ execution mode.
+It has no effect unless C++11 is available and
+$code parallel_setup$$ is called with $icode thread_num$$ equal to
+$code CPPAD_NULL$$.
+
+$end
+*/
+	/*!
+	Add a routine that resets the state for a thread number that is reused.
+
+	This must be called in sequential execution mode
+	(it is used by parallel_ad to reset the tape for a thread number).
+	Adding a routine that is already in the list has no effect.
+
+	\param reset
+	is called with a thread number when a thread that is registered
+	(see parallel_setup) is given a number that was released by a thread
+	that exited.
+	*/
+	static void thread_reset_add(void (*reset)(size_t thread))
+	{	CPPAD_ASSERT_KNOWN(
+			! in_parallel(),
+			"thread_reset_add: cannot be called in parallel mode"
+		);
+		void (**list)(size_t) = thread_reset_list();
+		size_t i = 0;
+		while( list[i] != CPPAD_NULL && list[i] != reset )
+			++i;
+		CPPAD_ASSERT_KNOWN(
+			i < thread_reset_max,
+			"thread_reset_add: too many reset routines"
+		);
+		list[i] = reset;
 	}
 /*
 $begin ta_num_threads$$
@@ -681,6 +1830,15 @@ $spell
 	num
 	ptr
 	thread_alloc
+	mmap
+	madvise
+	megabytes
+	sys
+	mman
+	syscall
+	unistd
+	hpp
+	NUMA
 $$
 
 $section Get At Least A Specified Amount of Memory$$
@@ -688,7 +1846,9 @@ $mindex allocate$$
 
 
 $head Syntax$$
-$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%)%$$
+$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%)
+%$$
+$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%, %arena%)%$$
 
 $head Purpose$$
 Use $cref thread_alloc$$ to obtain a minimum number of bytes of memory
@@ -725,6 +1885,14 @@ $codei%
 It is the location where the $icode cap_bytes$$ of memory
 that have been allocated for use begins.
 
+$head arena$$
+If this argument is present, it has prototype
+$codei%
+	CppAD::thread_alloc_arena* %arena%
+%$$
+If it is not null, the memory is obtained from this
+$cref/arena/ta_arena/$$ instead of the $code thread_alloc$$ pools.
+
 $head Allocation Speed$$
 This allocation should be faster if the following conditions hold:
 $list number$$
@@ -736,10 +1904,44 @@ the previous $icode min_bytes$$ and previous $icode cap_bytes$$.
 $lend
 
 $head Alignment$$
-We call a memory allocation aligned if the address is a multiple
-of the number of bytes in a $code size_t$$ value.
-If the system $code new$$ allocator is aligned, then $icode v_ptr$$
-pointer is also aligned.
+If $icode cap_bytes$$ is greater than or equal
+$code CPPAD_THREAD_ALLOC_ALIGN_BYTES$$,
+or huge pages are used for $icode cap_bytes$$ (see below),
+the address $icode v_ptr$$ is a multiple of 64 bytes
+(a typical cache line size).
+Hence it is aligned for any $code double$$ vector instructions
+that require 16, 32, or 64 byte alignment.
+Smaller allocations do not use extra memory for this padding;
+their address is a multiple of the number of bytes in a $code size_t$$
+value (if the system $code new$$ allocator is aligned to this size).
+The default value for this preprocessor symbol is $code 4096$$.
+It can be changed by defining it before $code thread_alloc.hpp$$
+is included and it must have the same value for every file that
+includes $code thread_alloc.hpp$$.
+
+$head Huge Pages$$
+On Linux systems that support transparent huge pages
+(when $code MADV_HUGEPAGE$$ is defined),
+memory for $icode cap_bytes$$ greater than or equal
+$code CPPAD_THREAD_ALLOC_HUGE_BYTES$$ is obtained using $code mmap$$
+and huge pages are requested using $code madvise$$.
+This reduces translation lookaside buffer misses for large arrays.
+The default value for this preprocessor symbol is 16 megabytes
+($code 16777216$$).
+It can be changed by defining it before $code thread_alloc.hpp$$
+is included and it must have the same value for every file that
+includes $code thread_alloc.hpp$$.
+A value of zero means that huge pages are not used.
+
+$head System Headers$$
+On Linux systems, $code thread_alloc.hpp$$ includes the POSIX headers
+$code sys/mman.h$$, $code sys/syscall.h$$, and $code unistd.h$$
+(for huge pages and NUMA nodes).
+Defining $code CPPAD_THREAD_ALLOC_SYSTEM$$ as zero,
+before $code thread_alloc.hpp$$ is included,
+suppresses these headers (and the use of huge pages and NUMA nodes).
+It must have the same value for every file that
+includes $code thread_alloc.hpp$$.
 
 $head Example$$
 $cref thread_alloc.cpp$$
@@ -791,6 +1993,10 @@ $end
 		size_t thread            = thread_num();
 		size_t tc_index          = thread * num_cap + c_index;
 		thread_alloc_info* info  = thread_info(thread);
+# if CPPAD_USE_CPLUSPLUS_2011
+		// memory of this capacity returned by other threads
+		remote_drain(thread, c_index);
+# endif
 
 # ifndef NDEBUG
 		// trace allocation
@@ -813,13 +2019,16 @@ $end
 		block_t* available_root = info->root_available_ + c_index;
 
 		// check if we already have a node we can use
-		void* v_node              = available_root->next_;
+		block_t* previous         = available_root;
+		if( set_get_numa_local(false) )
+			previous = numa_previous(available_root, cap_bytes);
+		void* v_node              = previous->next_;
 		block_t* node             = reinterpret_cast<block_t*>(v_node);
 		if( node != CPPAD_NULL )
 		{	CPPAD_ASSERT_UNKNOWN( node->tc_index_ == tc_index );
 
 			// remove node from available list
-			available_root->next_ = node->next_;
+			previous->next_       = node->next_;
 
 			// return value for get_memory
 			void* v_ptr = reinterpret_cast<void*>(node + 1);
@@ -837,8 +2046,9 @@ $end
 # endif
 
 			// adjust counts
-			inc_inuse(cap_bytes, thread);
-			dec_available(cap_bytes, thread);
+			inc_inuse(cap_bytes, thread, node->numa_);
+			dec_available(cap_bytes, thread, node->numa_);
+			stat_get(node, thread, c_index);
 
 			// return pointer to memory, do not inclue thread_alloc information
 			return v_ptr;
@@ -847,8 +2057,8 @@ $end
 		// Create a new node with thread_alloc information at front.
 		// This uses the system allocator, which is thread safe, but slower,
 		// because the thread might wait for a lock on the allocator.
-		v_node          = ::operator new(sizeof(block_t) + cap_bytes);
-		node            = reinterpret_cast<block_t*>(v_node);
+		node            = system_new(cap_bytes);
+		v_node          = reinterpret_cast<void*>(node);
 		node->tc_index_ = tc_index;
 		void* v_ptr     = reinterpret_cast<void*>(node + 1);
 
@@ -866,10 +2076,46 @@ $end
 # endif
 
 		// adjust counts
-		inc_inuse(cap_bytes, thread);
+		inc_inuse(cap_bytes, thread, node->numa_);
+		stat_get(node, thread, c_index);
 
 		return v_ptr;
 	}
+	/*!
+	Get memory from an arena (or from the thread_alloc pools).
+
+	\param min_bytes [in]
+	The minimum number of bytes of memory to be obtained for use.
+
+	\param cap_bytes [out]
+	The actual number of bytes of memory obtained for use.
+
+	\param arena [in]
+	is the arena that the memory is obtained from
+	(if it is null, the thread_alloc pools are used).
+
+	\return
+	pointer to the beginning of the memory allocated for use.
+	*/
+	static void* get_memory(
+		size_t min_bytes, size_t& cap_bytes, thread_alloc_arena* arena
+	)
+	{	if( arena == CPPAD_NULL )
+			return get_memory(min_bytes, cap_bytes);
+		CPPAD_ASSERT_KNOWN(
+			min_bytes < std::numeric_limits<size_t>::max() / 2 ,
+			"get_memory(min_bytes, cap_bytes): min_bytes is too large"
+		);
+		size_t num_cap = capacity_info()->number;
+		size_t c_index = 0;
+		const size_t* capacity_vec = capacity_info()->value;
+		while( capacity_vec[c_index] < min_bytes )
+		{	++c_index;
+			CPPAD_ASSERT_UNKNOWN(c_index < num_cap );
+		}
+		cap_bytes = capacity_vec[c_index];
+		return arena_get(arena, cap_bytes, c_index);
+	}
 
 /* -----------------------------------------------------------------------
 $begin ta_return_memory$$
@@ -907,6 +2153,19 @@ the corresponding call to $cref/get_memory/ta_get_memory/$$,
 or the current execution mode must be sequential
 (not $cref/parallel/ta_in_parallel/$$).
 
+$subhead C++11$$
+If C++11 is available, memory can also be returned by a different thread
+during parallel execution.
+In this case it is placed in a lock-free list for the thread that
+allocated it, and is returned to that thread's pool
+during its next call to $cref/get_memory/ta_get_memory/$$ for the same
+capacity (or the next call to
+$cref/free_available/ta_free_available/$$ or
+$cref/reset_peak/ta_statistics/reset_peak/$$ for that thread).
+The routines $cref/inuse/ta_inuse/$$, $cref/available/ta_available/$$,
+and the other $cref/statistics/ta_statistics/$$ routines
+count this memory as returned, but they do not change the lists.
+
 $head NDEBUG$$
 If $code NDEBUG$$ is defined, $icode v_ptr$$ is not checked (this is faster).
 Otherwise, a list of in use pointers is searched to make sure
@@ -932,6 +2191,8 @@ $end
 	We must either be in sequential (not parallel) execution mode,
 	or the current thread must be the same as for the corresponding call
 	to \c get_memory.
+	If C++11 is available, a different thread can return the memory
+	during parallel execution (see \c remote_push).
 	*/
 	static void return_memory(void* v_ptr)
 	{	size_t num_cap   = capacity_info()->number;
@@ -940,68 +2201,240 @@ $end
 		size_t tc_index  = node->tc_index_;
 		size_t thread    = tc_index / num_cap;
 		size_t c_index   = tc_index % num_cap;
-		size_t capacity  = capacity_info()->value[c_index];
+
+		// memory that was obtained from an arena
+		if( thread == CPPAD_MAX_NUM_THREADS )
+		{	arena_return(node, capacity_info()->value[c_index]);
+			return;
+		}
 
 		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
+# if CPPAD_USE_CPLUSPLUS_2011
+		// memory allocated by a different thread is returned to that thread
+		// during its next get_memory for this capacity
+		if( in_parallel() && thread != thread_num() )
+		{	remote_push(node, thread, c_index);
+			return;
+		}
+# else
 		CPPAD_ASSERT_KNOWN(
 			thread == thread_num() || (! in_parallel()),
 			"Attempt to return memory for a different thread "
 			"while in parallel mode"
 		);
+# endif
+		return_memory_owner(node, thread, c_index);
+	}
+/* -----------------------------------------------------------------------
+$begin ta_grow_memory$$
+$spell
+	num
+	ptr
+	thread_alloc
+	mmap
+	mremap
+	memcpy
+$$
 
-		thread_alloc_info* info = thread_info(thread);
-# ifndef NDEBUG
-# ifndef CPPAD_DEBUG_AND_RELEASE
-		// remove node from inuse list
-		void* v_node         = reinterpret_cast<void*>(node);
-		block_t* inuse_root  = info->root_inuse_ + c_index;
-		block_t* previous    = inuse_root;
-		while( (previous->next_ != CPPAD_NULL) & (previous->next_ != v_node) )
-			previous = reinterpret_cast<block_t*>(previous->next_);
+$section Increase the Capacity of Memory From thread_alloc$$
+
+$head Syntax$$
+$icode%new_ptr% = thread_alloc::grow_memory(
+	%v_ptr%, %keep_bytes%, %min_bytes%, %cap_bytes%
+)
+%$$
+$icode%new_ptr% = thread_alloc::grow_memory(
+	%v_ptr%, %keep_bytes%, %min_bytes%, %cap_bytes%, %arena%
+)%$$
+
+$head Purpose$$
+Obtain memory with capacity of at least $icode min_bytes$$
+that contains the first $icode keep_bytes$$ of the memory pointed to by
+$icode v_ptr$$, and return the memory pointed to by $icode v_ptr$$.
+
+$head v_ptr$$
+This argument has prototype
+$codei%
+	void* %v_ptr%
+%$$.
+It must be a pointer to memory that was obtained by
+$cref/get_memory/ta_get_memory/$$ (or $code grow_memory$$)
+and not yet returned.
+After this call, it is no longer in use and must not be returned.
+
+$head keep_bytes$$
+This argument has prototype
+$codei%
+	size_t %keep_bytes%
+%$$
+It must be less than or equal the capacity for $icode v_ptr$$
+and less than or equal $icode min_bytes$$.
+
+$head min_bytes$$
+This argument has prototype
+$codei%
+	size_t %min_bytes%
+%$$
+It is the minimum number of bytes of memory to be obtained for use.
+
+$head cap_bytes$$
+This argument has prototype
+$codei%
+	size_t& %cap_bytes%
+%$$
+Its input value does not matter.
+Upon return, it is the actual number of bytes (capacity)
+that have been obtained for use.
+
+$head arena$$
+If this argument is present, it has prototype
+$codei%
+	CppAD::thread_alloc_arena* %arena%
+%$$
+If it is not null, new memory (if any is required) is obtained
+from this $cref/arena/ta_arena/$$.
+Otherwise, if $icode v_ptr$$ was obtained from an arena,
+the new memory is obtained from the same arena,
+and if not, it is obtained from the $code thread_alloc$$ pools.
+
+$head new_ptr$$
+The return value $icode new_ptr$$ has prototype
+$codei%
+	void* %new_ptr%
+%$$
+It is the location where the $icode cap_bytes$$ of memory
+that have been obtained for use begin.
+The first $icode keep_bytes$$ of this memory are equal to the
+first $icode keep_bytes$$ of the memory at $icode v_ptr$$
+(before the call).
+
+$head Remapping$$
+If the memory at $icode v_ptr$$ was obtained using $code mmap$$
+(see $cref/huge pages/ta_get_memory/Huge Pages/$$),
+the Linux $code mremap$$ system call is available,
+$icode arena$$ is null,
+and the current thread allocated $icode v_ptr$$,
+the memory is grown in place (or its pages are moved to a new address).
+In this case the memory is not copied and
+twice the memory is not required during the operation.
+Otherwise, new memory is obtained using $code get_memory$$,
+$icode keep_bytes$$ are copied to the new memory using $code memcpy$$,
+and $icode v_ptr$$ is returned using
+$cref/return_memory/ta_return_memory/$$.
+
+$head Thread$$
+The same rules as for $code return_memory$$ apply to $icode v_ptr$$.
+
+$end
+*/
+	/*!
+	Increase the capacity of memory that was obtained by \c get_memory.
+
+	\param v_ptr [in]
+	Value of the pointer returned by \c get_memory and still in use.
+	After this call, this pointer must not be used.
+
+	\param keep_bytes [in]
+	Number of bytes at the beginning of the memory that are preserved.
+
+	\param min_bytes [in]
+	The minimum number of bytes of memory to be obtained for use.
+
+	\param cap_bytes [out]
+	The actual number of bytes of memory obtained for use.
+
+	\param arena [in]
+	if not null, is the arena that new memory is obtained from.
+	Otherwise new memory is obtained from the same place as v_ptr.
+
+	\return
+	pointer to the beginning of the memory allocated for use.
+	*/
+	static void* grow_memory(
+		void*               v_ptr              ,
+		size_t              keep_bytes         ,
+		size_t              min_bytes          ,
+		size_t&             cap_bytes          ,
+		thread_alloc_arena* arena = CPPAD_NULL )
+	{	size_t num_cap   = capacity_info()->number;
+		const size_t* capacity_vec = capacity_info()->value;
+
+		block_t* node    = reinterpret_cast<block_t*>(v_ptr) - 1;
+		size_t tc_index  = node->tc_index_;
+		size_t thread    = tc_index / num_cap;
+		size_t c_index   = tc_index % num_cap;
+		size_t capacity  = capacity_vec[c_index];
+		CPPAD_ASSERT_KNOWN(
+			keep_bytes <= capacity && keep_bytes <= min_bytes,
+			"grow_memory: keep_bytes > min_bytes or the capacity for v_ptr"
+		);
 
-		// check that v_ptr is valid
-		if( previous->next_ != v_node )
-		{	using std::endl;
-			std::ostringstream oss;
-			oss << "return_memory: attempt to return memory not in use";
-			oss << endl;
-			oss << "v_ptr    = " << v_ptr    << endl;
-			oss << "thread   = " << thread   << endl;
-			oss << "capacity = " << capacity << endl;
-			oss << "See CPPAD_TRACE_THREAD & CPPAD_TRACE_CAPACITY in";
-			oss << endl << "%# include <cppad/utility/thread_alloc.hpp>" << endl;
-			// oss.str() returns a string object with a copy of the current
-			// contents in the stream buffer.
-			std::string msg_str       = oss.str();
-			// msg_str.c_str() returns a pointer to the c-string
-			// representation of the string object's value.
-			const char* msg_char_star = msg_str.c_str();
-			CPPAD_ASSERT_KNOWN(false, msg_char_star );
+		// check if the current memory is large enough
+		if( min_bytes <= capacity )
+		{	cap_bytes = capacity;
+			return v_ptr;
 		}
-		// remove v_ptr from inuse list
-		previous->next_  = node->next_;
-# endif
-		// trace option
-		if( capacity==CPPAD_TRACE_CAPACITY && thread==CPPAD_TRACE_THREAD )
-		{	std::cout << "return_memory: v_ptr = " << v_ptr << std::endl; }
+# if CPPAD_THREAD_ALLOC_MREMAP
+		if( arena == CPPAD_NULL            &&
+		    thread < CPPAD_MAX_NUM_THREADS &&
+		    thread == thread_num()         &&
+		    system_huge(capacity)          )
+		{	// determine the new capacity
+			size_t new_index = c_index;
+			while( capacity_vec[new_index] < min_bytes )
+			{	++new_index;
+				CPPAD_ASSERT_UNKNOWN( new_index < num_cap );
+			}
+			cap_bytes = capacity_vec[new_index];
 
+			// remove node from the inuse list before its address changes
+			inuse_remove(node, thread, c_index);
+			stat_return(node, thread, c_index);
+			size_t numa    = node->numa_;
+			void*  old_raw = node->raw_;
+# ifndef NDEBUG
+			size_t offset  = size_t(
+				reinterpret_cast<char*>(node) - reinterpret_cast<char*>(old_raw)
+			);
 # endif
-		// capacity bytes are removed from the inuse pool
-		dec_inuse(capacity, thread);
-
-		// check for case where we just return the memory to the system
-		if( ! set_get_hold_memory(false) )
-		{	::operator delete( reinterpret_cast<void*>(node) );
-			return;
-		}
+			void* v_raw = mremap(
+				old_raw,
+				system_size(capacity),
+				system_size(cap_bytes),
+				MREMAP_MAYMOVE
+			);
+			if( v_raw == MAP_FAILED )
+			{	inuse_add(node, thread, c_index);
+				stat_get(node, thread, c_index);
+				throw std::bad_alloc();
+			}
+			// mmap memory is page aligned so the block has the same offset
+			block_t* new_node = system_align(v_raw, cap_bytes);
+			CPPAD_ASSERT_UNKNOWN(
+				reinterpret_cast<char*>(new_node) ==
+				reinterpret_cast<char*>(v_raw) + offset
+			);
+			new_node->tc_index_ = thread * num_cap + new_index;
+			inuse_add(new_node, thread, new_index);
 
-		// add this node to available list for this thread and capacity
-		block_t* available_root = info->root_available_ + c_index;
-		node->next_             = available_root->next_;
-		available_root->next_   = reinterpret_cast<void*>(node);
+			// adjust counts
+			dec_inuse(capacity, thread, numa);
+			inc_inuse(cap_bytes, thread, numa);
+			stat_get(new_node, thread, new_index);
 
-		// capacity bytes are added to the available pool
-		inc_available(capacity, thread);
+			return reinterpret_cast<void*>(new_node + 1);
+		}
+# endif
+		// memory from an arena is grown in the same arena
+		if( arena == CPPAD_NULL && thread == CPPAD_MAX_NUM_THREADS )
+			arena = static_cast<thread_alloc_arena*>(node->next_);
+
+		// get new memory, copy the bytes that are kept, return old memory
+		void* new_ptr = get_memory(min_bytes, cap_bytes, arena);
+		if( keep_bytes > 0 )
+			std::memcpy(new_ptr, v_ptr, keep_bytes);
+		return_memory(v_ptr);
+		return new_ptr;
 	}
 /* -----------------------------------------------------------------------
 $begin ta_free_available$$
@@ -1066,6 +2499,9 @@ $end
 			"while in parallel mode"
 		);
 
+		// memory returned by other threads is now available
+		remote_drain_all(thread);
+
 		size_t num_cap = capacity_info()->number;
 		if( num_cap == 0 )
 			return;
@@ -1079,10 +2515,9 @@ $end
 			while( v_ptr != CPPAD_NULL )
 			{	block_t* node = reinterpret_cast<block_t*>(v_ptr);
 				void* next    = node->next_;
-				::operator delete(v_ptr);
+				dec_available(capacity, thread, node->numa_);
+				system_delete(node, capacity);
 				v_ptr         = next;
-
-				dec_available(capacity, thread);
 			}
 			available_root->next_ = CPPAD_NULL;
 		}
@@ -1137,6 +2572,491 @@ $end
 	{	bool set = true;
 		set_get_hold_memory(set, value);
 	}
+/* -----------------------------------------------------------------------
+$begin ta_numa_local$$
+$spell
+	alloc
+	numa
+	mmap
+	mbind
+	getcpu
+$$
+
+$section Use Memory That is Local to the NUMA Node of a Thread$$
+
+$head Syntax$$
+$codei%thread_alloc::numa_local(%value%)
+%$$
+$icode%numa% = thread_alloc::numa_node()%$$
+
+$head Purpose$$
+On systems with more than one non-uniform memory access (NUMA) node,
+memory that was first touched by a thread running on one node
+is slower to access from the other nodes.
+The $cref/available/ta_available/$$ memory for a thread may have been
+first touched on a different node; e.g., if the
+thread number is used by a different system thread,
+or if the system moved the thread to a different processor.
+
+$head value$$
+If $icode value$$ is true,
+$cref/get_memory/ta_get_memory/$$ only uses available memory that is on
+the same NUMA node as the current thread.
+If there is no such memory, and the available memory was obtained using
+$code mmap$$ (see $cref/huge pages/ta_get_memory/Huge Pages/$$),
+it is moved to the current node using the Linux $code mbind$$ system call.
+Otherwise, new memory is obtained from the system
+(so that the current thread is the first to touch it)
+and the other memory remains available for use on its node.
+By default (when $code numa_local$$ has not been called)
+the node for available memory is not checked.
+This routine should only be called in sequential execution mode.
+
+$head numa$$
+The return value $icode numa$$ has prototype
+$codei%
+	size_t %numa%
+%$$
+It is the NUMA node for the processor that the current thread is
+running on (as determined by the Linux $code getcpu$$ system call).
+If this system call is not available, $icode numa$$ is zero.
+In order to avoid a system call for every memory request,
+the node is saved for each thread and only determined again
+after every $code 64$$ calls to $code numa_node$$
+(and when a $cref/thread number/ta_thread_num/$$ is reused).
+Nodes with an index greater than or equal 16 are reported as node 15.
+
+$head Statistics$$
+The memory that is in use, or available, for a thread and node can be
+determined using $cref/inuse/ta_inuse/$$ and
+$cref/available/ta_available/$$ with a $icode numa$$ argument.
+
+$end
+*/
+	/*!
+	Change the thread_alloc NUMA local memory setting.
+
+	\param value [in]
+	New value for the thread_alloc NUMA local memory setting.
+	*/
+	static void numa_local(bool value)
+	{	CPPAD_ASSERT_KNOWN(
+			! in_parallel(),
+			"numa_local: called in parallel execution mode."
+		);
+		bool set = true;
+		set_get_numa_local(set, value);
+	}
+	/*!
+	NUMA node for the processor that the current thread is running on.
+
+	\return
+	is the value saved for this thread, which is determined again using
+	numa_node_system after every numa_refresh calls.
+	*/
+	static size_t numa_node(void)
+	{	thread_alloc_info* info = thread_info( thread_num() );
+		if( info->numa_count_ == 0 )
+		{	info->numa_node_  = numa_node_system();
+			info->numa_count_ = numa_refresh;
+		}
+		--info->numa_count_;
+		return info->numa_node_;
+	}
+/* -----------------------------------------------------------------------
+$begin ta_arena$$
+$spell
+	alloc
+	num
+	ptr
+	bool
+	const
+	inuse
+	deallocate
+	Taylor
+$$
+
+$section Use a Memory Arena in Place of the thread_alloc Pools$$
+
+$head Syntax$$
+$codei%class %my_arena% : public CppAD::thread_alloc_arena {
+	%...%
+};
+%$$
+$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%, %arena%)
+%$$
+$icode%f%.set_arena(%arena%)%$$
+
+$head Purpose$$
+An arena can be used to obtain memory from a region
+that is managed by the user; e.g.,
+a bump allocator that is reset after each evaluation request,
+or a region that was reserved in advance.
+This avoids fragmenting the $code thread_alloc$$ pools and
+enables the memory for a request to be released in constant time.
+An arena is only used for the allocations that specify it;
+i.e., other memory used by CppAD is not affected.
+
+$head thread_alloc_arena$$
+The class $icode my_arena$$ must be derived from
+$code CppAD::thread_alloc_arena$$ and define the following
+virtual functions:
+
+$subhead allocate$$
+$codei%	void* %my_arena%::allocate(size_t %num_bytes%)
+%$$
+returns a pointer to at least $icode num_bytes$$ of memory
+(it must not return null).
+The memory does not need to have any alignment;
+$code thread_alloc$$ aligns the memory it returns.
+
+$subhead deallocate$$
+$codei%	void %my_arena%::deallocate(void* %v_ptr%, size_t %num_bytes%)
+%$$
+is called when $code thread_alloc$$ no longer needs memory that was
+obtained by $icode%v_ptr% = %my_arena%.allocate(%num_bytes%)%$$.
+(For a bump allocator this function need not do anything.)
+
+$head get_memory$$
+The $cref/arena/ta_get_memory/arena/$$ argument to $code get_memory$$
+obtains one allocation from an arena.
+
+$head ADFun$$
+The $cref/set_arena/fun_arena/$$ member function of an $code ADFun$$
+object uses an arena for its Taylor coefficients,
+partial derivatives, and forward Jacobian sparsity patterns.
+
+$head Returning Memory$$
+Memory obtained from an arena is returned to that arena
+by $cref/return_memory/ta_return_memory/$$.
+Hence all the objects that contain memory from an arena
+must be deleted (or have their memory freed) before the arena is reset
+or deleted.
+If memory from an arena may be returned by other threads,
+its $code deallocate$$ function must be thread safe.
+
+$head Statistics$$
+Memory obtained from an arena is not included in the
+$cref/inuse/ta_inuse/$$ and $cref/available/ta_available/$$ statistics.
+
+$head Example$$
+$children%
+	example/utility/thread_alloc_arena.cpp
+%$$
+The file $cref thread_alloc_arena.cpp$$ is an example and test
+that uses a bump allocator for an $code ADFun$$ object.
+
+$end
+*/
+
+/* -----------------------------------------------------------------------
+$begin ta_statistics$$
+$spell
+	alloc
+	num
+	inuse
+	enum
+	optimizer
+	Taylor
+	const
+$$
+
+$section Memory Allocation Statistics for a Thread$$
+
+$head Syntax$$
+$icode%old_tag% = thread_alloc::set_tag(%new_tag%)
+%$$
+$codei%thread_alloc::tag_scope %scope%(%new_tag%)
+%$$
+$icode%num_bytes% = thread_alloc::peak_inuse(%thread%)
+%$$
+$icode%num_bytes% = thread_alloc::tag_inuse(%thread%, %tag%)
+%$$
+$icode%num_bytes% = thread_alloc::tag_peak(%thread%, %tag%)
+%$$
+$codei%thread_alloc::reset_peak(%thread%)
+%$$
+$icode%num_cap% = thread_alloc::num_capacity()
+%$$
+$icode%cap_bytes% = thread_alloc::capacity(%c_index%)
+%$$
+$icode%count% = thread_alloc::num_get(%thread%, %c_index%)
+%$$
+$icode%count% = thread_alloc::num_return(%thread%, %c_index%)
+%$$
+
+$head Purpose$$
+These routines can be used to determine which parts of a program
+use the most memory, the high-water mark for the memory in use,
+and the distribution of the allocation sizes.
+
+$head thread$$
+This argument has prototype
+$codei%
+	size_t %thread%
+%$$
+Either $cref/thread_num/ta_thread_num/$$ must be the same as $icode thread$$,
+or the current execution mode must be sequential
+(not $cref/parallel/ta_in_parallel/$$).
+
+$head tag$$
+The arguments $icode tag$$, $icode new_tag$$, and the
+return value $icode old_tag$$ have type
+$code thread_alloc::tag_enum$$.
+The possible values, and the part of CppAD that uses each value, are:
+$table
+$icode tag$$              $cnext Memory used for $rnext
+$code general_tag$$       $cnext not in one of the cases below $rnext
+$code recorder_tag$$      $cnext recording an operation sequence $rnext
+$code taylor_tag$$        $cnext $cref Forward$$, $cref Reverse$$ and
+	$cref capacity_order$$ $rnext
+$code sparsity_tag$$      $cnext sparsity patterns and sparse derivatives $rnext
+$code optimize_tag$$      $cnext the $cref optimize$$ routine
+$tend
+The value $code thread_alloc::number_tag$$ is the number of possible tags
+(it is not a valid tag).
+
+$head set_tag$$
+Future calls to $cref/get_memory/ta_get_memory/$$ by the current thread
+are attributed to $icode new_tag$$
+and $icode old_tag$$ is the previous tag for the current thread.
+The tag for a thread starts out as $code general_tag$$.
+Memory is attributed to the tag that was in effect when it was obtained,
+even if it is returned when a different tag is in effect.
+
+$head tag_scope$$
+The constructor for $icode scope$$ sets the tag for the current thread
+to $icode new_tag$$ and its destructor restores the previous tag.
+CppAD uses this to tag the memory used by its routines; e.g.,
+the memory used for sparsity patterns during a call to
+$cref sparse_jac$$ has tag $code sparsity_tag$$.
+
+$head peak_inuse$$
+The return value $icode num_bytes$$ is the maximum, since the
+statistics for $icode thread$$ were reset, of the number of bytes
+$cref/inuse/ta_inuse/$$ by the thread.
+
+$head tag_inuse$$
+The return value $icode num_bytes$$ is the number of bytes
+in use by $icode thread$$ that are attributed to $icode tag$$.
+
+$head tag_peak$$
+The return value $icode num_bytes$$ is the maximum, since the
+statistics for $icode thread$$ were reset, of the value
+$icode%tag_inuse%(%thread%, %tag%)%$$.
+
+$head reset_peak$$
+This resets $icode peak_inuse$$ and $icode tag_peak$$ to their current
+in use values, and the $icode num_get$$ and $icode num_return$$ counts
+to zero, for the specified thread.
+This is the only routine that resets these statistics; e.g.,
+they are not changed by $cref/free_available/ta_free_available/$$.
+
+$head num_cap$$
+The return value $icode num_cap$$ has type $code size_t$$
+and is the number of different capacities that are used for
+memory allocations.
+
+$head c_index$$
+This argument has prototype
+$codei%
+	size_t %c_index%
+%$$
+and must be less than $icode num_cap$$.
+It identifies one of the capacities.
+
+$head cap_bytes$$
+The return value $icode cap_bytes$$ has type $code size_t$$.
+It is the number of bytes for the capacity with index $icode c_index$$.
+The capacities are increasing with $icode c_index$$.
+
+$head num_get$$
+The return value $icode count$$ has type $code size_t$$.
+It is the number of calls to $code get_memory$$ by $icode thread$$
+that returned memory with capacity $icode cap_bytes$$.
+
+$head num_return$$
+The return value $icode count$$ has type $code size_t$$.
+It is the number of blocks of memory, that were obtained by
+$icode thread$$ and have capacity $icode cap_bytes$$,
+that have been returned using $cref/return_memory/ta_return_memory/$$.
+Memory that is returned by a different thread during parallel execution
+is counted when $code return_memory$$ is called
+(before it is moved to the pool for $icode thread$$); see
+$cref/C++11/ta_return_memory/Thread/C++11/$$.
+
+$head Arena$$
+Memory obtained from an $cref/arena/ta_arena/$$ is not included in
+these statistics.
+
+$end
+*/
+	/*!
+	Change the tag that is used for the memory allocated by the current thread.
+
+	\param new_tag [in]
+	is the new tag for the current thread.
+
+	\return
+	is the tag for the current thread before this call.
+	*/
+	static tag_enum set_tag(tag_enum new_tag)
+	{	CPPAD_ASSERT_KNOWN(
+			new_tag < number_tag,
+			"set_tag(new_tag): new_tag is not a valid tag"
+		);
+		size_t* tag      = thread_tag() + thread_num();
+		tag_enum old_tag = tag_enum(*tag);
+		*tag             = size_t(new_tag);
+		return old_tag;
+	}
+	/// sets the tag for the current thread while an object of this class exists
+	class tag_scope {
+	private:
+		/// tag before this object was constructed
+		const tag_enum old_tag_;
+	public:
+		/// set the tag for the current thread
+		tag_scope(tag_enum new_tag) : old_tag_( set_tag(new_tag) )
+		{ }
+		/// restore the previous tag
+		~tag_scope(void)
+		{	set_tag(old_tag_); }
+	};
+	/*!
+	Maximum amount of memory that has been inuse.
+
+	\copydetails inuse
+	*/
+	static size_t peak_inuse(size_t thread)
+	{	CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		return thread_stat(thread)->count_peak_;
+	}
+	/*!
+	Amount of memory that is inuse and attributed to a tag.
+
+	\copydetails inuse
+
+	\param tag [in]
+	is the tag (must be less than number_tag).
+	*/
+	static size_t tag_inuse(size_t thread, tag_enum tag)
+	{	CPPAD_ASSERT_KNOWN(
+			tag < number_tag,
+			"tag_inuse(thread, tag): tag is not a valid tag"
+		);
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		// memory in the remote lists has been returned
+		size_t remote = remote_bytes(thread, CPPAD_MAX_NUM_NUMA, tag);
+		return thread_stat(thread)->count_tag_inuse_[tag] - remote;
+	}
+	/*!
+	Maximum amount of memory that has been inuse and attributed to a tag.
+
+	\copydetails tag_inuse
+	*/
+	static size_t tag_peak(size_t thread, tag_enum tag)
+	{	CPPAD_ASSERT_KNOWN(
+			tag < number_tag,
+			"tag_peak(thread, tag): tag is not a valid tag"
+		);
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		return thread_stat(thread)->count_tag_peak_[tag];
+	}
+	/*!
+	Reset the peak memory and histogram statistics for a thread.
+
+	\param thread [in]
+	is the thread for the statistics.
+	During parallel execution, this must be the thread
+	that is currently executing.
+	*/
+	static void reset_peak(size_t thread)
+	{	CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		// so that memory in the remote lists is not counted after the reset
+		remote_drain_all(thread);
+		thread_stat_t* stat = thread_stat(thread);
+		stat->count_peak_   = thread_info(thread)->count_inuse_;
+		for(size_t k = 0; k < number_tag; k++)
+			stat->count_tag_peak_[k] = stat->count_tag_inuse_[k];
+		for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
+		{	stat->num_get_[c]    = 0;
+			stat->num_return_[c] = 0;
+		}
+	}
+	/// number of capacities used by thread_alloc
+	static size_t num_capacity(void)
+	{	return capacity_info()->number; }
+	/*!
+	A capacity used by thread_alloc.
+
+	\param c_index [in]
+	is the index of the capacity (must be less than num_capacity()).
+
+	\return
+	is the number of bytes for this capacity.
+	*/
+	static size_t capacity(size_t c_index)
+	{	CPPAD_ASSERT_KNOWN(
+			c_index < capacity_info()->number,
+			"capacity(c_index): c_index >= num_capacity()"
+		);
+		return capacity_info()->value[c_index];
+	}
+	/*!
+	Number of get_memory calls by a thread for one capacity.
+
+	\copydetails inuse
+
+	\param c_index [in]
+	is the index of the capacity (must be less than num_capacity()).
+	*/
+	static size_t num_get(size_t thread, size_t c_index)
+	{	CPPAD_ASSERT_KNOWN(
+			c_index < capacity_info()->number,
+			"num_get(thread, c_index): c_index >= num_capacity()"
+		);
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		return thread_stat(thread)->num_get_[c_index];
+	}
+	/*!
+	Number of blocks of memory returned to a thread for one capacity.
+
+	\copydetails num_get
+	*/
+	static size_t num_return(size_t thread, size_t c_index)
+	{	CPPAD_ASSERT_KNOWN(
+			c_index < capacity_info()->number,
+			"num_return(thread, c_index): c_index >= num_capacity()"
+		);
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		size_t count = thread_stat(thread)->num_return_[c_index];
+# if CPPAD_USE_CPLUSPLUS_2011
+		// memory in the remote lists has been returned
+		count += remote_count(
+			thread, c_index, CPPAD_MAX_NUM_NUMA, number_tag
+		);
+# endif
+		return count;
+	}
 
 /* -----------------------------------------------------------------------
 $begin ta_inuse$$
@@ -1144,6 +3064,7 @@ $spell
 	num
 	inuse
 	thread_alloc
+	numa
 $$
 
 $section Amount of Memory a Thread is Currently Using$$
@@ -1151,7 +3072,9 @@ $mindex inuse$$
 
 
 $head Syntax$$
-$icode%num_bytes% = thread_alloc::inuse(%thread%)%$$
+$icode%num_bytes% = thread_alloc::inuse(%thread%)
+%$$
+$icode%num_bytes% = thread_alloc::inuse(%thread%, %numa%)%$$
 
 $head Purpose$$
 Memory being managed by $cref thread_alloc$$ has two states,
@@ -1174,6 +3097,21 @@ $codei%
 	size_t %num_bytes%
 %$$
 It is the number of bytes currently in use by the specified thread.
+This routine does not change the memory pools; e.g.,
+memory that was returned by a different thread
+(see $cref/C++11/ta_return_memory/Thread/C++11/$$)
+is not counted as in use even if it has not yet been moved
+to the pool for the specified thread.
+
+$head numa$$
+If this argument is present, it has prototype
+$codei%
+	size_t %numa%
+%$$
+and must be less than 16.
+In this case $icode num_bytes$$ is the number of bytes in use
+by the specified thread that are on the specified
+$cref/NUMA node/ta_numa_local/numa/$$.
 
 $head Example$$
 $cref thread_alloc.cpp$$
@@ -1198,21 +3136,47 @@ $end
 		CPPAD_ASSERT_UNKNOWN(
 			thread == thread_num() || (! in_parallel())
 		);
+		// memory in the remote lists has been returned
+		size_t remote = remote_bytes(thread, CPPAD_MAX_NUM_NUMA, number_tag);
 		thread_alloc_info* info = thread_info(thread);
-		return info->count_inuse_;
+		return info->count_inuse_ - remote;
+	}
+	/*!
+	Determine the amount of memory that is currently inuse
+	and on a NUMA node.
+
+	\copydetails inuse
+
+	\param numa [in]
+	is the NUMA node (must be less than CPPAD_MAX_NUM_NUMA).
+	*/
+	static size_t inuse(size_t thread, size_t numa)
+	{	CPPAD_ASSERT_KNOWN(
+			numa < CPPAD_MAX_NUM_NUMA,
+			"inuse(thread, numa): numa is too large"
+		);
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		size_t remote = remote_bytes(thread, numa, number_tag);
+		return thread_info(thread)->count_inuse_numa_[numa] - remote;
 	}
 /* -----------------------------------------------------------------------
 $begin ta_available$$
 $spell
 	num
 	thread_alloc
+	numa
 $$
 
 $section Amount of Memory Available for Quick Use by a Thread$$
 
 
 $head Syntax$$
-$icode%num_bytes% = thread_alloc::available(%thread%)%$$
+$icode%num_bytes% = thread_alloc::available(%thread%)
+%$$
+$icode%num_bytes% = thread_alloc::available(%thread%, %numa%)%$$
 
 $head Purpose$$
 Memory being managed by $cref thread_alloc$$ has two states,
@@ -1235,6 +3199,22 @@ $codei%
 	size_t %num_bytes%
 %$$
 It is the number of bytes currently available for use by the specified thread.
+This routine does not change the memory pools; e.g.,
+if $cref/hold_memory/ta_hold_memory/$$ is true,
+memory that was returned by a different thread
+(see $cref/C++11/ta_return_memory/Thread/C++11/$$)
+is counted as available even if it has not yet been moved
+to the pool for the specified thread.
+
+$head numa$$
+If this argument is present, it has prototype
+$codei%
+	size_t %numa%
+%$$
+and must be less than 16.
+In this case $icode num_bytes$$ is the number of bytes available
+for the specified thread that are on the specified
+$cref/NUMA node/ta_numa_local/numa/$$.
 
 $head Example$$
 $cref thread_alloc.cpp$$
@@ -1252,8 +3232,35 @@ $end
 		CPPAD_ASSERT_UNKNOWN(
 			thread == thread_num() || (! in_parallel())
 		);
+		// memory in the remote lists is held for this thread
+		size_t remote = 0;
+		if( set_get_hold_memory(false) )
+			remote = remote_bytes(thread, CPPAD_MAX_NUM_NUMA, number_tag);
 		thread_alloc_info* info = thread_info(thread);
-		return info->count_available_;
+		return info->count_available_ + remote;
+	}
+	/*!
+	Determine the amount of memory that is currently available for use
+	and on a NUMA node.
+
+	\copydetails inuse
+
+	\param numa [in]
+	is the NUMA node (must be less than CPPAD_MAX_NUM_NUMA).
+	*/
+	static size_t available(size_t thread, size_t numa)
+	{	CPPAD_ASSERT_KNOWN(
+			numa < CPPAD_MAX_NUM_NUMA,
+			"available(thread, numa): numa is too large"
+		);
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		size_t remote = 0;
+		if( set_get_hold_memory(false) )
+			remote = remote_bytes(thread, numa, number_tag);
+		return thread_info(thread)->count_available_numa_[numa] + remote;
 	}
 /* -----------------------------------------------------------------------
 $begin ta_create_array$$
@@ -1521,4 +3528,8 @@ $end
 # undef CPPAD_MIN_DOUBLE_CAPACITY
 # undef CPPAD_TRACE_CAPACITY
 # undef CPPAD_TRACE_THREAD
+# undef CPPAD_THREAD_ALLOC_ALIGN
+# undef CPPAD_THREAD_ALLOC_MMAP
+# undef CPPAD_THREAD_ALLOC_MREMAP
+# undef CPPAD_THREAD_ALLOC_NUMA
 # endif
@@ -0,0 +1,477 @@
+# ifndef CPPAD_UTILITY_THREAD_TEAM_HPP
+# define CPPAD_UTILITY_THREAD_TEAM_HPP
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin thread_team$$
+$spell
+	const
+	hpp
+	num
+	ptr
+	bool
+	std
+	alloc
+	nx
+	ny
+	xk
+	lambda
+	pthread
+$$
+
+$section A Team of Threads That Evaluate in Parallel$$
+
+$head Syntax$$
+$codei%# include <cppad/utility/thread_team.hpp>
+%$$
+$codei%thread_team %team%(%num_threads%)
+%$$
+$icode%num_threads% = %team%.num_threads()
+%$$
+$icode%team%.parallel_for(%n%, %body%)
+%$$
+$icode%team%.forward_batch(%f%, %x%, %y%)
+%$$
+
+$head Purpose$$
+The $cref team_thread.hpp$$ specifications are implemented
+by each user, using their threading system, as part of the
+$cref thread_test.cpp$$ examples.
+If the C++11 standard library threads are acceptable,
+this class can be used instead.
+It takes care of the $cref/parallel_setup/ta_parallel_setup/$$,
+thread numbering, and work splitting.
+
+$head C++11$$
+This class is only defined when
+$code CPPAD_USE_CPLUSPLUS_2011$$ is true.
+One may need to link with a threading library; e.g., using the
+$code -pthread$$ compiler flag.
+
+$head Restrictions$$
+Only one $code thread_team$$ object can exist at a time.
+It must be constructed, used, and destroyed by the master thread
+in sequential execution mode; i.e.,
+$cref/in_parallel/ta_in_parallel/$$ is false.
+It cannot be used at the same time as other threading systems
+that use $code thread_alloc::parallel_setup$$.
+
+$head team$$
+The constructor for $icode team$$ creates $icode%num_threads% - 1%$$
+new threads that wait until $code parallel_for$$ or
+$code forward_batch$$ is called.
+It then calls
+$codei%
+	thread_alloc::parallel_setup(%num_threads%, %in_parallel%, %thread_num%)
+%$$
+where $icode in_parallel$$ is true while the team is working
+and $icode thread_num$$ is zero for the master thread and between
+one and $icode%num_threads% - 1%$$ for the other threads.
+The destructor for $icode team$$ terminates the other threads,
+frees their $cref/available/ta_available/$$ memory,
+and returns $code thread_alloc$$ to one thread.
+
+$head num_threads$$
+This is the number of threads in the team
+(including the master thread).
+It has type $code size_t$$, must be greater than zero,
+and must not be greater than
+$cref/CPPAD_MAX_NUM_THREADS/multi_thread/CPPAD_MAX_NUM_THREADS/$$.
+
+$head parallel_for$$
+This executes
+$codei%
+	%body%(%i%)
+%$$
+for $icode%i% = 0 , %...% , %n%-1%$$ using all the threads in the team
+and returns when they are all done.
+The argument $icode n$$ has type $code size_t$$ and the argument
+$icode body$$ has prototype
+$codei%
+	const %Body%& %body%
+%$$
+where $icode Body$$ is a function object type (e.g., a lambda)
+with a $code const$$ $codei%void operator()(size_t %i%)%$$.
+The value of $icode i$$ has type $code size_t$$.
+The different calls to $icode body$$ must not depend on each other
+and must be safe to run in parallel.
+
+$subhead Work Stealing$$
+Each thread starts with an equal share of the indices.
+When a thread is done with its share,
+it takes indices that have not yet been started from the other threads.
+This keeps all the threads busy when the cost of the different indices
+is not the same.
+
+$subhead Exceptions$$
+If $icode body$$ throws an exception,
+one of the exceptions is thrown by $code parallel_for$$
+after all the threads are done.
+
+$subhead AD Types$$
+If $icode body$$ uses $codei%AD<%Base%>%$$ objects,
+$cref/parallel_ad<Base>()/parallel_ad/$$ must be called after
+$icode team$$ is constructed and before $code parallel_for$$.
+
+$head forward_batch$$
+This evaluates a function for a batch of arguments in parallel.
+
+$subhead f$$
+The argument $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%>& %f%
+%$$
+Each thread uses its own copy of $icode f$$
+(and $code parallel_ad<%Base%>%$$ is called by $code forward_batch$$).
+
+$subhead x$$
+The argument $icode x$$ has prototype
+$codei%
+	const %VectorBase%& %x%
+%$$
+where $icode VectorBase$$ is a $cref SimpleVector$$ class
+with elements of type $icode Base$$.
+Its size is $icode%N% * %nx%$$ where $icode nx$$ is the
+domain dimension for $icode f$$ and $icode N$$ is the number of
+arguments in the batch.
+For $icode%k% = 0 , %...% , %N%-1%$$ the $th k$$ argument is
+$codei%
+	%xk%[%j%] = %x%[ %k% * %nx% + %j% ]
+%$$
+for $icode%j% = 0 , %...% , %nx%-1%$$.
+
+$subhead y$$
+The argument $icode y$$ has prototype
+$codei%
+	%VectorBase%& %y%
+%$$
+Its input value does not matter.
+Upon return it has size $icode%N% * %ny%$$ where $icode ny$$
+is the range dimension for $icode f$$ and
+$codei%
+	%y%[ %k% * %ny% + %i% ] = %f%.Forward(0, %xk%)[%i%]
+%$$
+for $icode%i% = 0 , %...% , %ny%-1%$$.
+Different threads write to different elements of $icode y$$ at the same
+time, so $icode VectorBase$$ cannot be a packed vector like
+$code std::vector<bool>$$.
+
+$children%
+	example/utility/thread_team.cpp
+%$$
+$head Example$$
+The file $cref thread_team.cpp$$ contains an example and test
+of this class.
+
+$end
+*/
+# include <cppad/configure.hpp>
+# include <cppad/utility/thread_alloc.hpp>
+# include <cppad/utility/check_simple_vector.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <functional>
+# include <exception>
+# include <atomic>
+# include <vector>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file thread_team.hpp
+A team of C++11 threads that evaluate in parallel.
+*/
+
+// defined in cppad/core
+template <class Base> class ADFun;
+template <class Base> void parallel_ad(void);
+
+/*!
+A team of C++11 threads that evaluate in parallel.
+*/
+class thread_team {
+private:
+	/// range of indices that a thread has not yet started
+	struct range_t {
+		/// next index to start (may be greater than end_)
+		std::atomic<size_t> next_;
+		/// end of the range
+		size_t              end_;
+		/// put each range in a different cache line
+		char                pad_[64];
+	};
+	// ------------------------------------------------------------------------
+	/// is the team currently working
+	static std::atomic<bool>& running(void)
+	{	static std::atomic<bool> value(false);
+		return value;
+	}
+	/// is there a team that has not been destroyed
+	static bool& exists(void)
+	{	static bool value = false;
+		return value;
+	}
+	/// thread number for the current thread
+	static size_t& thread_number(void)
+	{	static thread_local size_t value = 0;
+		return value;
+	}
+	/// in_parallel function passed to thread_alloc::parallel_setup
+	static bool team_in_parallel(void)
+	{	return running(); }
+	/// thread_num function passed to thread_alloc::parallel_setup
+	static size_t team_thread_num(void)
+	{	return thread_number(); }
+	// ------------------------------------------------------------------------
+	/// number of threads in the team
+	const size_t                     num_threads_;
+	/// the threads other than the master thread
+	std::vector<std::thread>         worker_;
+	/// mutex that protects the values below
+	std::mutex                       mutex_;
+	/// notify the other threads that there is a new job (or to stop)
+	std::condition_variable          start_;
+	/// notify the master thread that the other threads are done
+	std::condition_variable          done_;
+	/// incremented for each new job
+	size_t                           generation_;
+	/// number of other threads that are done with the current job
+	size_t                           num_done_;
+	/// should the other threads terminate
+	bool                             stop_;
+	/// the current job (its argument is the thread number)
+	std::function<void(size_t)>      job_;
+	/// first exception thrown during the current job
+	std::exception_ptr               error_;
+	// ------------------------------------------------------------------------
+	/*!
+	Run the current job for a thread and record an exception (if any).
+
+	\param thread [in]
+	is the thread number for the current thread.
+	*/
+	void run_job(size_t thread)
+	{	try
+		{	job_(thread); }
+		catch(...)
+		{	std::lock_guard<std::mutex> lock(mutex_);
+			if( ! error_ )
+				error_ = std::current_exception();
+		}
+	}
+	/*!
+	Loop for the threads other than the master thread.
+
+	\param thread [in]
+	is the thread number for this thread (greater than zero).
+	*/
+	void worker_loop(size_t thread)
+	{	thread_number()   = thread;
+		size_t generation = 0;
+		while( true )
+		{	{	std::unique_lock<std::mutex> lock(mutex_);
+				while( ! stop_ && generation == generation_ )
+					start_.wait(lock);
+				if( stop_ )
+					return;
+				generation = generation_;
+			}
+			run_job(thread);
+			{	std::lock_guard<std::mutex> lock(mutex_);
+				if( ++num_done_ + 1 == num_threads_ )
+					done_.notify_one();
+			}
+		}
+	}
+	/*!
+	Run a job on all the threads in the team and wait for it to finish.
+
+	\param job [in]
+	is called with each thread number (during parallel execution).
+	If it throws an exception, one of the exceptions is rethrown
+	after all the threads are done.
+	*/
+	void run(const std::function<void(size_t)>& job)
+	{	CPPAD_ASSERT_KNOWN(
+			! running(),
+			"thread_team: cannot be used during parallel execution"
+		);
+		{	std::lock_guard<std::mutex> lock(mutex_);
+			job_      = job;
+			error_    = std::exception_ptr();
+			num_done_ = 0;
+			++generation_;
+			running() = true;
+		}
+		start_.notify_all();
+		run_job(0);
+		{	std::unique_lock<std::mutex> lock(mutex_);
+			while( num_done_ + 1 < num_threads_ )
+				done_.wait(lock);
+			running() = false;
+			job_      = std::function<void(size_t)>();
+		}
+		if( error_ )
+			std::rethrow_exception(error_);
+	}
+public:
+	/*!
+	Create a team of threads and set up thread_alloc for the team.
+
+	\param num_threads [in]
+	is the number of threads in the team (including the master thread).
+	*/
+	thread_team(size_t num_threads)
+	: num_threads_(num_threads)
+	, generation_(0)
+	, num_done_(0)
+	, stop_(false)
+	{	CPPAD_ASSERT_KNOWN(
+			0 < num_threads && num_threads <= CPPAD_MAX_NUM_THREADS,
+			"thread_team: num_threads is zero or "
+			"greater than CPPAD_MAX_NUM_THREADS"
+		);
+		CPPAD_ASSERT_KNOWN(
+			! thread_alloc::in_parallel(),
+			"thread_team: constructor called in parallel execution mode"
+		);
+		CPPAD_ASSERT_KNOWN(
+			! exists(),
+			"thread_team: only one team can exist at a time"
+		);
+		exists() = true;
+		thread_alloc::parallel_setup(
+			num_threads, team_in_parallel, team_thread_num
+		);
+		for(size_t thread = 1; thread < num_threads; ++thread)
+			worker_.push_back(
+				std::thread(&thread_team::worker_loop, this, thread)
+			);
+	}
+	/// terminate the other threads and return thread_alloc to one thread
+	~thread_team(void)
+	{	{	std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		start_.notify_all();
+		for(size_t k = 0; k < worker_.size(); ++k)
+			worker_[k].join();
+		for(size_t thread = 1; thread < num_threads_; ++thread)
+			thread_alloc::free_available(thread);
+		thread_alloc::parallel_setup(1, CPPAD_NULL, CPPAD_NULL);
+		exists() = false;
+	}
+	/// number of threads in the team
+	size_t num_threads(void) const
+	{	return num_threads_; }
+	/*!
+	Execute body(i) for i = 0, ..., n-1 in parallel.
+
+	\param n [in]
+	is the number of indices.
+
+	\param body [in]
+	is the function object that is called for each index.
+	*/
+	template <class Body>
+	void parallel_for(size_t n, const Body& body)
+	{	if( n == 0 )
+			return;
+		// initial range for each thread
+		std::vector<range_t> range(num_threads_);
+		for(size_t thread = 0; thread < num_threads_; ++thread)
+		{	range[thread].next_ = (n * thread) / num_threads_;
+			range[thread].end_  = (n * (thread + 1)) / num_threads_;
+		}
+		range_t* range_ptr = range.data();
+		size_t   num_range = num_threads_;
+		//
+		// start with the range for this thread, then steal from the others
+		std::function<void(size_t)> job = [=, &body](size_t thread)
+		{	for(size_t k = 0; k < num_range; ++k)
+			{	range_t& r = range_ptr[ (thread + k) % num_range ];
+				size_t i   = r.next_.fetch_add(1);
+				while( i < r.end_ )
+				{	body(i);
+					i = r.next_.fetch_add(1);
+				}
+			}
+		};
+		run(job);
+	}
+	/*!
+	Evaluate zero order forward mode for a batch of arguments in parallel.
+
+	\tparam Base
+	is the base type for the recording in f.
+
+	\tparam VectorBase
+	is a simple vector class with elements of type Base.
+
+	\param f [in]
+	is the function that is evaluated (each thread uses a copy of f).
+
+	\param x [in]
+	is the batch of arguments; size N * f.Domain().
+
+	\param y [out]
+	is the batch of results; size N * f.Range().
+	*/
+	template <class Base, class VectorBase>
+	void forward_batch(
+		const ADFun<Base>& f ,
+		const VectorBase&  x ,
+		VectorBase&        y )
+	{	size_t nx = f.Domain();
+		size_t ny = f.Range();
+		CPPAD_ASSERT_KNOWN(
+			nx > 0 && x.size() % nx == 0,
+			"thread_team::forward_batch: x.size() is not a multiple of "
+			"f.Domain()"
+		);
+		size_t N = x.size() / nx;
+		y.resize(N * ny);
+		parallel_ad<Base>();
+		CheckSimpleVector<Base, VectorBase>();
+		//
+		// copy of f for each thread (made by the thread that uses it)
+		std::vector< ADFun<Base> > g(num_threads_);
+		std::vector<char>          copied(num_threads_, 0);
+		ADFun<Base>*               g_ptr      = g.data();
+		char*                      copied_ptr = copied.data();
+		const ADFun<Base>*         f_ptr      = &f;
+		const VectorBase*          x_ptr      = &x;
+		VectorBase*                y_ptr      = &y;
+		//
+		// one evaluation of f
+		parallel_for(N, [=](size_t k)
+		{	size_t thread = thread_number();
+			if( ! copied_ptr[thread] )
+			{	g_ptr[thread]      = *f_ptr;
+				copied_ptr[thread] = 1;
+			}
+			VectorBase xk(nx), yk;
+			for(size_t j = 0; j < nx; ++j)
+				xk[j] = (*x_ptr)[ k * nx + j ];
+			yk = g_ptr[thread].Forward(0, xk);
+			for(size_t i = 0; i < ny; ++i)
+				(*y_ptr)[ k * ny + i ] = yk[i];
+		});
+	}
+};
+
+} // END_CPPAD_NAMESPACE
+
+# endif // CPPAD_USE_CPLUSPLUS_2011
+# endif
@@ -26,6 +26,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 
 // external complied tests
 extern bool checkpoint(void);
+extern bool checkpoint_thread(void);
 extern bool eigen_cholesky(void);
 extern bool eigen_mat_inv(void);
 extern bool eigen_mat_mul(void);
@@ -55,6 +56,7 @@ int main(void)
 
 	// external compiled tests
 	Run( checkpoint,          "checkpoint"     );
+	Run( checkpoint_thread,   "checkpoint_thread" );
 	Run( extended_ode,        "extended_ode"   );
 	Run( for_sparse_hes,      "for_sparse_hes" );
 	Run( for_sparse_jac,      "for_sparse_jac" );
@@ -0,0 +1,151 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin checkpoint_thread.cpp$$
+$spell
+	checkpointing
+$$
+
+$section Checkpointing in Parallel Mode: Example and Test$$
+
+$head Purpose$$
+This example uses one checkpoint function object,
+for the function $latex G : \B{R}^2 \rightarrow \B{R}^2$$ defined by
+$latex \[
+	G(x) = \left( \begin{array}{c}
+		x_0 \cdot x_1
+		\\
+		\sin( x_0 )
+	\end{array} \right)
+\] $$
+from all the threads in a $cref thread_team$$ at the same time.
+Each thread records its own functions that use the checkpoint function,
+and computes function values, derivatives, and sparsity patterns
+for these functions.
+The operation sequence for $latex G$$ is only stored once.
+
+$code
+$srcfile%example/atomic/checkpoint_thread.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <cppad/utility/thread_team.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+namespace {
+	using CppAD::AD;
+	typedef CPPAD_TESTVECTOR(AD<double>) ADVector;
+
+	void g_algo(const ADVector& ax, ADVector& ay)
+	{	ay[0] = ax[0] * ax[1];
+		ay[1] = sin( ax[0] );
+	}
+	// function values, Jacobian, and Jacobian sparsity at x
+	// for a function that uses the checkpoint function
+	void compute(
+		CppAD::checkpoint<double>& g_check ,
+		const CPPAD_TESTVECTOR(double)& x  ,
+		CPPAD_TESTVECTOR(double)&       y  ,
+		CPPAD_TESTVECTOR(double)&       jac,
+		CppAD::vectorBool&              pattern )
+	{	size_t n = 2, m = 2;
+		ADVector ax(n), ay(m);
+		for(size_t j = 0; j < n; j++)
+			ax[j] = x[j];
+		CppAD::Independent(ax);
+		g_check(ax, ay);
+		CppAD::ADFun<double> f(ax, ay);
+		//
+		y   = f.Forward(0, x);
+		jac = f.Jacobian(x);
+		CppAD::vectorBool r(n * n);
+		for(size_t i = 0; i < n; i++)
+			for(size_t j = 0; j < n; j++)
+				r[i * n + j] = i == j;
+		pattern = f.ForSparseJac(n, r);
+	}
+}
+
+bool checkpoint_thread(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+	size_t n = 2, m = 2;
+	//
+	// number of argument values and number of threads
+	size_t N           = 100;
+	size_t num_threads = 4;
+	{	// results for each argument value
+		std::vector< CPPAD_TESTVECTOR(double) > x(N), y(N), jac(N);
+		std::vector< CppAD::vectorBool > pattern(N);
+		for(size_t k = 0; k < N; k++)
+		{	x[k].resize(n);
+			x[k][0] = double(k) / double(N);
+			x[k][1] = double(k + 1);
+		}
+		//
+		// checkpoint version of G(x)
+		ADVector ax(n), ay(m);
+		ax[0] = 0.0;
+		ax[1] = 0.0;
+		CppAD::checkpoint<double> g_check("g_check", g_algo, ax, ay);
+		//
+		// Compute the first result in sequential mode. This also initializes
+		// static variables that are used by the calculations.
+		compute(g_check, x[0], y[0], jac[0], pattern[0]);
+		//
+		// compute the rest of the results using the same checkpoint object
+		// from all the threads at the same time
+		{	CppAD::thread_team team(num_threads);
+			CppAD::parallel_ad<double>();
+			team.parallel_for(N - 1, [&](size_t i)
+			{	size_t k = i + 1;
+				compute(g_check, x[k], y[k], jac[k], pattern[k]);
+			});
+		}
+		// back to sequential execution mode
+		ok &= thread_alloc::num_threads() == 1;
+		//
+		// check the results
+		for(size_t k = 0; k < N; k++)
+		{	double x0 = x[k][0];
+			double x1 = x[k][1];
+			double c0 = std::cos(x0);
+			ok &= CppAD::NearEqual(y[k][0], x0 * x1, eps, eps);
+			ok &= CppAD::NearEqual(y[k][1], std::sin(x0), eps, eps);
+			//
+			ok &= CppAD::NearEqual(jac[k][0 * n + 0], x1, eps, eps);
+			ok &= CppAD::NearEqual(jac[k][0 * n + 1], x0, eps, eps);
+			ok &= CppAD::NearEqual(jac[k][1 * n + 0], c0, eps, eps);
+			ok &= jac[k][1 * n + 1] == 0.0;
+			//
+			ok &= pattern[k][0 * n + 0] == true;
+			ok &= pattern[k][0 * n + 1] == true;
+			ok &= pattern[k][1 * n + 0] == true;
+			ok &= pattern[k][1 * n + 1] == false;
+		}
+	}
+	// g_check, and the results, have been deleted so the other threads
+	// are not using any memory
+	for(size_t thread = 1; thread < num_threads; thread++)
+		ok &= thread_alloc::inuse(thread) == 0;
+	//
+	return ok;
+}
+# else
+bool checkpoint_thread(void)
+{	return true; }
+# endif
+// END C++
@@ -110,11 +110,13 @@ extern bool log1p(void);
 extern bool log(void);
 extern bool LuRatio(void);
 extern bool LuVecADOk(void);
+extern bool memory_checkpoint(void);
 extern bool MulEq(void);
 extern bool mul_level_adolc_ode(void);
 extern bool mul_level_adolc(void);
 extern bool mul_level_ode(void);
 extern bool mul_level(void);
+extern bool multi_start_newton(void);
 extern bool Mul(void);
 extern bool NearEqualExt(void);
 extern bool new_dynamic(void);
@@ -129,6 +131,7 @@ extern bool Poly(void);
 extern bool pow_int(void);
 extern bool pow(void);
 extern bool print_for(void);
+extern bool reroll(void);
 extern bool reverse_any(void);
 extern bool reverse_one(void);
 extern bool reverse_three(void);
@@ -223,9 +226,11 @@ int main(void)
 	Run( log,               "log"              );
 	Run( LuRatio,           "LuRatio"          );
 	Run( LuVecADOk,         "LuVecADOk"        );
+	Run( memory_checkpoint, "memory_checkpoint" );
 	Run( MulEq,             "MulEq"            );
 	Run( mul_level,         "mul_level"        );
 	Run( mul_level_ode,     "mul_level_ode"    );
+	Run( multi_start_newton, "multi_start_newton" );
 	Run( Mul,               "Mul"              );
 	Run( NearEqualExt,      "NearEqualExt"     );
 	Run( new_dynamic,       "new_dynamic"      );
@@ -239,6 +244,7 @@ int main(void)
 	Run( Poly,              "Poly"             );
 	Run( pow_int,           "pow_int"          );
 	Run( pow,               "pow"              );
+	Run( reroll,            "reroll"           );
 	Run( reverse_any,       "reverse_any"      );
 	Run( reverse_one,       "reverse_one"      );
 	Run( reverse_three,     "reverse_three"    );
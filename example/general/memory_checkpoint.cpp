@@ -0,0 +1,85 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin memory_checkpoint.cpp$$
+
+$section Split an Operation Sequence into Checkpoint Functions: Example and Test$$
+
+$code
+$srcfile%example/general/memory_checkpoint.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool memory_checkpoint(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+	// domain space vector
+	size_t n = 3;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	for(size_t j = 0; j < n; ++j)
+		ax[j] = 0.1 * double(j + 1);
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// a long computation with a small number of results
+	size_t n_step = 50;
+	CPPAD_TESTVECTOR(AD<double>) ay(ax);
+	for(size_t k = 0; k < n_step; ++k)
+	{	AD<double> sum = ay[0] + ay[1] + ay[2];
+		for(size_t i = 0; i < n; ++i)
+			ay[i] = ay[i] + 0.01 * cos( sum * ay[i] );
+	}
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay), g;
+	g = f;
+
+	// split g so that reverse mode stores Taylor coefficients
+	// for at most one quarter of the variables in f
+	size_t max_var = f.size_var() / 4;
+	CppAD::memory_checkpoint<double> body(g, max_var);
+
+	// check that the bound is satisfied
+	ok &= 1 < body.size();
+	ok &= body.ok();
+	ok &= body.peak_var() <= max_var;
+	ok &= g.size_var() < max_var;
+
+	// check zero order forward mode
+	CPPAD_TESTVECTOR(double) x(n), y_f(n), y_g(n);
+	for(size_t j = 0; j < n; ++j)
+		x[j] = 0.2 * double(j + 1);
+	y_f  = f.Forward(0, x);
+	y_g  = g.Forward(0, x);
+	for(size_t i = 0; i < n; ++i)
+		ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+
+	// check first order reverse mode
+	CPPAD_TESTVECTOR(double) w(n), dw_f(n), dw_g(n);
+	for(size_t i = 0; i < n; ++i)
+		w[i] = double(i + 1);
+	dw_f = f.Reverse(1, w);
+	dw_g = g.Reverse(1, w);
+	for(size_t j = 0; j < n; ++j)
+		ok &= NearEqual(dw_g[j], dw_f[j], eps99, eps99);
+
+	return ok;
+}
+// END C++
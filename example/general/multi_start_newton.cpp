@@ -0,0 +1,98 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin multi_start_newton.cpp$$
+
+$section Multi-Start Newton's Method: Example and Test$$
+
+$head Function$$
+This example finds the zeros of
+$latex \[
+f(x) = \left( \begin{array}{c}
+	\sin( x_0 ) \\
+	x_1^2 - 1
+\end{array} \right)
+\] $$
+in the box $latex [-1, 7] \times [-2, 2]$$; i.e.,
+$latex x_0 \in \{ 0 , \pi , 2 \pi \}$$ and $latex x_1 \in \{ -1 , 1 \}$$.
+
+$code
+$srcfile%example/general/multi_start_newton.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+bool multi_start_newton(void)
+{	bool ok = true;
+	using CppAD::AD;
+	double eps = 1e-10;
+	double pi  = 4.0 * std::atan(1.0);
+	//
+	// record f(x)
+	size_t n = 2;
+	CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(n);
+	ax[0] = 0.0;
+	ax[1] = 0.0;
+	CppAD::Independent(ax);
+	ay[0] = sin( ax[0] );
+	ay[1] = ax[1] * ax[1] - 1.0;
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// box and number of sub-intervals in each direction
+	CPPAD_TESTVECTOR(double) xlow(n), xup(n);
+	CPPAD_TESTVECTOR(size_t) num_sub(n);
+	xlow[0]    = -1.0;
+	xup[0]     = 7.0;
+	num_sub[0] = 20;
+	xlow[1]    = -2.0;
+	xup[1]     = 2.0;
+	num_sub[1] = 10;
+	//
+	// find the zeros using four threads
+	size_t max_itr     = 20;
+	size_t num_threads = 4;
+	CPPAD_TESTVECTOR(double) xout;
+	size_t num_root = CppAD::multi_start_newton(
+		xout, f, num_sub, xlow, xup, eps, max_itr, num_threads
+	);
+	//
+	// check the zeros
+	ok &= num_root == 6;
+	ok &= xout.size() == num_root * n;
+	size_t count[3] = { 0, 0, 0 };
+	for(size_t k = 0; k < num_root; ++k)
+	{	double x0 = xout[k * n + 0];
+		double x1 = xout[k * n + 1];
+		ok &= CppAD::NearEqual(std::fabs(x1), 1.0, eps, eps);
+		for(size_t i = 0; i < 3; ++i)
+		{	if( std::fabs(x0 - double(i) * pi) < 1e-8 )
+				++count[i];
+		}
+	}
+	for(size_t i = 0; i < 3; ++i)
+		ok &= count[i] == 2;
+	//
+	// sequential execution mode with one thread after the calculation
+	ok &= CppAD::thread_alloc::num_threads() == 1;
+	ok &= ! CppAD::thread_alloc::in_parallel();
+	//
+	return ok;
+}
+# else
+bool multi_start_newton(void)
+{	return true; }
+# endif
+// END C++
@@ -0,0 +1,94 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin reroll.cpp$$
+
+$section Replace Repeated Operations by Checkpoint Functions: Example and Test$$
+
+$code
+$srcfile%example/general/reroll.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	// one time step for an approximate solution of an ODE
+	template <class Vector> void step(Vector& y)
+	{	typedef typename Vector::value_type scalar;
+		scalar h  = scalar(0.1);
+		scalar y0 = y[0];
+		scalar y1 = y[1];
+		y[0] = y0 + h * ( y1 * y0 - sin(y0) );
+		y[1] = y1 + h * ( exp(- y0 * y0) - y1 / (scalar(1.0) + y1 * y1) );
+	}
+}
+
+bool reroll(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+	// domain space vector
+	size_t n = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// take n_step time steps
+	size_t n_step = 20;
+	CPPAD_TESTVECTOR(AD<double>) ay(ax);
+	for(size_t k = 0; k < n_step; ++k)
+		step(ay);
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay), g;
+	g = f;
+
+	// replace the time steps in g by calls to a checkpoint function
+	CppAD::reroll<double> body(g);
+
+	// there is one checkpoint function and it is called for each time step
+	ok &= body.size()   == 1;
+	ok &= body.n_call() == n_step;
+
+	// the operation sequence for g has fewer operations and variables
+	ok &= g.size_op()  < f.size_op();
+	ok &= g.size_var() < f.size_var();
+
+	// check zero order forward mode
+	CPPAD_TESTVECTOR(double) x(n), y_f(n), y_g(n);
+	x[0] = 0.25;
+	x[1] = 0.75;
+	y_f  = f.Forward(0, x);
+	y_g  = g.Forward(0, x);
+	for(size_t i = 0; i < n; ++i)
+		ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+
+	// check first order reverse mode
+	CPPAD_TESTVECTOR(double) w(n), dw_f(n), dw_g(n);
+	w[0] = 1.0;
+	w[1] = 2.0;
+	dw_f = f.Reverse(1, w);
+	dw_g = g.Reverse(1, w);
+	for(size_t j = 0; j < n; ++j)
+		ok &= NearEqual(dw_g[j], dw_f[j], eps99, eps99);
+
+	return ok;
+}
+// END C++
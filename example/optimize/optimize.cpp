@@ -28,6 +28,10 @@ extern bool forward_active(void);
 extern bool nest_conditional(void);
 extern bool print_for(void);
 extern bool reverse_active(void);
+extern bool simplify(void);
+extern bool renumber(void);
+extern bool report(void);
+extern bool vecad(void);
 
 // main program that runs all the tests
 int main(void)
@@ -45,6 +49,10 @@ int main(void)
 	Run( nest_conditional,    "nest_conditional"   );
 	Run( print_for,           "print_for"          );
 	Run( reverse_active,      "reverse_active"     );
+	Run( simplify,            "simplify"           );
+	Run( renumber,            "renumber"           );
+	Run( report,              "report"             );
+	Run( vecad,               "vecad"              );
 	//
 	// check for memory leak
 	bool memory_ok = CppAD::thread_alloc::free_all();
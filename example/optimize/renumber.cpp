@@ -0,0 +1,95 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin optimize_renumber.cpp$$
+
+$section Example Optimization and Renumbering Operations$$
+
+$code
+$srcfile%example/optimize/renumber.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	template <class Vector> void fun(const Vector& x, Vector& y)
+	{	typedef typename Vector::value_type scalar;
+		size_t n = x.size();
+		size_t m = y.size();
+
+		// first layer of values (all computed before any of them are used)
+		Vector a(n);
+		for(size_t j = 0; j < n; j++)
+			a[j] = exp( x[j] );
+
+		// second layer uses the first layer in reverse order
+		for(size_t i = 0; i < m; i++)
+		{	y[i] = scalar(0.0);
+			for(size_t j = 0; j < n; j++)
+				y[i] += scalar(double(i + 1)) * sin( a[n - j - 1] );
+		}
+	}
+}
+bool renumber(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+	// domain space vector
+	size_t n  = 5;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1) / double(n);
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	fun(ax, ay);
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay), g;
+	g = f;
+
+	// Optimize the operation sequence without and with renumbering
+	f.optimize();
+	g.optimize("renumber");
+
+	// all the operations in fun are used, so renumbering does not change
+	// the number of variables or operators
+	ok &= f.size_var() == g.size_var();
+	ok &= f.size_op()  == g.size_op();
+
+	// Check result for a zero order calculation for a different x,
+	CPPAD_TESTVECTOR(double) x(n), y(m), check(m);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(n - j) / double(n);
+	y = g.Forward(0, x);
+	fun(x, check);
+	for(size_t i = 0; i < m; i++)
+		ok  &= NearEqual(y[i], check[i], eps10, eps10);
+
+	// Check the derivative
+	CPPAD_TESTVECTOR(double) jac_f(m * n), jac_g(m * n);
+	jac_f = f.Jacobian(x);
+	jac_g = g.Jacobian(x);
+	for(size_t k = 0; k < m * n; k++)
+		ok &= NearEqual(jac_g[k], jac_f[k], eps10, eps10);
+
+	return ok;
+}
+// END C++
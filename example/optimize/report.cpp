@@ -0,0 +1,95 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin optimize_report.cpp$$
+
+$section Example Optimization Report$$
+
+$code
+$srcfile%example/optimize/report.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool report(void)
+{	bool ok = true;
+	using CppAD::AD;
+
+	// domain space vector
+	size_t n  = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// sin(x[0]) is computed twice
+	AD<double> a = sin( ax[0] );
+	AD<double> b = sin( ax[0] );
+
+	// this sum is converted to one cumulative summation operator
+	AD<double> sum = a + b + ax[1];
+
+	// the value of c is not used when ax[0] < ax[1]
+	AD<double> c    = exp( ax[1] );
+	AD<double> zero = 0.0;
+	AD<double> d    = CppAD::CondExpLt(ax[0], ax[1], zero, c);
+
+	// this variable is not used
+	AD<double> e = cos( ax[0] );
+
+	// range space vector
+	size_t m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	ay[0] = sum;
+	ay[1] = d;
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+
+	// optimize and report what was done
+	CppAD::optimize_report info;
+	f.optimize("", info);
+
+	// check the sizes before and after
+	ok &= info.n_op_after  == f.size_op();
+	ok &= info.n_var_after == f.size_var();
+	ok &= info.n_var_after < info.n_var_before;
+	ok &= info.n_dyn_after == info.n_dyn_before;
+
+	// check the number of each transformation
+	ok &= info.n_match == 1;
+	ok &= info.n_csum  == 1;
+	ok &= info.n_cskip == 1;
+
+	// check that the times are consistent
+	double sum_time = info.time_simplify + info.time_renumber
+		+ info.time_usage + info.time_match + info.time_cexp
+		+ info.time_record;
+	ok &= 0.0 <= sum_time && sum_time <= info.time_total;
+
+	// check the result for a zero order calculation
+	CPPAD_TESTVECTOR(double) x(n), y(m);
+	x[0] = 0.5;
+	x[1] = 0.25;
+	y    = f.Forward(0, x);
+	double eps = 10.0 * std::numeric_limits<double>::epsilon();
+	double check = 2.0 * std::sin(x[0]) + x[1];
+	ok &= CppAD::NearEqual(y[0], check, eps, eps);
+	ok &= CppAD::NearEqual(y[1], std::exp(x[1]), eps, eps);
+	//
+	return ok;
+}
+// END C++
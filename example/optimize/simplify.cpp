@@ -0,0 +1,126 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin optimize_simplify.cpp$$
+
+$section Example Optimization and Algebraic Simplification$$
+
+$code
+$srcfile%example/optimize/simplify.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	struct tape_size { size_t n_var; size_t n_op; };
+
+	template <class Vector> void fun(
+		const Vector& x, Vector& y, tape_size& before, tape_size& after
+	)
+	{	typedef typename Vector::value_type scalar;
+
+		// phantom variable with index 0 and independent variables
+		// begin operator, independent variable operators and end operator
+		before.n_var = 1 + x.size(); before.n_op  = 2 + x.size();
+		after.n_var  = 1 + x.size(); after.n_op   = 2 + x.size();
+
+		// pow(x, 2) is replaced by x * x which has one result (not three)
+		scalar a = pow(x[0], 2.0);
+		before.n_var += 3; before.n_op  += 1;
+		after.n_var  += 1; after.n_op   += 1;
+
+		// -(-x) is replaced by x
+		scalar b = - ( - x[1] );
+		before.n_var += 2; before.n_op  += 2;
+		after.n_var  += 0; after.n_op   += 0;
+
+		// x - x is replaced by the constant zero
+		scalar c = x[0] - x[0];
+		before.n_var += 1; before.n_op  += 1;
+		after.n_var  += 0; after.n_op   += 0;
+
+		// 0 * x is folded to zero and 0 + b is replaced by b
+		scalar d = c * x[1] + b;
+		before.n_var += 2; before.n_op  += 2;
+		after.n_var  += 0; after.n_op   += 0;
+
+		// x / x is replaced by the constant one and 1 * a by a
+		scalar e = x[0] / x[0];
+		scalar f = e * a;
+		before.n_var += 2; before.n_op  += 2;
+		after.n_var  += 0; after.n_op   += 0;
+
+		// results for this operation sequence
+		y[0] = d;
+		y[1] = f;
+		y[2] = c;
+		// a dependent variable that is a constant requires a
+		// parameter to variable operator
+		before.n_var += 0; before.n_op  += 0;
+		after.n_var  += 1; after.n_op   += 1;
+	}
+}
+bool simplify(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+	// domain space vector
+	size_t n  = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 3;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	tape_size before, after;
+	fun(ax, ay, before, after);
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+	ok &= f.size_var() == before.n_var;
+	ok &= f.size_op()  == before.n_op;
+
+	// Optimize the operation sequence
+	f.optimize("simplify");
+	ok &= f.size_var() == after.n_var;
+	ok &= f.size_op()  == after.n_op;
+
+	// Check result for a zero order calculation for a different x,
+	CPPAD_TESTVECTOR(double) x(n), y(m), check(m);
+	x[0] = 0.75;
+	x[1] = 2.25;
+	y    = f.Forward(0, x);
+	fun(x, check, before, after);
+	for(size_t i = 0; i < m; i++)
+		ok  &= NearEqual(y[i], check[i], eps10, eps10);
+
+	// Check the derivative
+	CPPAD_TESTVECTOR(double) jac(m * n);
+	jac = f.Jacobian(x);
+	ok &= jac[0 * n + 0] == 0.0;
+	ok &= jac[0 * n + 1] == 1.0;
+	ok &= NearEqual(jac[1 * n + 0], 2.0 * x[0], eps10, eps10);
+	ok &= jac[1 * n + 1] == 0.0;
+	ok &= jac[2 * n + 0] == 0.0;
+	ok &= jac[2 * n + 1] == 0.0;
+
+	return ok;
+}
+// END C++
@@ -0,0 +1,123 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin optimize_vecad.cpp$$
+$spell
+	VecAD
+$$
+
+$section Example Optimization and VecAD Operations$$
+
+$code
+$srcfile%example/optimize/vecad.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool vecad(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+	// domain space vector
+	size_t n = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	ax[0] = 0.5;
+	ax[1] = 1.5;
+
+	// vectors with initial values that are parameters
+	CppAD::VecAD<double> v(3), w(2);
+	for(size_t i = 0; i < 3; ++i)
+		v[i] = 4.0;
+	for(size_t i = 0; i < 2; ++i)
+		w[i] = 5.0;
+
+	// declare independent variables and start tape recording
+	CppAD::Independent(ax);
+
+	// phantom variable with index 0 and independent variables
+	// begin operator, independent variable operators and end operator
+	size_t n_var = 1 + n, n_op = 2 + n;
+
+	// parameter indices for the vectors
+	AD<double> zero(0), one(1), two(2);
+
+	// a store of a variable using a parameter index
+	// (this store, and the addition, are removed because v[zero]
+	// is stored again before it is loaded)
+	v[zero] = ax[0] + ax[1];
+	n_var  += 1; n_op += 2;
+
+	// a store of a variable using a parameter index
+	v[zero] = ax[0] * ax[1];
+	n_var  += 1; n_op += 2;
+
+	// a store of a parameter using a parameter index
+	v[one] = 3.0;
+	n_op  += 1;
+
+	// loads using a parameter index; their values are known from the
+	// previous stores and they are replaced by the values that were stored
+	AD<double> a = v[zero];
+	AD<double> b = v[one];
+	n_var += 2; n_op += 2;
+
+	// the value of w[one] depends on the value of the variable index
+	w[ax[0]] = ax[1];
+	n_op    += 1;
+
+	// this load is not replaced
+	AD<double> c = w[one];
+	n_var  += 1; n_op += 1;
+
+	// range space vector (v[two] is a load of an initial value)
+	size_t m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	ay[0] = a * b;
+	ay[1] = c + v[two];
+	n_var  += 3; n_op += 3;
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+	ok &= f.size_var() == n_var;
+	ok &= f.size_op()  == n_op;
+
+	// After optimization:
+	// the first addition, all the stores to v, and the load a are removed.
+	// The loads b and v[two] become parameter operators and v is removed.
+	f.optimize();
+	ok &= f.size_var()   == n_var - 2;
+	ok &= f.size_op()    == n_op  - 5;
+	ok &= f.size_VecAD() == 1 + 2;
+
+	// check zero order forward mode
+	CPPAD_TESTVECTOR(double) x(n), y(m);
+	x[0] = 1.0;
+	x[1] = 2.0;
+	y    = f.Forward(0, x);
+	ok  &= NearEqual(y[0], x[0] * x[1] * 3.0, eps10, eps10);
+	ok  &= NearEqual(y[1], x[1] + 4.0, eps10, eps10);
+
+	// check first order forward mode
+	CPPAD_TESTVECTOR(double) dx(n), dy(m);
+	dx[0] = 1.0;
+	dx[1] = 0.0;
+	dy    = f.Forward(1, dx);
+	ok   &= NearEqual(dy[0], x[1] * 3.0, eps10, eps10);
+	ok   &= NearEqual(dy[1], 0.0, eps10, eps10);
+
+	return ok;
+}
+// END C++
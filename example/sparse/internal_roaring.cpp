@@ -0,0 +1,151 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin internal_roaring.cpp$$
+$spell
+	Cpp
+	Jacobian
+	Hessian
+$$
+
+$section Compressed Bitmap Internal Sparsity: Example and Test$$
+
+$head Purpose$$
+This example has a Jacobian with one dense row and all the other rows
+having at most two non-zeros.
+It checks that the sparsity patterns computed using
+$cref internal_roaring$$ are the same as those computed using
+vectors of sets.
+
+$code
+$srcfile%example/sparse/internal_roaring.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+	typedef CPPAD_TESTVECTOR(size_t)     SizeVector;
+	typedef CppAD::sparse_rc<SizeVector> sparsity;
+
+	// check if two sparsity patterns are equal
+	bool equal(const sparsity& a, const sparsity& b)
+	{	bool ok = a.nr() == b.nr() && a.nc() == b.nc() && a.nnz() == b.nnz();
+		if( ! ok )
+			return false;
+		SizeVector a_order = a.row_major();
+		SizeVector b_order = b.row_major();
+		for(size_t k = 0; k < a.nnz(); k++)
+		{	ok &= a.row()[ a_order[k] ] == b.row()[ b_order[k] ];
+			ok &= a.col()[ a_order[k] ] == b.col()[ b_order[k] ];
+		}
+		return ok;
+	}
+}
+
+bool internal_roaring(void)
+{	bool ok = true;
+	using CppAD::AD;
+	//
+	// domain space vector
+	size_t n = 100;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+
+	// declare independent variables and start recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = n;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	ay[0] = 0.0;
+	for(size_t j = 0; j < n; j++)
+		ay[0] += ax[j] * ax[j];
+	for(size_t i = 1; i < m; i++)
+		ay[i] = ax[i-1] * sin( ax[i] );
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// the default is to not use compressed bitmaps
+	ok &= ! f.internal_roaring();
+
+	// sparsity pattern for the identity matrix
+	sparsity identity(n, n, n);
+	for(size_t k = 0; k < n; k++)
+		identity.set(k, k, k);
+	//
+	bool transpose       = false;
+	bool dependency      = false;
+	bool internal_bool   = false;
+	CPPAD_TESTVECTOR(bool) select(n);
+	for(size_t j = 0; j < n; j++)
+		select[j] = true;
+	//
+	// compute sparsity patterns using vectors of sets
+	sparsity for_jac_set, rev_jac_set, for_hes_set, rev_hes_set;
+	f.for_jac_sparsity(
+		identity, transpose, dependency, internal_bool, for_jac_set
+	);
+	f.rev_jac_sparsity(
+		identity, transpose, dependency, internal_bool, rev_jac_set
+	);
+	f.rev_hes_sparsity(select, transpose, internal_bool, rev_hes_set);
+	f.for_hes_sparsity(select, select, internal_bool, for_hes_set);
+	//
+	// compute sparsity patterns using compressed bitmaps
+	f.internal_roaring(true);
+	ok &= f.internal_roaring();
+	sparsity for_jac, rev_jac, for_hes, rev_hes;
+	f.for_jac_sparsity(
+		identity, transpose, dependency, internal_bool, for_jac
+	);
+	f.rev_jac_sparsity(
+		identity, transpose, dependency, internal_bool, rev_jac
+	);
+	f.rev_hes_sparsity(select, transpose, internal_bool, rev_hes);
+	f.for_hes_sparsity(select, select, internal_bool, for_hes);
+	//
+	// the first row of the Jacobian is dense, other rows have two entries
+	ok &= for_jac.nnz() == n + 2 * (m - 1);
+	//
+	// the Hessian of sum of components is tri-diagonal
+	ok &= for_hes.nnz() == n + 2 * (n - 1);
+	//
+	// check that the results are the same
+	ok &= equal(for_jac, for_jac_set);
+	ok &= equal(rev_jac, rev_jac_set);
+	ok &= equal(for_hes, for_hes_set);
+	ok &= equal(rev_hes, rev_hes_set);
+	//
+	// memory for forward Jacobian sparsity is reported by size_forward_set
+	ok &= f.size_forward_bool() == 0;
+	ok &= f.size_forward_set() > 0;
+	f.size_forward_set(0);
+	ok &= f.size_forward_set() == 0;
+	//
+	// internal_bool true still uses a vector of boolean values
+	sparsity for_jac_bool;
+	internal_bool = true;
+	f.for_jac_sparsity(
+		identity, transpose, dependency, internal_bool, for_jac_bool
+	);
+	ok &= f.size_forward_bool() > 0;
+	ok &= f.size_forward_set() == 0;
+	ok &= equal(for_jac_bool, for_jac_set);
+	//
+	return ok;
+}
+// END C++
@@ -36,12 +36,14 @@ extern bool for_hes_sparsity(void);
 extern bool for_jac_sparsity(void);
 extern bool for_sparse_hes(void);
 extern bool ForSparseJac(void);
+extern bool internal_roaring(void);
 extern bool rc_sparsity(void);
 extern bool rev_hes_sparsity(void);
 extern bool rev_jac_sparsity(void);
 extern bool rev_sparse_hes(void);
 extern bool RevSparseJac(void);
 extern bool sparse2eigen(void);
+extern bool sparse_cache(void);
 extern bool sparse_hessian(void);
 extern bool sparse_hes(void);
 extern bool sparse_jac_for(void);
@@ -49,6 +51,7 @@ extern bool sparse_jacobian(void);
 extern bool sparse_jac_rev(void);
 extern bool sparse_sub_hes(void);
 extern bool sparsity_sub(void);
+extern bool subgraph_hes(void);
 extern bool subgraph_hes2jac(void);
 extern bool subgraph_jac_rev(void);
 extern bool subgraph_reverse(void);
@@ -72,11 +75,13 @@ int main(void)
 	Run( for_jac_sparsity,          "for_jac_sparsity" );
 	Run( for_sparse_hes,            "for_sparse_hes" );
 	Run( ForSparseJac,              "ForSparseJac" );
+	Run( internal_roaring,          "internal_roaring" );
 	Run( rc_sparsity,               "rc_sparsity" );
 	Run( rev_hes_sparsity,          "rev_hes_sparsity" );
 	Run( rev_jac_sparsity,          "rev_jac_sparsity" );
 	Run( rev_sparse_hes,            "rev_sparse_hes" );
 	Run( RevSparseJac,              "RevSparseJac" );
+	Run( sparse_cache,              "sparse_cache" );
 	Run( sparse_hessian,            "sparse_hessian" );
 	Run( sparse_hes,                "sparse_hes" );
 	Run( sparse_jac_for,            "sparse_jac_for" );
@@ -84,6 +89,7 @@ int main(void)
 	Run( sparse_jac_rev,            "sparse_jac_rev" );
 	Run( sparse_sub_hes,            "sparse_sub_hes" );
 	Run( sparsity_sub,              "sparsity_sub" );
+	Run( subgraph_hes,              "subgraph_hes" );
 	Run( subgraph_hes2jac,          "subgraph_hes2jac" );
 	Run( subgraph_jac_rev,          "subgraph_jac_rev" );
 	Run( subgraph_reverse,          "reverse_subgraph");
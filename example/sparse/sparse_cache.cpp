@@ -0,0 +1,193 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin sparse_cache.cpp$$
+$spell
+	Cpp
+	Jacobian
+	Hessian
+$$
+
+$section Sparse Derivatives With Cached Sparsity and Coloring: Example and Test$$
+
+$code
+$srcfile%example/sparse/sparse_cache.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <sstream>
+
+namespace {
+	typedef CPPAD_TESTVECTOR(CppAD::AD<double>)  a_vector;
+	typedef CPPAD_TESTVECTOR(double)             d_vector;
+	typedef CPPAD_TESTVECTOR(size_t)             s_vector;
+	typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+
+	// f(x) = ( x_0 * x_1 , x_1 * x_2 , ... , x_{n-2} * x_{n-1} , x_0^3 )
+	// (if add is true, the multiplications x_i * x_{i+1} are additions)
+	void record(size_t n, CppAD::ADFun<double>& f, bool add = false)
+	{	a_vector ax(n), ay(n);
+		for(size_t j = 0; j < n; j++)
+			ax[j] = double(j + 1);
+		CppAD::Independent(ax);
+		for(size_t i = 0; i + 1 < n; i++)
+		{	if( add )
+				ay[i] = ax[i] + ax[i+1];
+			else
+				ay[i] = ax[i] * ax[i+1];
+		}
+		ay[n-1] = ax[0] * ax[0] * ax[0];
+		f.Dependent(ax, ay);
+	}
+
+	// check a sparse matrix against the corresponding dense matrix
+	bool check(const sparse_matrix& sparse, const d_vector& dense)
+	{	bool ok = true;
+		size_t nc = sparse.nc();
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		d_vector full(sparse.nr() * nc);
+		for(size_t k = 0; k < full.size(); k++)
+			full[k] = 0.0;
+		for(size_t k = 0; k < sparse.nnz(); k++)
+			full[ sparse.row()[k] * nc + sparse.col()[k] ] = sparse.val()[k];
+		for(size_t k = 0; k < full.size(); k++)
+			ok &= CppAD::NearEqual(full[k], dense[k], eps99, eps99);
+		return ok;
+	}
+}
+
+bool sparse_cache(void)
+{	bool ok = true;
+	//
+	// create f: x -> y
+	size_t n = 5, m = n;
+	CppAD::ADFun<double> f;
+	record(n, f);
+	//
+	// point at which we are computing the derivatives
+	d_vector x(n), w(m);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(j + 2);
+	for(size_t i = 0; i < m; i++)
+		w[i] = double(i + 1);
+	//
+	// the default is to not cache the sparsity patterns and colorings
+	ok &= ! f.sparse_cache();
+	sparse_matrix jac, hes;
+	size_t n_sweep = f.sparse_jac_full(x, jac);
+	ok &= jac.nnz() == 2 * (m - 1) + 1;
+	ok &= n_sweep == 2;
+	ok &= check(jac, f.Jacobian(x));
+	n_sweep = f.sparse_hes_full(x, w, hes);
+	ok &= hes.nnz() == 2 * (n - 1) + 1;
+	ok &= check(hes, f.Hessian(x, w));
+	//
+	// cache the sparsity patterns and colorings in f
+	f.sparse_cache(true);
+	size_t memory = f.Memory();
+	ok &= f.sparse_jac_full(x, jac) == 2;
+	ok &= f.sparse_hes_full(x, w, hes) == n_sweep;
+	ok &= f.Memory() > memory;
+	//
+	// use the cached values at a different point
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(n - j);
+	ok &= f.sparse_jac_full(x, jac) == 2;
+	ok &= check(jac, f.Jacobian(x));
+	ok &= f.sparse_hes_full(x, w, hes) == n_sweep;
+	ok &= check(hes, f.Hessian(x, w));
+	//
+	// save the cached values
+	std::stringstream stream;
+	f.sparse_cache_write(stream);
+	std::string saved = stream.str();
+	//
+	// a new recording of the same function can use the saved values
+	CppAD::ADFun<double> g;
+	record(n, g);
+	ok &= ! g.sparse_cache();
+	memory = g.Memory();
+	std::stringstream stream_g(saved);
+	ok &= g.sparse_cache_read(stream_g);
+	ok &= g.sparse_cache();
+	ok &= g.Memory() > memory;
+	ok &= g.sparse_jac_full(x, jac) == 2;
+	ok &= check(jac, g.Jacobian(x));
+	ok &= g.sparse_hes_full(x, w, hes) == n_sweep;
+	ok &= check(hes, g.Hessian(x, w));
+	//
+	// sparse_jac_for and sparse_hes also use the cached colorings when
+	// they are called with the same patterns as sparse_jac_full and
+	// sparse_hes_full and the default coloring methods
+	CppAD::sparse_rc<s_vector> identity(m, m, m), jac_pattern;
+	for(size_t i = 0; i < m; i++)
+		identity.set(i, i, i);
+	g.rev_jac_sparsity(identity, false, false, false, jac_pattern);
+	sparse_matrix jac_subset(jac_pattern);
+	CppAD::sparse_jac_work jac_work;
+	size_t group_max = 1;
+	ok &= g.sparse_jac_for(
+		group_max, x, jac_subset, jac_pattern, "cppad", jac_work
+	) == 2;
+	ok &= check(jac_subset, g.Jacobian(x));
+	CPPAD_TESTVECTOR(bool) select_domain(n), select_range(m);
+	for(size_t j = 0; j < n; j++)
+		select_domain[j] = true;
+	for(size_t i = 0; i < m; i++)
+		select_range[i] = true;
+	CppAD::sparse_rc<s_vector> hes_pattern;
+	g.for_hes_sparsity(select_domain, select_range, false, hes_pattern);
+	sparse_matrix hes_subset(hes_pattern);
+	CppAD::sparse_hes_work hes_work;
+	ok &= g.sparse_hes(
+		x, w, hes_subset, hes_pattern, "cppad.symmetric", hes_work
+	) == n_sweep;
+	ok &= check(hes_subset, g.Hessian(x, w));
+	//
+	// the saved values cannot be used for a different function
+	CppAD::ADFun<double> h;
+	record(n + 1, h);
+	std::stringstream stream_h(saved);
+	ok &= ! h.sparse_cache_read(stream_h);
+	ok &= ! h.sparse_cache();
+	//
+	// nor for a different function with the same number of operations
+	CppAD::ADFun<double> a;
+	record(n, a, true);
+	ok &= a.size_op() == g.size_op() && a.size_var() == g.size_var();
+	std::stringstream stream_a(saved);
+	ok &= ! a.sparse_cache_read(stream_a);
+	ok &= ! a.sparse_cache();
+	//
+	// a copy of f has the same cached values
+	CppAD::ADFun<double> c;
+	c = f;
+	ok &= c.sparse_cache();
+	ok &= c.Memory() == f.Memory();
+	//
+	// optimizing f changes its operation sequence and frees the cache
+	memory = f.Memory();
+	f.optimize();
+	ok &= f.sparse_cache();
+	ok &= f.Memory() < memory;
+	//
+	// turning the cache off frees the cached values
+	memory = c.Memory();
+	c.sparse_cache(false);
+	ok &= c.Memory() < memory;
+	//
+	return ok;
+}
+// END C++
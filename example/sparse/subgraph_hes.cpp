@@ -0,0 +1,107 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin subgraph_hes.cpp$$
+$spell
+	Hessian
+	Subgraphs
+$$
+
+$section Computing Sparse Hessian Using Subgraphs: Example and Test$$
+
+$code
+$srcfile%example/sparse/subgraph_hes.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool subgraph_hes(void)
+{	bool ok = true;
+	//
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	typedef CPPAD_TESTVECTOR(AD<double>)          a_vector;
+	typedef CPPAD_TESTVECTOR(double)              d_vector;
+	typedef CPPAD_TESTVECTOR(size_t)              s_vector;
+	typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+	//
+	double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+	//
+	// domain space vector
+	size_t n = 6;
+	a_vector ax(n);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+	//
+	// declare independent variables and starting recording
+	CppAD::Independent(ax);
+	//
+	// range space vector
+	// y_0     = x_0 * ( x_1 * x_1 + ... + x_{n-1} * x_{n-1} )
+	// y_i     = sin( x_i ) * x_{i+1} for i = 1 , ... , n-2
+	// y_{n-1} = exp( x_{n-1} )
+	size_t m = n;
+	a_vector ay(m);
+	AD<double> sum = 0.0;
+	for(size_t j = 1; j < n; j++)
+		sum += ax[j] * ax[j];
+	ay[0] = ax[0] * sum;
+	for(size_t i = 1; i < n - 1; i++)
+		ay[i] = sin( ax[i] ) * ax[i+1];
+	ay[n-1] = exp( ax[n-1] );
+	//
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// point at which we are computing the Hessian
+	d_vector x(n);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(j + 2);
+	//
+	// subset corresponding to the lower triangle of the Hessian
+	size_t nnz = n * (n + 1) / 2;
+	CppAD::sparse_rc<s_vector> pattern(n, n, nnz);
+	size_t k = 0;
+	for(size_t r = 0; r < n; r++)
+	{	for(size_t c = 0; c <= r; c++)
+			pattern.set(k++, r, c);
+	}
+	sparse_matrix subset(pattern);
+	//
+	// weight vector, the second component is not included
+	d_vector w(m);
+	for(size_t i = 0; i < m; i++)
+		w[i] = double(i + 1);
+	w[1] = 0.0;
+	//
+	// compute Hessian using subgraphs
+	f.subgraph_hes(x, w, subset);
+	//
+	// check result
+	d_vector hes = f.Hessian(x, w);
+	ok &= subset.nnz() == nnz;
+	for(k = 0; k < nnz; k++)
+	{	size_t r = subset.row()[k];
+		size_t c = subset.col()[k];
+		double v = subset.val()[k];
+		ok &= NearEqual(v, hes[r * n + c], eps99, eps99);
+	}
+	//
+	// the second component, which has weight zero, is the only component
+	// that depends on both x_1 and x_2
+	ok &= subset.val()[ 2 * (2 + 1) / 2 + 1 ] == 0.0;
+	//
+	return ok;
+}
+// END C++
@@ -188,6 +188,27 @@ bool check_alignment(void)
 	// return memory to available pool
 	thread_alloc::return_memory(v_ptr);
 
+	// check an allocation that is aligned to a cache line ------------------
+	min_bytes = 4096;
+	v_ptr     = thread_alloc::get_memory(min_bytes, cap_bytes);
+	v_size_t  = reinterpret_cast<size_t>(v_ptr);
+	ok       &= (v_size_t % 64) == 0;
+	thread_alloc::return_memory(v_ptr);
+
+	// check a large allocation (may use huge pages) -------------------------
+	min_bytes = 20000000;
+	v_ptr     = thread_alloc::get_memory(min_bytes, cap_bytes);
+	v_size_t  = reinterpret_cast<size_t>(v_ptr);
+	ok       &= (v_size_t % 64) == 0;
+	ok       &= min_bytes <= cap_bytes;
+
+	// use the first and last byte of the memory
+	char* c_ptr        = reinterpret_cast<char*>(v_ptr);
+	c_ptr[0]           = 'a';
+	c_ptr[cap_bytes-1] = 'b';
+	ok &= c_ptr[0] == 'a';
+	thread_alloc::return_memory(v_ptr);
+
 	// check array allocation ----------------------------------------------
 	size_t size_min = 1;
 	size_t size_out;
@@ -0,0 +1,157 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin thread_alloc_arena.cpp$$
+$spell
+	Taylor
+$$
+
+$section Using a Bump Allocator Arena with thread_alloc: Example and Test$$
+
+$head Purpose$$
+This example uses a bump allocator, in a region that is reserved in
+advance, for the memory used by an $code ADFun$$ object during
+its evaluation requests (see $cref fun_arena$$).
+The region is reset, in constant time, after each request.
+The function includes a $cref checkpoint$$ function,
+and the memory used by the checkpoint function is not in the arena.
+
+$code
+$srcfile%example/utility/thread_alloc_arena.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <vector>
+# include <new>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+// bump allocator in a region that is reserved in advance
+class bump_arena : public CppAD::thread_alloc_arena {
+private:
+	// region of memory for this arena
+	std::vector<char> region_;
+	// number of bytes in region_ that are currently used
+	size_t            used_;
+	// number of allocations that have not been deallocated
+	size_t            outstanding_;
+public:
+	bump_arena(size_t num_bytes)
+	: region_(num_bytes), used_(0), outstanding_(0)
+	{ }
+	virtual void* allocate(size_t num_bytes)
+	{	if( used_ + num_bytes > region_.size() )
+			throw std::bad_alloc();
+		void* v_ptr  = reinterpret_cast<void*>( region_.data() + used_ );
+		used_       += num_bytes;
+		++outstanding_;
+		return v_ptr;
+	}
+	virtual void deallocate(void* /* v_ptr */, size_t /* num_bytes */)
+	{	--outstanding_; }
+	// release all the memory in constant time
+	void reset(void)
+	{	used_ = 0; }
+	// number of bytes in use
+	size_t used(void) const
+	{	return used_; }
+	// number of allocations that have not been deallocated
+	size_t outstanding(void) const
+	{	return outstanding_; }
+	// is a pointer in this region
+	bool contains(const void* v_ptr) const
+	{	const char* c_ptr = reinterpret_cast<const char*>(v_ptr);
+		return region_.data() <= c_ptr && c_ptr < region_.data() + used_;
+	}
+};
+
+// algorithm that is used for a checkpoint function
+void square_algo(
+	const CppAD::vector< CppAD::AD<double> >& ax ,
+	      CppAD::vector< CppAD::AD<double> >& ay )
+{	ay[0] = ax[0] * ax[0]; }
+
+} // END_EMPTY_NAMESPACE
+
+bool thread_alloc_arena(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::thread_alloc;
+	//
+	// checkpoint function for the square of a scalar
+	CppAD::vector< AD<double> > au(1), av(1);
+	au[0] = 1.0;
+	CppAD::checkpoint<double> square("square", square_algo, au, av);
+	//
+	// record f(x) = (x_0 * x_1 * ... * x_{n-1})^2
+	size_t n = 5;
+	CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(1);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+	CppAD::Independent(ax);
+	au[0] = 1.0;
+	for(size_t j = 0; j < n; j++)
+		au[0] *= ax[j];
+	square(au, av);
+	ay[0] = av[0];
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// arena used for the evaluation requests
+	bump_arena arena(1000000);
+	f.set_arena(&arena);
+	//
+	for(size_t request = 0; request < 3; ++request)
+	{	CppAD::vector<double> x(n), w(1), dw;
+		for(size_t j = 0; j < n; j++)
+			x[j] = double(request + j + 1);
+		w[0] = 1.0;
+		f.Forward(0, x);
+		dw = f.Reverse(1, w);
+		//
+		// the Taylor coefficients are in the arena, other memory is not
+		ok &= arena.used() > 0;
+		ok &= arena.outstanding() > 0;
+		ok &= ! arena.contains( dw.data() );
+		//
+		// check the derivative
+		double prod = 1.0;
+		for(size_t j = 0; j < n; j++)
+			prod *= x[j];
+		for(size_t j = 0; j < n; j++)
+		{	double check = 2.0 * prod * prod / x[j];
+			ok &= CppAD::NearEqual(dw[j], check, 1e-10, 1e-10);
+		}
+		//
+		// free the memory that f has in the arena
+		f.capacity_order(0);
+		//
+		// now the arena can be reset
+		// (the memory used by the checkpoint function is not in the arena)
+		ok &= arena.outstanding() == 0;
+		arena.reset();
+	}
+	//
+	// f no longer uses the arena
+	f.set_arena(CPPAD_NULL);
+	CppAD::vector<double> x(n), y;
+	for(size_t j = 0; j < n; j++)
+		x[j] = 1.0;
+	y   = f.Forward(0, x);
+	ok &= y[0] == 1.0;
+	ok &= arena.used() == 0;
+	//
+	return ok;
+}
+// END C++
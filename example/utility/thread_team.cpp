@@ -0,0 +1,100 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin thread_team.cpp$$
+
+$section A Team of Threads: Example and Test$$
+
+$code
+$srcfile%example/utility/thread_team.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <cppad/utility/thread_team.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+bool thread_team(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::thread_alloc;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+	//
+	// record f(x) = [ x_0 * x_1 , x_0 + x_1 ]
+	size_t nx = 2, ny = 2;
+	CPPAD_TESTVECTOR( AD<double> ) ax(nx), ay(ny);
+	ax[0] = 1.0;
+	ax[1] = 2.0;
+	CppAD::Independent(ax);
+	ay[0] = ax[0] * ax[1];
+	ay[1] = ax[0] + ax[1];
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// team of threads
+	size_t num_threads = 4;
+	{	CppAD::thread_team team(num_threads);
+		ok &= team.num_threads() == num_threads;
+		//
+		// parallel_for: record the thread that computes each element
+		size_t n = 1000;
+		std::vector<size_t> square(n), thread(n);
+		team.parallel_for(n, [&](size_t i)
+		{	square[i] = i * i;
+			thread[i] = thread_alloc::thread_num();
+		});
+		for(size_t i = 0; i < n; ++i)
+		{	ok &= square[i] == i * i;
+			ok &= thread[i] < num_threads;
+		}
+		//
+		// forward_batch: evaluate f for a batch of arguments
+		size_t N = 100;
+		CPPAD_TESTVECTOR(double) x(N * nx), y;
+		for(size_t k = 0; k < N; ++k)
+		{	x[k * nx + 0] = double(k);
+			x[k * nx + 1] = double(k + 1);
+		}
+		team.forward_batch(f, x, y);
+		ok &= y.size() == N * ny;
+		for(size_t k = 0; k < N; ++k)
+		{	double x0 = x[k * nx + 0];
+			double x1 = x[k * nx + 1];
+			ok &= CppAD::NearEqual(y[k * ny + 0], x0 * x1, eps, eps);
+			ok &= CppAD::NearEqual(y[k * ny + 1], x0 + x1, eps, eps);
+		}
+		//
+		// an exception thrown by one of the threads
+		bool caught = false;
+		try
+		{	team.parallel_for(n, [](size_t i)
+			{	if( i == 500 )
+					throw std::runtime_error("i == 500");
+			});
+		}
+		catch(const std::runtime_error&)
+		{	caught = true; }
+		ok &= caught;
+	}
+	// the team has been destroyed so we are back to one thread
+	ok &= thread_alloc::num_threads() == 1;
+	for(size_t thread = 1; thread < num_threads; ++thread)
+		ok &= thread_alloc::inuse(thread) == 0;
+	//
+	return ok;
+}
+# else
+bool thread_team(void)
+{	return true; }
+# endif
+// END C++
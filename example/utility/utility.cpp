@@ -44,6 +44,8 @@ extern bool SimpleVector(void);
 extern bool sparse_rc(void);
 extern bool sparse_rcv(void);
 extern bool thread_alloc(void);
+extern bool thread_alloc_arena(void);
+extern bool thread_team(void);
 extern bool to_string(void);
 extern bool vectorBool(void);
 
@@ -76,6 +78,8 @@ int main(void)
 	Run( set_union,              "set_union" );
 	Run( SimpleVector,           "SimpleVector" );
 	Run( thread_alloc,           "thread_alloc" );
+	Run( thread_alloc_arena,     "thread_alloc_arena" );
+	Run( thread_team,            "thread_team" );
 	Run( sparse_rc,              "sparse_rc" );
 	Run( sparse_rcv,             "sparse_rcv" );
 	Run( to_string,              "to_string" );
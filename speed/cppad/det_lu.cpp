@@ -56,7 +56,7 @@ bool link_det_lu(
 
 	// --------------------------------------------------------------------
 	// check global options
-	const char* valid[] = { "memory", "optimize"};
+	const char* valid[] = { "memory", "optimize", "renumber"};
 	size_t n_valid = sizeof(valid) / sizeof(valid[0]);
 	typedef std::map<std::string, bool>::iterator iterator;
 	//
@@ -73,6 +73,8 @@ bool link_det_lu(
 	// optimization options:
 	std::string optimize_options =
 		"no_conditional_skip no_compare_op no_print_for_op";
+	if( global_option["renumber"] )
+		optimize_options += " renumber";
 	// -----------------------------------------------------
 	// setup
 	typedef CppAD::AD<double>           ADScalar;
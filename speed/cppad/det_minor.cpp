@@ -57,7 +57,7 @@ bool link_det_minor(
 
 	// --------------------------------------------------------------------
 	// check global options
-	const char* valid[] = { "memory", "onetape", "optimize"};
+	const char* valid[] = { "memory", "onetape", "optimize", "renumber"};
 	size_t n_valid = sizeof(valid) / sizeof(valid[0]);
 	typedef std::map<std::string, bool>::iterator iterator;
 	//
@@ -74,6 +74,8 @@ bool link_det_minor(
 	// optimization options: no conditional skips or compare operators
 	std::string optimize_options =
 		"no_conditional_skip no_compare_op no_print_for_op";
+	if( global_option["renumber"] )
+		optimize_options += " renumber";
 	// -----------------------------------------------------
 	// setup
 
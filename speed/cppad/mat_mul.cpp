@@ -62,7 +62,8 @@ bool link_mat_mul(
 
 	// --------------------------------------------------------------------
 	// check global options
-	const char* valid[] = { "memory", "onetape", "optimize", "atomic"};
+	const char* valid[] =
+		{ "memory", "onetape", "optimize", "renumber", "atomic"};
 	size_t n_valid = sizeof(valid) / sizeof(valid[0]);
 	typedef std::map<std::string, bool>::iterator iterator;
 	//
@@ -79,6 +80,8 @@ bool link_mat_mul(
 	// optimization options: no conditional skips or compare operators
 	std::string optimize_options =
 		"no_conditional_skip no_compare_op no_print_for_op";
+	if( global_option["renumber"] )
+		optimize_options += " renumber";
 	// -----------------------------------------------------
 	// setup
 	typedef CppAD::AD<double>           ADScalar;
@@ -58,7 +58,7 @@ bool link_ode(
 
 	// --------------------------------------------------------------------
 	// check global options
-	const char* valid[] = { "memory", "onetape", "optimize"};
+	const char* valid[] = { "memory", "onetape", "optimize", "renumber"};
 	size_t n_valid = sizeof(valid) / sizeof(valid[0]);
 	typedef std::map<std::string, bool>::iterator iterator;
 	//
@@ -75,6 +75,8 @@ bool link_ode(
 	// optimization options: no conditional skips or compare operators
 	std::string optimize_options =
 		"no_conditional_skip no_compare_op no_print_for_op";
+	if( global_option["renumber"] )
+		optimize_options += " renumber";
 	// --------------------------------------------------------------------
 	// setup
 	assert( x.size() == size );
@@ -14,6 +14,7 @@ $spell
 	ifdef
 	ifndef
 	colpack
+	parcolor
 	boolsparsity
 	namespace
 	Jac
@@ -81,6 +82,8 @@ namespace {
 		// optimization options
 		std::string optimize_options =
 			"no_conditional_skip no_compare_op no_print_for_op";
+		if( global_option["renumber"] )
+			optimize_options += " renumber";
 		//
 		// order of derivative in sparse_hes_fun
 		size_t order = 0;
@@ -245,6 +248,8 @@ namespace {
 				coloring = "colpack";
 			if( global_option["symmetric"] )
 				coloring += ".symmetric";
+			else if( global_option["parcolor"] )
+				coloring += ".parallel";
 			else
 				coloring += ".general";
 			//
@@ -273,6 +278,8 @@ namespace {
 				if( global_option["colpack"] )
 					coloring = "colpack";
 # endif
+				if( global_option["parcolor"] )
+					coloring = "cppad.parallel";
 				size_t group_max = 1;
 				n_sweep = fun.sparse_jac_for(
 					group_max, x, subset, sparsity, coloring, jac_work
@@ -302,8 +309,8 @@ bool link_sparse_hessian(
 	// --------------------------------------------------------------------
 	// check global options
 	const char* valid[] = {
-		"memory", "onetape", "optimize", "hes2jac", "subgraph",
-		"boolsparsity", "revsparsity", "symmetric"
+		"memory", "onetape", "optimize", "renumber", "hes2jac",
+		"subgraph", "boolsparsity", "revsparsity", "symmetric", "parcolor"
 # if CPPAD_HAS_COLPACK
 		, "colpack"
 # else
@@ -332,6 +339,10 @@ bool link_sparse_hessian(
 	{	if( ! global_option["hes2jac"] )
 			return false;
 	}
+	if( global_option["parcolor"] )
+	{	if( global_option["colpack"] || global_option["symmetric"] )
+			return false;
+	}
 # if ! CPPAD_HAS_COLPACK
 	if( global_option["colpack"] )
 		return false;
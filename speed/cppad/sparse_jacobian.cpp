@@ -15,6 +15,7 @@ $spell
 	ifdef
 	ifndef
 	colpack
+	parcolor
 	boolsparsity
 	namespace
 	onetape
@@ -118,8 +119,8 @@ bool link_sparse_jacobian(
 	// --------------------------------------------------------------------
 	// check global options
 	const char* valid[] = {
-		"memory", "onetape", "optimize", "subgraph",
-		"boolsparsity", "revsparsity", "subsparsity"
+		"memory", "onetape", "optimize", "renumber", "subgraph",
+		"boolsparsity", "revsparsity", "subsparsity", "parcolor"
 # if CPPAD_HAS_COLPACK
 		, "colpack"
 # endif
@@ -136,6 +137,8 @@ bool link_sparse_jacobian(
 				return false;
 		}
 	}
+	if( global_option["parcolor"] && global_option["colpack"] )
+		return false;
 	if( global_option["subsparsity"] )
 	{	if( global_option["boolsparisty"]
 		||  global_option["revsparsity"]
@@ -146,6 +149,8 @@ bool link_sparse_jacobian(
 	// optimization options: no conditional skips or compare operators
 	std::string optimize_options =
 		"no_conditional_skip no_compare_op no_print_for_op";
+	if( global_option["renumber"] )
+		optimize_options += " renumber";
 	// -----------------------------------------------------
 	// setup
 	typedef CppAD::AD<double>    a_double;
@@ -178,6 +183,8 @@ bool link_sparse_jacobian(
 	if( global_option["colpack"] )
 		coloring = "colpack";
 # endif
+	if( global_option["parcolor"] )
+		coloring = "cppad.parallel";
 	//
 	// maximum number of colors at once
 	//
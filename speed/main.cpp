@@ -55,6 +55,7 @@ $spell
 	subsparsity
 	revsparsity
 	colpack
+	parcolor
 	onetape
 	boolsparsity
 	optionlist
@@ -208,6 +209,13 @@ If it is false, this optimization will not be done.
 Note that this option is usually slower unless it is combined with the
 $code onetape$$ option.
 
+$subhead renumber$$
+If this option is present, and the $code optimize$$ option is present,
+the $cref/renumber/optimize/options/renumber/$$ option is
+included when CppAD optimizes the operation sequence.
+This is used to compare the speed of the sweeps with and without
+renumbering the operators.
+
 $subhead atomic$$
 If this option is present,
 CppAD will use a user defined
@@ -265,6 +273,18 @@ If this option is present,
 CppAD will use $cref/colpack/colpack_prefix/$$ to do the coloring.
 Otherwise, it will use it's own coloring algorithm.
 
+$subhead parcolor$$
+If this option is present,
+CppAD will use its
+$cref/parallel/sparse_jac/coloring/cppad.parallel/$$ coloring algorithm.
+Comparing the $cref/n_sweep/speed_main/Speed Results/n_sweep/$$
+and rate results, with and without this option,
+compares the number of colors and time for the parallel
+and sequential coloring algorithms.
+(The coloring is included in the timing unless $code onetape$$
+is also present.)
+This option cannot be combined with $code colpack$$ or $code symmetric$$.
+
 $subhead symmetric$$
 If this option is present, CppAD will use a symmetric
 $cref/coloring method/sparse_hessian/work/color_method/$$
@@ -382,6 +402,7 @@ namespace {
 		"memory",
 		"onetape",
 		"optimize",
+		"renumber",
 		"atomic",
 		"hes2jac",
 		"subgraph",
@@ -389,6 +410,7 @@ namespace {
 		"revsparsity",
 		"subsparsity",
 		"colpack",
+		"parcolor",
 		"symmetric"
 	};
 	size_t num_option = sizeof(option_list) / sizeof( option_list[0] );
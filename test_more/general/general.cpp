@@ -75,6 +75,7 @@ extern bool jacobian(void);
 extern bool log10(void);
 extern bool log1p(void);
 extern bool log(void);
+extern bool memory_checkpoint(void);
 extern bool mul_cond_rev(void);
 extern bool mul_cskip(void);
 extern bool MulEq(void);
@@ -93,6 +94,7 @@ extern bool Poly(void);
 extern bool PowInt(void);
 extern bool Pow(void);
 extern bool print_for(void);
+extern bool reroll(void);
 extern bool reverse(void);
 extern bool rev_sparse_jac(void);
 extern bool RevTwo(void);
@@ -107,6 +109,7 @@ extern bool sparse_hessian(void);
 extern bool sparse_jacobian(void);
 extern bool sparse_jac_work(void);
 extern bool sparse_sub_hes(void);
+extern bool sparse_thread(void);
 extern bool sparse_vec_ad(void);
 extern bool Sqrt(void);
 extern bool std_math(void);
@@ -116,6 +119,11 @@ extern bool Sub(void);
 extern bool SubZero(void);
 extern bool tan(void);
 extern bool test_vector(void);
+extern bool thread_grow(void);
+extern bool thread_numa(void);
+extern bool thread_register(void);
+extern bool thread_remote(void);
+extern bool thread_stat(void);
 extern bool to_string(void);
 extern bool Value(void);
 extern bool VecADPar(void);
@@ -124,6 +132,7 @@ extern bool VecUnary(void);
 // END_SORT_THIS_LINE_MINUS_1
 
 // tests in local subdirectory
+extern bool color_general(void);
 extern bool vector_set(void);
 
 // main program that runs all the tests
@@ -182,6 +191,7 @@ int main(void)
 	Run( log10,           "log10"          );
 	Run( log1p,           "log1p"          );
 	Run( log,             "log"            );
+	Run( memory_checkpoint, "memory_checkpoint" );
 	Run( mul_cond_rev,    "mul_cond_rev"   );
 	Run( mul_cskip,       "Mul_cskip"      );
 	Run( MulEq,           "MulEq"          );
@@ -200,6 +210,7 @@ int main(void)
 	Run( PowInt,          "PowInt"         );
 	Run( Pow,             "Pow"            );
 	Run( print_for,       "print_for"      );
+	Run( reroll,          "reroll"         );
 	Run( reverse,         "reverse"        );
 	Run( rev_sparse_jac,  "rev_sparse_jac" );
 	Run( RevTwo,          "RevTwo"         );
@@ -214,6 +225,7 @@ int main(void)
 	Run( sparse_jacobian, "sparse_jacobian");
 	Run( sparse_jac_work, "sparse_jac_work");
 	Run( sparse_sub_hes,  "sparse_sub_hes" );
+	Run( sparse_thread,   "sparse_thread"  );
 	Run( sparse_vec_ad,   "sparse_vec_ad"  );
 	Run( Sqrt,            "Sqrt"           );
 	Run( std_math,        "std_math"       );
@@ -222,6 +234,11 @@ int main(void)
 	Run( Sub,             "Sub"            );
 	Run( SubZero,         "SubZero"        );
 	Run( tan,             "tan"            );
+	Run( thread_grow,     "thread_grow"    );
+	Run( thread_numa,     "thread_numa"    );
+	Run( thread_register, "thread_register");
+	Run( thread_remote,   "thread_remote"  );
+	Run( thread_stat,     "thread_stat"    );
 	Run( to_string,       "to_string"      );
 	Run( Value,           "Value"          );
 	Run( VecADPar,        "VecADPar"       );
@@ -245,7 +262,8 @@ int main(void)
 	Run( test_vector, "test_vector" );
 # endif
 	// local sub-directory
-	Run( test_vector,      "test_vector"   );
+	Run( color_general,    "color_general" );
+	Run( vector_set,       "vector_set"    );
 	//
 	// check for memory leak
 	bool memory_ok = CppAD::thread_alloc::free_all();
@@ -0,0 +1,172 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/cppad.hpp>
+# include <cppad/speed/uniform_01.hpp>
+
+namespace { //  BEGIN empty namespace
+
+typedef CppAD::vector<size_t> s_vector;
+
+// check that a row coloring satisfies the conditions in color_general_cppad
+bool check_color(
+	const CppAD::local::sparse_list& pattern ,
+	const s_vector&                  row     ,
+	const s_vector&                  col     ,
+	const s_vector&                  color   )
+{	bool ok  = true;
+	size_t m = pattern.n_set();
+	size_t K = row.size();
+	//
+	for(size_t k = 0; k < K; k++)
+		ok &= color[ row[k] ] < m;
+	for(size_t k = 0; k < K; k++)
+	{	size_t i = row[k];
+		size_t j = col[k];
+		// no other row with the same color is non-zero in column j
+		for(size_t r = 0; r < m; r++) if( r != i && color[r] == color[i] )
+			ok &= ! pattern.is_element(r, j);
+	}
+	return ok;
+}
+
+// number of colors used by a coloring
+size_t number_colors(const s_vector& color, size_t m)
+{	size_t n_color = 0;
+	for(size_t i = 0; i < m; i++) if( color[i] < m )
+		n_color = std::max(n_color, color[i] + 1);
+	return n_color;
+}
+
+bool random_pattern(size_t m, size_t n, size_t n_per_row)
+{	bool ok = true;
+	//
+	// random sparsity pattern
+	CppAD::local::sparse_list pattern;
+	pattern.resize(m, n);
+	CppAD::vector<double> u(n_per_row);
+	for(size_t i = 0; i < m; i++)
+	{	CppAD::uniform_01(n_per_row, u);
+		for(size_t ell = 0; ell < n_per_row; ell++)
+			pattern.post_element(i, size_t( u[ell] * double(n-1) ) );
+		pattern.process_post(i);
+	}
+	//
+	// compute every other entry in the pattern
+	s_vector row, col;
+	size_t count = 0;
+	for(size_t i = 0; i < m; i++)
+	{	CppAD::local::sparse_list::const_iterator itr(pattern, i);
+		size_t j = *itr;
+		while( j != pattern.end() )
+		{	if( count++ % 2 == 0 )
+			{	row.push_back(i);
+				col.push_back(j);
+			}
+			j = *(++itr);
+		}
+	}
+	//
+	// sequential algorithm
+	s_vector color(m);
+	CppAD::local::color_general_cppad(pattern, row, col, color);
+	ok &= check_color(pattern, row, col, color);
+	size_t n_color = number_colors(color, m);
+	//
+	// parallel algorithm with different number of threads
+	for(size_t n_thread = 1; n_thread < 5; n_thread++)
+	{	CppAD::local::color_general_parallel(
+			pattern, row, col, color, n_thread
+		);
+		ok &= check_color(pattern, row, col, color);
+		//
+		// colors that are used are 0, ..., number_colors - 1
+		size_t n_color_par = number_colors(color, m);
+		s_vector used(n_color_par);
+		for(size_t ell = 0; ell < n_color_par; ell++)
+			used[ell] = 0;
+		for(size_t i = 0; i < m; i++) if( color[i] < m )
+			used[ color[i] ]++;
+		for(size_t ell = 0; ell < n_color_par; ell++)
+			ok &= used[ell] > 0;
+		//
+		// speculative coloring should not be much worse than sequential
+		ok &= n_color_par <= 2 * n_color;
+	}
+	return ok;
+}
+
+bool sparse_jac_parallel(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	typedef CppAD::vector<double>      d_vector;
+	typedef CppAD::vector< AD<double> > a_vector;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+	//
+	// f(x) = ( x[j] * x[j+1] , j = 0, ..., n-2 )
+	size_t n = 10, m = n - 1;
+	a_vector ax(n), ay(m);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+	CppAD::Independent(ax);
+	for(size_t i = 0; i < m; i++)
+		ay[i] = ax[i] * ax[i+1];
+	CppAD::ADFun<double> f(ax, ay);
+	//
+	// sparsity pattern for Jacobian
+	CppAD::sparse_rc<s_vector> pattern(m, n, 2 * m);
+	for(size_t i = 0; i < m; i++)
+	{	pattern.set(2 * i,     i, i);
+		pattern.set(2 * i + 1, i, i + 1);
+	}
+	d_vector x(n);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(j + 2);
+	//
+	// compute entire Jacobian using forward and reverse mode
+	for(size_t mode = 0; mode < 2; mode++)
+	{	CppAD::sparse_rcv<s_vector, d_vector> subset( pattern );
+		CppAD::sparse_jac_work work;
+		std::string coloring = "cppad.parallel";
+		size_t n_sweep;
+		if( mode == 0 )
+		{	size_t group_max = 2;
+			n_sweep = f.sparse_jac_for(
+				group_max, x, subset, pattern, coloring, work
+			);
+		}
+		else
+			n_sweep = f.sparse_jac_rev(x, subset, pattern, coloring, work);
+		//
+		// band structure can be computed with a few sweeps
+		ok &= 2 <= n_sweep && n_sweep <= 4;
+		for(size_t k = 0; k < 2 * m; k++)
+		{	size_t i = subset.row()[k];
+			size_t j = subset.col()[k];
+			double check = x[i];
+			if( i == j )
+				check = x[i + 1];
+			ok &= NearEqual(subset.val()[k], check, eps, eps);
+		}
+	}
+	return ok;
+}
+
+} // END empty namespace
+
+bool color_general(void)
+{	bool ok = true;
+	ok     &= random_pattern(50, 40, 3);
+	ok     &= random_pattern(200, 20, 5);
+	ok     &= sparse_jac_parallel();
+	return ok;
+}
@@ -1,5 +1,5 @@
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-17 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the
@@ -10,6 +10,8 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
 # include <cppad/cppad.hpp>
+# include <cppad/speed/uniform_01.hpp>
+# include <set>
 
 namespace { //  BEGIN empty namespace
 
@@ -233,6 +235,258 @@ bool test_post(void)
 	return ok;
 }
 
+// compare a vector of sets with a vector of standard sets
+template<class VectorSet>
+bool equal_sets(
+	const VectorSet&                     vec_set ,
+	const std::vector< std::set<size_t> >& check   )
+{	bool ok = true;
+	size_t end = vec_set.end();
+	for(size_t i = 0; i < check.size(); i++)
+	{	std::set<size_t>::const_iterator itr_check = check[i].begin();
+		typename VectorSet::const_iterator itr(vec_set, i);
+		while( itr_check != check[i].end() )
+		{	ok &= *itr == *itr_check;
+			++itr_check;
+			++itr;
+		}
+		ok &= *itr == end;
+	}
+	return ok;
+}
+
+// random sets with elements that are dense in some ranges
+// (and sparse in others) and random operations on the sets
+template<class VectorSet>
+bool test_random(void)
+{	bool ok = true;
+	//
+	size_t n_set = 6;
+	size_t end   = 200000;
+	VectorSet vec_set, other;
+	vec_set.resize(n_set, end);
+	other.resize(n_set, end);
+	std::vector< std::set<size_t> > check(n_set), check_other(n_set);
+	//
+	CppAD::vector<double> u(2);
+	for(size_t i = 0; i < n_set; i++)
+	{	// a run of consecutive elements
+		CppAD::uniform_01(2, u);
+		size_t start  = size_t( u[0] * double(end / 2) );
+		size_t length = 1 + size_t( u[1] * double(10000 * i) );
+		for(size_t k = start; k < start + length && k < end; k++)
+		{	vec_set.post_element(i, k);
+			check[i].insert(k);
+		}
+		// every other element in a range (uses a bitmap)
+		start = 65536 * (i % 3);
+		for(size_t k = start; k < start + 10000 * (i % 2); k += 2)
+		{	vec_set.post_element(i, k);
+			check[i].insert(k);
+		}
+		// random elements
+		for(size_t k = 0; k < 50; k++)
+		{	CppAD::uniform_01(1, u);
+			size_t element = size_t( u[0] * double(end - 1) );
+			vec_set.post_element(i, element);
+			check[i].insert(element);
+		}
+		vec_set.process_post(i);
+		//
+		// other[i] = a few random elements
+		for(size_t k = 0; k < 5; k++)
+		{	CppAD::uniform_01(1, u);
+			size_t element = size_t( u[0] * double(end - 1) );
+			other.add_element(i, element);
+			check_other[i].insert(element);
+		}
+	}
+	ok &= equal_sets(vec_set, check);
+	ok &= equal_sets(other, check_other);
+	for(size_t i = 0; i < n_set; i++)
+	{	ok &= vec_set.number_elements(i) == check[i].size();
+		std::set<size_t>::const_iterator itr = check[i].begin();
+		for(size_t k = 0; k < 10 && itr != check[i].end(); k++, itr++)
+			ok &= vec_set.is_element(i, *itr);
+	}
+	//
+	// binary operations with this and other vector of sets
+	for(size_t pass = 0; pass < 3; pass++)
+	{	for(size_t target = 0; target < n_set; target++)
+		{	size_t left  = (target + 1 + pass) % n_set;
+			size_t right = (target + 2 + pass) % n_set;
+			std::set<size_t> result;
+			if( pass == 0 )
+			{	std::set_union(
+					check[left].begin(), check[left].end(),
+					check[right].begin(), check[right].end(),
+					std::inserter(result, result.begin())
+				);
+				vec_set.binary_union(target, left, right, vec_set);
+			}
+			else if( pass == 1 )
+			{	std::set_intersection(
+					check[left].begin(), check[left].end(),
+					check[right].begin(), check[right].end(),
+					std::inserter(result, result.begin())
+				);
+				vec_set.binary_intersection(target, left, right, vec_set);
+			}
+			else
+			{	std::set_union(
+					check[left].begin(), check[left].end(),
+					check_other[right].begin(), check_other[right].end(),
+					std::inserter(result, result.begin())
+				);
+				vec_set.binary_union(target, left, right, other);
+			}
+			check[target] = result;
+		}
+		ok &= equal_sets(vec_set, check);
+	}
+	//
+	// assignment of all the sets
+	other = vec_set;
+	ok &= equal_sets(other, check);
+	//
+	return ok;
+}
+
+// add_element for sets that are shared, interleaved with other sets,
+// and that change between the array, run, and bitmap representations
+template<class VectorSet>
+bool test_add_element(void)
+{	bool ok = true;
+	//
+	size_t n_set = 4;
+	size_t end   = 3 * 65536;
+	VectorSet vec_set;
+	vec_set.resize(n_set, end);
+	std::vector< std::set<size_t> > check(n_set);
+	//
+	CppAD::vector<double> u(1);
+	for(size_t k = 0; k < 6000; k++)
+	{	size_t i = k % n_set;
+		size_t element;
+		if( i == 0 )
+			element = 2 * k;             // array changes to bitmap
+		else if( i == 1 )
+		{	// two runs with a gap at 65536 + 700
+			element = 65536 + k / n_set;
+			if( k / n_set >= 700 )
+				++element;
+		}
+		else
+		{	CppAD::uniform_01(1, u);    // random
+			element = size_t( u[0] * double(end - 1) );
+		}
+		vec_set.add_element(i, element);
+		check[i].insert(element);
+		//
+		// share set 3 with set 2 (so the next addition copies it)
+		if( k % 1000 == 0 )
+		{	vec_set.assignment(3, 2, vec_set);
+			check[3] = check[2];
+		}
+	}
+	// element that joins two runs, and one that goes before the first key
+	vec_set.add_element(1, 65536 + 700);
+	check[1].insert(65536 + 700);
+	vec_set.add_element(1, 3);
+	check[1].insert(3);
+	//
+	ok &= equal_sets(vec_set, check);
+	for(size_t i = 0; i < n_set; i++)
+		ok &= vec_set.number_elements(i) == check[i].size();
+	//
+	return ok;
+}
+
+// compaction and statistics for sparse_list
+bool test_compact(void)
+{	bool ok = true;
+	typedef CppAD::local::sparse_list_statistics statistics;
+	//
+	size_t n_set = 10;
+	size_t end   = 1000;
+	CppAD::local::sparse_list vec_set;
+	vec_set.resize(n_set, end);
+	std::vector< std::set<size_t> > check(n_set);
+	//
+	// set[i] = { i, i + n_set, i + 2 * n_set, ... }
+	for(size_t i = 0; i < n_set; i++)
+	{	for(size_t k = i; k < end; k += n_set)
+		{	vec_set.post_element(i, k);
+			check[i].insert(k);
+		}
+		vec_set.process_post(i);
+	}
+	// set[1] = set[0] (shares the list for set[0])
+	vec_set.assignment(1, 0, vec_set);
+	check[1] = check[0];
+	//
+	// replace set[i], i > 1, by the union of set[i] and set[i-1]
+	// (the old lists for these sets are garbage)
+	for(size_t i = 2; i < n_set; i++)
+	{	vec_set.binary_union(i, i, i - 1, vec_set);
+		check[i].insert(check[i-1].begin(), check[i-1].end());
+	}
+	// clear the last half of the sets (their lists are garbage)
+	for(size_t i = n_set / 2; i < n_set; i++)
+	{	vec_set.clear(i);
+		check[i].clear();
+	}
+	// post an element that is not yet processed
+	vec_set.post_element(0, end - 1);
+	//
+	statistics before = vec_set.statistics();
+	ok &= before.number_set == n_set / 2;
+	ok &= before.number_distinct_list == n_set / 2 - 1;
+	ok &= before.number_unshared_entry ==
+		before.number_list_entry + 1 + end / n_set;
+	ok &= before.number_post == 1;
+	ok &= before.number_not_used > 0;
+	//
+	vec_set.compact();
+	statistics after = vec_set.statistics();
+	ok &= after.number_not_used == 0;
+	ok &= after.number_list_entry == before.number_list_entry;
+	ok &= after.number_distinct_list == before.number_distinct_list;
+	ok &= after.number_post == 1;
+	ok &= after.capacity < before.capacity;
+	//
+	vec_set.process_post(0);
+	check[0].insert(end - 1);
+	ok &= equal_sets(vec_set, check);
+	//
+	// with automatic compaction, the garbage does not build up
+	vec_set.auto_compact(true);
+	for(size_t pass = 0; pass < 20; pass++)
+	{	for(size_t i = 0; i < n_set; i++)
+		{	size_t left = (i + pass + 1) % n_set;
+			vec_set.binary_intersection(i, left, i, vec_set);
+			std::set<size_t> result;
+			std::set_intersection(
+				check[left].begin(), check[left].end(),
+				check[i].begin(), check[i].end(),
+				std::inserter(result, result.begin())
+			);
+			check[i] = result;
+			vec_set.binary_union(i, i, (i + 1) % n_set, vec_set);
+			check[i].insert(
+				check[(i + 1) % n_set].begin(), check[(i + 1) % n_set].end()
+			);
+			statistics stats = vec_set.statistics();
+			size_t size = 1 + stats.number_list_entry + stats.number_post
+				+ stats.number_not_used;
+			ok &= stats.number_not_used < size / 2 + 100;
+		}
+	}
+	ok &= equal_sets(vec_set, check);
+	//
+	return ok;
+}
+
 } // END empty namespace
 
 bool vector_set(void)
@@ -241,18 +495,30 @@ bool vector_set(void)
 	ok     &= test_no_other<CppAD::local::sparse_pack>();
 	ok     &= test_no_other<CppAD::local::sparse_list>();
 	ok     &= test_no_other<CppAD::local::sparse_sizevec>();
+	ok     &= test_no_other<CppAD::local::sparse_roaring>();
 	//
 	ok     &= test_yes_other<CppAD::local::sparse_pack>();
 	ok     &= test_yes_other<CppAD::local::sparse_list>();
 	ok     &= test_yes_other<CppAD::local::sparse_sizevec>();
+	ok     &= test_yes_other<CppAD::local::sparse_roaring>();
 	//
 	ok     &= test_intersection<CppAD::local::sparse_pack>();
 	ok     &= test_intersection<CppAD::local::sparse_list>();
 	ok     &= test_intersection<CppAD::local::sparse_sizevec>();
+	ok     &= test_intersection<CppAD::local::sparse_roaring>();
 	//
 	ok     &= test_post<CppAD::local::sparse_pack>();
 	ok     &= test_post<CppAD::local::sparse_list>();
 	ok     &= test_post<CppAD::local::sparse_sizevec>();
+	ok     &= test_post<CppAD::local::sparse_roaring>();
+	//
+	ok     &= test_random<CppAD::local::sparse_list>();
+	ok     &= test_random<CppAD::local::sparse_roaring>();
+	//
+	ok     &= test_add_element<CppAD::local::sparse_list>();
+	ok     &= test_add_element<CppAD::local::sparse_roaring>();
+	//
+	ok     &= test_compact();
 	//
 	return ok;
 }
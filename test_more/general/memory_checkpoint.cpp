@@ -0,0 +1,267 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/cppad.hpp>
+
+namespace {
+	using CppAD::AD;
+	using CppAD::ADFun;
+	using CppAD::NearEqual;
+	typedef CPPAD_TESTVECTOR(AD<double>) ADVector;
+	typedef CPPAD_TESTVECTOR(double)     DoubleVector;
+
+	// compare forward, reverse, and sparsity for two functions
+	bool check_same(ADFun<double>& f, ADFun<double>& g)
+	{	bool ok = true;
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		size_t n = f.Domain();
+		size_t m = f.Range();
+		ok &= g.Domain() == n;
+		ok &= g.Range()  == m;
+		//
+		DoubleVector x(n), dx(n);
+		for(size_t j = 0; j < n; ++j)
+		{	x[j]   = 0.5 + double(j) / double(n);
+			dx[j]  = double(j + 1);
+		}
+		DoubleVector y_f(m), y_g(m);
+		y_f = f.Forward(0, x);
+		y_g = g.Forward(0, x);
+		for(size_t i = 0; i < m; ++i)
+			ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+		y_f = f.Forward(1, dx);
+		y_g = g.Forward(1, dx);
+		for(size_t i = 0; i < m; ++i)
+			ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+		//
+		DoubleVector w(m), dw_f(2 * n), dw_g(2 * n);
+		for(size_t i = 0; i < m; ++i)
+			w[i] = double(i + 1);
+		dw_f = f.Reverse(2, w);
+		dw_g = g.Reverse(2, w);
+		for(size_t k = 0; k < 2 * n; ++k)
+			ok &= NearEqual(dw_g[k], dw_f[k], eps99, eps99);
+		//
+		// second order reverse with weights for both orders
+		DoubleVector w2(2 * m);
+		for(size_t k = 0; k < 2 * m; ++k)
+			w2[k] = double(k + 1);
+		dw_f = f.Reverse(2, w2);
+		dw_g = g.Reverse(2, w2);
+		for(size_t k = 0; k < 2 * n; ++k)
+			ok &= NearEqual(dw_g[k], dw_f[k], eps99, eps99);
+		//
+		// Hessian
+		DoubleVector h_f(n * n), h_g(n * n);
+		for(size_t i = 0; i < m; ++i)
+		{	h_f = f.Hessian(x, i);
+			h_g = g.Hessian(x, i);
+			for(size_t k = 0; k < n * n; ++k)
+				ok &= NearEqual(h_g[k], h_f[k], eps99, eps99);
+		}
+		//
+		// Jacobian sparsity
+		CppAD::vectorBool r(n * n), s_f(m * n), s_g(m * n);
+		for(size_t i = 0; i < n; ++i)
+			for(size_t j = 0; j < n; ++j)
+				r[i * n + j] = i == j;
+		s_f = f.ForSparseJac(n, r);
+		s_g = g.ForSparseJac(n, r);
+		for(size_t k = 0; k < m * n; ++k)
+			ok &= s_g[k] == s_f[k];
+		//
+		// Hessian sparsity
+		CppAD::vectorBool s(m), p_f(n * n), p_g(n * n);
+		for(size_t i = 0; i < m; ++i)
+			s[i] = true;
+		p_f = f.RevSparseHes(n, s);
+		p_g = g.RevSparseHes(n, s);
+		for(size_t k = 0; k < n * n; ++k)
+			ok &= p_g[k] == p_f[k];
+		//
+		return ok;
+	}
+
+	// record a function that has operations that are not part of segments
+	void record(ADFun<double>& f)
+	{	size_t n = 4;
+		ADVector ax(n);
+		for(size_t j = 0; j < n; ++j)
+			ax[j] = double(j + 1) / double(n);
+		CppAD::Independent(ax);
+		//
+		CppAD::VecAD<double> av(n);
+		ADVector ay(2);
+		ay[0] = 0.0;
+		ay[1] = 0.0;
+		for(size_t k = 0; k < 20; ++k)
+		{	size_t j = k % n;
+			AD<double> u = exp( - ax[j] * ay[0] ) + sin( ay[1] + ax[j] );
+			AD<double> v = u * u / (1.0 + ax[(j + 1) % n] * u);
+			// conditional expression and VecAD operations
+			ay[0] = CondExpLt(u, v, ay[0] + u, ay[0] - v);
+			av[ AD<double>( double(j) ) ] = v;
+			ay[1] += av[ AD<double>( double(j) ) ] * ax[j];
+		}
+		f.Dependent(ax, ay);
+	}
+
+	// the bound is satisfied
+	bool satisfied(void)
+	{	bool ok = true;
+		ADFun<double> f, g;
+		record(f);
+		g = f;
+		//
+		size_t max_var = f.size_var() / 2;
+		CppAD::memory_checkpoint<double> body(g, max_var);
+		ok &= 0 < body.size();
+		ok &= body.peak_var() <= max_var;
+		ok &= body.ok();
+		ok &= check_same(f, g);
+		//
+		// optimize can be used after splitting
+		g.optimize();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// the bound is not possible
+	bool not_possible(void)
+	{	bool ok = true;
+		ADFun<double> f, g;
+		record(f);
+		g = f;
+		//
+		size_t max_var = 1;
+		CppAD::memory_checkpoint<double> body(g, max_var);
+		ok &= 0 < body.size();
+		ok &= max_var < body.peak_var();
+		ok &= ! body.ok();
+		ok &= body.peak_var() < f.size_var();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// operations that are not used (segments with no results)
+	bool not_used(void)
+	{	bool ok = true;
+		size_t n = 2;
+		ADVector ax(n), ay(1);
+		ax[0] = 0.5;
+		ax[1] = 1.5;
+		CppAD::Independent(ax);
+		ay[0] = 0.0;
+		for(size_t k = 0; k < 10; ++k)
+		{	AD<double> u = ax[k % n] * ay[0] + 1.0;
+			u = sin(u) * cos(u) + u * u;
+			ay[0] = CondExpGt(u, ax[0], u, ay[0] - u);
+			// conditional expressions are not in segments so these
+			// operations are a separate segment
+			AD<double> not_used = cos(u) * sin(u) / (1.0 + u * u);
+			ay[0] = CondExpLt(ay[0], ax[1], ay[0], ax[1]);
+		}
+		ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		size_t max_var = f.size_var() / 4;
+		CppAD::memory_checkpoint<double> body(g, max_var);
+		ok &= 0 < body.size();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// second order derivatives with conditional expressions and results
+	// of a segment that are equal (after optimization of its function)
+	bool second_order(void)
+	{	bool ok = true;
+		size_t n = 3;
+		ADVector ax(n), ay(2);
+		for(size_t j = 0; j < n; ++j)
+			ax[j] = double(j + 1) / double(n);
+		CppAD::Independent(ax);
+		ay[0] = ax[0];
+		ay[1] = ax[1];
+		for(size_t k = 0; k < 10; ++k)
+		{	size_t j = k % n;
+			AD<double> u = sin( ax[j] * ay[0] ) * ay[0] + cos( ay[0] );
+			AD<double> v = sin( ax[j] * ay[0] ) * ay[0] + cos( ay[0] );
+			ay[0] = CondExpGt(u, ax[j], v, 0.5 * u);
+			ay[1] = ay[1] + u * ax[j];
+		}
+		ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		size_t max_var = f.size_var() / 3;
+		CppAD::memory_checkpoint<double> body(g, max_var);
+		ok &= 0 < body.size();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// cumulative summation operators in an optimized operation sequence
+	bool cumulative_sum(void)
+	{	bool ok = true;
+		size_t n = 3;
+		ADVector ax(n), ay(1);
+		for(size_t j = 0; j < n; ++j)
+			ax[j] = double(j + 1) / double(n);
+		CppAD::Independent(ax);
+		ay[0] = 0.0;
+		for(size_t k = 0; k < 20; ++k)
+		{	AD<double> u = ax[k % n] * ay[0];
+			ay[0] = ay[0] + sin(u) - ax[0] + 2.0 - ax[1] + cos(u);
+		}
+		ADFun<double> f(ax, ay), g;
+		f.optimize();
+		g = f;
+		//
+		size_t max_var = f.size_var() / 2;
+		CppAD::memory_checkpoint<double> body(g, max_var);
+		ok &= 0 < body.size();
+		ok &= body.ok();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// nothing to do
+	bool no_change(void)
+	{	bool ok = true;
+		ADFun<double> f, g;
+		record(f);
+		g = f;
+		//
+		size_t max_var = f.size_var();
+		CppAD::memory_checkpoint<double> body(g, max_var);
+		ok &= body.size()     == 0;
+		ok &= body.peak_var() == f.size_var();
+		ok &= g.size_op()     == f.size_op();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+}
+
+bool memory_checkpoint(void)
+{	bool ok = true;
+	ok &= satisfied();
+	ok &= not_possible();
+	ok &= not_used();
+	ok &= second_order();
+	ok &= cumulative_sum();
+	ok &= no_change();
+	return ok;
+}
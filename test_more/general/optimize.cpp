@@ -603,6 +603,88 @@ namespace {
 
 		return ok;
 	}
+	bool vecad_forward(void)
+	{	// Test VecAD store to load forwarding and dead store removal
+		bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+		// domain space vector
+		size_t n = 2;
+		vector< AD<double> > ax(n);
+		ax[0] = 0.5;
+		ax[1] = 1.5;
+
+		// vector with initial values that are parameters
+		size_t n_v = 3;
+		CppAD::VecAD<double> v(n_v);
+		for(size_t i = 0; i < n_v; ++i)
+			v[i] = double(i + 1);
+
+		// declare independent variables and start tape recording
+		CppAD::Independent(ax);
+		AD<double> zero(0), one(1), two(2);
+
+		size_t m = 6;
+		vector< AD<double> > ay(m);
+
+		// load of an initial value
+		ay[0] = v[two] * ax[0];
+
+		// store of a parameter and a variable, then loads
+		v[one]  = 4.0;
+		v[zero] = sin( ax[1] );
+		ay[1]   = v[zero] * v[one];
+
+		// load that is only used by one case of a conditional expression
+		ay[2] = CondExpLt(ax[0], ax[1], v[zero] + 1.0, cos( ax[0] ) );
+
+		// store using a variable index; the following loads are not replaced
+		v[ ax[0] ] = ax[1];
+		ay[3]      = v[zero] + v[one];
+
+		// a store with a parameter index after the store with a variable index
+		v[zero] = exp( ax[0] );
+		v[zero] = ax[0] * ax[1];
+		ay[4]   = v[zero] + v[two];
+
+		// a store with a parameter index that is only used by a load with
+		// a variable index (x[1] is always one in the tests below)
+		v[one] = cos( ax[1] );
+		ay[5]  = v[ ax[1] ];
+
+		// create f: x -> y and stop tape recording
+		CppAD::ADFun<double> f(ax, ay), g;
+		g = f;
+		if( conditional_skip_ )
+			g.optimize();
+		else
+			g.optimize("no_conditional_skip");
+		//
+		// the exp operator (and its store) has been removed
+		ok &= g.size_var() < f.size_var();
+		//
+		vector<double> x(n), y_f(m), y_g(m);
+		for(size_t k = 0; k < 3; ++k)
+		{	// cases where x[0] < x[1], x[0] == x[1] and x[0] > x[1]
+			x[0] = double(k);
+			x[1] = 1.0;
+			y_f  = f.Forward(0, x);
+			y_g  = g.Forward(0, x);
+			for(size_t i = 0; i < m; ++i)
+				ok &= NearEqual(y_g[i], y_f[i], eps10, eps10);
+			//
+			vector<double> w(m), dw_f(n), dw_g(n);
+			for(size_t i = 0; i < m; ++i)
+				w[i] = double(i + 1);
+			dw_f = f.Reverse(1, w);
+			dw_g = g.Reverse(1, w);
+			for(size_t j = 0; j < n; ++j)
+				ok &= NearEqual(dw_g[j], dw_f[j], eps10, eps10);
+		}
+		return ok;
+	}
 	bool depend_three(void)
 	{	// Power function is a special case for optimize
 		bool ok = true;
@@ -1014,6 +1096,65 @@ namespace {
 
 		return ok;
 	}
+	// -------------------------------------------------------------------
+	bool duplicate_five(void)
+	{	// Check that duplicate expressions are found when they are far apart
+		// in a large operation sequence (the previous hash table had a fixed
+		// number of buckets and forgot old operators when they were full).
+		bool ok = true;
+		using CppAD::AD;
+		using CppAD::NearEqual;
+		double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+
+		// number of terms in each sequence (three variables per term)
+		size_t N = std::min(
+			size_t(50000),
+			size_t(std::numeric_limits<CPPAD_TAPE_ADDR_TYPE>::max()) / 8
+		);
+
+		// domain and range space vectors
+		size_t n = 2, m = 2;
+		CppAD::vector< AD<double> > X(n), Y(m);
+		X[0] = 0.5;
+		X[1] = 0.6;
+
+		// declare independent variables and start tape recording
+		CppAD::Independent(X);
+
+		// compute the same sequence twice
+		CppAD::vector< AD<double> > R(N), S(N);
+		R[0] = S[0] = X[0];
+		R[1] = S[1] = X[1];
+		for(size_t k = 2; k < N; k++)
+			R[k] = sin( R[k-1] - R[k-2] );
+		for(size_t k = 2; k < N; k++)
+			S[k] = sin( S[k-1] - S[k-2] );
+		Y[0] = R[N-1];
+		Y[1] = S[N-1];
+
+		// create f: X -> Y and stop tape recording
+		CppAD::ADFun<double> F(X, Y);
+
+		// each term uses three variables (the subtract, sin, and cos)
+		ok &= F.size_var() == 1 + n + 2 * 3 * (N - 2);
+
+		if( conditional_skip_ )
+			F.optimize();
+		else
+			F.optimize("no_conditional_skip");
+
+		// every operator in the second sequence is a duplicate
+		ok &= F.size_var() == 1 + n + 3 * (N - 2);
+
+		CppAD::vector<double> x(n), y(m);
+		x[0] = 0.5;
+		x[1] = 0.6;
+		y    = F.Forward(0, x);
+		ok  &= NearEqual(y[0], Value(Y[0]), eps10, eps10);
+		ok  &= y[0] == y[1];
+
+		return ok;
+	}
 	// ====================================================================
 	bool cumulative_sum(void)
 	{	// test conversion of a sequence of additions and subtraction
@@ -1786,6 +1927,65 @@ namespace {
 
 		return ok;
 	}
+	// ----------------------------------------------------------------
+	void l_algo(
+		const CppAD::vector< CppAD::AD<double> >& ax ,
+		      CppAD::vector< CppAD::AD<double> >& ay )
+	{	ay[0] = exp( - ax[0] * ax[1] );
+		ay[1] = sin( ax[0] + ax[1] );
+	}
+	//
+	// Test bug where one result of an atomic function was conditionally
+	// skipped separately from the other operations in the call
+	bool cond_exp_atomic_result(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::NearEqual;
+		double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+		using CppAD::vector;
+
+		// Create a checkpoint version of the function l_algo
+		vector< AD<double> > au(2), av(2);
+		au[0] = 1.0;
+		au[1] = 2.0;
+		CppAD::checkpoint<double> l_check("l_check", l_algo, au, av);
+
+		vector< AD<double> > ax(2), ay(2);
+		ax[0] = 1.0;
+		ax[1] = 2.0;
+		Independent(ax);
+		au[0] = ax[0] * ax[1];
+		au[1] = ax[1] + 1.0;
+		l_check(au, av);
+		// av[0] is only used by one case, av[1] is always used
+		ay[0] = CondExpLt(ax[0], ax[1], av[0], ax[0]);
+		ay[1] = av[1];
+		CppAD::ADFun<double> f;
+		f.Dependent(ax, ay);
+
+		// case where av[0] is not used
+		vector<double> x(2), y_before(2), y_after(2);
+		vector<double> w(2), dw_before(2), dw_after(2);
+		x[0]      = 3.0;
+		x[1]      = 2.0;
+		w[0]      = 1.0;
+		w[1]      = 2.0;
+		y_before  = f.Forward(0, x);
+		dw_before = f.Reverse(1, w);
+		if( conditional_skip_ )
+			f.optimize();
+		else
+			f.optimize("no_conditional_skip");
+		y_after   = f.Forward(0, x);
+		dw_after  = f.Reverse(1, w);
+
+		for(size_t i = 0; i < 2; ++i)
+		{	ok &= NearEqual(y_before[i] , y_after[i], eps10, eps10);
+			ok &= NearEqual(dw_before[i], dw_after[i], eps10, eps10);
+		}
+
+		return ok;
+	}
 	// -----------------------------------------------------------------------
 	// Test reverse mode conditionalay skipping commands.
 	template <class Type>
@@ -2061,6 +2261,136 @@ namespace {
 		//
 		return ok;
 	}
+	// -----------------------------------------------------------------------
+	// Test simplification, renumbering, and optimizing a function more than
+	// once (the second optimization starts with cumulative summation operators)
+	bool simplify_twice(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		using CppAD::NearEqual;
+		double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+		//
+		size_t n = 2, m = 4;
+		vector< AD<double> > ax(n), ap(1), ay(m);
+		ax[0] = 0.5;
+		ax[1] = 2.0;
+		ap[0] = 3.0;
+		size_t abort_op_index = 0;
+		bool   record_compare = true;
+		CppAD::Independent(ax, abort_op_index, record_compare, ap);
+		//
+		// zero and one are constants that are computed using variables
+		AD<double> zero = ax[0] - ax[0];
+		AD<double> one  = ax[1] / ax[1];
+		//
+		// summation that includes a dynamic parameter
+		ay[0] = ax[0] + ax[1] * one + ap[0] - (zero + ax[1]) + 1.0;
+		//
+		// conditional expression where comparison is constant
+		ay[1] = CondExpLt(zero, one, pow(ax[0], 2.0), ax[1]);
+		//
+		// VecAD stores of parameters using parameter and variable indices
+		CppAD::VecAD<double> v(2);
+		AD<double> index = ax[0] - 0.5;
+		v[ AD<double>(1) ] = 4.0;
+		v[index]           = 5.0 * one;
+		ay[2] = v[ AD<double>(1) ] * v[index];
+		//
+		// a dependent variable that is a constant
+		ay[3] = zero * ax[1];
+		//
+		CppAD::ADFun<double> f(ax, ay);
+		//
+		vector<double> x(n), p(1), y(m), check(m), jac(m * n);
+		x[0] = 0.5;
+		x[1] = 3.0;
+		p[0] = 4.0;
+		check[0] = x[0] + p[0] + 1.0;
+		check[1] = x[0] * x[0];
+		check[2] = 4.0 * 5.0;
+		check[3] = 0.0;
+		for(size_t k = 0; k < 3; k++)
+		{	if( k == 0 )
+				f.optimize("simplify");
+			else
+				f.optimize();
+			f.new_dynamic(p);
+			y   = f.Forward(0, x);
+			jac = f.Jacobian(x);
+			for(size_t i = 0; i < m; i++)
+				ok &= NearEqual(y[i], check[i], eps10, eps10);
+			ok &= NearEqual(jac[0 * n + 0], 1.0, eps10, eps10);
+			ok &= NearEqual(jac[1 * n + 0], 2.0 * x[0], eps10, eps10);
+			for(size_t i = 0; i < m; i++)
+			{	for(size_t j = 0; j < n; j++)
+				{	if( (j != 0) | (i > 1) )
+						ok &= jac[i * n + j] == 0.0;
+				}
+			}
+		}
+		return ok;
+	}
+	// -----------------------------------------------------------------------
+	// Test that using multiple threads to match operators
+	// does not change the optimized operation sequence
+	bool num_threads_match(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+		double eps10 = 10.0 * std::numeric_limits<double>::epsilon();
+		//
+		size_t n = 3, N = 300;
+		vector< AD<double> > ax(n), av;
+		for(size_t j = 0; j < n; j++)
+		{	ax[j] = double(j + 1) / double(n);
+			av.push_back( ax[j] );
+		}
+		CppAD::Independent(ax);
+		//
+		// many expressions that are equivalent to previous expressions
+		for(size_t k = 0; k < N; k++)
+		{	AD<double> a = av[ (7 * k) % av.size() ];
+			AD<double> b = av[ (k * k) % av.size() ];
+			AD<double> c;
+			switch( k % 5 )
+			{	case 0: c = a + b;    break;
+				case 1: c = b * a;    break;
+				case 2: c = sin(a);   break;
+				case 3: c = a - 2.0;  break;
+				case 4: c = CondExpLt(a, b, a * b, b + a); break;
+			}
+			av.push_back( c / (1.0 + c * c) );
+		}
+		size_t m = N / 10;
+		vector< AD<double> > ay(m);
+		for(size_t i = 0; i < m; i++)
+			ay[i] = av[ n + 10 * i ];
+		CppAD::ADFun<double> f(ax, ay), f_opt, g;
+		f_opt = f;
+		f_opt.optimize();
+		//
+		vector<double> x(n), y_f(m), y_g(m);
+		for(size_t j = 0; j < n; j++)
+			x[j] = double(n - j) / double(n);
+		for(size_t num_threads = 2; num_threads < 5; num_threads++)
+		{	g = f;
+			std::string options = "num_threads=";
+			options += CppAD::to_string(num_threads);
+			g.optimize(options);
+			//
+			ok &= f_opt.size_op()     == g.size_op();
+			ok &= f_opt.size_op_arg() == g.size_op_arg();
+			ok &= f_opt.size_var()    == g.size_var();
+			ok &= f_opt.size_par()    == g.size_par();
+			//
+			y_f = f_opt.Forward(0, x);
+			y_g = g.Forward(0, x);
+			for(size_t i = 0; i < m; i++)
+				ok &= CppAD::NearEqual(y_f[i], y_g[i], eps10, eps10);
+		}
+		return ok;
+	}
 }
 
 bool optimize(void)
@@ -2071,6 +2401,10 @@ bool optimize(void)
 	// check optimization with print_for operations
 	ok     &= check_print_for();
 
+	// check simplification and optimizing twice
+	ok     &= simplify_twice();
+	ok     &= num_threads_match();
+
 	// optimize an example ODE
 	ok &= optimize_ode();
 
@@ -2104,6 +2438,8 @@ bool optimize(void)
 		// check reverse dependency analysis optimization
 		ok     &= depend_one();
 		ok     &= depend_two();
+		// check VecAD store to load forwarding and dead store removal
+		ok     &= vecad_forward();
 		ok     &= depend_three();
 		ok     &= depend_four();
 		// check removal of duplicate expressions
@@ -2111,6 +2447,7 @@ bool optimize(void)
 		ok     &= duplicate_two();
 		ok     &= duplicate_three();
 		ok     &= duplicate_four();
+		ok     &= duplicate_five();
 		// convert sequence of additions to cumulative summation
 		ok     &= cumulative_sum();
 		ok     &= forward_csum();
@@ -2133,6 +2470,8 @@ bool optimize(void)
 		ok     &= cond_exp_skip_atomic();
 		// check conditional dependence through atomic function
 		ok     &= cond_exp_atomic_dependence();
+		// check conditional skip of one result of an atomic function
+		ok     &= cond_exp_atomic_result();
 		// check reverse mode conditional skipping
 		ok     &= cond_exp_reverse();
 		// check case where an expresion needed by both true and false case
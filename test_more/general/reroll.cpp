@@ -0,0 +1,226 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/cppad.hpp>
+
+namespace {
+	using CppAD::AD;
+	using CppAD::ADFun;
+	using CppAD::NearEqual;
+	typedef CPPAD_TESTVECTOR(AD<double>) ADVector;
+	typedef CPPAD_TESTVECTOR(double)     DoubleVector;
+
+	// computation for one element of a mesh
+	AD<double> element(const AD<double>& u, const AD<double>& v)
+	{	AD<double> d = v - u;
+		AD<double> s = sqrt( 1.0 + d * d );
+		AD<double> a = exp( - u * v ) / s;
+		return a * cos(u + v) + d * s;
+	}
+
+	// compare forward, reverse, and sparsity for two functions
+	bool check_same(ADFun<double>& f, ADFun<double>& g)
+	{	bool ok = true;
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		size_t n = f.Domain();
+		size_t m = f.Range();
+		ok &= g.Domain() == n;
+		ok &= g.Range()  == m;
+		//
+		DoubleVector x(n), dx(n), ddx(n);
+		for(size_t j = 0; j < n; ++j)
+		{	x[j]   = 0.5 + double(j) / double(n);
+			dx[j]  = double(j + 1);
+			ddx[j] = 1.0 / double(j + 1);
+		}
+		DoubleVector y_f(m), y_g(m);
+		y_f = f.Forward(0, x);
+		y_g = g.Forward(0, x);
+		for(size_t i = 0; i < m; ++i)
+			ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+		y_f = f.Forward(1, dx);
+		y_g = g.Forward(1, dx);
+		for(size_t i = 0; i < m; ++i)
+			ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+		y_f = f.Forward(2, ddx);
+		y_g = g.Forward(2, ddx);
+		for(size_t i = 0; i < m; ++i)
+			ok &= NearEqual(y_g[i], y_f[i], eps99, eps99);
+		//
+		DoubleVector w(m), dw_f(3 * n), dw_g(3 * n);
+		for(size_t i = 0; i < m; ++i)
+			w[i] = double(i + 1);
+		dw_f = f.Reverse(3, w);
+		dw_g = g.Reverse(3, w);
+		for(size_t k = 0; k < 3 * n; ++k)
+			ok &= NearEqual(dw_g[k], dw_f[k], eps99, eps99);
+		//
+		// Jacobian sparsity
+		CppAD::vectorBool r(n * n), s_f(m * n), s_g(m * n);
+		for(size_t i = 0; i < n; ++i)
+			for(size_t j = 0; j < n; ++j)
+				r[i * n + j] = i == j;
+		s_f = f.ForSparseJac(n, r);
+		s_g = g.ForSparseJac(n, r);
+		for(size_t k = 0; k < m * n; ++k)
+			ok &= s_g[k] == s_f[k];
+		//
+		// Hessian sparsity
+		CppAD::vectorBool s(m), h_f(n * n), h_g(n * n);
+		for(size_t i = 0; i < m; ++i)
+			s[i] = true;
+		h_f = f.RevSparseHes(n, s);
+		h_g = g.RevSparseHes(n, s);
+		for(size_t k = 0; k < n * n; ++k)
+			ok &= h_g[k] == h_f[k];
+		//
+		return ok;
+	}
+
+	// the elements of a mesh (arguments do not follow a simple pattern)
+	bool mesh(void)
+	{	bool ok = true;
+		size_t n_element = 12;
+		size_t n = n_element + 1;
+		ADVector ax(n);
+		for(size_t j = 0; j < n; ++j)
+			ax[j] = double(j + 1);
+		CppAD::Independent(ax);
+		//
+		ADVector ay(2);
+		ay[0] = ax[0];
+		AD<double> last = 0.0;
+		for(size_t e = 0; e < n_element; ++e)
+		{	// element e uses ax[e] and ax[(5 * e + 1) % n]
+			size_t j = (5 * e + 1) % n;
+			last     = element(ax[e], ax[j]);
+			ay[0]   += last;
+		}
+		ay[1] = last * ax[0];
+		ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		CppAD::reroll<double> body(g);
+		ok &= body.size()   == 1;
+		ok &= body.n_call() == n_element;
+		ok &= g.size_op() < f.size_op();
+		ok &= check_same(f, g);
+		//
+		// optimize can be used after reroll
+		g.optimize();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// a time loop where each step uses the previous step
+	bool time_loop(void)
+	{	bool ok = true;
+		size_t n = 3;
+		ADVector ax(n);
+		for(size_t j = 0; j < n; ++j)
+			ax[j] = 0.1 * double(j + 1);
+		CppAD::Independent(ax);
+		//
+		ADVector ay(ax), az(n);
+		size_t n_step = 15;
+		for(size_t k = 0; k < n_step; ++k)
+		{	for(size_t i = 0; i < n; ++i)
+				az[i] = ay[(i + 1) % n] * sin( ay[i] ) + 0.5 * ay[i];
+			ay = az;
+		}
+		ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		CppAD::reroll<double> body(g, 100);
+		ok &= body.size()   == 1;
+		ok &= body.n_call() == n_step;
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// the last repeat has more results than the others
+	bool last_repeat(void)
+	{	bool ok = true;
+		size_t n = 3;
+		ADVector ax(n);
+		for(size_t j = 0; j < n; ++j)
+			ax[j] = 0.1 * double(j + 1);
+		CppAD::Independent(ax);
+		//
+		// each step is ten operators with three arguments and one result
+		size_t n_step = 7;
+		ADVector ay(2), at(9);
+		AD<double> y = ax[2];
+		for(size_t k = 0; k < n_step; ++k)
+		{	at[0] = y * ax[0];
+			at[1] = at[0] + 1.0;
+			at[2] = at[1] * at[1];
+			at[3] = at[2] - 2.0;
+			at[4] = at[3] * ax[1];
+			at[5] = at[4] + 3.0;
+			at[6] = at[5] * at[0];
+			at[7] = at[6] - at[1];
+			at[8] = at[7] * 0.5;
+			y     = at[8] + at[2];
+		}
+		ay[0] = y;
+		// every operator in the last step is a result, so its call would
+		// have more operators than the step
+		ay[1] = 0.0;
+		for(size_t i = 0; i < 9; ++i)
+			ay[1] += at[i];
+		ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		// the group stops at the step before the last step
+		// (instead of using segments that are two steps long)
+		size_t max_op = 20;
+		CppAD::reroll<double> body(g, max_op);
+		ok &= body.size()   == 1;
+		ok &= body.n_call() == n_step - 1;
+		ok &= g.size_op() < f.size_op();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+
+	// nothing is repeated
+	bool no_repeat(void)
+	{	bool ok = true;
+		size_t n = 2;
+		ADVector ax(n), ay(1);
+		ax[0] = 1.0;
+		ax[1] = 2.0;
+		CppAD::Independent(ax);
+		ay[0] = exp( ax[0] ) * sin( ax[1] ) / ( ax[0] + ax[1] );
+		ADFun<double> f(ax, ay), g;
+		g = f;
+		//
+		CppAD::reroll<double> body(g);
+		ok &= body.size()   == 0;
+		ok &= body.n_call() == 0;
+		ok &= g.size_op()   == f.size_op();
+		ok &= check_same(f, g);
+		//
+		return ok;
+	}
+}
+
+bool reroll(void)
+{	bool ok = true;
+	ok &= mesh();
+	ok &= time_loop();
+	ok &= last_repeat();
+	ok &= no_repeat();
+	return ok;
+}
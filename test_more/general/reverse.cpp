@@ -1,5 +1,5 @@
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-17 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the
@@ -451,6 +451,50 @@ bool reverse_mul(void)
 	return ok;
 }
 // ----------------------------------------------------------------------------
+// two dependent variables that are the same variable
+bool reverse_same_dependent(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+
+	size_t n = 2, m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+	ax[0] = 1.;
+	ax[1] = 2.;
+	CppAD::Independent(ax);
+	ay[0] = ax[0] * ax[1];
+	ay[1] = ay[0];
+	CppAD::ADFun<double> f(ax, ay);
+
+	CPPAD_TESTVECTOR(double) x0(n), x1(n);
+	x0[0] = 3.;
+	x0[1] = 4.;
+	x1[0] = 5.;
+	x1[1] = 6.;
+	f.Forward(0, x0);
+	f.Forward(1, x1);
+
+	// weights for the zero and first order coefficients of each y_i
+	size_t p = 2;
+	CPPAD_TESTVECTOR(double) w(m*p), dw(n*p);
+	w[0*p+0] = 1.;
+	w[0*p+1] = 2.;
+	w[1*p+0] = 3.;
+	w[1*p+1] = 4.;
+	dw = f.Reverse(p, w);
+
+	// y_0 = y_1 = x_0 * x_1 so the weights are summed
+	double w0 = w[0*p+0] + w[1*p+0];
+	double w1 = w[0*p+1] + w[1*p+1];
+	ok &= NearEqual(dw[0*p+0], w0 * x0[1] + w1 * x1[1], eps, eps);
+	ok &= NearEqual(dw[1*p+0], w0 * x0[0] + w1 * x1[0], eps, eps);
+	ok &= NearEqual(dw[0*p+1], w1 * x0[1], eps, eps);
+	ok &= NearEqual(dw[1*p+1], w1 * x0[0], eps, eps);
+
+	return ok;
+}
+// ----------------------------------------------------------------------------
 } // End empty namespace
 
 # include <vector>
@@ -459,6 +503,7 @@ bool reverse(void)
 {	bool ok = true;
 	ok &= reverse_one();
 	ok &= reverse_mul();
+	ok &= reverse_same_dependent();
 
 	ok &= reverse_any_cases< CppAD::vector  <double> >();
 	ok &= reverse_any_cases< std::vector    <double> >();
@@ -0,0 +1,280 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check sparse Jacobians, Hessians, and subgraph sparsity patterns computed
+using multiple threads (n_thread argument) are the same as when one thread
+is used.
+*/
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+typedef CppAD::vector<size_t>             s_vector;
+typedef CppAD::vector<double>             d_vector;
+typedef CppAD::vector< CppAD::AD<double> > a_vector;
+
+// algorithm used for checkpoint function
+void square_algo(const a_vector& au, a_vector& av)
+{	av[0] = au[0] * au[0]; }
+
+// f(x) has a banded Jacobian and uses conditional expressions and VecAD
+// (if square is not null, it is an atomic function that is also used)
+// (if vecad is false, VecAD is not used)
+CppAD::ADFun<double>* record(
+	size_t n, CppAD::checkpoint<double>* square, bool vecad = true
+)
+{	using CppAD::AD;
+	size_t m = n;
+	//
+	a_vector ax(n), ay(m);
+	for(size_t j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+	CppAD::Independent(ax);
+	//
+	CppAD::VecAD<double> v(n);
+	for(size_t j = 0; j < n; j++)
+	{	AD<double> index = double(j);
+		v[index] = ax[j] * ax[j];
+	}
+	AD<double> zero(0.0);
+	for(size_t i = 0; i < m; i++)
+	{	AD<double> index = double(i);
+		if( vecad )
+			ay[i] = v[index];
+		else
+			ay[i] = ax[i] * ax[i];
+		if( i + 1 < n )
+			ay[i] += CppAD::CondExpGt(ax[i], zero, ax[i] * ax[i+1], ax[i+1]);
+		if( i > 0 )
+			ay[i] += sin( ax[i-1] ) * ax[i];
+	}
+	if( square != CPPAD_NULL )
+	{	a_vector au(1), av(1);
+		au[0] = ax[0];
+		(*square)(au, av);
+		ay[0] += av[0];
+	}
+	return new CppAD::ADFun<double>(ax, ay);
+}
+
+// Taylor coefficients in f (from the previous call to Forward)
+// (includes the result of a second order forward for one direction)
+d_vector taylor(CppAD::ADFun<double>& f)
+{	size_t n = f.Domain();
+	size_t m = f.Range();
+	d_vector result(2 + m);
+	result[0] = double( f.size_order() );
+	result[1] = double( f.size_direction() );
+	for(size_t i = 0; i < m; i++)
+		result[2 + i] = 0.0;
+	if( f.size_order() == 2 && f.size_direction() == 1 )
+	{	d_vector x2(n), y2(m);
+		for(size_t j = 0; j < n; j++)
+			x2[j] = 1.0;
+		y2 = f.Forward(2, x2);
+		for(size_t i = 0; i < m; i++)
+			result[2 + i] = y2[i];
+	}
+	return result;
+}
+
+bool check_jac(CppAD::ADFun<double>& f, const d_vector& x)
+{	bool ok = true;
+	size_t n = f.Domain();
+	//
+	// sparsity pattern for Jacobian
+	CppAD::sparse_rc<s_vector> pattern_in(n, n, n), pattern_out;
+	for(size_t j = 0; j < n; j++)
+		pattern_in.set(j, j, j);
+	f.for_jac_sparsity(pattern_in, false, false, false, pattern_out);
+	//
+	std::string coloring = "cppad";
+	for(size_t mode = 0; mode < 3; mode++)
+	{	CppAD::sparse_rcv<s_vector, d_vector> one( pattern_out );
+		CppAD::sparse_rcv<s_vector, d_vector> four( pattern_out );
+		CppAD::sparse_jac_work work_one, work_four;
+		size_t n_sweep_one = 0, n_sweep_four = 0;
+		if( mode < 2 )
+		{	size_t group_max = 1 + 2 * mode;
+			n_sweep_one = f.sparse_jac_for(
+				group_max, x, one, pattern_out, coloring, work_one, 1
+			);
+			d_vector taylor_one = taylor(f);
+			n_sweep_four = f.sparse_jac_for(
+				group_max, x, four, pattern_out, coloring, work_four, 4
+			);
+			// f has the same Taylor coefficients
+			d_vector taylor_four = taylor(f);
+			for(size_t i = 0; i < taylor_one.size(); i++)
+				ok &= taylor_one[i] == taylor_four[i];
+		}
+		else
+		{	n_sweep_one = f.sparse_jac_rev(
+				x, one, pattern_out, coloring, work_one, 1
+			);
+			n_sweep_four = f.sparse_jac_rev(
+				x, four, pattern_out, coloring, work_four, 4
+			);
+		}
+		ok &= n_sweep_one == n_sweep_four;
+		for(size_t k = 0; k < pattern_out.nnz(); k++)
+			ok &= one.val()[k] == four.val()[k];
+	}
+	// check one value
+	d_vector jac = f.Jacobian(x);
+	CppAD::sparse_rcv<s_vector, d_vector> subset( pattern_out );
+	CppAD::sparse_jac_work work;
+	f.sparse_jac_rev(x, subset, pattern_out, coloring, work, 3);
+	for(size_t k = 0; k < pattern_out.nnz(); k++)
+	{	size_t i = subset.row()[k];
+		size_t j = subset.col()[k];
+		ok &= CppAD::NearEqual(subset.val()[k], jac[i * n + j], 1e-10, 1e-10);
+	}
+	return ok;
+}
+
+bool check_hes(CppAD::ADFun<double>& f, const d_vector& x)
+{	bool ok = true;
+	size_t n = f.Domain();
+	size_t m = f.Range();
+	//
+	d_vector w(m);
+	for(size_t i = 0; i < m; i++)
+		w[i] = double(i + 1);
+	//
+	// sparsity pattern for Hessian
+	CppAD::sparse_rc<s_vector> pattern_in(n, n, n), pattern_jac, pattern;
+	for(size_t j = 0; j < n; j++)
+		pattern_in.set(j, j, j);
+	f.for_jac_sparsity(pattern_in, false, false, false, pattern_jac);
+	CppAD::vector<bool> select_range(m);
+	for(size_t i = 0; i < m; i++)
+		select_range[i] = true;
+	f.rev_hes_sparsity(select_range, false, false, pattern);
+	//
+	std::string coloring = "cppad.symmetric";
+	CppAD::sparse_rcv<s_vector, d_vector> one( pattern ), four( pattern );
+	CppAD::sparse_hes_work work_one, work_four;
+	size_t n_sweep_one = f.sparse_hes(
+		x, w, one, pattern, coloring, work_one, 1
+	);
+	d_vector taylor_one = taylor(f);
+	size_t n_sweep_four = f.sparse_hes(
+		x, w, four, pattern, coloring, work_four, 4
+	);
+	ok &= n_sweep_one == n_sweep_four;
+	//
+	// f has the same Taylor coefficients
+	d_vector taylor_four = taylor(f);
+	for(size_t i = 0; i < taylor_one.size(); i++)
+		ok &= taylor_one[i] == taylor_four[i];
+	//
+	d_vector hes = f.Hessian(x, w);
+	for(size_t k = 0; k < pattern.nnz(); k++)
+	{	size_t i = pattern.row()[k];
+		size_t j = pattern.col()[k];
+		ok &= one.val()[k] == four.val()[k];
+		ok &= CppAD::NearEqual(four.val()[k], hes[i * n + j], 1e-10, 1e-10);
+	}
+	return ok;
+}
+
+bool check_subgraph(CppAD::ADFun<double>& f, const d_vector& x)
+{	bool ok = true;
+	size_t n = f.Domain();
+	size_t m = f.Range();
+	//
+	CppAD::vector<bool> select_domain(n), select_range(m);
+	for(size_t j = 0; j < n; j++)
+		select_domain[j] = true;
+	for(size_t i = 0; i < m; i++)
+		select_range[i] = i % 3 != 1;
+	//
+	// sparsity patterns
+	CppAD::sparse_rc<s_vector> one, four;
+	bool transpose = false;
+	f.subgraph_sparsity(select_domain, select_range, transpose, one, 1);
+	f.subgraph_sparsity(select_domain, select_range, transpose, four, 4);
+	ok &= one.nnz() == four.nnz();
+	for(size_t k = 0; k < one.nnz(); k++)
+	{	ok &= one.row()[k] == four.row()[k];
+		ok &= one.col()[k] == four.col()[k];
+	}
+	s_vector one_order  = one.row_major();
+	//
+	// Jacobian with the same sparsity pattern
+	CppAD::sparse_rcv<s_vector, d_vector> jac_one, jac_four;
+	f.subgraph_jac_rev(select_domain, select_range, x, jac_one, 1);
+	f.subgraph_jac_rev(select_domain, select_range, x, jac_four, 4);
+	ok &= jac_one.nnz() == one.nnz();
+	ok &= jac_four.nnz() == one.nnz();
+	d_vector jac = f.Jacobian(x);
+	for(size_t k = 0; k < one.nnz(); k++)
+	{	size_t i = jac_four.row()[k];
+		size_t j = jac_four.col()[k];
+		ok &= i == one.row()[ one_order[k] ] && j == one.col()[ one_order[k] ];
+		ok &= jac_one.val()[k] == jac_four.val()[k];
+		ok &= CppAD::NearEqual(jac_four.val()[k], jac[i * n + j], 1e-10, 1e-10);
+	}
+	//
+	// subset that includes elements that are not in the sparsity pattern
+	CppAD::sparse_rc<s_vector> pattern(m, n, 2 * m);
+	for(size_t i = 0; i < m; i++)
+	{	pattern.set(2 * i, i, (i + 3) % n);
+		pattern.set(2 * i + 1, i, i);
+	}
+	CppAD::sparse_rcv<s_vector, d_vector> subset_one( pattern );
+	CppAD::sparse_rcv<s_vector, d_vector> subset_four( pattern );
+	f.subgraph_jac_rev(x, subset_one, 1);
+	f.subgraph_jac_rev(x, subset_four, 4);
+	for(size_t k = 0; k < pattern.nnz(); k++)
+	{	size_t i = pattern.row()[k];
+		size_t j = pattern.col()[k];
+		ok &= subset_one.val()[k] == subset_four.val()[k];
+		ok &= CppAD::NearEqual(subset_four.val()[k], jac[i * n + j], 1e-10, 1e-10);
+	}
+	return ok;
+}
+
+} // END_EMPTY_NAMESPACE
+
+bool sparse_thread(void)
+{	bool ok = true;
+	size_t n = 20;
+	d_vector x(n);
+	for(size_t j = 0; j < n; j++)
+		x[j] = double(j) - 5.0;
+	//
+	// checkpoint function (atomic functions are evaluated using one thread)
+	a_vector au(1), av(1);
+	au[0] = 1.0;
+	CppAD::checkpoint<double> square("square", square_algo, au, av);
+	//
+	for(size_t use_atomic = 0; use_atomic < 2; use_atomic++)
+	{	CppAD::checkpoint<double>* ptr = CPPAD_NULL;
+		if( use_atomic )
+			ptr = &square;
+		CppAD::ADFun<double>* f = record(n, ptr);
+		ok &= check_jac(*f, x);
+		ok &= check_hes(*f, x);
+		delete f;
+		//
+		// subgraphs do not include the VecAD store operations
+		f = record(n, ptr, false);
+		ok &= check_subgraph(*f, x);
+		delete f;
+	}
+	// threads used by sparse routines are not left in parallel mode
+	ok &= CppAD::thread_alloc::num_threads() == 1;
+	ok &= ! CppAD::thread_alloc::in_parallel();
+	return ok;
+}
@@ -290,15 +290,84 @@ namespace {
 		return ok;
 	}
 
+	// ------------------------------------------------------------------------
+	bool test_subgraph_hes(bool optimize)
+	{	bool ok = true;
+		double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+		//
+		// declare checkpoint function
+		avector au(3), av(1);
+		for(size_t j = 0; j < 3; j++)
+			au[j] = AD<double>(j);
+		if( atom_g == CPPAD_NULL )
+			atom_g = new CppAD::checkpoint<double>("atom_g", g_algo, au, av);
+		//
+		// domain space vector
+		size_t n = 6;
+		avector ax(n);
+		for(size_t j = 0; j < n; j++)
+			ax[j] = AD<double>(j);
+		CppAD::Independent(ax);
+		//
+		// range space vector
+		size_t m = 5;
+		avector ay(m);
+		ay[0] = ax[0] * ax[1] * ax[1];
+		ay[1] = CppAD::CondExpLt(
+			ax[2], ax[3], ax[2] * ax[3] * ax[3], cos( ax[2] )
+		);
+		for(size_t j = 0; j < size_t(au.size()); ++j)
+			au[j] = ax[j + 3];
+		(*atom_g)(au, av);
+		ay[2] = av[0] * av[0];
+		ay[3] = ax[5];
+		ay[4] = 3.0;
+		CppAD::ADFun<double> f(ax, ay);
+		if( optimize )
+			f.optimize();
+		//
+		// weight vector
+		CPPAD_TESTVECTOR(double) w(m);
+		for(size_t i = 0; i < m; i++)
+			w[i] = double(i + 1);
+		//
+		// subset corresponding to the entire Hessian
+		sparsity pattern(n, n, n * n);
+		for(size_t k = 0; k < n * n; k++)
+			pattern.set(k, k / n, k % n);
+		CppAD::sparse_rcv<svector, CPPAD_TESTVECTOR(double)> subset(pattern);
+		//
+		// check both cases for the conditional expression
+		CPPAD_TESTVECTOR(double) x(n);
+		for(size_t j = 0; j < n; ++j)
+			x[j] = double(j + 1) / 2.0;
+		for(size_t rep = 0; rep < 2; ++rep)
+		{	if( rep == 1 )
+				x[2] = 2.0 * x[3];
+			f.subgraph_hes(x, w, subset);
+			CPPAD_TESTVECTOR(double) check = f.Hessian(x, w);
+			for(size_t k = 0; k < n * n; ++k)
+			{	size_t r = subset.row()[k];
+				size_t c = subset.col()[k];
+				double v = subset.val()[k];
+				ok &= CppAD::NearEqual(v, check[r * n + c], eps99, eps99);
+			}
+		}
+		//
+		return ok;
+	}
+
 }
 bool subgraph(void)
 {	bool ok       = true;
 	bool optimize = false;
 	ok           &= test_subgraph_sparsity(optimize);
 	ok           &= test_subgraph_reverse(optimize);
+	ok           &= test_subgraph_hes(optimize);
 	optimize      = true;
 	ok           &= test_subgraph_sparsity(optimize);
 	ok           &= test_subgraph_reverse(optimize);
+	ok           &= test_subgraph_hes(optimize);
 	//
 	ok           &= atom_g != CPPAD_NULL;
 	delete atom_g;
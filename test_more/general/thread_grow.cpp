@@ -0,0 +1,86 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check thread_alloc::grow_memory and pod_vector::extend
+for both small and large (possibly remapped) memory.
+*/
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+// grow memory from min_bytes[0] to min_bytes[1] to min_bytes[2]
+bool grow(const size_t* min_bytes)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	size_t thread = thread_alloc::thread_num();
+	size_t inuse  = thread_alloc::inuse(thread);
+	//
+	size_t cap_bytes;
+	void* v_ptr = thread_alloc::get_memory(min_bytes[0], cap_bytes);
+	unsigned char* c_ptr = reinterpret_cast<unsigned char*>(v_ptr);
+	size_t stride = 1 + min_bytes[0] / 1000;
+	for(size_t i = 0; i < min_bytes[0]; i += stride)
+		c_ptr[i] = static_cast<unsigned char>(i % 251);
+	//
+	for(size_t k = 1; k < 3; ++k)
+	{	v_ptr = thread_alloc::grow_memory(
+			v_ptr, min_bytes[k-1], min_bytes[k], cap_bytes
+		);
+		ok   &= min_bytes[k] <= cap_bytes;
+		ok   &= thread_alloc::inuse(thread) == inuse + cap_bytes;
+		// capacities of at least 4096 bytes are aligned to a cache line
+		if( cap_bytes >= 4096 )
+			ok &= reinterpret_cast<size_t>(v_ptr) % 64 == 0;
+		c_ptr = reinterpret_cast<unsigned char*>(v_ptr);
+		for(size_t i = 0; i < min_bytes[0]; i += stride)
+			ok &= c_ptr[i] == static_cast<unsigned char>(i % 251);
+		// use the last byte of the new memory
+		c_ptr[cap_bytes - 1] = 1;
+	}
+	thread_alloc::return_memory(v_ptr);
+	ok &= thread_alloc::inuse(thread) == inuse;
+	//
+	return ok;
+}
+
+} // END_EMPTY_NAMESPACE
+
+bool thread_grow(void)
+{	bool ok = true;
+	//
+	// small memory
+	size_t small[] = { 100, 1000, 5000 };
+	ok &= grow(small);
+	//
+	// large memory
+	size_t large[] = { 20000000, 60000000, 200000000 };
+	ok &= grow(large);
+	//
+	// pod_vector extend up to 40 megabytes
+	CppAD::local::pod_vector<size_t> vec;
+	size_t n = 5000000;
+	for(size_t i = 0; i < n; ++i)
+		vec[ vec.extend(1) ] = i;
+	ok &= vec.size() == n;
+	for(size_t i = 0; i < n; ++i)
+		ok &= vec[i] == i;
+	//
+	// pod_vector_maybe extend up to 40 megabytes
+	CppAD::local::pod_vector_maybe<double> dvec;
+	for(size_t i = 0; i < n; ++i)
+		dvec[ dvec.extend(1) ] = double(i);
+	ok &= dvec.size() == n;
+	for(size_t i = 0; i < n; ++i)
+		ok &= dvec[i] == double(i);
+	//
+	return ok;
+}
@@ -0,0 +1,76 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check thread_alloc::numa_local and the NUMA node memory statistics.
+*/
+# include <cppad/utility/thread_alloc.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+// sum of the inuse and available statistics for all the NUMA nodes
+void numa_sum(size_t thread, size_t& inuse, size_t& available)
+{	using CppAD::thread_alloc;
+	inuse     = 0;
+	available = 0;
+	for(size_t numa = 0; numa < 16; ++numa)
+	{	inuse     += thread_alloc::inuse(thread, numa);
+		available += thread_alloc::available(thread, numa);
+	}
+}
+
+} // END_EMPTY_NAMESPACE
+
+bool thread_numa(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	size_t thread = thread_alloc::thread_num();
+	size_t inuse, available;
+	//
+	ok &= thread_alloc::numa_node() < 16;
+	//
+	thread_alloc::hold_memory(true);
+	thread_alloc::numa_local(true);
+	//
+	// a small and a large (may use huge pages) allocation
+	size_t min_bytes[2] = { 100, 20000000 };
+	for(size_t k = 0; k < 2; ++k)
+	{	size_t cap_bytes;
+		void* v_ptr = thread_alloc::get_memory(min_bytes[k], cap_bytes);
+		numa_sum(thread, inuse, available);
+		ok &= inuse     == thread_alloc::inuse(thread);
+		ok &= available == thread_alloc::available(thread);
+		thread_alloc::return_memory(v_ptr);
+		//
+		// available memory is on the node for this thread, so it is re-used
+		// (unless the system moved this thread to a different node)
+		size_t numa = thread_alloc::numa_node();
+		size_t check;
+		if( thread_alloc::available(thread, numa) >= cap_bytes )
+		{	void* v_same = thread_alloc::get_memory(min_bytes[k], check);
+			ok &= v_same == v_ptr;
+			thread_alloc::return_memory(v_same);
+		}
+		numa_sum(thread, inuse, available);
+		ok &= inuse     == thread_alloc::inuse(thread);
+		ok &= available == thread_alloc::available(thread);
+	}
+	//
+	// restore default settings
+	thread_alloc::numa_local(false);
+	thread_alloc::hold_memory(false);
+	thread_alloc::free_available(thread);
+	numa_sum(thread, inuse, available);
+	ok &= available == 0;
+	ok &= inuse     == thread_alloc::inuse(thread);
+	//
+	return ok;
+}
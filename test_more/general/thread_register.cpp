@@ -0,0 +1,158 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check thread_alloc::parallel_setup with thread_num equal to CPPAD_NULL;
+i.e., threads that are registered using C++11 thread_local storage.
+More threads are created than num_threads, but at most num_threads - 1
+are running at the same time (in addition to the master thread).
+Some threads exit while recording and without freeing their memory;
+this state is reset when their thread numbers are reused.
+*/
+# include <cppad/cppad.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <thread>
+# include <atomic>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+// true while the worker threads are running
+std::atomic<bool> running(false);
+
+// number of worker threads that have their thread number
+std::atomic<size_t> n_started(0);
+
+bool in_parallel(void)
+{	return running; }
+
+// work done by each of the threads
+class worker {
+private:
+	size_t  n_;
+	size_t& thread_;
+	bool&   ok_;
+	size_t  n_worker_;
+	bool    abandon_;
+public:
+	worker(
+		size_t n, size_t& thread, bool& ok, size_t n_worker, bool abandon
+	)
+	: n_(n), thread_(thread), ok_(ok), n_worker_(n_worker), abandon_(abandon)
+	{ }
+	void operator()(void) const
+	{	using CppAD::AD;
+		thread_ = CppAD::thread_alloc::thread_num();
+		//
+		// wait until all the workers are registered
+		// (so they are running at the same time)
+		++n_started;
+		while( n_started < n_worker_ )
+			std::this_thread::yield();
+		//
+		// record f(x) = x_0 * x_1 * ... * x_{n-1}
+		CPPAD_TESTVECTOR( AD<double> ) ax(n_), ay(1);
+		for(size_t j = 0; j < n_; j++)
+			ax[j] = double(j + 1);
+		CppAD::Independent(ax);
+		ay[0] = 1.0;
+		for(size_t j = 0; j < n_; j++)
+			ay[0] *= ax[j];
+		//
+		// exit while recording and without freeing memory
+		if( abandon_ )
+		{	ok_ = CppAD::thread_alloc::inuse(thread_) > 0;
+			return;
+		}
+		bool ok;
+		{	CppAD::ADFun<double> f(ax, ay);
+			//
+			// check the derivative
+			CPPAD_TESTVECTOR(double) x(n_), dw;
+			for(size_t j = 0; j < n_; j++)
+				x[j] = double(j + 2);
+			f.Forward(0, x);
+			CPPAD_TESTVECTOR(double) w(1);
+			w[0] = 1.0;
+			dw   = f.Reverse(1, w);
+			ok   = true;
+			for(size_t j = 0; j < n_; j++)
+			{	double check = 1.0;
+				for(size_t k = 0; k < n_; k++) if( k != j )
+					check *= x[k];
+				ok &= CppAD::NearEqual(dw[j], check, 1e-10, 1e-10);
+			}
+		}
+		//
+		// thread number does not change
+		ok   &= thread_ == CppAD::thread_alloc::thread_num();
+		ok_   = ok;
+		//
+		// free memory for this thread before it exits
+		CppAD::thread_alloc::free_available(thread_);
+	}
+};
+
+} // END_EMPTY_NAMESPACE
+
+bool thread_register(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	//
+	// number of threads that are registered at the same time
+	size_t num_threads = 4;
+	thread_alloc::parallel_setup(num_threads, in_parallel, CPPAD_NULL);
+	CppAD::parallel_ad<double>();
+	ok &= thread_alloc::thread_num() == 0;
+	//
+	// create more threads than num_threads, a batch at a time
+	size_t n_batch  = 3;
+	size_t n_worker = num_threads - 1;
+	for(size_t batch = 0; batch < n_batch; ++batch)
+	{	size_t thread[3];
+		bool   thread_ok[3];
+		std::thread other[3];
+		running   = true;
+		n_started = 0;
+		for(size_t i = 0; i < n_worker; ++i)
+		{	// in the first batch, the first worker abandons its recording
+			bool abandon = batch == 0 && i == 0;
+			other[i] = std::thread( worker(
+				batch + i + 2, thread[i], thread_ok[i], n_worker, abandon
+			) );
+		}
+		for(size_t i = 0; i < n_worker; ++i)
+			other[i].join();
+		running = false;
+		//
+		// each worker got a different thread number that is not zero
+		for(size_t i = 0; i < n_worker; ++i)
+		{	ok &= thread_ok[i];
+			ok &= 0 < thread[i] && thread[i] < num_threads;
+			for(size_t k = 0; k < i; ++k)
+				ok &= thread[i] != thread[k];
+		}
+		ok &= thread_alloc::thread_num() == 0;
+	}
+	//
+	// return to sequential mode
+	thread_alloc::parallel_setup(1, CPPAD_NULL, CPPAD_NULL);
+	CppAD::parallel_ad<double>();
+	ok &= thread_alloc::thread_num() == 0;
+	for(size_t thread = 1; thread < num_threads; ++thread)
+		ok &= thread_alloc::inuse(thread) == 0;
+	//
+	return ok;
+}
+# else
+bool thread_register(void)
+{	return true; }
+# endif
@@ -0,0 +1,145 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check thread_alloc::return_memory for memory that was allocated by a
+different thread during parallel execution.
+*/
+# include <cppad/cppad.hpp>
+
+# if CPPAD_USE_CPLUSPLUS_2011
+# include <thread>
+# include <atomic>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+
+// true while the worker threads are running
+std::atomic<bool> running(false);
+
+// set by the producer when its memory is ready to be returned
+std::atomic<bool> produced(false);
+
+// set by the consumer when it has returned the memory
+std::atomic<bool> consumed(false);
+
+bool in_parallel(void)
+{	return running; }
+
+// number of blocks of memory passed from producer to consumer
+const size_t n_block = 10;
+
+// memory passed from producer to consumer
+void* block[n_block];
+
+// allocates memory that is returned by the consumer
+class producer {
+private:
+	bool& ok_;
+public:
+	producer(bool& ok) : ok_(ok)
+	{ }
+	void operator()(void) const
+	{	using CppAD::thread_alloc;
+		bool ok       = true;
+		size_t thread = thread_alloc::thread_num();
+		size_t inuse  = thread_alloc::inuse(thread);
+		//
+		size_t min_bytes = 100, cap_bytes;
+		for(size_t k = 0; k < n_block; ++k)
+			block[k] = thread_alloc::get_memory(min_bytes, cap_bytes);
+		ok &= thread_alloc::inuse(thread) == inuse + n_block * cap_bytes;
+		//
+		// wait for the consumer to return the memory
+		produced = true;
+		while( ! consumed )
+			std::this_thread::yield();
+		//
+		// memory returned by the consumer is now available to this thread
+		ok &= thread_alloc::inuse(thread) == inuse;
+		ok &= thread_alloc::available(thread) >= n_block * cap_bytes;
+		//
+		// the next request uses one of the returned blocks
+		void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+		bool found  = false;
+		for(size_t k = 0; k < n_block; ++k)
+			found |= v_ptr == block[k];
+		ok &= found;
+		thread_alloc::return_memory(v_ptr);
+		//
+		// free memory for this thread before it exits
+		thread_alloc::free_available(thread);
+		ok &= thread_alloc::available(thread) == 0;
+		ok_ = ok;
+	}
+};
+
+// returns the memory allocated by the producer
+class consumer {
+private:
+	bool& ok_;
+public:
+	consumer(bool& ok) : ok_(ok)
+	{ }
+	void operator()(void) const
+	{	using CppAD::thread_alloc;
+		size_t thread = thread_alloc::thread_num();
+		size_t inuse  = thread_alloc::inuse(thread);
+		//
+		while( ! produced )
+			std::this_thread::yield();
+		for(size_t k = 0; k < n_block; ++k)
+			thread_alloc::return_memory( block[k] );
+		//
+		// inuse memory for this thread does not change
+		ok_ = thread_alloc::inuse(thread) == inuse;
+		thread_alloc::free_available(thread);
+		consumed = true;
+	}
+};
+
+} // END_EMPTY_NAMESPACE
+
+bool thread_remote(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	//
+	size_t num_threads = 3;
+	thread_alloc::parallel_setup(num_threads, in_parallel, CPPAD_NULL);
+	thread_alloc::hold_memory(true);
+	//
+	bool producer_ok = false;
+	bool consumer_ok = false;
+	running  = true;
+	produced = false;
+	consumed = false;
+	std::thread other[2];
+	other[0] = std::thread( producer(producer_ok) );
+	other[1] = std::thread( consumer(consumer_ok) );
+	other[0].join();
+	other[1].join();
+	running = false;
+	ok &= producer_ok;
+	ok &= consumer_ok;
+	//
+	// return to sequential mode
+	thread_alloc::hold_memory(false);
+	thread_alloc::parallel_setup(1, CPPAD_NULL, CPPAD_NULL);
+	for(size_t thread = 1; thread < num_threads; ++thread)
+	{	ok &= thread_alloc::inuse(thread) == 0;
+		ok &= thread_alloc::available(thread) == 0;
+	}
+	//
+	return ok;
+}
+# else
+bool thread_remote(void)
+{	return true; }
+# endif
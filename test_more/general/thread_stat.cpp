@@ -0,0 +1,127 @@
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-18 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check the thread_alloc allocation statistics; i.e., the peak memory,
+the memory for each tag, and the histogram of allocations.
+*/
+# include <cppad/cppad.hpp>
+
+bool thread_stat(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::thread_alloc;
+	size_t thread  = thread_alloc::thread_num();
+	size_t num_cap = thread_alloc::num_capacity();
+	//
+	// capacities are increasing
+	for(size_t c = 1; c < num_cap; ++c)
+		ok &= thread_alloc::capacity(c-1) < thread_alloc::capacity(c);
+	//
+	// set_tag and tag_scope
+	ok &= thread_alloc::set_tag(thread_alloc::optimize_tag)
+		== thread_alloc::general_tag;
+	{	thread_alloc::tag_scope scope(thread_alloc::taylor_tag);
+		ok &= thread_alloc::set_tag(thread_alloc::taylor_tag)
+			== thread_alloc::taylor_tag;
+	}
+	ok &= thread_alloc::set_tag(thread_alloc::general_tag)
+		== thread_alloc::optimize_tag;
+	//
+	// start with zero counts
+	thread_alloc::reset_peak(thread);
+	size_t inuse = thread_alloc::inuse(thread);
+	size_t tag_inuse[thread_alloc::number_tag];
+	for(size_t k = 0; k < thread_alloc::number_tag; ++k)
+	{	thread_alloc::tag_enum tag = thread_alloc::tag_enum(k);
+		tag_inuse[k] = thread_alloc::tag_inuse(thread, tag);
+		ok &= thread_alloc::tag_peak(thread, tag) == tag_inuse[k];
+	}
+	ok &= thread_alloc::peak_inuse(thread) == inuse;
+	for(size_t c = 0; c < num_cap; ++c)
+	{	ok &= thread_alloc::num_get(thread, c) == 0;
+		ok &= thread_alloc::num_return(thread, c) == 0;
+	}
+	{	// record f(x) = x_0 * x_1 * ... * x_{n-1}
+		size_t n = 20;
+		CPPAD_TESTVECTOR( AD<double> ) ax(n), ay(1);
+		for(size_t j = 0; j < n; j++)
+			ax[j] = double(j + 1);
+		CppAD::Independent(ax);
+		ay[0] = 1.0;
+		for(size_t j = 0; j < n; j++)
+			ay[0] *= ax[j];
+		CppAD::ADFun<double> f(ax, ay);
+		//
+		// taylor coefficients
+		CPPAD_TESTVECTOR(double) x(n);
+		for(size_t j = 0; j < n; j++)
+			x[j] = 1.0;
+		f.Forward(0, x);
+		//
+		// sparsity pattern
+		CppAD::vectorBool r(n * n), s;
+		for(size_t i = 0; i < n; i++)
+			for(size_t j = 0; j < n; j++)
+				r[i * n + j] = i == j;
+		s = f.ForSparseJac(n, r);
+		//
+		// memory for this calculation is attributed to its tag
+		ok &= thread_alloc::tag_peak(thread, thread_alloc::recorder_tag)
+			> tag_inuse[thread_alloc::recorder_tag];
+		ok &= thread_alloc::tag_peak(thread, thread_alloc::taylor_tag)
+			> tag_inuse[thread_alloc::taylor_tag];
+		ok &= thread_alloc::tag_peak(thread, thread_alloc::sparsity_tag)
+			> tag_inuse[thread_alloc::sparsity_tag];
+		ok &= thread_alloc::peak_inuse(thread) > inuse;
+		ok &= thread_alloc::peak_inuse(thread) >= thread_alloc::inuse(thread);
+		//
+		// f contains recorder and taylor memory
+		ok &= thread_alloc::tag_inuse(thread, thread_alloc::recorder_tag)
+			> tag_inuse[thread_alloc::recorder_tag];
+		ok &= thread_alloc::tag_inuse(thread, thread_alloc::taylor_tag)
+			> tag_inuse[thread_alloc::taylor_tag];
+	}
+	// all the memory has been returned
+	ok &= thread_alloc::inuse(thread) == inuse;
+	size_t sum = 0;
+	for(size_t k = 0; k < thread_alloc::number_tag; ++k)
+	{	thread_alloc::tag_enum tag = thread_alloc::tag_enum(k);
+		ok &= thread_alloc::tag_inuse(thread, tag) == tag_inuse[k];
+		sum += thread_alloc::tag_inuse(thread, tag);
+	}
+	ok &= sum == inuse;
+	//
+	// histogram of allocations is balanced
+	size_t num_get = 0;
+	for(size_t c = 0; c < num_cap; ++c)
+	{	ok &= thread_alloc::num_get(thread, c)
+			== thread_alloc::num_return(thread, c);
+		num_get += thread_alloc::num_get(thread, c);
+	}
+	ok &= num_get > 0;
+	//
+	// free_available does not change the statistics
+	size_t peak = thread_alloc::peak_inuse(thread);
+	thread_alloc::free_available(thread);
+	ok &= thread_alloc::peak_inuse(thread) == peak;
+	size_t num_return = 0;
+	for(size_t c = 0; c < num_cap; ++c)
+		num_return += thread_alloc::num_return(thread, c);
+	ok &= num_return == num_get;
+	//
+	// reset_peak
+	thread_alloc::reset_peak(thread);
+	ok &= thread_alloc::peak_inuse(thread) == inuse;
+	ok &= thread_alloc::num_get(thread, 0) == 0;
+	//
+	return ok;
+}